@@ -24,6 +24,10 @@
 
 #include "AppDelegate.h"
 #include "HelloWorldScene.h"
+#include "managers/FrameRateManager.h"
+#include "configs/AssetVariants.h"
+#include "utils/AssetVariantLoader.h"
+#include "utils/BundleFileUtils.h"
 
 // #define USE_AUDIO_ENGINE 1
 // #define USE_SIMPLE_AUDIO_ENGINE 1
@@ -47,12 +51,18 @@ static cocos2d::Size smallResolutionSize = cocos2d::Size(480, 320);
 static cocos2d::Size mediumResolutionSize = cocos2d::Size(1024, 768);
 static cocos2d::Size largeResolutionSize = cocos2d::Size(2048, 1536);
 
+// tools/assetpack 生成的资源包，不存在时逐个读取资源文件
+static const char* ASSET_BUNDLE_FILE = "assets.cgpk";
+
 AppDelegate::AppDelegate()
 {
 }
 
 AppDelegate::~AppDelegate() 
 {
+    FrameRateManager::destroyInstance();
+    AssetVariantLoader::destroyInstance();
+
 #if USE_AUDIO_ENGINE
     AudioEngine::end();
 #elif USE_SIMPLE_AUDIO_ENGINE
@@ -77,7 +87,44 @@ static int register_all_packages()
     return 0; //flag for packages manager
 }
 
+// 设置 contentScaleFactor；有 tools/assetc 生成的变体清单时加载最接近 requestedScale 的一档缩小纹理
+// 变体纹理中图片的像素是原图的 scale 倍，contentScaleFactor 同乘 scale，卡牌在屏幕上的大小与使用原图时相同；
+// 没有清单、没有合适的档位或加载失败时使用原图。返回是否使用了变体
+static bool applyAssetVariants(float requestedScale)
+{
+    auto director = Director::getInstance();
+    auto fileUtils = FileUtils::getInstance();
+    director->setContentScaleFactor(requestedScale);
+    if (!fileUtils->isFileExist(AssetVariants::MANIFEST_FILE)) {
+        return false;
+    }
+
+    AssetVariantManifest manifest;
+    std::string error;
+    if (!AssetVariants::parseManifest(fileUtils->getStringFromFile(AssetVariants::MANIFEST_FILE), manifest, &error)) {
+        CCLOG("AssetVariants: %s", error.c_str());
+        return false;
+    }
+    const AssetVariant* variant = AssetVariants::selectVariant(manifest, requestedScale);
+    if (!variant) {
+        return false;
+    }
+
+    // 精灵帧按 contentScaleFactor 把像素换算为点，先设置再加载
+    director->setContentScaleFactor(requestedScale * variant->scale);
+    if (!AssetVariantLoader::getInstance()->load(manifest, static_cast<size_t>(variant - manifest.variants.data()), &error)) {
+        CCLOG("AssetVariants: %s", error.c_str());
+        director->setContentScaleFactor(requestedScale);
+        return false;
+    }
+    CCLOG("AssetVariants: %s x%.4f, %d file(s)", variant->name.c_str(), variant->scale, static_cast<int>(manifest.files.size()));
+    return true;
+}
+
 bool AppDelegate::applicationDidFinishLaunching() {
+    // 有资源包时所有资源读取都走内存映射，需要在读取任何资源之前安装
+    BundleFileUtils::install(ASSET_BUNDLE_FILE);
+
     // initialize director
     auto director = Director::getInstance();
     auto glview = director->getOpenGLView();
@@ -96,23 +143,39 @@ bool AppDelegate::applicationDidFinishLaunching() {
     // set FPS. the default value is 1.0/60 if you don't call this
     director->setAnimationInterval(1.0f / 60);
 
+    // 没有动画和输入时降到空闲帧率，触摸或动画开始时恢复 60 帧
+    auto frameRate = FrameRateManager::getInstance();
+    frameRate->setActiveInterval(1.0f / 60);
+#if MEASURE_FRAME_RATE
+    frameRate->setMeasureEnabled(true, 60.0f);
+#endif
+    frameRate->start();
+
     // Set the design resolution
     glview->setDesignResolutionSize(designResolutionSize.width, designResolutionSize.height, ResolutionPolicy::FIXED_WIDTH);
     auto frameSize = glview->getFrameSize();
+    float contentScale;
     // if the frame's height is larger than the height of medium size.
     if (frameSize.height > mediumResolutionSize.height)
     {        
-        director->setContentScaleFactor(MIN(largeResolutionSize.height/designResolutionSize.height, largeResolutionSize.width/designResolutionSize.width));
+        contentScale = MIN(largeResolutionSize.height/designResolutionSize.height, largeResolutionSize.width/designResolutionSize.width);
     }
     // if the frame's height is larger than the height of small size.
     else if (frameSize.height > smallResolutionSize.height)
     {        
-        director->setContentScaleFactor(MIN(mediumResolutionSize.height/designResolutionSize.height, mediumResolutionSize.width/designResolutionSize.width));
+        contentScale = MIN(mediumResolutionSize.height/designResolutionSize.height, mediumResolutionSize.width/designResolutionSize.width);
     }
     // if the frame's height is smaller than the height of medium size.
     else
     {        
-        director->setContentScaleFactor(MIN(smallResolutionSize.height/designResolutionSize.height, smallResolutionSize.width/designResolutionSize.width));
+        contentScale = MIN(smallResolutionSize.height/designResolutionSize.height, smallResolutionSize.width/designResolutionSize.width);
+    }
+    bool useVariants = applyAssetVariants(contentScale);
+
+    // 使用变体时卡牌素材已经加载为精灵帧，否则把原图直接从映射解码进纹理缓存
+    auto bundle = BundleFileUtils::getInstalled();
+    if (bundle && !useVariants) {
+        bundle->preloadImages("res/");
     }
 
     register_all_packages();
@@ -141,6 +204,7 @@ void AppDelegate::applicationDidEnterBackground() {
 // this function will be called when the app is active again
 void AppDelegate::applicationWillEnterForeground() {
     Director::getInstance()->startAnimation();
+    FrameRateManager::getInstance()->wake();
 
 #if USE_AUDIO_ENGINE
     AudioEngine::resumeAll();
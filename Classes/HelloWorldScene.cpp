@@ -1,6 +1,19 @@
 #include "HelloWorldScene.h"
 #include "controllers/GameController.h"
 
+// 自动对局压测：连续自动打完若干局并输出性能报告（见 controllers/AutoPlayer.h）
+// #define ENABLE_AUTOPLAY 1
+
+#if ENABLE_AUTOPLAY
+#include "controllers/AutoPlayer.h"
+#endif
+
+// #define ENABLE_RACE 1
+
+#if ENABLE_RACE
+#include "controllers/RaceController.h"
+#endif
+
 USING_NS_CC;
 
 Scene* HelloWorld::createScene()
@@ -20,8 +33,26 @@ bool HelloWorld::init()
     // 创建游戏控制器
     _gameController = new GameController();
     if (_gameController && _gameController->init(this)) {
-        // 加载关卡
-        _gameController->loadLevel("level1.json");
+        // 在后台构建关卡，首帧先显示空牌桌，构建完成后再铺牌
+        _gameController->loadLevelAsync("level1.json");
+        
+#if ENABLE_AUTOPLAY
+        AutoPlayConfig config;
+        config.levelFile = "level1.json";
+        auto autoPlayer = AutoPlayer::create(_gameController, config);
+        if (autoPlayer) {
+            this->addChild(autoPlayer);
+        }
+#endif
+
+#if ENABLE_RACE
+        // 与本地机器人对战（回环模拟网络延迟），提示文字显示在牌桌之上
+        RaceConfig raceConfig;
+        auto raceController = RaceController::create(_gameController, raceConfig);
+        if (raceController) {
+            this->addChild(raceController, 1);
+        }
+#endif
     }
 
     return true;
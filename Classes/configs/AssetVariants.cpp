@@ -0,0 +1,175 @@
+#include "AssetVariants.h"
+#include "json/rapidjson.h"
+#include "json/document.h"
+#include <algorithm>
+#include <cstdio>
+
+const char* AssetVariants::MANIFEST_FILE = "variants/variants.json";
+
+namespace {
+
+// 档位比较容差：清单中的缩放写成 4 位小数
+const float SCALE_EPSILON = 0.001f;
+
+void setError(std::string* error, const std::string& msg)
+{
+    if (error) {
+        *error = msg;
+    }
+}
+
+// 与 AppDelegate 一致：contentScaleFactor = min(档位高 / 设计高, 档位宽 / 设计宽)
+float bucketScale(float width, float height)
+{
+    const float designWidth = 1080.0f;
+    const float designHeight = 2080.0f;
+    return std::min(height / designHeight, width / designWidth);
+}
+
+void appendJsonString(std::string& out, const std::string& value)
+{
+    out += '"';
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+        }
+        out += c;
+    }
+    out += '"';
+}
+
+} // namespace
+
+void AssetVariants::getDefaultVariants(std::vector<AssetVariant>& outVariants)
+{
+    outVariants.clear();
+    outVariants.push_back(AssetVariant("large", bucketScale(2048.0f, 1536.0f), "variants/large"));
+    outVariants.push_back(AssetVariant("medium", bucketScale(1024.0f, 768.0f), "variants/medium"));
+    outVariants.push_back(AssetVariant("small", bucketScale(480.0f, 320.0f), "variants/small"));
+}
+
+bool AssetVariants::parseManifest(const std::string& json, AssetVariantManifest& outManifest, std::string* error)
+{
+    outManifest = AssetVariantManifest();
+
+    rapidjson::Document doc;
+    doc.Parse(json.c_str());
+    if (doc.HasParseError() || !doc.IsObject()) {
+        setError(error, "JSON parse error");
+        return false;
+    }
+    if (!doc.HasMember("Version") || !doc["Version"].IsInt() || doc["Version"].GetInt() != MANIFEST_VERSION) {
+        setError(error, "unsupported manifest version");
+        return false;
+    }
+    if (doc.HasMember("Format") && doc["Format"].IsString()) {
+        outManifest.format = doc["Format"].GetString();
+    }
+
+    if (!doc.HasMember("Variants") || !doc["Variants"].IsArray()) {
+        setError(error, "missing Variants");
+        return false;
+    }
+    const rapidjson::Value& variants = doc["Variants"];
+    for (rapidjson::SizeType i = 0; i < variants.Size(); i++) {
+        const rapidjson::Value& item = variants[i];
+        if (!item.IsObject()
+            || !item.HasMember("Name") || !item["Name"].IsString()
+            || !item.HasMember("Scale") || !item["Scale"].IsNumber()
+            || !item.HasMember("Dir") || !item["Dir"].IsString()
+            || item["Scale"].GetFloat() <= 0.0f) {
+            setError(error, "invalid variant #" + std::to_string(i));
+            return false;
+        }
+        outManifest.variants.push_back(AssetVariant(item["Name"].GetString(), item["Scale"].GetFloat(), item["Dir"].GetString()));
+    }
+
+    if (!doc.HasMember("Files") || !doc["Files"].IsArray()) {
+        setError(error, "missing Files");
+        return false;
+    }
+    const rapidjson::Value& files = doc["Files"];
+    for (rapidjson::SizeType i = 0; i < files.Size(); i++) {
+        const rapidjson::Value& item = files[i];
+        if (!item.IsObject()
+            || !item.HasMember("Path") || !item["Path"].IsString()
+            || !item.HasMember("Sizes") || !item["Sizes"].IsArray()
+            || item["Sizes"].Size() != outManifest.variants.size()) {
+            setError(error, "invalid file #" + std::to_string(i));
+            return false;
+        }
+        AssetVariantFile file;
+        file.path = item["Path"].GetString();
+        const rapidjson::Value& sizes = item["Sizes"];
+        for (rapidjson::SizeType v = 0; v < sizes.Size(); v++) {
+            const rapidjson::Value& size = sizes[v];
+            if (!size.IsArray() || size.Size() != 2 || !size[0].IsInt() || !size[1].IsInt()
+                || size[0].GetInt() <= 0 || size[1].GetInt() <= 0) {
+                setError(error, "invalid size of " + file.path);
+                return false;
+            }
+            file.widths.push_back(size[0].GetInt());
+            file.heights.push_back(size[1].GetInt());
+        }
+        outManifest.files.push_back(file);
+    }
+    return true;
+}
+
+std::string AssetVariants::toJson(const AssetVariantManifest& manifest)
+{
+    std::string out = "{\n  \"Version\": " + std::to_string(MANIFEST_VERSION) + ",\n  \"Format\": ";
+    appendJsonString(out, manifest.format);
+    out += ",\n  \"Variants\": [";
+    for (size_t i = 0; i < manifest.variants.size(); i++) {
+        const AssetVariant& variant = manifest.variants[i];
+        char scale[32];
+        std::snprintf(scale, sizeof(scale), "%.4f", variant.scale);
+        out += i == 0 ? "\n    { \"Name\": " : ",\n    { \"Name\": ";
+        appendJsonString(out, variant.name);
+        out += std::string(", \"Scale\": ") + scale + ", \"Dir\": ";
+        appendJsonString(out, variant.dir);
+        out += " }";
+    }
+    out += "\n  ],\n  \"Files\": [";
+    for (size_t i = 0; i < manifest.files.size(); i++) {
+        const AssetVariantFile& file = manifest.files[i];
+        out += i == 0 ? "\n    { \"Path\": " : ",\n    { \"Path\": ";
+        appendJsonString(out, file.path);
+        out += ", \"Sizes\": [";
+        for (size_t v = 0; v < file.widths.size(); v++) {
+            out += (v == 0 ? "[" : ", [") + std::to_string(file.widths[v]) + ", " + std::to_string(file.heights[v]) + "]";
+        }
+        out += "] }";
+    }
+    out += "\n  ]\n}\n";
+    return out;
+}
+
+const AssetVariant* AssetVariants::selectVariant(const AssetVariantManifest& manifest, float requestedScale)
+{
+    const AssetVariant* best = nullptr;
+    for (const auto& variant : manifest.variants) {
+        // 不小于 1 的档位没有意义，直接用原图
+        if (variant.scale >= 1.0f || variant.scale + SCALE_EPSILON < requestedScale) {
+            continue;
+        }
+        if (!best || variant.scale < best->scale) {
+            best = &variant;
+        }
+    }
+    return best;
+}
+
+std::string AssetVariants::variantPath(const AssetVariant& variant, const std::string& file)
+{
+    size_t dot = file.find_last_of('.');
+    size_t slash = file.find_last_of('/');
+    std::string stem = (dot != std::string::npos && (slash == std::string::npos || dot > slash)) ? file.substr(0, dot) : file;
+    return variant.dir + "/" + stem + ".pvr";
+}
+
+std::string AssetVariants::alphaPath(const AssetVariant& variant, const std::string& file)
+{
+    return variantPath(variant, file) + "@alpha";
+}
@@ -0,0 +1,69 @@
+#ifndef __ASSET_VARIANTS_H__
+#define __ASSET_VARIANTS_H__
+
+#include <string>
+#include <vector>
+
+/**
+ * 一档缩放的资源变体
+ * scale 为相对原图（按设计分辨率制作）的缩放；使用该变体时 contentScaleFactor 也乘以 scale，显示大小不变
+ */
+struct AssetVariant {
+    std::string name;
+    float scale;
+    std::string dir;         // 相对资源根目录，如 "variants/medium"
+
+    AssetVariant() : scale(1.0f) {}
+    AssetVariant(const std::string& n, float s, const std::string& d) : name(n), scale(s), dir(d) {}
+};
+
+/**
+ * 清单中的一张原图
+ * 变体纹理的宽高补齐到 2 次幂（GLES2 只能对 2 次幂纹理使用 mipmap），缩小后的图片在纹理左上角，
+ * widths / heights 为各档中图片本身的像素尺寸，顺序与清单的 variants 一致
+ */
+struct AssetVariantFile {
+    std::string path;                    // 原图相对路径，如 "res/card_general.png"
+    std::vector<int> widths;
+    std::vector<int> heights;
+};
+
+/**
+ * 变体清单（tools/assetc 生成的 variants/variants.json）
+ */
+struct AssetVariantManifest {
+    std::string format;                  // 像素格式，仅供查看（运行时以纹理文件头为准）
+    std::vector<AssetVariant> variants;
+    std::vector<AssetVariantFile> files;
+};
+
+/**
+ * 资源变体
+ *
+ * 构建时 tools/assetc 为每档缩放生成缩小后的 PVR 纹理（默认 ETC1 加分离 alpha，带完整 mipmap），
+ * 运行时按分辨率档位选择一档，由 AssetVariantLoader 加载为以原图路径命名的精灵帧。
+ * 清单解析与选择不依赖 cocos2d，构建工具和游戏共用。
+ */
+class AssetVariants {
+public:
+    static const int MANIFEST_VERSION = 2;
+    static const char* MANIFEST_FILE;    // "variants/variants.json"
+
+    // 默认的三档缩放，与 AppDelegate 的 small / medium / large 分辨率对设计分辨率 1080x2080 的比例一致
+    static void getDefaultVariants(std::vector<AssetVariant>& outVariants);
+
+    static bool parseManifest(const std::string& json, AssetVariantManifest& outManifest, std::string* error = nullptr);
+    static std::string toJson(const AssetVariantManifest& manifest);
+
+    // 选择缩放不小于 requestedScale 的最小一档（只缩小不放大）；没有合适的档位时返回 nullptr，使用原图
+    static const AssetVariant* selectVariant(const AssetVariantManifest& manifest, float requestedScale);
+
+    // 原图在某一档中的路径："res/a.png" -> "variants/medium/res/a.pvr"
+    static std::string variantPath(const AssetVariant& variant, const std::string& file);
+
+    // ETC1 分离 alpha 纹理的路径，沿用 cocos2d 的 "@alpha" 后缀："variants/medium/res/a.pvr@alpha"
+    // 不透明图片没有 alpha 纹理
+    static std::string alphaPath(const AssetVariant& variant, const std::string& file);
+};
+
+#endif // __ASSET_VARIANTS_H__
@@ -0,0 +1,261 @@
+#include "DealEngine.h"
+#include <cstring>
+
+namespace {
+
+const char DESCRIPTOR_MAGIC[4] = { 'C', 'G', 'D', 'L' };
+
+/**
+ * 主牌区布局模板（关卡坐标，主牌区坐标未加堆牌区高度）
+ * 按数组顺序放牌，后放的牌压在先放的上方
+ */
+struct LayoutPoint {
+    short x;
+    short y;
+};
+
+// 两侧阶梯（与 level1.json 相同）
+const LayoutPoint TWIN_STAIRS[] = {
+    { 250, 1000 }, { 300, 800 }, { 350, 600 },
+    { 850, 1000 }, { 800, 800 }, { 750, 600 },
+};
+
+// 金字塔：5 行，下面一行压住上面一行的相邻两张
+const LayoutPoint PYRAMID[] = {
+    { 540, 1200 },
+    { 440, 1050 }, { 640, 1050 },
+    { 340, 900 }, { 540, 900 }, { 740, 900 },
+    { 240, 750 }, { 440, 750 }, { 640, 750 }, { 840, 750 },
+    { 140, 600 }, { 340, 600 }, { 540, 600 }, { 740, 600 }, { 940, 600 },
+};
+
+// 四列，每列 4 张向下叠放
+const LayoutPoint COLUMNS[] = {
+    { 180, 1200 }, { 420, 1200 }, { 660, 1200 }, { 900, 1200 },
+    { 180, 1080 }, { 420, 1080 }, { 660, 1080 }, { 900, 1080 },
+    { 180, 960 }, { 420, 960 }, { 660, 960 }, { 900, 960 },
+    { 180, 840 }, { 420, 840 }, { 660, 840 }, { 900, 840 },
+};
+
+// 两行错位：第二行压住第一行的相邻两张
+const LayoutPoint DOUBLE_ROW[] = {
+    { 140, 1000 }, { 340, 1000 }, { 540, 1000 }, { 740, 1000 }, { 940, 1000 },
+    { 240, 880 }, { 440, 880 }, { 640, 880 }, { 840, 880 },
+};
+
+struct LayoutTemplate {
+    const char* name;
+    const LayoutPoint* points;
+    int count;
+};
+
+const LayoutTemplate TEMPLATES[] = {
+    { "twin_stairs", TWIN_STAIRS, static_cast<int>(sizeof(TWIN_STAIRS) / sizeof(TWIN_STAIRS[0])) },
+    { "pyramid", PYRAMID, static_cast<int>(sizeof(PYRAMID) / sizeof(PYRAMID[0])) },
+    { "columns", COLUMNS, static_cast<int>(sizeof(COLUMNS) / sizeof(COLUMNS[0])) },
+    { "double_row", DOUBLE_ROW, static_cast<int>(sizeof(DOUBLE_ROW) / sizeof(DOUBLE_ROW[0])) },
+};
+
+const int TEMPLATE_COUNT = static_cast<int>(sizeof(TEMPLATES) / sizeof(TEMPLATES[0]));
+
+/**
+ * 只用整数运算的随机数发生器（splitmix64 播种 + xorshift64*）
+ */
+class DealRandom {
+public:
+    explicit DealRandom(uint64_t seed)
+    {
+        uint64_t z = seed + 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        _state = z ^ (z >> 31);
+        if (_state == 0) {
+            _state = 0x2545F4914F6CDD1DULL;
+        }
+    }
+
+    uint32_t next()
+    {
+        _state ^= _state >> 12;
+        _state ^= _state << 25;
+        _state ^= _state >> 27;
+        return static_cast<uint32_t>((_state * 0x2545F4914F6CDD1DULL) >> 32);
+    }
+
+    // [0, bound) 内均匀分布，拒绝采样消除取模偏差
+    uint32_t nextBelow(uint32_t bound)
+    {
+        uint32_t threshold = (0u - bound) % bound;
+        while (true) {
+            uint32_t r = next();
+            if (r >= threshold) {
+                return r % bound;
+            }
+        }
+    }
+
+private:
+    uint64_t _state;
+};
+
+void setError(std::string* error, const std::string& msg)
+{
+    if (error) {
+        *error = msg;
+    }
+}
+
+} // namespace
+
+bool DealEngine::deal(const DealDescriptor& desc, LevelConfig& outLevel, std::string* error)
+{
+    outLevel.clear();
+
+    if (desc.layoutTemplate >= TEMPLATE_COUNT) {
+        setError(error, "unknown layout template " + std::to_string(desc.layoutTemplate));
+        return false;
+    }
+    if (desc.matchRule >= MatchRuleType::COUNT) {
+        setError(error, "unknown match rule");
+        return false;
+    }
+    if (desc.deckCount < 1 || desc.deckCount > 4) {
+        setError(error, "deck count must be 1..4");
+        return false;
+    }
+    if ((desc.suitMask & 0x0F) == 0 || desc.faceMin > desc.faceMax || desc.faceMax >= LevelLayout::FACE_COUNT) {
+        setError(error, "empty suit mask or invalid face range");
+        return false;
+    }
+
+    // 按约束生成牌组（牌码从小到大，保证洗牌前的顺序确定）
+    uint8_t deck[LevelLayout::CARD_CODE_COUNT * 4];
+    int deckSize = 0;
+    for (int d = 0; d < desc.deckCount; d++) {
+        for (int suit = 0; suit < LevelLayout::SUIT_COUNT; suit++) {
+            if (!(desc.suitMask & (1 << suit))) {
+                continue;
+            }
+            for (int face = desc.faceMin; face <= desc.faceMax; face++) {
+                deck[deckSize++] = static_cast<uint8_t>(LevelLayout::makeCardCode(face, suit));
+            }
+        }
+    }
+
+    const LayoutTemplate& layout = TEMPLATES[desc.layoutTemplate];
+    int needed = layout.count + desc.trayCount + 1;
+    if (needed > deckSize) {
+        setError(error, "deck has " + std::to_string(deckSize) + " cards, deal needs " + std::to_string(needed));
+        return false;
+    }
+
+    // 只需洗出前 needed 张
+    DealRandom rng(desc.seed);
+    for (int i = 0; i < needed; i++) {
+        int j = i + static_cast<int>(rng.nextBelow(static_cast<uint32_t>(deckSize - i)));
+        uint8_t tmp = deck[i];
+        deck[i] = deck[j];
+        deck[j] = tmp;
+    }
+
+    outLevel.matchRule = desc.matchRule;
+    outLevel.playfield.reserve(layout.count);
+    for (int i = 0; i < layout.count; i++) {
+        outLevel.playfield.push_back(LevelCardConfig(
+            LevelLayout::cardCodeFace(deck[i]),
+            LevelLayout::cardCodeSuit(deck[i]),
+            static_cast<float>(layout.points[i].x),
+            static_cast<float>(layout.points[i].y)));
+    }
+    outLevel.stack.reserve(desc.trayCount + 1);
+    for (int i = layout.count; i < needed; i++) {
+        outLevel.stack.push_back(LevelCardConfig(LevelLayout::cardCodeFace(deck[i]), LevelLayout::cardCodeSuit(deck[i]), 0.0f, 0.0f));
+    }
+    return true;
+}
+
+void DealEngine::encode(const DealDescriptor& desc, std::vector<unsigned char>& outData)
+{
+    outData.clear();
+    outData.reserve(DESCRIPTOR_SIZE);
+    for (char c : DESCRIPTOR_MAGIC) {
+        outData.push_back(static_cast<unsigned char>(c));
+    }
+    outData.push_back(static_cast<unsigned char>(DESCRIPTOR_VERSION));
+    outData.push_back(desc.layoutTemplate);
+    outData.push_back(static_cast<unsigned char>(desc.matchRule));
+    outData.push_back(desc.deckCount);
+    outData.push_back(desc.suitMask);
+    outData.push_back(desc.faceMin);
+    outData.push_back(desc.faceMax);
+    outData.push_back(desc.trayCount);
+    for (int i = 0; i < 8; i++) {
+        outData.push_back(static_cast<unsigned char>((desc.seed >> (i * 8)) & 0xFF));
+    }
+}
+
+bool DealEngine::decode(const unsigned char* data, size_t size, DealDescriptor& outDesc, std::string* error)
+{
+    if (!isDescriptor(reinterpret_cast<const char*>(data), size) || size != DESCRIPTOR_SIZE) {
+        setError(error, "not a deal descriptor");
+        return false;
+    }
+    if (data[4] != DESCRIPTOR_VERSION) {
+        setError(error, "unsupported deal descriptor version " + std::to_string(data[4]));
+        return false;
+    }
+    if (data[6] >= static_cast<unsigned char>(MatchRuleType::COUNT)) {
+        setError(error, "unknown match rule " + std::to_string(data[6]));
+        return false;
+    }
+
+    outDesc.layoutTemplate = data[5];
+    outDesc.matchRule = static_cast<MatchRuleType>(data[6]);
+    outDesc.deckCount = data[7];
+    outDesc.suitMask = data[8];
+    outDesc.faceMin = data[9];
+    outDesc.faceMax = data[10];
+    outDesc.trayCount = data[11];
+    outDesc.seed = 0;
+    for (int i = 0; i < 8; i++) {
+        outDesc.seed |= static_cast<uint64_t>(data[12 + i]) << (i * 8);
+    }
+    return true;
+}
+
+bool DealEngine::isDescriptor(const char* data, size_t size)
+{
+    return data && size >= sizeof(DESCRIPTOR_MAGIC) && std::memcmp(data, DESCRIPTOR_MAGIC, sizeof(DESCRIPTOR_MAGIC)) == 0;
+}
+
+int DealEngine::getTemplateCount()
+{
+    return TEMPLATE_COUNT;
+}
+
+const char* DealEngine::templateName(int layoutTemplate)
+{
+    if (layoutTemplate < 0 || layoutTemplate >= TEMPLATE_COUNT) {
+        return "unknown";
+    }
+    return TEMPLATES[layoutTemplate].name;
+}
+
+bool DealEngine::parseTemplateName(const std::string& name, uint8_t& outTemplate)
+{
+    for (int i = 0; i < TEMPLATE_COUNT; i++) {
+        if (name == TEMPLATES[i].name) {
+            outTemplate = static_cast<uint8_t>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+int DealEngine::getTemplateCardCount(int layoutTemplate)
+{
+    if (layoutTemplate < 0 || layoutTemplate >= TEMPLATE_COUNT) {
+        return 0;
+    }
+    return TEMPLATES[layoutTemplate].count;
+}
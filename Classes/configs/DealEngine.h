@@ -0,0 +1,66 @@
+#ifndef __DEAL_ENGINE_H__
+#define __DEAL_ENGINE_H__
+
+#include "LevelConfig.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * 发牌描述：布局模板 + 随机种子 + 牌组约束
+ * 同一描述在任何平台上发出的牌完全相同，一个关卡只需 20 字节
+ */
+struct DealDescriptor {
+    uint64_t seed;                // 随机种子
+    uint8_t layoutTemplate;       // 主牌区布局模板编号（见 DealEngine::templateName）
+    MatchRuleType matchRule;      // 匹配规则
+    uint8_t deckCount;            // 使用几副牌（1~4）
+    uint8_t suitMask;             // 可用花色，第 i 位对应花色 i
+    uint8_t faceMin;              // 可用牌面范围 [faceMin, faceMax]
+    uint8_t faceMax;
+    uint8_t trayCount;            // 备用牌张数（底牌堆共 trayCount + 1 张）
+
+    DealDescriptor()
+        : seed(0)
+        , layoutTemplate(0)
+        , matchRule(MatchRuleType::STANDARD)
+        , deckCount(1)
+        , suitMask(0x0F)
+        , faceMin(0)
+        , faceMax(LevelLayout::FACE_COUNT - 1)
+        , trayCount(20)
+    {
+    }
+};
+
+/**
+ * 确定性发牌引擎
+ *
+ * 按约束生成牌组，用种子驱动的整数随机数做 Fisher-Yates 洗牌：
+ * 前 P 张按模板顺序放入主牌区（后放的在上方），之后 trayCount + 1 张组成 Stack（最后一张为顶牌）。
+ * 随机数只用 64 位整数运算（splitmix64 播种 + xorshift64*），不依赖标准库分布，保证跨平台一致。
+ *
+ * 描述的二进制格式（小端）：
+ *   "CGDL" | u8 版本 | u8 模板 | u8 匹配规则 | u8 副数 | u8 花色掩码 | u8 最小牌面 | u8 最大牌面 | u8 备用牌数 | u64 种子
+ */
+class DealEngine {
+public:
+    static const int DESCRIPTOR_VERSION = 1;
+    static const size_t DESCRIPTOR_SIZE = 20;
+
+    // 按描述发牌
+    static bool deal(const DealDescriptor& desc, LevelConfig& outLevel, std::string* error = nullptr);
+
+    // 描述的序列化
+    static void encode(const DealDescriptor& desc, std::vector<unsigned char>& outData);
+    static bool decode(const unsigned char* data, size_t size, DealDescriptor& outDesc, std::string* error = nullptr);
+    static bool isDescriptor(const char* data, size_t size);
+
+    // 布局模板
+    static int getTemplateCount();
+    static const char* templateName(int layoutTemplate);
+    static bool parseTemplateName(const std::string& name, uint8_t& outTemplate);
+    static int getTemplateCardCount(int layoutTemplate);
+};
+
+#endif // __DEAL_ENGINE_H__
@@ -0,0 +1,351 @@
+#include "LevelCanonicalizer.h"
+#include "LevelConfigLoader.h"
+#include "models/BoardState.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+const int POSITION_SCALE = 4;      // 坐标按 1/4 像素量化
+const int MIRROR_COUNT = 4;        // 不镜像、左右、上下、左右加上下
+
+uint64_t rotl64(uint64_t x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+uint64_t fmix64(uint64_t k)
+{
+    k ^= k >> 33;
+    k *= 0xFF51AFD7ED558CCDULL;
+    k ^= k >> 33;
+    k *= 0xC4CEB9FE1A85EC53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+uint64_t readBlock(const unsigned char* p)
+{
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; i--) {
+        value = (value << 8) | p[i];
+    }
+    return value;
+}
+
+int32_t quantize(float value)
+{
+    return static_cast<int32_t>(std::lround(value * POSITION_SCALE));
+}
+
+void putU16(std::vector<unsigned char>& out, uint32_t value)
+{
+    out.push_back(static_cast<unsigned char>(value >> 8));
+    out.push_back(static_cast<unsigned char>(value));
+}
+
+// 大端写入：平移后坐标非负，按字节比较即按数值比较
+void putU32(std::vector<unsigned char>& out, uint32_t value)
+{
+    out.push_back(static_cast<unsigned char>(value >> 24));
+    out.push_back(static_cast<unsigned char>(value >> 16));
+    out.push_back(static_cast<unsigned char>(value >> 8));
+    out.push_back(static_cast<unsigned char>(value));
+}
+
+int cardCode(const LevelCardConfig& card)
+{
+    return LevelLayout::makeCardCode(card.face, card.suit);
+}
+
+int permuteCode(int code, const SuitPermutation& suits)
+{
+    return LevelLayout::makeCardCode(LevelLayout::cardCodeFace(code), suits.map[LevelLayout::cardCodeSuit(code)]);
+}
+
+/**
+ * 主牌区的遮挡关系：重叠的两张牌中后放的压住先放的，与镜像、平移无关
+ */
+struct CoverGraph {
+    std::vector<std::vector<int>> above;   // 压在该牌上方的牌
+    std::vector<int> belowCount;           // 该牌压住的牌数
+
+    explicit CoverGraph(const LevelConfig& level)
+        : above(level.playfield.size())
+        , belowCount(level.playfield.size(), 0)
+    {
+        const auto& cards = level.playfield;
+        for (size_t i = 0; i < cards.size(); i++) {
+            for (size_t j = i + 1; j < cards.size(); j++) {
+                if (BoardLayout::cardsOverlap(cards[i].x, cards[i].y, cards[j].x, cards[j].y)) {
+                    above[i].push_back(static_cast<int>(j));
+                    belowCount[j]++;
+                }
+            }
+        }
+    }
+};
+
+/**
+ * 一种镜像下的主牌区：平移后的量化坐标和规范顺序
+ */
+struct MirrorLayout {
+    std::vector<int32_t> x;
+    std::vector<int32_t> y;
+    std::vector<int> order;      // 规范顺序中第 k 张对应的原卡牌下标
+};
+
+// 量化、镜像并平移到最小坐标为 0
+void placeMirrored(const LevelConfig& level, int mirror, MirrorLayout& out)
+{
+    size_t count = level.playfield.size();
+    out.x.resize(count);
+    out.y.resize(count);
+    int32_t minX = INT32_MAX;
+    int32_t minY = INT32_MAX;
+    for (size_t i = 0; i < count; i++) {
+        int32_t x = quantize(level.playfield[i].x);
+        int32_t y = quantize(level.playfield[i].y);
+        out.x[i] = (mirror & 1) ? -x : x;
+        out.y[i] = (mirror & 2) ? -y : y;
+        minX = std::min(minX, out.x[i]);
+        minY = std::min(minY, out.y[i]);
+    }
+    for (size_t i = 0; i < count; i++) {
+        out.x[i] -= minX;
+        out.y[i] -= minY;
+    }
+}
+
+// 遮挡关系的拓扑序：重叠的两张保持原先后，可以放的牌中取 (y, x) 最小的
+// 量化后同坐标的牌必然重叠，可以放的牌中坐标不会相同，顺序与花色无关
+void orderByCovering(const CoverGraph& graph, MirrorLayout& layout)
+{
+    size_t count = layout.x.size();
+    std::vector<int> pending(graph.belowCount);
+    std::vector<char> placed(count, 0);
+    layout.order.clear();
+    layout.order.reserve(count);
+
+    for (size_t k = 0; k < count; k++) {
+        int best = -1;
+        for (size_t i = 0; i < count; i++) {
+            if (placed[i] || pending[i] != 0) {
+                continue;
+            }
+            if (best < 0 || layout.y[i] < layout.y[best] || (layout.y[i] == layout.y[best] && layout.x[i] < layout.x[best])) {
+                best = static_cast<int>(i);
+            }
+        }
+        placed[best] = 1;
+        layout.order.push_back(best);
+        for (int upper : graph.above[best]) {
+            pending[upper]--;
+        }
+    }
+}
+
+// 规范序列化：u8 规则 | u16 主牌区数量 | u16 底牌堆数量 | 主牌区每张 u8 牌码 u32 x u32 y | 底牌堆每张 u8 牌码
+void serialize(const LevelConfig& level, const MirrorLayout& layout, const SuitPermutation& suits, std::vector<unsigned char>& out)
+{
+    out.clear();
+    out.push_back(static_cast<unsigned char>(level.matchRule));
+    putU16(out, static_cast<uint32_t>(level.playfield.size()));
+    putU16(out, static_cast<uint32_t>(level.stack.size()));
+    for (int index : layout.order) {
+        out.push_back(static_cast<unsigned char>(permuteCode(cardCode(level.playfield[index]), suits)));
+        putU32(out, static_cast<uint32_t>(layout.x[index]));
+        putU32(out, static_cast<uint32_t>(layout.y[index]));
+    }
+    for (const auto& card : level.stack) {
+        out.push_back(static_cast<unsigned char>(permuteCode(cardCode(card), suits)));
+    }
+}
+
+// 近似签名的特征
+uint64_t featureOf(uint64_t kind, uint64_t face, uint64_t a, uint64_t b)
+{
+    return fmix64((kind << 60) ^ (face << 52) ^ ((a & 0x3FFFFFF) << 26) ^ (b & 0x3FFFFFF));
+}
+
+} // namespace
+
+std::string LevelHash128::toString() const
+{
+    char text[40];
+    std::snprintf(text, sizeof(text), "%016llx%016llx",
+        static_cast<unsigned long long>(hi), static_cast<unsigned long long>(lo));
+    return text;
+}
+
+void LevelCanonicalizer::suitSymmetries(MatchRuleType rule, std::vector<SuitPermutation>& outPermutations)
+{
+    outPermutations.clear();
+    const uint64_t* rows = MatchRules::rowsFor(rule);
+
+    SuitPermutation perm;
+    uint8_t suits[LevelLayout::SUIT_COUNT] = { 0, 1, 2, 3 };
+    do {
+        std::copy(suits, suits + LevelLayout::SUIT_COUNT, perm.map);
+        bool preserved = true;
+        for (int a = 0; a < LevelLayout::CARD_CODE_COUNT && preserved; a++) {
+            uint64_t mapped = 0;
+            for (int b = 0; b < LevelLayout::CARD_CODE_COUNT; b++) {
+                if ((rows[a] >> b) & 1) {
+                    mapped |= 1ULL << permuteCode(b, perm);
+                }
+            }
+            preserved = mapped == rows[permuteCode(a, perm)];
+        }
+        if (preserved) {
+            outPermutations.push_back(perm);
+        }
+    } while (std::next_permutation(suits, suits + LevelLayout::SUIT_COUNT));
+}
+
+bool LevelCanonicalizer::canonicalize(const LevelConfig& level, CanonicalLevel& outCanonical, std::string* error)
+{
+    if (!LevelConfigLoader::validate(level, error)) {
+        return false;
+    }
+
+    std::vector<SuitPermutation> permutations;
+    suitSymmetries(level.matchRule, permutations);
+    CoverGraph graph(level);
+
+    MirrorLayout layouts[MIRROR_COUNT];
+    std::vector<unsigned char> candidate;
+    int bestMirror = -1;
+    size_t bestPermutation = 0;
+    outCanonical.key.clear();
+    for (int mirror = 0; mirror < MIRROR_COUNT; mirror++) {
+        placeMirrored(level, mirror, layouts[mirror]);
+        orderByCovering(graph, layouts[mirror]);
+        for (size_t p = 0; p < permutations.size(); p++) {
+            serialize(level, layouts[mirror], permutations[p], candidate);
+            if (bestMirror < 0 || candidate < outCanonical.key) {
+                outCanonical.key.swap(candidate);
+                bestMirror = mirror;
+                bestPermutation = p;
+            }
+        }
+    }
+
+    const MirrorLayout& layout = layouts[bestMirror];
+    const SuitPermutation& suits = permutations[bestPermutation];
+    outCanonical.suits = suits;
+    outCanonical.mirrorX = (bestMirror & 1) != 0;
+    outCanonical.mirrorY = (bestMirror & 2) != 0;
+    outCanonical.hash = hashBytes(outCanonical.key.data(), outCanonical.key.size());
+
+    // 规范关卡：底牌堆坐标不参与玩法，统一置 0
+    LevelConfig& canonical = outCanonical.level;
+    canonical.clear();
+    canonical.matchRule = level.matchRule;
+    canonical.playfield.reserve(level.playfield.size());
+    for (int index : layout.order) {
+        int code = permuteCode(cardCode(level.playfield[index]), suits);
+        canonical.playfield.push_back(LevelCardConfig(LevelLayout::cardCodeFace(code), LevelLayout::cardCodeSuit(code),
+            static_cast<float>(layout.x[index]) / POSITION_SCALE, static_cast<float>(layout.y[index]) / POSITION_SCALE));
+    }
+    canonical.stack.reserve(level.stack.size());
+    for (const auto& card : level.stack) {
+        int code = permuteCode(cardCode(card), suits);
+        canonical.stack.push_back(LevelCardConfig(LevelLayout::cardCodeFace(code), LevelLayout::cardCodeSuit(code), 0.0f, 0.0f));
+    }
+    return true;
+}
+
+void LevelCanonicalizer::nearSignature(const LevelConfig& level, NearSignature& outSignature)
+{
+    // 特征：主牌区 (牌面, 量化坐标)，四种镜像取并集；底牌堆 (位置, 牌面)；另加规则
+    std::vector<uint64_t> features;
+    features.reserve(level.playfield.size() * MIRROR_COUNT + level.stack.size() + 1);
+    MirrorLayout layout;
+    for (int mirror = 0; mirror < MIRROR_COUNT; mirror++) {
+        placeMirrored(level, mirror, layout);
+        for (size_t i = 0; i < level.playfield.size(); i++) {
+            features.push_back(featureOf(1, static_cast<uint64_t>(level.playfield[i].face),
+                static_cast<uint64_t>(layout.x[i]), static_cast<uint64_t>(layout.y[i])));
+        }
+    }
+    for (size_t i = 0; i < level.stack.size(); i++) {
+        features.push_back(featureOf(2, static_cast<uint64_t>(level.stack[i].face), i, 0));
+    }
+    features.push_back(featureOf(3, 0, static_cast<uint64_t>(level.matchRule), 0));
+
+    for (int k = 0; k < NearSignature::SIZE; k++) {
+        uint64_t salt = (static_cast<uint64_t>(k) + 1) * 0x9E3779B97F4A7C15ULL;
+        uint32_t minValue = UINT32_MAX;
+        for (uint64_t feature : features) {
+            uint32_t value = static_cast<uint32_t>(fmix64(feature ^ salt) >> 32);
+            minValue = std::min(minValue, value);
+        }
+        outSignature.values[k] = minValue;
+    }
+}
+
+double LevelCanonicalizer::similarity(const NearSignature& a, const NearSignature& b)
+{
+    int same = 0;
+    for (int k = 0; k < NearSignature::SIZE; k++) {
+        if (a.values[k] == b.values[k]) {
+            same++;
+        }
+    }
+    return static_cast<double>(same) / NearSignature::SIZE;
+}
+
+LevelHash128 LevelCanonicalizer::hashBytes(const void* data, size_t size, uint64_t seed)
+{
+    const uint64_t c1 = 0x87C37B91114253D5ULL;
+    const uint64_t c2 = 0x4CF5AD432745937FULL;
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    size_t blockCount = size / 16;
+    uint64_t h1 = seed;
+    uint64_t h2 = seed;
+
+    for (size_t i = 0; i < blockCount; i++) {
+        uint64_t k1 = readBlock(bytes + i * 16);
+        uint64_t k2 = readBlock(bytes + i * 16 + 8);
+
+        k1 *= c1; k1 = rotl64(k1, 31); k1 *= c2; h1 ^= k1;
+        h1 = rotl64(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52DCE729;
+        k2 *= c2; k2 = rotl64(k2, 33); k2 *= c1; h2 ^= k2;
+        h2 = rotl64(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495AB5;
+    }
+
+    // 尾部不足 16 字节
+    const unsigned char* tail = bytes + blockCount * 16;
+    size_t rest = size & 15;
+    uint64_t k1 = 0;
+    uint64_t k2 = 0;
+    for (size_t i = rest; i > 8; i--) {
+        k2 = (k2 << 8) | tail[i - 1];
+    }
+    for (size_t i = std::min<size_t>(rest, 8); i > 0; i--) {
+        k1 = (k1 << 8) | tail[i - 1];
+    }
+    if (rest > 8) {
+        k2 *= c2; k2 = rotl64(k2, 33); k2 *= c1; h2 ^= k2;
+    }
+    if (rest > 0) {
+        k1 *= c1; k1 = rotl64(k1, 31); k1 *= c2; h1 ^= k1;
+    }
+
+    h1 ^= size;
+    h2 ^= size;
+    h1 += h2;
+    h2 += h1;
+    h1 = fmix64(h1);
+    h2 = fmix64(h2);
+    h1 += h2;
+    h2 += h1;
+
+    LevelHash128 hash;
+    hash.hi = h1;
+    hash.lo = h2;
+    return hash;
+}
@@ -0,0 +1,83 @@
+#ifndef __LEVEL_CANONICALIZER_H__
+#define __LEVEL_CANONICALIZER_H__
+
+#include "LevelConfig.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * 128 位关卡哈希
+ */
+struct LevelHash128 {
+    uint64_t hi;
+    uint64_t lo;
+
+    LevelHash128() : hi(0), lo(0) {}
+
+    // 32 位十六进制
+    std::string toString() const;
+
+    bool operator==(const LevelHash128& other) const { return hi == other.hi && lo == other.lo; }
+    bool operator!=(const LevelHash128& other) const { return !(*this == other); }
+    bool operator<(const LevelHash128& other) const { return hi != other.hi ? hi < other.hi : lo < other.lo; }
+};
+
+/**
+ * 花色置换：map[原花色] = 新花色
+ */
+struct SuitPermutation {
+    uint8_t map[LevelLayout::SUIT_COUNT];
+};
+
+/**
+ * 关卡的规范形式
+ */
+struct CanonicalLevel {
+    LevelConfig level;                  // 规范化后的关卡（可直接加载，玩法与原关卡相同）
+    std::vector<unsigned char> key;     // 规范序列化字节，两个关卡等价当且仅当 key 相同
+    LevelHash128 hash;                  // key 的 128 位哈希
+    SuitPermutation suits;              // 采用的花色置换
+    bool mirrorX;                       // 是否左右镜像
+    bool mirrorY;                       // 是否上下镜像
+};
+
+/**
+ * 近似签名：卡牌特征集合的 MinHash，两份签名相同位置取值相等的比例估计 Jaccard 相似度
+ */
+struct NearSignature {
+    static const int SIZE = 64;
+    uint32_t values[SIZE];
+};
+
+/**
+ * 关卡规范化
+ * 把只差花色置换、镜像、平移或无关叠放顺序的关卡化为同一规范形式，用于跨关卡库查重
+ *
+ * 等价变换（都不改变玩法）：
+ *   - 花色置换：只允许保持当前匹配规则匹配表不变的置换（标准规则 24 种，同色规则 8 种）
+ *   - 左右、上下镜像和整体平移：重叠关系不变；坐标平移到最小值为 0，按 1/4 像素量化
+ *   - 主牌区顺序：互不重叠的牌交换先后不影响遮挡，按遮挡关系的拓扑序重排，同层按坐标排序
+ * 在所有镜像和允许的花色置换中取序列化字节最小的一个作为规范形式，底牌堆顺序保持不变。
+ *
+ * 近似签名不区分花色，取四种镜像下特征集合的并集，与镜像和花色置换无关，改动少量卡牌时签名大部分不变。
+ */
+class LevelCanonicalizer {
+public:
+    // 规范化（关卡需能通过 LevelConfigLoader::validate）
+    static bool canonicalize(const LevelConfig& level, CanonicalLevel& outCanonical, std::string* error = nullptr);
+
+    // 近似签名
+    static void nearSignature(const LevelConfig& level, NearSignature& outSignature);
+
+    // 两份签名估计的 Jaccard 相似度（0~1）
+    static double similarity(const NearSignature& a, const NearSignature& b);
+
+    // 保持规则匹配表不变的全部花色置换（恒等置换在最前）
+    static void suitSymmetries(MatchRuleType rule, std::vector<SuitPermutation>& outPermutations);
+
+    // MurmurHash3 x64 128
+    static LevelHash128 hashBytes(const void* data, size_t size, uint64_t seed = 0);
+};
+
+#endif // __LEVEL_CANONICALIZER_H__
@@ -0,0 +1,80 @@
+#ifndef __LEVEL_CONFIG_H__
+#define __LEVEL_CONFIG_H__
+
+#include "models/MatchRules.h"
+#include <vector>
+
+/**
+ * 关卡中单张卡牌的静态配置
+ * 坐标为关卡文件中的原始坐标（主牌区坐标未加堆牌区高度）
+ */
+struct LevelCardConfig {
+    int face;     // 牌面：0=A ... 12=K
+    int suit;     // 花色：0=梅花, 1=方块, 2=红桃, 3=黑桃
+    float x;
+    float y;
+
+    LevelCardConfig()
+        : face(-1)
+        , suit(-1)
+        , x(0.0f)
+        , y(0.0f)
+    {
+    }
+
+    LevelCardConfig(int f, int s, float px, float py)
+        : face(f)
+        , suit(s)
+        , x(px)
+        , y(py)
+    {
+    }
+};
+
+/**
+ * 关卡静态配置
+ * 与 level1.json 一一对应，不依赖 cocos2d，可在工具和服务端复用
+ */
+struct LevelConfig {
+    std::vector<LevelCardConfig> playfield;   // 主牌区
+    std::vector<LevelCardConfig> stack;       // 最后一张是底牌堆顶牌，其余为备用牌堆
+    MatchRuleType matchRule;                  // 匹配规则（"MatchRule" 字段，缺省为标准规则）
+
+    LevelConfig()
+        : matchRule(MatchRuleType::STANDARD)
+    {
+    }
+
+    void clear()
+    {
+        playfield.clear();
+        stack.clear();
+        matchRule = MatchRuleType::STANDARD;
+    }
+};
+
+/**
+ * 关卡布局常量
+ */
+namespace LevelLayout {
+    const float STACK_AREA_HEIGHT = 580.0f;   // 堆牌区高度
+    const float PLAYFIELD_WIDTH = 1080.0f;    // 主牌区宽度
+    const float PLAYFIELD_HEIGHT = 1500.0f;   // 主牌区高度（设计分辨率 2080 减去堆牌区）
+    const float CARD_WIDTH = 182.0f;          // 卡牌宽度（card_general.png）
+    const float CARD_HEIGHT = 282.0f;         // 卡牌高度
+    const float STACK_POS_X = 700.0f;         // 底牌堆位置
+    const float STACK_POS_Y = 290.0f;
+    const float TRAY_POS_X = 380.0f;          // 备用牌堆位置
+    const float TRAY_POS_Y = 290.0f;
+
+    const int FACE_COUNT = 13;
+    const int SUIT_COUNT = 4;
+    const int CARD_CODE_COUNT = FACE_COUNT * SUIT_COUNT;
+
+    // 牌面+花色压缩为 0~51 的牌码
+    inline int makeCardCode(int face, int suit) { return suit * FACE_COUNT + face; }
+    inline int cardCodeFace(int code) { return code % FACE_COUNT; }
+    inline int cardCodeSuit(int code) { return code / FACE_COUNT; }
+}
+
+#endif // __LEVEL_CONFIG_H__
@@ -0,0 +1,343 @@
+#include "LevelConfigLoader.h"
+#include "DealEngine.h"
+#include "json/rapidjson.h"
+#include "json/document.h"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+const char BINARY_MAGIC[4] = { 'C', 'G', 'L', 'V' };
+const size_t BINARY_HEADER_SIZE = 10;
+const size_t PLAYFIELD_RECORD_SIZE = 5;
+
+void setError(std::string* error, const std::string& msg)
+{
+    if (error) {
+        *error = msg;
+    }
+}
+
+bool parseCard(const rapidjson::Value& cardData, bool needPosition, LevelCardConfig& outCard)
+{
+    if (!cardData.IsObject()
+        || !cardData.HasMember("CardFace") || !cardData["CardFace"].IsInt()
+        || !cardData.HasMember("CardSuit") || !cardData["CardSuit"].IsInt()) {
+        return false;
+    }
+
+    outCard.face = cardData["CardFace"].GetInt();
+    outCard.suit = cardData["CardSuit"].GetInt();
+    outCard.x = 0.0f;
+    outCard.y = 0.0f;
+
+    if (cardData.HasMember("Position") && cardData["Position"].IsObject()) {
+        const rapidjson::Value& pos = cardData["Position"];
+        if (pos.HasMember("x") && pos["x"].IsNumber()) {
+            outCard.x = pos["x"].GetFloat();
+        }
+        if (pos.HasMember("y") && pos["y"].IsNumber()) {
+            outCard.y = pos["y"].GetFloat();
+        }
+    }
+    else if (needPosition) {
+        return false;
+    }
+    return true;
+}
+
+void writeU16(std::vector<unsigned char>& out, unsigned int value)
+{
+    out.push_back(static_cast<unsigned char>(value & 0xFF));
+    out.push_back(static_cast<unsigned char>((value >> 8) & 0xFF));
+}
+
+unsigned int readU16(const unsigned char* p)
+{
+    return static_cast<unsigned int>(p[0]) | (static_cast<unsigned int>(p[1]) << 8);
+}
+
+unsigned char packCard(const LevelCardConfig& card)
+{
+    return static_cast<unsigned char>((card.suit << 4) | card.face);
+}
+
+void unpackCard(unsigned char packed, LevelCardConfig& outCard)
+{
+    outCard.face = packed & 0x0F;
+    outCard.suit = (packed >> 4) & 0x0F;
+}
+
+// "Deal": { "Template": "pyramid", "Seed": 12345, "Tray": 20, "Decks": 1, "Suits": 15, "FaceMin": 0, "FaceMax": 12 }
+bool parseDeal(const rapidjson::Value& dealData, DealDescriptor& outDesc, std::string* error)
+{
+    if (!dealData.IsObject()) {
+        setError(error, "invalid Deal");
+        return false;
+    }
+
+    if (dealData.HasMember("Template")) {
+        const rapidjson::Value& layout = dealData["Template"];
+        if (layout.IsString()) {
+            if (!DealEngine::parseTemplateName(layout.GetString(), outDesc.layoutTemplate)) {
+                setError(error, std::string("unknown Deal Template ") + layout.GetString());
+                return false;
+            }
+        }
+        else if (layout.IsInt() && layout.GetInt() >= 0 && layout.GetInt() < DealEngine::getTemplateCount()) {
+            outDesc.layoutTemplate = static_cast<uint8_t>(layout.GetInt());
+        }
+        else {
+            setError(error, "invalid Deal Template");
+            return false;
+        }
+    }
+
+    // 种子可写数字或十进制字符串（超过 2^53 的种子在部分 JSON 工具中会丢精度）
+    if (dealData.HasMember("Seed")) {
+        const rapidjson::Value& seed = dealData["Seed"];
+        if (seed.IsUint64()) {
+            outDesc.seed = seed.GetUint64();
+        }
+        else if (seed.IsString()) {
+            char* end = nullptr;
+            outDesc.seed = std::strtoull(seed.GetString(), &end, 10);
+            if (!end || *end != '\0' || end == seed.GetString()) {
+                setError(error, "invalid Deal Seed");
+                return false;
+            }
+        }
+        else {
+            setError(error, "invalid Deal Seed");
+            return false;
+        }
+    }
+
+    struct ByteField {
+        const char* name;
+        uint8_t* value;
+    };
+    const ByteField fields[] = {
+        { "Tray", &outDesc.trayCount },
+        { "Decks", &outDesc.deckCount },
+        { "Suits", &outDesc.suitMask },
+        { "FaceMin", &outDesc.faceMin },
+        { "FaceMax", &outDesc.faceMax },
+    };
+    for (const auto& field : fields) {
+        if (!dealData.HasMember(field.name)) {
+            continue;
+        }
+        const rapidjson::Value& value = dealData[field.name];
+        if (!value.IsInt() || value.GetInt() < 0 || value.GetInt() > 255) {
+            setError(error, std::string("invalid Deal ") + field.name);
+            return false;
+        }
+        *field.value = static_cast<uint8_t>(value.GetInt());
+    }
+    return true;
+}
+
+} // namespace
+
+bool LevelConfigLoader::loadFromJson(const std::string& jsonStr, LevelConfig& outLevel, std::string* error)
+{
+    outLevel.clear();
+
+    rapidjson::Document doc;
+    doc.Parse(jsonStr.c_str());
+
+    if (doc.HasParseError() || !doc.IsObject()) {
+        setError(error, "JSON parse error");
+        return false;
+    }
+
+    // 匹配规则：可写规则名（如 "no_wrap"）或编号
+    if (doc.HasMember("MatchRule")) {
+        const rapidjson::Value& rule = doc["MatchRule"];
+        if (rule.IsString()) {
+            if (!MatchRules::parseRuleName(rule.GetString(), outLevel.matchRule)) {
+                setError(error, std::string("unknown MatchRule ") + rule.GetString());
+                return false;
+            }
+        }
+        else if (rule.IsInt() && rule.GetInt() >= 0 && rule.GetInt() < static_cast<int>(MatchRuleType::COUNT)) {
+            outLevel.matchRule = static_cast<MatchRuleType>(rule.GetInt());
+        }
+        else {
+            setError(error, "invalid MatchRule");
+            return false;
+        }
+    }
+
+    // 种子关卡：由发牌引擎生成主牌区和底牌堆，忽略 Playfield/Stack
+    if (doc.HasMember("Deal")) {
+        DealDescriptor desc;
+        desc.matchRule = outLevel.matchRule;
+        if (!parseDeal(doc["Deal"], desc, error)) {
+            outLevel.clear();
+            return false;
+        }
+        return DealEngine::deal(desc, outLevel, error);
+    }
+
+    // 解析主牌区
+    if (doc.HasMember("Playfield") && doc["Playfield"].IsArray()) {
+        const rapidjson::Value& playfield = doc["Playfield"];
+        outLevel.playfield.reserve(playfield.Size());
+        for (rapidjson::SizeType i = 0; i < playfield.Size(); i++) {
+            LevelCardConfig card;
+            if (!parseCard(playfield[i], true, card)) {
+                setError(error, "invalid Playfield card #" + std::to_string(i));
+                return false;
+            }
+            outLevel.playfield.push_back(card);
+        }
+    }
+
+    // 解析底牌堆（最后一张是顶牌，前面的是备用牌）
+    if (doc.HasMember("Stack") && doc["Stack"].IsArray()) {
+        const rapidjson::Value& stack = doc["Stack"];
+        outLevel.stack.reserve(stack.Size());
+        for (rapidjson::SizeType i = 0; i < stack.Size(); i++) {
+            LevelCardConfig card;
+            if (!parseCard(stack[i], false, card)) {
+                setError(error, "invalid Stack card #" + std::to_string(i));
+                return false;
+            }
+            outLevel.stack.push_back(card);
+        }
+    }
+
+    return true;
+}
+
+bool LevelConfigLoader::loadFromBinary(const unsigned char* data, size_t size, LevelConfig& outLevel, std::string* error)
+{
+    outLevel.clear();
+
+    if (!data || size < BINARY_HEADER_SIZE || std::memcmp(data, BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0) {
+        setError(error, "not a binary level");
+        return false;
+    }
+    if (data[4] != BINARY_VERSION) {
+        setError(error, "unsupported binary level version " + std::to_string(data[4]));
+        return false;
+    }
+
+    if (data[5] >= static_cast<unsigned char>(MatchRuleType::COUNT)) {
+        setError(error, "unknown match rule " + std::to_string(data[5]));
+        return false;
+    }
+    outLevel.matchRule = static_cast<MatchRuleType>(data[5]);
+
+    size_t playfieldCount = readU16(data + 6);
+    size_t stackCount = readU16(data + 8);
+    if (size != BINARY_HEADER_SIZE + playfieldCount * PLAYFIELD_RECORD_SIZE + stackCount) {
+        setError(error, "binary level size mismatch");
+        return false;
+    }
+
+    const unsigned char* p = data + BINARY_HEADER_SIZE;
+    outLevel.playfield.resize(playfieldCount);
+    for (size_t i = 0; i < playfieldCount; i++) {
+        LevelCardConfig& card = outLevel.playfield[i];
+        unpackCard(p[0], card);
+        card.x = static_cast<float>(static_cast<short>(readU16(p + 1)));
+        card.y = static_cast<float>(static_cast<short>(readU16(p + 3)));
+        p += PLAYFIELD_RECORD_SIZE;
+    }
+
+    outLevel.stack.resize(stackCount);
+    for (size_t i = 0; i < stackCount; i++) {
+        unpackCard(p[i], outLevel.stack[i]);
+    }
+
+    return true;
+}
+
+bool LevelConfigLoader::loadFromBuffer(const char* data, size_t size, LevelConfig& outLevel, std::string* error)
+{
+    if (DealEngine::isDescriptor(data, size)) {
+        DealDescriptor desc;
+        if (!DealEngine::decode(reinterpret_cast<const unsigned char*>(data), size, desc, error)) {
+            outLevel.clear();
+            return false;
+        }
+        return DealEngine::deal(desc, outLevel, error);
+    }
+    if (isBinary(data, size)) {
+        return loadFromBinary(reinterpret_cast<const unsigned char*>(data), size, outLevel, error);
+    }
+    return loadFromJson(std::string(data, size), outLevel, error);
+}
+
+bool LevelConfigLoader::saveToBinary(const LevelConfig& level, std::vector<unsigned char>& outData, std::string* error)
+{
+    outData.clear();
+
+    if (!validate(level, error)) {
+        return false;
+    }
+    if (level.playfield.size() > 0xFFFF || level.stack.size() > 0xFFFF) {
+        setError(error, "too many cards for binary level");
+        return false;
+    }
+
+    outData.reserve(BINARY_HEADER_SIZE + level.playfield.size() * PLAYFIELD_RECORD_SIZE + level.stack.size());
+    outData.insert(outData.end(), BINARY_MAGIC, BINARY_MAGIC + sizeof(BINARY_MAGIC));
+    outData.push_back(static_cast<unsigned char>(BINARY_VERSION));
+    outData.push_back(static_cast<unsigned char>(level.matchRule));
+    writeU16(outData, static_cast<unsigned int>(level.playfield.size()));
+    writeU16(outData, static_cast<unsigned int>(level.stack.size()));
+
+    for (const auto& card : level.playfield) {
+        long x = std::lround(card.x);
+        long y = std::lround(card.y);
+        if (x < -32768 || x > 32767 || y < -32768 || y > 32767) {
+            setError(error, "card position out of binary range");
+            outData.clear();
+            return false;
+        }
+        outData.push_back(packCard(card));
+        writeU16(outData, static_cast<unsigned int>(x) & 0xFFFF);
+        writeU16(outData, static_cast<unsigned int>(y) & 0xFFFF);
+    }
+
+    for (const auto& card : level.stack) {
+        outData.push_back(packCard(card));
+    }
+
+    return true;
+}
+
+bool LevelConfigLoader::isBinary(const char* data, size_t size)
+{
+    return data && size >= sizeof(BINARY_MAGIC) && std::memcmp(data, BINARY_MAGIC, sizeof(BINARY_MAGIC)) == 0;
+}
+
+bool LevelConfigLoader::validate(const LevelConfig& level, std::string* error)
+{
+    for (size_t i = 0; i < level.playfield.size(); i++) {
+        const LevelCardConfig& card = level.playfield[i];
+        if (card.face < 0 || card.face >= LevelLayout::FACE_COUNT
+            || card.suit < 0 || card.suit >= LevelLayout::SUIT_COUNT) {
+            setError(error, "Playfield card #" + std::to_string(i) + " face/suit out of range");
+            return false;
+        }
+    }
+    for (size_t i = 0; i < level.stack.size(); i++) {
+        const LevelCardConfig& card = level.stack[i];
+        if (card.face < 0 || card.face >= LevelLayout::FACE_COUNT
+            || card.suit < 0 || card.suit >= LevelLayout::SUIT_COUNT) {
+            setError(error, "Stack card #" + std::to_string(i) + " face/suit out of range");
+            return false;
+        }
+    }
+    if (level.stack.empty()) {
+        setError(error, "Stack is empty");
+        return false;
+    }
+    return true;
+}
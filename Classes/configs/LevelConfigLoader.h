@@ -0,0 +1,42 @@
+#ifndef __LEVEL_CONFIG_LOADER_H__
+#define __LEVEL_CONFIG_LOADER_H__
+
+#include "LevelConfig.h"
+#include <string>
+#include <vector>
+
+/**
+ * 关卡配置加载器
+ * 负责 JSON 关卡与二进制关卡的解析和序列化，游戏、工具、校验服务共用同一份解析代码
+ *
+ * 二进制格式（小端）：
+ *   "CGLV" | u8 版本 | u8 匹配规则 | u16 主牌区数量 | u16 底牌堆数量
+ *   主牌区每张：u8 (花色<<4 | 牌面) | i16 x | i16 y
+ *   底牌堆每张：u8 (花色<<4 | 牌面)
+ *
+ * JSON 中带 "Deal" 对象时为种子关卡，由 DealEngine 按模板和种子生成卡牌
+ */
+class LevelConfigLoader {
+public:
+    static const int BINARY_VERSION = 1;
+
+    // 解析 JSON 关卡
+    static bool loadFromJson(const std::string& jsonStr, LevelConfig& outLevel, std::string* error = nullptr);
+
+    // 解析二进制关卡
+    static bool loadFromBinary(const unsigned char* data, size_t size, LevelConfig& outLevel, std::string* error = nullptr);
+
+    // 根据文件头自动识别 JSON、二进制关卡或发牌描述（"CGDL"，见 DealEngine）
+    static bool loadFromBuffer(const char* data, size_t size, LevelConfig& outLevel, std::string* error = nullptr);
+
+    // 序列化为二进制关卡
+    static bool saveToBinary(const LevelConfig& level, std::vector<unsigned char>& outData, std::string* error = nullptr);
+
+    // 判断数据是否为二进制关卡
+    static bool isBinary(const char* data, size_t size);
+
+    // 基本合法性检查（牌面/花色范围、底牌堆非空）
+    static bool validate(const LevelConfig& level, std::string* error = nullptr);
+};
+
+#endif // __LEVEL_CONFIG_LOADER_H__
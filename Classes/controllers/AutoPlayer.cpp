@@ -0,0 +1,305 @@
+#include "AutoPlayer.h"
+#include "controllers/GameController.h"
+#include "managers/FrameRateManager.h"
+#include "utils/ProcessStats.h"
+
+USING_NS_CC;
+
+AutoPlayer::AutoPlayer()
+    : _controller(nullptr)
+    , _waiting(false)
+    , _waitFrames(0)
+    , _gameMoves(0)
+    , _gamesPlayed(0)
+    , _gamesWon(0)
+    , _stalls(0)
+    , _moves(0)
+    , _rejected(0)
+    , _randomState(1)
+    , _finished(false)
+    , _hasLastFrame(false)
+    , _frameBuckets()
+    , _frameCount(0)
+    , _maxFrameUs(0)
+    , _savedTimeScale(1.0f)
+    , _savedAnimationInterval(1.0f / 60.0f)
+    , _baselineMemory(0)
+    , _baselineNodes(0)
+{
+}
+
+AutoPlayer* AutoPlayer::create(GameController* controller, const AutoPlayConfig& config)
+{
+    AutoPlayer* ret = new (std::nothrow) AutoPlayer();
+    if (ret && ret->init(controller, config)) {
+        ret->autorelease();
+        return ret;
+    }
+    CC_SAFE_DELETE(ret);
+    return nullptr;
+}
+
+bool AutoPlayer::init(GameController* controller, const AutoPlayConfig& config)
+{
+    if (!Node::init() || !controller) {
+        return false;
+    }
+
+    _controller = controller;
+    _config = config;
+    _randomState = config.seed != 0 ? config.seed : 1;
+
+    // 出牌后等提交再出下一步，保证每一步都走完整的动画和模型更新
+    _committedHandle = _controller->getEventBus().subscribe<MoveCommittedEvent>([this](const MoveCommittedEvent&) {
+        _waiting = false;
+        _moves++;
+        _gameMoves++;
+    });
+
+    // 帧间隔由 FrameRateManager 管理，改它的满帧率间隔，空闲降帧不会把压测拖慢
+    auto director = Director::getInstance();
+    auto frameRate = FrameRateManager::getInstance();
+    _savedTimeScale = director->getScheduler()->getTimeScale();
+    _savedAnimationInterval = frameRate->getActiveInterval();
+    director->getScheduler()->setTimeScale(_config.timeScale);
+    if (_config.uncapFrameRate) {
+        frameRate->setActiveInterval(1.0f / 1000.0f);
+    }
+
+    _startTime = std::chrono::steady_clock::now();
+    cocos2d::log("AutoPlayer: %d games of %s, policy %d, time scale %.0fx",
+        _config.games, _config.levelFile.c_str(), static_cast<int>(_config.policy), _config.timeScale);
+
+    scheduleUpdate();
+    return true;
+}
+
+void AutoPlayer::onExit()
+{
+    finish();
+    Node::onExit();
+}
+
+void AutoPlayer::update(float)
+{
+    auto now = std::chrono::steady_clock::now();
+    if (_hasLastFrame) {
+        recordFrame(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now - _lastFrame).count()));
+    }
+    _lastFrame = now;
+    _hasLastFrame = true;
+
+    if (_finished) {
+        return;
+    }
+    FrameRateManager::getInstance()->keepAwake();
+
+    // 关卡还在后台构建
+    if (_controller->isLoadingLevel()) {
+        return;
+    }
+
+    if (_waiting) {
+        // 动画在时间倍率下应在几帧内结束，长时间没有提交说明控制器或视图卡住了
+        if (++_waitFrames < STALL_FRAMES) {
+            return;
+        }
+        cocos2d::log("AutoPlayer: no commit after %d frames in game %d, restarting", STALL_FRAMES, _gamesPlayed + 1);
+        _stalls++;
+        _waiting = false;
+        startNextGame();
+        return;
+    }
+
+    _controller->getGameModel()->collectPlayableSlots(_playableSlots);
+    if (isGameOver()) {
+        startNextGame();
+        return;
+    }
+
+    _waiting = playOneStep();
+    _waitFrames = 0;
+}
+
+bool AutoPlayer::playOneStep()
+{
+    GameModel* model = _controller->getGameModel();
+    bool canFlip = !model->getTrayCards().empty();
+
+    if (_config.policy == AutoPlayPolicy::RANDOM) {
+        uint32_t roll = nextRandom() % 100;
+
+        if (roll < static_cast<uint32_t>(_config.undoPercent) && _controller->getUndoManager()->canUndo()) {
+            _controller->onUndoClicked();
+            return true;
+        }
+
+        // 误点：点一张在场但不能匹配的牌，走一遍拒绝路径，不产生提交
+        if (roll >= 100 - static_cast<uint32_t>(_config.misclickPercent)) {
+            _blockedSlots.clear();
+            for (const auto& card : model->getPlayfieldCards()) {
+                if (!model->canMatchTop(card.getSlot())) {
+                    _blockedSlots.push_back(card.getSlot());
+                }
+            }
+            if (!_blockedSlots.empty()) {
+                int slot = _blockedSlots[nextRandom() % _blockedSlots.size()];
+                _controller->onCardClicked(model->getPlayfieldCard(slot).getId());
+                _rejected++;
+                return false;
+            }
+        }
+
+        size_t choices = _playableSlots.size() + (canFlip ? 1 : 0);
+        if (choices == 0) {
+            return false;
+        }
+        size_t pick = nextRandom() % choices;
+        if (pick < _playableSlots.size()) {
+            _controller->onCardClicked(model->getPlayfieldCard(_playableSlots[pick]).getId());
+        }
+        else {
+            _controller->onTrayClicked();
+        }
+        return true;
+    }
+
+    if (!_playableSlots.empty()) {
+        _controller->onCardClicked(model->getPlayfieldCard(_playableSlots[0]).getId());
+        return true;
+    }
+    if (canFlip) {
+        _controller->onTrayClicked();
+        return true;
+    }
+    return false;
+}
+
+bool AutoPlayer::isGameOver() const
+{
+    GameModel* model = _controller->getGameModel();
+    if (model->getPlayfieldCards().empty()) {
+        return true;
+    }
+    if (_gameMoves >= _config.maxMovesPerGame) {
+        return true;
+    }
+    return model->getTrayCards().empty() && _playableSlots.empty();
+}
+
+void AutoPlayer::startNextGame()
+{
+    if (_controller->getGameModel()->getPlayfieldCards().empty()) {
+        _gamesWon++;
+    }
+    _gamesPlayed++;
+
+    if (_gamesPlayed == 1) {
+        _baselineMemory = ProcessStats::getResidentBytes();
+        _baselineNodes = countNodes(Director::getInstance()->getRunningScene());
+    }
+    if (_config.reportEvery > 0 && _gamesPlayed % _config.reportEvery == 0) {
+        report(false);
+    }
+    if (_config.games > 0 && _gamesPlayed >= _config.games) {
+        report(true);
+        finish();
+        return;
+    }
+
+    _gameMoves = 0;
+    _playableSlots.clear();
+    if (!_controller->loadLevel(_config.levelFile)) {
+        cocos2d::log("AutoPlayer: cannot load %s", _config.levelFile.c_str());
+        finish();
+    }
+}
+
+void AutoPlayer::recordFrame(uint64_t frameUs)
+{
+    uint64_t bucket = frameUs / FRAME_BUCKET_US;
+    _frameBuckets[bucket < FRAME_BUCKETS ? bucket : FRAME_BUCKETS - 1]++;
+    _frameCount++;
+    if (frameUs > _maxFrameUs) {
+        _maxFrameUs = frameUs;
+    }
+}
+
+uint64_t AutoPlayer::frameTimePercentileUs(double ratio) const
+{
+    if (_frameCount == 0) {
+        return 0;
+    }
+    uint64_t target = static_cast<uint64_t>(_frameCount * ratio);
+    uint64_t seen = 0;
+    for (int i = 0; i < FRAME_BUCKETS; i++) {
+        seen += _frameBuckets[i];
+        if (seen > target) {
+            return (i + 1) * FRAME_BUCKET_US;   // 桶上界
+        }
+    }
+    return _maxFrameUs;
+}
+
+int AutoPlayer::countNodes(Node* node) const
+{
+    if (!node) {
+        return 0;
+    }
+    int count = 1;
+    for (auto child : node->getChildren()) {
+        count += countNodes(child);
+    }
+    return count;
+}
+
+void AutoPlayer::report(bool final)
+{
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - _startTime).count();
+    size_t memory = ProcessStats::getResidentBytes();
+    int nodes = countNodes(Director::getInstance()->getRunningScene());
+
+    cocos2d::log("AutoPlayer%s: games=%d won=%d moves=%llu rejected=%llu stalls=%d moves/s=%.0f"
+        " frame_us p50<=%llu p99<=%llu max=%llu nodes=%d (%+d) rss_kb=%llu (%+lld) arena_chunks=%d",
+        final ? " [final]" : "",
+        _gamesPlayed,
+        _gamesWon,
+        static_cast<unsigned long long>(_moves),
+        static_cast<unsigned long long>(_rejected),
+        _stalls,
+        seconds > 0.0 ? _moves / seconds : 0.0,
+        static_cast<unsigned long long>(frameTimePercentileUs(0.50)),
+        static_cast<unsigned long long>(frameTimePercentileUs(0.99)),
+        static_cast<unsigned long long>(_maxFrameUs),
+        nodes,
+        nodes - _baselineNodes,
+        static_cast<unsigned long long>(memory / 1024),
+        (static_cast<long long>(memory) - static_cast<long long>(_baselineMemory)) / 1024,
+        static_cast<int>(_controller->getLevelArena().getChunkCount()));
+}
+
+void AutoPlayer::finish()
+{
+    if (_finished) {
+        return;
+    }
+    _finished = true;
+    _controller->getEventBus().unsubscribe(_committedHandle);
+
+    auto director = Director::getInstance();
+    director->getScheduler()->setTimeScale(_savedTimeScale);
+    FrameRateManager::getInstance()->setActiveInterval(_savedAnimationInterval);
+
+    if (_config.exitWhenDone) {
+        director->end();
+    }
+}
+
+uint32_t AutoPlayer::nextRandom()
+{
+    // xorshift32，只要求各次运行结果可复现
+    _randomState ^= _randomState << 13;
+    _randomState ^= _randomState >> 17;
+    _randomState ^= _randomState << 5;
+    return _randomState;
+}
@@ -0,0 +1,126 @@
+#ifndef __AUTO_PLAYER_H__
+#define __AUTO_PLAYER_H__
+
+#include "cocos2d.h"
+#include "models/GameEvents.h"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class GameController;
+
+/**
+ * 自动对局策略
+ */
+enum class AutoPlayPolicy {
+    GREEDY = 0,      // 有可匹配的牌就点第一张，否则翻牌
+    RANDOM           // 在可匹配的牌、翻牌、回退中随机选择，并按比例插入误点
+};
+
+/**
+ * 自动对局配置
+ */
+struct AutoPlayConfig {
+    std::string levelFile;       // 每局重新加载的关卡
+    AutoPlayPolicy policy;
+    float timeScale;             // 调度器时间倍率，让 0.3 秒的移动动画在一两帧内结束
+    int games;                   // 总局数，0 表示一直运行
+    int maxMovesPerGame;         // 单局步数上限，超过后直接开下一局
+    int undoPercent;             // RANDOM 策略下选择回退的概率（%）
+    int misclickPercent;         // RANDOM 策略下点击不可匹配的牌的概率（%）
+    int reportEvery;             // 每多少局输出一次报告
+    uint32_t seed;
+    bool uncapFrameRate;         // 解除帧率上限，尽可能快地跑帧
+    bool exitWhenDone;           // 跑完后退出程序（用于无人值守的压测）
+
+    AutoPlayConfig()
+        : levelFile("level1.json")
+        , policy(AutoPlayPolicy::RANDOM)
+        , timeScale(50.0f)
+        , games(1000)
+        , maxMovesPerGame(400)
+        , undoPercent(10)
+        , misclickPercent(5)
+        , reportEvery(100)
+        , seed(1)
+        , uncapFrameRate(true)
+        , exitWhenDone(false)
+    {
+    }
+};
+
+/**
+ * 自动对局（压测用）
+ *
+ * 通过 GameController 的 onCardClicked / onTrayClicked / onUndoClicked 入口出牌，
+ * 与真人点击走完全相同的控制器、视图和动画路径。每次出牌后等待 MoveCommittedEvent 再出下一步，
+ * 一局结束（通关、无路可走或超过步数上限）后重新加载关卡。
+ * 定期输出出牌速度、帧耗时分位数、场景节点数和常驻内存增长，用于发现泄漏和性能退化。
+ */
+class AutoPlayer : public cocos2d::Node {
+public:
+    static AutoPlayer* create(GameController* controller, const AutoPlayConfig& config);
+
+    virtual void onExit() override;
+    virtual void update(float dt) override;
+
+    int getGamesPlayed() const { return _gamesPlayed; }
+    uint64_t getMovesPlayed() const { return _moves; }
+
+private:
+    AutoPlayer();
+    bool init(GameController* controller, const AutoPlayConfig& config);
+
+    // 按策略选择并执行一步（_playableSlots 需已更新），返回是否需要等待提交
+    bool playOneStep();
+
+    // 当前局是否已结束（通关、无路可走或超过步数上限）
+    bool isGameOver() const;
+
+    void startNextGame();
+    void recordFrame(uint64_t frameUs);
+    uint64_t frameTimePercentileUs(double ratio) const;
+    int countNodes(cocos2d::Node* node) const;
+    void report(bool final);
+    void finish();
+
+    uint32_t nextRandom();
+
+    // 帧耗时直方图：100 微秒一档，最后一档收纳所有更慢的帧
+    static const int FRAME_BUCKETS = 1000;
+    static const uint64_t FRAME_BUCKET_US = 100;
+    static const int STALL_FRAMES = 600;
+
+    GameController* _controller;
+    AutoPlayConfig _config;
+    EventHandle _committedHandle;
+
+    bool _waiting;               // 已出牌，等待提交
+    int _waitFrames;
+    int _gameMoves;
+    int _gamesPlayed;
+    int _gamesWon;
+    int _stalls;
+    uint64_t _moves;
+    uint64_t _rejected;
+    uint32_t _randomState;
+    bool _finished;
+
+    std::vector<int> _playableSlots;
+    std::vector<int> _blockedSlots;
+
+    std::chrono::steady_clock::time_point _startTime;
+    std::chrono::steady_clock::time_point _lastFrame;
+    bool _hasLastFrame;
+    uint32_t _frameBuckets[FRAME_BUCKETS];
+    uint64_t _frameCount;
+    uint64_t _maxFrameUs;
+
+    float _savedTimeScale;
+    float _savedAnimationInterval;
+    size_t _baselineMemory;      // 第一局结束时的常驻内存（跳过预热期）
+    int _baselineNodes;
+};
+
+#endif // __AUTO_PLAYER_H__
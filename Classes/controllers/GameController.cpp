@@ -1,48 +1,101 @@
 #include "GameController.h"
-#include "json/rapidjson.h"
-#include "json/document.h"
+#include "configs/LevelConfigLoader.h"
+#include "views/GameView.h"
+#include "managers/FrameRateManager.h"
 
 USING_NS_CC;
 
+namespace {
+
+// 异步加载轮询的调度键
+const char* LOAD_SCHEDULE_KEY = "GameController.load";
+
+// 局面分析结论轮询的调度键
+const char* ANALYSIS_SCHEDULE_KEY = "GameController.analysis";
+
+} // namespace
+
 GameController::GameController()
     : _gameModel(nullptr)
     , _gameView(nullptr)
     , _undoManager(nullptr)
     , _nextCardId(0)
+    , _levelSeq(0)
+    , _moveIndex(0)
+    , _lastCommitUs(0)
+    , _lastInputUs(0)
+    , _movePending(false)
+    , _boardStateSynced(false)
+    , _loadTicket(0)
+    , _loadPending(false)
 {
 }
 
 GameController::~GameController()
 {
+    cancelLevelLoad();
+    setPositionAnalysisEnabled(false);
+    for (auto& handle : _subscriptions) {
+        _eventBus.unsubscribe(handle);
+    }
+    // _gameView 由 cocos2d 或调用方管理，不需要手动删除，但要断开它对事件总线的引用
+    if (_gameView) {
+        _gameView->setEventBus(nullptr);
+    }
     CC_SAFE_DELETE(_gameModel);
     CC_SAFE_DELETE(_undoManager);
-    // _gameView 由 cocos2d 管理，不需要手动删除
 }
 
 bool GameController::init(Scene* scene)
 {
     if (!scene) return false;
     
+    auto gameView = GameView::create();
+    if (gameView) {
+        scene->addChild(gameView);
+    }
+    if (!initWithView(gameView)) {
+        return false;
+    }
+    
+    // 遥测写到可写目录下，目录创建失败时不记录
+    std::string telemetryDir = FileUtils::getInstance()->getWritablePath() + "telemetry/";
+    if (FileUtils::getInstance()->createDirectory(telemetryDir)) {
+        _telemetry.start(telemetryDir);
+    }
+    
+    // 对局中尽早提示无法通关
+    setPositionAnalysisEnabled(true);
+    
+    return true;
+}
+
+bool GameController::initWithView(IGameView* view)
+{
+    if (_gameModel) return false;
+    
     _gameModel = new GameModel();
     _undoManager = new UndoManager();
     
-    _gameView = GameView::create();
-    if (_gameView) {
-        scene->addChild(_gameView);
-        
-        // 设置回调
-        _gameView->setCardClickCallback([this](int cardId) {
-            this->onCardClicked(cardId);
-        });
-        
-        _gameView->setTrayClickCallback([this]() {
-            this->onTrayClicked();
-        });
-        
-        _gameView->setUndoClickCallback([this]() {
-            this->onUndoClicked();
-        });
-    }
+    _gameView = view ? view : &_nullView;
+    _gameView->setEventBus(&_eventBus);
+    
+    // 订阅视图事件（处理函数只捕获 this，不分配内存）
+    _subscriptions[0] = _eventBus.subscribe<CardClickedEvent>([this](const CardClickedEvent& event) {
+        this->onCardClicked(event.cardId);
+    });
+    _subscriptions[1] = _eventBus.subscribe<TrayClickedEvent>([this](const TrayClickedEvent&) {
+        this->onTrayClicked();
+    });
+    _subscriptions[2] = _eventBus.subscribe<UndoClickedEvent>([this](const UndoClickedEvent&) {
+        this->onUndoClicked();
+    });
+    _subscriptions[3] = _eventBus.subscribe<AnimationDoneEvent>([this](const AnimationDoneEvent& event) {
+        this->onAnimationDone(event);
+    });
+    _subscriptions[4] = _eventBus.subscribe<MoveCommittedEvent>([this](const MoveCommittedEvent& event) {
+        this->onMoveCommitted(event);
+    });
     
     return true;
 }
@@ -58,154 +111,260 @@ bool GameController::loadLevel(const std::string& levelFile)
         return false;
     }
     
-    if (!parseLevelConfig(jsonStr)) {
+    return loadLevelData(jsonStr);
+}
+
+bool GameController::loadLevelData(const std::string& data)
+{
+    if (!_gameModel) {
+        return false;
+    }
+    cancelLevelLoad();
+    if (!parseLevelConfig(data)) {
         return false;
     }
     
     // 初始化视图
-    if (_gameView && _gameModel) {
-        _gameView->initWithModel(_gameModel);
-    }
+    _gameView->initWithModel(_gameModel);
     
     return true;
 }
 
-bool GameController::parseLevelConfig(const std::string& jsonStr)
+bool GameController::loadBuiltLevel(const BuiltLevel& level)
 {
-    rapidjson::Document doc;
-    doc.Parse(jsonStr.c_str());
+    if (!_gameModel || !level.layout) {
+        return false;
+    }
+    cancelLevelLoad();
+    applyBuiltLevel(level);
+    _gameView->initWithModel(_gameModel);
+    return true;
+}
 
-    if (doc.HasParseError()) {
-        CCLOG("JSON parse error!");
+bool GameController::loadLevelAsync(const std::string& levelFile)
+{
+    if (!_gameModel) {
         return false;
     }
+    if (!_loader) {
+        _loader.reset(new ThreadPool(1, 0));
+    }
 
-    const float STACK_AREA_HEIGHT = 580.0f;  // 堆牌区高度
+    // 路径解析会写 FileUtils 的缓存，只在主线程做；工作线程只读取已解析的完整路径
+    std::string fullPath = FileUtils::getInstance()->fullPathForFilename(levelFile);
+    if (fullPath.empty()) {
+        CCLOG("Failed to load level file: %s", levelFile.c_str());
+        return false;
+    }
 
-    // 解析主牌区
-    if (doc.HasMember("Playfield") && doc["Playfield"].IsArray()) {
-        const rapidjson::Value& playfield = doc["Playfield"];
-        for (rapidjson::SizeType i = 0; i < playfield.Size(); i++) {
-            const rapidjson::Value& cardData = playfield[i];
+    cancelLevelLoad();
+    uint32_t ticket = _loadTicket;
+    bool submitted = _loader->submit([this, fullPath, ticket]() {
+        std::unique_ptr<LoadedLevel> loaded(new LoadedLevel());
+        loaded->ticket = ticket;
+        std::string data = FileUtils::getInstance()->getStringFromFile(fullPath);
+        if (data.empty()) {
+            loaded->error = "cannot read " + fullPath;
+        }
+        else {
+            loaded->level = BuiltLevel::build(data.data(), data.size(), &loaded->error);
+        }
+        _loadedLevels.post(std::move(loaded));
+    });
+    if (!submitted) {
+        return false;
+    }
 
-            int face = cardData["CardFace"].GetInt();
-            int suit = cardData["CardSuit"].GetInt();
-            float x = cardData["Position"]["x"].GetFloat();
-            float y = cardData["Position"]["y"].GetFloat();
+    _loadPending = true;
+    Director::getInstance()->getScheduler()->schedule([this](float) {
+        pollLevelLoad();
+    }, this, 0.0f, false, LOAD_SCHEDULE_KEY);
+    FrameRateManager::getInstance()->keepAwake();
+    return true;
+}
 
-            // 主牌区的y坐标需要加上堆牌区高度
-            Vec2 pos(x, y + STACK_AREA_HEIGHT);
+bool GameController::pollLevelLoad()
+{
+    if (!_loadPending) {
+        return false;
+    }
 
-            CardModel card(_nextCardId++,
-                static_cast<CardFaceType>(face),
-                static_cast<CardSuitType>(suit),
-                pos);
-            _gameModel->addPlayfieldCard(card);
-        }
+    std::unique_ptr<LoadedLevel> loaded = _loadedLevels.take();
+    if (!loaded || loaded->ticket != _loadTicket) {
+        // 还在构建，或是已被取代的旧结果；保持满帧率以便尽快拿到结果
+        FrameRateManager::getInstance()->keepAwake();
+        return false;
     }
 
-    // 解析底牌堆（手牌区右侧的牌）
-    // Stack中的牌：最后一张是顶牌（显示的牌），前面的是备用牌
-    if (doc.HasMember("Stack") && doc["Stack"].IsArray()) {
-        const rapidjson::Value& stack = doc["Stack"];
-        int stackSize = stack.Size();
-
-        // 底牌堆位置（右侧）
-        Vec2 stackPos(700, 290);
-        // 备用牌堆位置（左侧）
-        Vec2 trayPos(380, 290);
-
-        for (rapidjson::SizeType i = 0; i < stack.Size(); i++) {
-            const rapidjson::Value& cardData = stack[i];
-
-            int face = cardData["CardFace"].GetInt();
-            int suit = cardData["CardSuit"].GetInt();
-
-            if (i == stackSize - 1) {
-                // 最后一张是底牌堆顶牌
-                CardModel card(_nextCardId++,
-                    static_cast<CardFaceType>(face),
-                    static_cast<CardSuitType>(suit),
-                    stackPos);
-                _gameModel->addStackCard(card);
-            }
-            else {
-                // 其他是备用牌堆
-                CardModel card(_nextCardId++,
-                    static_cast<CardFaceType>(face),
-                    static_cast<CardSuitType>(suit),
-                    trayPos);
-                _gameModel->addTrayCard(card);
-            }
-        }
+    _loadPending = false;
+    Director::getInstance()->getScheduler()->unschedule(LOAD_SCHEDULE_KEY, this);
+    if (!loaded->level) {
+        CCLOG("Level load error: %s", loaded->error.c_str());
+        return false;
+    }
+
+    applyBuiltLevel(*loaded->level);
+    _gameView->initWithModel(_gameModel);
+    return true;
+}
+
+void GameController::setPositionAnalysisEnabled(bool enabled)
+{
+    if (enabled == (_analyzer != nullptr)) {
+        return;
+    }
+    if (!enabled) {
+        Director::getInstance()->getScheduler()->unschedule(ANALYSIS_SCHEDULE_KEY, this);
+        _analyzer.reset();
+        _verdict = PositionVerdict();
+        return;
     }
+    _analyzer.reset(new PositionAnalyzer());
+    if (_boardState.getLayoutPtr()) {
+        requestPositionAnalysis();
+    }
+}
+
+void GameController::requestPositionAnalysis()
+{
+    if (!_analyzer) {
+        return;
+    }
+    _verdict = PositionVerdict();
+    _analyzer->request(_boardState);
+    Director::getInstance()->getScheduler()->schedule([this](float) {
+        pollPositionAnalysis();
+    }, this, 0.0f, false, ANALYSIS_SCHEDULE_KEY);
+}
 
+bool GameController::pollPositionAnalysis()
+{
+    PositionVerdict verdict;
+    if (!_analyzer || !_analyzer->poll(verdict)) {
+        return false;
+    }
+    Director::getInstance()->getScheduler()->unschedule(ANALYSIS_SCHEDULE_KEY, this);
+    _verdict = verdict;
+    _eventBus.publish(PositionAnalyzedEvent(verdict.status, verdict.movesLeft));
     return true;
 }
 
+void GameController::cancelLevelLoad()
+{
+    _loadTicket++;
+    if (_loadPending) {
+        _loadPending = false;
+        Director::getInstance()->getScheduler()->unschedule(LOAD_SCHEDULE_KEY, this);
+    }
+}
+
+bool GameController::parseLevelConfig(const std::string& jsonStr)
+{
+    std::string error;
+    auto level = BuiltLevel::build(jsonStr.data(), jsonStr.size(), &error);
+    if (!level) {
+        CCLOG("Level parse error: %s", error.c_str());
+        return false;
+    }
+
+    applyBuiltLevel(*level);
+    return true;
+}
+
+void GameController::applyBuiltLevel(const BuiltLevel& level)
+{
+    const BoardLayout& layout = *level.layout;
+
+    // 新关卡：先让模型放开上一关的内存，再整体释放 arena，然后按关卡规模预留
+    int playfieldCount = static_cast<int>(level.playfield.size());
+    int trayCount = static_cast<int>(level.tray.size());
+    _gameModel->clear();
+    _undoManager->clear();
+    _levelArena.release();
+    _gameModel->beginLevel(&_levelArena, playfieldCount, trayCount);
+    _undoManager->beginLevel(&_levelArena, static_cast<size_t>(playfieldCount + trayCount));
+
+    _gameModel->setMatchRule(layout.matchRule);
+    _playableSlots.reserve(static_cast<size_t>(playfieldCount));
+
+    // 卡牌和遮挡关系已在构建时算好，这里只按顺序填入
+    for (int slot = 0; slot < playfieldCount; slot++) {
+        _gameModel->addPlayfieldCard(level.playfield[slot], layout.covers[slot]);
+    }
+    for (const auto& card : level.tray) {
+        _gameModel->addTrayCard(card);
+    }
+    _gameModel->addStackCard(level.stackTop);
+    _nextCardId = level.getCardCount();
+    _boardState.init(level.layout);
+    _boardStateSynced = true;
+    _movePending = false;
+
+    _levelSeq++;
+    _moveIndex = 0;
+    _lastCommitUs = _telemetry.nowUs();
+    _lastInputUs = _lastCommitUs;
+    recordTelemetry(TelemetryRecord::LEVEL_START, -1);
+    requestPositionAnalysis();
+}
+
 void GameController::onCardClicked(int cardId)
 {
     CCLOG("Card clicked: %d", cardId);
+    if (_movePending) {
+        return;
+    }
+    _lastInputUs = _telemetry.nowUs();
     tryMatchCard(cardId);
 }
 
 void GameController::onTrayClicked()
 {
     CCLOG("Tray clicked");
+    if (_movePending) {
+        return;
+    }
+    _lastInputUs = _telemetry.nowUs();
     executeFlipTray();
 }
 
 void GameController::onUndoClicked()
 {
     CCLOG("Undo clicked");
+    if (_movePending) {
+        return;
+    }
+    _lastInputUs = _telemetry.nowUs();
     executeUndo();
 }
 
 bool GameController::tryMatchCard(int cardId)
 {
-    // 查找点击的卡牌
-    auto& playfieldCards = _gameModel->getPlayfieldCards();
-    CardModel* clickedCard = nullptr;
-    
-    for (auto& card : playfieldCards) {
-        if (card.getId() == cardId) {
-            clickedCard = &card;
-            break;
-        }
-    }
-    
-    if (!clickedCard) {
-        return false;
-    }
-    
-    // 获取底牌堆顶部的牌
-    CardModel* topStackCard = _gameModel->getTopStackCard();
-    if (!topStackCard) {
+    // 查找点击的卡牌所在槽位
+    int slot = _gameModel->findPlayfieldSlot(cardId);
+    if (slot < 0 || !_gameModel->isPlayfieldCardLive(slot)) {
         return false;
     }
     
-    // 检查是否可以匹配
-    if (clickedCard->canMatch(*topStackCard)) {
+    // 检查是否可与底牌堆顶牌匹配（只读取牌码、在场和可点击标记）
+    if (_gameModel->canMatchTop(slot)) {
         executeMatch(cardId);
         return true;
     }
     
     CCLOG("Cards cannot match!");
+    recordTelemetry(TelemetryRecord::REJECTED, cardId);
     return false;
 }
 
 void GameController::executeMatch(int cardId)
 {
     // 查找卡牌
-    auto& playfieldCards = _gameModel->getPlayfieldCards();
-    CardModel matchedCard;
-    
-    for (auto& card : playfieldCards) {
-        if (card.getId() == cardId) {
-            matchedCard = card;
-            break;
-        }
+    int slot = _gameModel->findPlayfieldSlot(cardId);
+    if (slot < 0) {
+        return;
     }
+    Vec2 fromPos = _gameModel->getPlayfieldCard(slot).getPosition();
     
     // 获取底牌堆顶部位置
     CardModel* topStackCard = _gameModel->getTopStackCard();
@@ -214,22 +373,13 @@ void GameController::executeMatch(int cardId)
     // 记录撤销操作
     UndoModel undoAction(UndoActionType::MATCH_CARD, 
                          cardId,
-                         matchedCard.getPosition(),
+                         fromPos,
                          targetPos);
     _undoManager->recordAction(undoAction);
     
-    // 播放动画
-    if (_gameView) {
-        _gameView->playMatchAnimation(cardId, targetPos, [this, cardId, matchedCard]() {
-            // 动画完成后更新数据
-            _gameModel->removePlayfieldCard(cardId);
-            
-            // 将匹配的牌加入底牌堆
-            CardModel newStackCard = matchedCard;
-            newStackCard.setPosition(_gameModel->getTopStackCard()->getPosition());
-            _gameModel->addStackCard(newStackCard);
-        });
-    }
+    // 播放动画，结束后在 onAnimationDone 中更新数据
+    _movePending = true;
+    _gameView->playMatchAnimation(cardId, targetPos);
 }
 
 void GameController::executeFlipTray()
@@ -255,23 +405,9 @@ void GameController::executeFlipTray()
         targetPos);
     _undoManager->recordAction(undoAction);
 
-    // 播放移动动画
-    if (_gameView) {
-        _gameView->playFlipTrayAnimation(trayCard, targetPos, [this, trayCard]() {
-            // 动画完成后，从备用牌堆移除，加入底牌堆
-            auto& trayCards = _gameModel->getTrayCards();
-            if (!trayCards.empty()) {
-                CardModel card = trayCards.back();
-                trayCards.pop_back();
-
-                // 更新位置并加入底牌堆
-                CardModel* topStackCard = _gameModel->getTopStackCard();
-                Vec2 stackPos = topStackCard ? topStackCard->getPosition() : Vec2(700, 290);
-                card.setPosition(stackPos);
-                _gameModel->addStackCard(card);
-            }
-            });
-    }
+    // 播放移动动画，结束后在 onAnimationDone 中更新数据
+    _movePending = true;
+    _gameView->playFlipTrayAnimation(trayCard, targetPos);
 }
 
 void GameController::executeUndo()
@@ -293,49 +429,176 @@ void GameController::executeUndo()
     CCLOG("Undo action type: %d, cardId: %d, originalPos: (%f, %f)",
         (int)actionType, cardId, originalPos.x, originalPos.y);
 
+    // 回退的牌是底牌堆最上面的牌，动画结束后在 onAnimationDone 中更新数据
+    auto& stackCards = _gameModel->getStackCards();
     if (actionType == UndoActionType::MATCH_CARD) {
         // 回退匹配操作：将牌从底牌堆移回主牌区
-        auto& stackCards = _gameModel->getStackCards();
         if (stackCards.size() > 1) {  // 确保底牌堆至少有2张牌
-            // 获取要回退的牌（底牌堆最上面的牌）
-            CardModel cardToUndo = stackCards.back();
-
-            if (_gameView) {
-                _gameView->playUndoAnimation(cardToUndo.getId(), originalPos, [this, cardToUndo, originalPos]() {
-                    // 动画完成后更新数据
-                    auto& stackCards = _gameModel->getStackCards();
-                    if (!stackCards.empty()) {
-                        stackCards.pop_back();
-
-                        // 恢复到主牌区
-                        CardModel restoredCard = cardToUndo;
-                        restoredCard.setPosition(originalPos);
-                        _gameModel->addPlayfieldCard(restoredCard);
-                    }
-                    });
-            }
+            _movePending = true;
+            _gameView->playUndoAnimation(stackCards.back().getId(), originalPos, AnimationKind::UNDO_MATCH);
         }
     }
     else if (actionType == UndoActionType::FLIP_TRAY_CARD) {
         // 回退翻牌操作：将牌从底牌堆移回备用牌堆
-        auto& stackCards = _gameModel->getStackCards();
         if (!stackCards.empty()) {
-            CardModel cardToUndo = stackCards.back();
-
-            if (_gameView) {
-                _gameView->playUndoAnimation(cardToUndo.getId(), originalPos, [this, cardToUndo, originalPos]() {
-                    // 动画完成后更新数据
-                    auto& stackCards = _gameModel->getStackCards();
-                    if (!stackCards.empty()) {
-                        stackCards.pop_back();
-
-                        // 恢复到备用牌堆
-                        CardModel restoredCard = cardToUndo;
-                        restoredCard.setPosition(originalPos);
-                        _gameModel->addTrayCard(restoredCard);
-                    }
-                    });
-            }
+            _movePending = true;
+            _gameView->playUndoAnimation(stackCards.back().getId(), originalPos, AnimationKind::UNDO_FLIP);
+        }
+    }
+}
+
+void GameController::undoAll()
+{
+    // 每一步与动画结束时的提交相同（含 MoveCommittedEvent 和遥测），只是不经过视图
+    if (_movePending) {
+        return;
+    }
+    UndoModel action;
+    while (_undoManager->popLastAction(action)) {
+        auto& stackCards = _gameModel->getStackCards();
+        bool isMatch = (action.getActionType() == UndoActionType::MATCH_CARD);
+        if (stackCards.empty() || (isMatch && stackCards.size() < 2)) {
+            break;
+        }
+        AnimationKind kind = isMatch ? AnimationKind::UNDO_MATCH : AnimationKind::UNDO_FLIP;
+        onAnimationDone(AnimationDoneEvent(stackCards.back().getId(), kind, action.getFromPosition()));
+    }
+    _gameView->syncWithModel();
+}
+
+void GameController::onAnimationDone(const AnimationDoneEvent& event)
+{
+    _movePending = false;
+    auto& stackCards = _gameModel->getStackCards();
+
+    switch (event.kind) {
+    case AnimationKind::MATCH: {
+        // 主牌区的牌移入底牌堆
+        int slot = _gameModel->findPlayfieldSlot(event.cardId);
+        if (slot < 0 || !_gameModel->isPlayfieldCardLive(slot)) {
+            return;
+        }
+        CardModel newStackCard = _gameModel->getPlayfieldCard(slot).toCardModel();
+        _gameModel->removePlayfieldCard(event.cardId);
+        newStackCard.setPosition(_gameModel->getTopStackCard()->getPosition());
+        _gameModel->addStackCard(newStackCard);
+        _eventBus.publish(MoveCommittedEvent(GameMove::match(event.cardId)));
+        break;
+    }
+    case AnimationKind::FLIP_TRAY: {
+        // 从备用牌堆移除，加入底牌堆
+        auto& trayCards = _gameModel->getTrayCards();
+        if (trayCards.empty()) {
+            return;
+        }
+        CardModel card = trayCards.back();
+        trayCards.pop_back();
+
+        CardModel* topStackCard = _gameModel->getTopStackCard();
+        Vec2 stackPos = topStackCard ? topStackCard->getPosition() : Vec2(700, 290);
+        card.setPosition(stackPos);
+        _gameModel->addStackCard(card);
+        _eventBus.publish(MoveCommittedEvent(GameMove::flip()));
+        break;
+    }
+    case AnimationKind::UNDO_MATCH: {
+        // 恢复到主牌区的原槽位
+        if (stackCards.empty()) {
+            return;
+        }
+        stackCards.pop_back();
+        _gameModel->restorePlayfieldCard(event.cardId, event.targetPos);
+        _eventBus.publish(MoveCommittedEvent(GameMove::undo()));
+        break;
+    }
+    case AnimationKind::UNDO_FLIP: {
+        // 恢复到备用牌堆
+        if (stackCards.empty()) {
+            return;
+        }
+        CardModel restoredCard = stackCards.back();
+        stackCards.pop_back();
+        restoredCard.setPosition(event.targetPos);
+        _gameModel->addTrayCard(restoredCard);
+        _eventBus.publish(MoveCommittedEvent(GameMove::undo()));
+        break;
+    }
+    }
+}
+
+void GameController::onMoveCommitted(const MoveCommittedEvent& event)
+{
+    _moveIndex++;
+    switch (event.move.type) {
+    case GameMove::MATCH: recordTelemetry(TelemetryRecord::MATCH, event.move.cardId); break;
+    case GameMove::FLIP:  recordTelemetry(TelemetryRecord::FLIP, -1); break;
+    case GameMove::UNDO:  recordTelemetry(TelemetryRecord::UNDO, -1); break;
+    }
+    _lastCommitUs = _telemetry.nowUs();
+
+    // 新的一步（含回退）取消上一局面的分析；棋盘拒绝这一步说明与模型不一致，按模型重建
+    if (!_boardStateSynced || !_boardState.applyMove(event.move)) {
+        CCLOG("BoardState out of sync at move %d, rebuilding from model", static_cast<int>(_moveIndex));
+        _boardStateSynced = resyncBoardState();
+    }
+    if (_boardStateSynced) {
+        requestPositionAnalysis();
+    }
+    else if (_analyzer) {
+        // 模型已不合规则，分析结论没有意义
+        _analyzer->cancel();
+        _verdict = PositionVerdict();
+    }
+
+    if (_gameModel->getPlayfieldCards().empty()) {
+        recordTelemetry(TelemetryRecord::LEVEL_WON, -1);
+    }
+    else if (_gameModel->getTrayCards().empty()) {
+        _gameModel->collectPlayableSlots(_playableSlots);
+        if (_playableSlots.empty()) {
+            recordTelemetry(TelemetryRecord::DEAD_END, -1);
+        }
+    }
+}
+
+bool GameController::resyncBoardState()
+{
+    std::shared_ptr<const BoardLayout> layout = _boardState.getLayoutPtr();
+    if (!layout || !_boardState.init(layout)) {
+        return false;
+    }
+    // 底牌堆第一张是开局的顶牌，之后每张对应一步：主牌区的牌为匹配，其余为翻牌
+    const auto& stackCards = _gameModel->getStackCards();
+    for (size_t i = 1; i < stackCards.size(); i++) {
+        int cardId = stackCards[i].getId();
+        bool ok = _gameModel->findPlayfieldSlot(cardId) >= 0 ? _boardState.applyMatch(cardId) : _boardState.applyFlip();
+        if (!ok) {
+            CCLOG("Model move %d (card %d) breaks the rules, position analysis disabled", static_cast<int>(i), cardId);
+            return false;
         }
     }
-}
\ No newline at end of file
+    return true;
+}
+
+void GameController::recordTelemetry(uint8_t type, int cardId)
+{
+    if (!_telemetry.isRunning()) {
+        return;
+    }
+
+    TelemetryRecord rec;
+    rec.type = type;
+    rec.cardId = static_cast<int16_t>(cardId);
+    rec.levelSeq = _levelSeq;
+    rec.moveIndex = _moveIndex;
+    rec.decideUs = _lastInputUs > _lastCommitUs ? static_cast<uint32_t>(_lastInputUs - _lastCommitUs) : 0;
+    rec.liveCount = static_cast<uint16_t>(_gameModel->getPlayfieldCards().size());
+    rec.trayRemaining = static_cast<uint16_t>(_gameModel->getTrayCards().size());
+    rec.undoDepth = static_cast<uint16_t>(_undoManager->getUndoCount());
+    rec.matchRule = static_cast<uint8_t>(_gameModel->getMatchRule());
+
+    _gameModel->collectPlayableSlots(_playableSlots);
+    rec.playableCount = static_cast<uint8_t>(_playableSlots.size() < 255 ? _playableSlots.size() : 255);
+
+    _telemetry.record(rec);
+}
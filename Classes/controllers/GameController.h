@@ -3,24 +3,70 @@
 
 #include "cocos2d.h"
 #include "models/GameModel.h"
-#include "views/GameView.h"
+#include "models/BuiltLevel.h"
+#include "models/GameEvents.h"
+#include "views/IGameView.h"
+#include "views/NullGameView.h"
 #include "managers/UndoManager.h"
+#include "utils/LevelArena.h"
+#include "utils/Mailbox.h"
+#include "utils/ThreadPool.h"
+#include "services/TelemetryRecorder.h"
+#include "services/PositionAnalyzer.h"
+#include <memory>
 
 /**
  * 游戏控制器类
  * 协调模型和视图，处理游戏逻辑
+ * 视图通过 IGameView 接口访问：init(scene) 使用 cocos 的 GameView，
+ * initWithView 可传入 NullGameView / RecordingGameView，在没有场景的情况下运行完整的出牌和回退逻辑
  */
 class GameController {
 public:
     GameController();
     ~GameController();
     
-    // 初始化控制器
+    // 初始化控制器，在 scene 中创建 GameView 并开启遥测
     bool init(cocos2d::Scene* scene);
     
-    // 加载关卡
+    // 以给定视图初始化（视图由调用方持有）；view 为空时使用内置的空视图
+    bool initWithView(IGameView* view);
+    
+    // 加载关卡文件
     bool loadLevel(const std::string& levelFile);
     
+    // 从内存加载关卡（JSON、二进制关卡或发牌描述）
+    bool loadLevelData(const std::string& data);
+    
+    // 应用已构建好的关卡（只填充模型和刷新视图，不做解析和遮挡计算）
+    bool loadBuiltLevel(const BuiltLevel& level);
+    
+    // 在工作线程读取并构建关卡，构建完成后由主线程的调度回调应用，调用本身不阻塞当前帧
+    // 返回 false 表示未能提交；加载失败只输出日志，当前关卡保持不变。后发起的加载会取代先发起的
+    bool loadLevelAsync(const std::string& levelFile);
+    
+    // 主线程调用：取出已构建好的关卡并应用，应用后返回 true（没有 cocos 调度器时可手动轮询）
+    bool pollLevelLoad();
+    
+    // 是否有异步加载尚未应用
+    bool isLoadingLevel() const { return _loadPending; }
+    
+    // 后台局面分析：开启后关卡开始和每提交一步都在工作线程判断还能否通关，
+    // 结论送达时发布 PositionAnalyzedEvent（init(scene) 时默认开启）
+    void setPositionAnalysisEnabled(bool enabled);
+    
+    // 主线程调用：取出最新的分析结论，送达时返回 true（没有 cocos 调度器时可手动轮询）
+    bool pollPositionAnalysis();
+    
+    // 最近送达的分析结论（分析中或未开启时为 UNKNOWN）
+    const PositionVerdict& getPositionVerdict() const { return _verdict; }
+    
+    // 与模型同步的无界面棋盘状态（供分析和求解使用）
+    const BoardState& getBoardState() const { return _boardState; }
+    
+    // 是否有移动动画尚未写入模型（期间点击和回退被忽略）
+    bool isMovePending() const { return _movePending; }
+    
     // 处理卡牌点击
     void onCardClicked(int cardId);
     
@@ -30,11 +76,24 @@ public:
     // 处理回退按钮点击
     void onUndoClicked();
     
+    // 回退到开局：不播放动画，直接按回退记录修改模型，最后让视图整体对齐一次
+    // 有移动动画未结束时不执行
+    void undoAll();
+    
     // 获取游戏模型
     GameModel* getGameModel() { return _gameModel; }
     
     // 获取游戏视图
-    GameView* getGameView() { return _gameView; }
+    IGameView* getGameView() { return _gameView; }
+    
+    // 获取撤销管理器
+    UndoManager* getUndoManager() { return _undoManager; }
+    
+    // 事件总线（可订阅 MoveCommittedEvent 等事件）
+    GameEventBus& getEventBus() { return _eventBus; }
+    
+    // 当前关卡的分配器（可用于确认对局中没有新的分配）
+    const LevelArena& getLevelArena() const { return _levelArena; }
 
 private:
     // 尝试匹配卡牌
@@ -49,14 +108,71 @@ private:
     // 执行回退操作
     void executeUndo();
     
+    // 移动动画结束，把对应操作写入数据模型
+    void onAnimationDone(const AnimationDoneEvent& event);
+    
     // 解析关卡配置
     bool parseLevelConfig(const std::string& jsonStr);
     
+    // 按构建好的关卡重置模型、撤销栈和遥测
+    void applyBuiltLevel(const BuiltLevel& level);
+    
+    // 作废进行中的异步加载（之后送达的结果被丢弃）
+    void cancelLevelLoad();
+    
+    // 把当前局面交给后台分析（取消上一次进行中的分析）
+    void requestPositionAnalysis();
+    
+    // 一步操作已写入模型（订阅 MoveCommittedEvent），记录遥测
+    void onMoveCommitted(const MoveCommittedEvent& event);
+    
+    // 按模型的底牌堆重放出 _boardState，模型本身不合规则时返回 false
+    bool resyncBoardState();
+    
+    // 以当前局面填写并记录一条遥测
+    void recordTelemetry(uint8_t type, int cardId);
+    
     GameModel* _gameModel;
-    GameView* _gameView;
+    IGameView* _gameView;
+    NullGameView _nullView;  // 未提供视图时使用
     UndoManager* _undoManager;
+    LevelArena _levelArena;  // 关卡级分配器，模型和撤销栈从中分配，切换关卡时整体释放
+    GameEventBus _eventBus;  // 控制器与视图之间的事件
+    EventHandle _subscriptions[5];
     
     int _nextCardId;  // 用于生成唯一卡牌ID
+    
+    // 遥测（主线程只入队，由后台线程写文件）
+    TelemetryRecorder _telemetry;
+    std::vector<int> _playableSlots;  // 统计可匹配数用，按关卡规模预留
+    uint32_t _levelSeq;               // 本次运行中的第几个关卡
+    uint16_t _moveIndex;              // 本关已提交的步数
+    uint64_t _lastCommitUs;           // 上一步提交（或关卡开始）的时间
+    uint64_t _lastInputUs;            // 最近一次点击的时间
+    
+    // 动画开始到写入模型之间，按旧局面判断的第二次点击会提交两步不合规则的操作
+    bool _movePending;
+    
+    /**
+     * 工作线程构建的结果
+     */
+    struct LoadedLevel {
+        uint32_t ticket;                          // 发起加载时的序号，过期的结果直接丢弃
+        std::shared_ptr<const BuiltLevel> level;  // 失败时为空
+        std::string error;
+    };
+    
+    // 后台局面分析
+    BoardState _boardState;                        // 随每步提交更新
+    bool _boardStateSynced;                        // 与模型一致；不一致时不做分析
+    std::unique_ptr<PositionAnalyzer> _analyzer;   // 未开启时为空
+    PositionVerdict _verdict;
+    
+    // 异步加载：工作线程只读文件和构建关卡，结果经无锁信箱交回主线程
+    Mailbox<LoadedLevel> _loadedLevels;
+    uint32_t _loadTicket;
+    bool _loadPending;
+    std::unique_ptr<ThreadPool> _loader;  // 首次异步加载时创建；最后声明，析构时最先等待工作线程退出
 };
 
 #endif // __GAME_CONTROLLER_H__
\ No newline at end of file
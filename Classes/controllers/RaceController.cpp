@@ -0,0 +1,235 @@
+#include "RaceController.h"
+#include "controllers/GameController.h"
+#include "managers/FrameRateManager.h"
+
+USING_NS_CC;
+
+namespace {
+
+const float LOGIC_FRAME_SECONDS = 1.0f / 60.0f;
+
+} // namespace
+
+RaceController::RaceController()
+    : _controller(nullptr)
+    , _accumulator(0.0f)
+    , _opponentLabel(nullptr)
+    , _resultLabel(nullptr)
+    , _shownRemaining(-1)
+    , _shownResult(false)
+    , _shownDesync(false)
+{
+}
+
+RaceController* RaceController::create(GameController* controller, const RaceConfig& config)
+{
+    RaceController* ret = new (std::nothrow) RaceController();
+    if (ret && ret->init(controller, config)) {
+        ret->autorelease();
+        return ret;
+    }
+    CC_SAFE_DELETE(ret);
+    return nullptr;
+}
+
+bool RaceController::init(GameController* controller, const RaceConfig& config)
+{
+    if (!Node::init() || !controller || config.localPlayer < 0 || config.localPlayer >= LockstepMatch::PLAYER_COUNT) {
+        return false;
+    }
+
+    _controller = controller;
+    _config = config;
+
+    // 玩家的每一步在动画结束、写入模型时提交，与对方看到的顺序一致
+    _committedHandle = _controller->getEventBus().subscribe<MoveCommittedEvent>([this](const MoveCommittedEvent& event) {
+        onMoveCommitted(event.move);
+    });
+
+    auto visibleSize = Director::getInstance()->getVisibleSize();
+
+    // 对方进度（主牌区顶部）
+    _opponentLabel = Label::createWithSystemFont("", "Arial", 36);
+    _opponentLabel->setPosition(Vec2(visibleSize.width / 2, visibleSize.height - 40));
+    _opponentLabel->setTextColor(Color4B(255, 255, 255, 255));
+    this->addChild(_opponentLabel);
+
+    // 对局结果（主牌区中央）
+    _resultLabel = Label::createWithSystemFont("", "Arial", 72);
+    _resultLabel->setPosition(Vec2(visibleSize.width / 2, 1180));
+    _resultLabel->setTextColor(Color4B(255, 235, 120, 255));
+    _resultLabel->setVisible(false);
+    this->addChild(_resultLabel);
+
+    scheduleUpdate();
+    return true;
+}
+
+void RaceController::onExit()
+{
+    _controller->getEventBus().unsubscribe(_committedHandle);
+    Node::onExit();
+}
+
+void RaceController::update(float dt)
+{
+    // 关卡还在后台构建
+    if (_controller->isLoadingLevel()) {
+        return;
+    }
+    const auto& layout = _controller->getBoardState().getLayoutPtr();
+    if (!layout) {
+        return;
+    }
+    if (layout != _layout) {
+        _layout = layout;
+        startMatch();
+    }
+    if (!_match.isStarted()) {
+        return;
+    }
+
+    // 对局未确定前保持满帧率：消息按逻辑帧收发，降帧会拉长双方的延迟
+    if (!_match.getResult().confirmed) {
+        FrameRateManager::getInstance()->keepAwake();
+    }
+
+    _accumulator += dt;
+    int steps = 0;
+    while (_accumulator >= LOGIC_FRAME_SECONDS && steps < MAX_STEPS_PER_UPDATE) {
+        _accumulator -= LOGIC_FRAME_SECONDS;
+        step();
+        steps++;
+    }
+    if (steps == MAX_STEPS_PER_UPDATE) {
+        _accumulator = 0.0f;
+    }
+    refreshLabels();
+}
+
+void RaceController::startMatch()
+{
+    _bot.reset();
+    _link.reset();
+    IMatchTransport* transport = _config.transport;
+    if (!transport) {
+        _link.reset(new LoopbackLink(_config.latencyFrames, _config.jitterFrames, _config.seed));
+        _bot.reset(new MatchBot());
+        int botPlayer = 1 - _config.localPlayer;
+        if (!_bot->start(_layout, botPlayer, &_link->getEndpoint(botPlayer), _config.botThinkFrames, _config.seed)) {
+            _bot.reset();
+        }
+        transport = &_link->getEndpoint(_config.localPlayer);
+    }
+    if (!_match.start(_layout, _config.localPlayer, transport)) {
+        cocos2d::log("RaceController: cannot start match");
+    }
+    _accumulator = 0.0f;
+    _shownRemaining = -1;
+    _shownResult = false;
+    _shownDesync = false;
+    _resultLabel->setVisible(false);
+}
+
+void RaceController::onMoveCommitted(const GameMove& move)
+{
+    if (!_match.isStarted() || _match.submitLocal(move)) {
+        return;
+    }
+    // 本端已通关或结果已确定后对局不再接收操作
+    if (_match.getFinishFrame(_match.getLocalPlayer()) != LockstepMatch::NOT_FINISHED || _match.getResult().confirmed) {
+        return;
+    }
+    cocos2d::log("RaceController: move %d (card %d) rejected at frame %u, resyncing from the model",
+        static_cast<int>(move.type), move.cardId, _match.getFrame());
+    if (!resyncLocalBoard()) {
+        cocos2d::log("RaceController: cannot resync the local board, match marked as desynced");
+        _match.markDesynced();
+    }
+}
+
+bool RaceController::resyncLocalBoard()
+{
+    // 模型底牌堆第一张是开局顶牌，之后每张对应一步：主牌区的牌为匹配，其余为翻牌
+    GameModel* model = _controller->getGameModel();
+    const auto& stackCards = model->getStackCards();
+    _modelMoves.clear();
+    for (size_t i = 1; i < stackCards.size(); i++) {
+        int cardId = stackCards[i].getId();
+        _modelMoves.push_back(model->findPlayfieldSlot(cardId) >= 0 ? GameMove::match(cardId) : GameMove::flip());
+    }
+
+    // 翻牌总是翻备用牌堆顶的牌，前缀相同时翻出的牌也相同，只需比较匹配的牌
+    const SessionHost& host = _match.getHost();
+    SessionHandle session = _match.getSession(_match.getLocalPlayer());
+    int playfieldCount = _match.getPlayfieldCount();
+    int sessionMoves = host.getStackSize(session) - 1;
+    int common = 0;
+    while (common < sessionMoves && common < static_cast<int>(_modelMoves.size())) {
+        int cardId = host.getStackCardId(session, common + 1);
+        const GameMove& expected = _modelMoves[common];
+        bool isMatch = cardId < playfieldCount;
+        if (isMatch != (expected.type == GameMove::MATCH) || (isMatch && cardId != expected.cardId)) {
+            break;
+        }
+        common++;
+    }
+
+    for (int i = sessionMoves; i > common; i--) {
+        if (!_match.submitLocal(GameMove::undo())) {
+            return false;
+        }
+    }
+    for (size_t i = static_cast<size_t>(common); i < _modelMoves.size(); i++) {
+        if (!_match.submitLocal(_modelMoves[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void RaceController::step()
+{
+    if (_link) {
+        _link->tick();
+    }
+    if (_bot) {
+        _bot->update();
+    }
+    _match.advanceFrame();
+}
+
+void RaceController::refreshLabels()
+{
+    if (_match.isDesynced() && !_shownDesync) {
+        _shownDesync = true;
+        _resultLabel->setString("对局不同步");
+        _resultLabel->setVisible(true);
+    }
+
+    int remote = _match.getRemotePlayer();
+    int remaining = _match.getLiveCount(remote);
+    if (remaining != _shownRemaining) {
+        _shownRemaining = remaining;
+        _opponentLabel->setString(StringUtils::format("对手 剩余 %d 张", remaining));
+    }
+
+    // 结果在双方输入都确定后才显示，之后不会再被迟到的输入改写
+    const RaceResult& result = _match.getResult();
+    if (result.confirmed && !_shownResult && !_shownDesync) {
+        _shownResult = true;
+        if (result.draw) {
+            _resultLabel->setString("平局");
+        }
+        else if (result.winner == _match.getLocalPlayer()) {
+            _resultLabel->setString("你赢了");
+        }
+        else {
+            _resultLabel->setString("对手先通关");
+        }
+        _resultLabel->setVisible(true);
+        cocos2d::log("RaceController: winner %d at frame %u, rollbacks %u, stalled frames %u%s",
+            result.winner, result.frame, _match.getStats().rollbacks, _match.getStats().stalledFrames,
+            _match.isDesynced() ? ", DESYNC" : "");
+    }
+}
@@ -0,0 +1,93 @@
+#ifndef __RACE_CONTROLLER_H__
+#define __RACE_CONTROLLER_H__
+
+#include "cocos2d.h"
+#include "models/GameEvents.h"
+#include "services/MatchBot.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class GameController;
+
+/**
+ * 对战配置
+ */
+struct RaceConfig {
+    IMatchTransport* transport;  // 联网对战的传输（由调用方持有）；为空时与本地机器人经回环对战
+    int localPlayer;             // 本端玩家序号，联网时双方约定为 0、1
+    int botThinkFrames;          // 机器人每隔多少帧出一步
+    int latencyFrames;           // 回环的模拟延迟（帧）
+    int jitterFrames;            // 回环的模拟抖动（帧），大于 0 时消息会乱序
+    uint64_t seed;
+
+    RaceConfig()
+        : transport(nullptr)
+        , localPlayer(0)
+        , botThinkFrames(45)
+        , latencyFrames(4)
+        , jitterFrames(2)
+        , seed(1)
+    {
+    }
+};
+
+/**
+ * 双人对战（谁先通关谁赢）
+ *
+ * 玩家照常通过 GameController 出牌，每一步提交（MoveCommittedEvent）后原样交给 LockstepMatch，
+ * 在当前逻辑帧生效并发给对方。GameController 在移动动画结束前忽略点击，提交的每一步都合规则；
+ * 万一对局拒绝了界面已提交的一步，按 GameModel 的底牌堆补发回退和操作把本端棋盘对齐，对不齐时标记不同步。
+ * 逻辑帧固定 60 帧每秒，与渲染帧率无关（空闲降帧时按累计时间补帧）。
+ * 对方棋盘不显示，只显示对方剩余的牌数和对局结果。
+ * 关卡重新加载后用新布局重新开一局。
+ */
+class RaceController : public cocos2d::Node {
+public:
+    static RaceController* create(GameController* controller, const RaceConfig& config);
+
+    virtual void onExit() override;
+    virtual void update(float dt) override;
+
+    const LockstepMatch& getMatch() const { return _match; }
+
+private:
+    RaceController();
+    bool init(GameController* controller, const RaceConfig& config);
+
+    // 用当前关卡开始新的一局
+    void startMatch();
+
+    // 推进一个逻辑帧（先推进回环和机器人，本端收到的是它们这一帧发出的消息）
+    void step();
+
+    // 玩家的一步已写入模型
+    void onMoveCommitted(const GameMove& move);
+
+    // 把本端对局棋盘对齐到 GameModel：回退到公共前缀，再补发模型中之后的操作（都作为本端输入发给对方）
+    bool resyncLocalBoard();
+
+    void refreshLabels();
+
+    // 单帧最多补的逻辑帧数，卡顿后不一次性追太多
+    static const int MAX_STEPS_PER_UPDATE = 8;
+
+    GameController* _controller;
+    RaceConfig _config;
+    EventHandle _committedHandle;
+
+    LockstepMatch _match;
+    std::shared_ptr<const BoardLayout> _layout;    // 当前对局使用的布局
+    std::unique_ptr<LoopbackLink> _link;           // 仅单机对战
+    std::unique_ptr<MatchBot> _bot;
+    float _accumulator;
+    std::vector<GameMove> _modelMoves;             // 对齐时按模型底牌堆还原的操作
+
+    cocos2d::Label* _opponentLabel;
+    cocos2d::Label* _resultLabel;
+    int _shownRemaining;
+    bool _shownResult;
+    bool _shownDesync;
+};
+
+#endif // __RACE_CONTROLLER_H__
@@ -0,0 +1,236 @@
+#include "FrameRateManager.h"
+#include "utils/ProcessStats.h"
+
+USING_NS_CC;
+
+namespace {
+
+const char* SCHEDULE_KEY = "FrameRateManager";
+
+// 输入监听优先于场景内的监听，且不吞掉事件
+const int INPUT_LISTENER_PRIORITY = -1;
+
+} // namespace
+
+FrameRateManager* FrameRateManager::s_instance = nullptr;
+
+FrameRateManager* FrameRateManager::getInstance()
+{
+    if (!s_instance) {
+        s_instance = new FrameRateManager();
+    }
+    return s_instance;
+}
+
+void FrameRateManager::destroyInstance()
+{
+    CC_SAFE_DELETE(s_instance);
+}
+
+FrameRateManager::FrameRateManager()
+    : _started(false)
+    , _enabled(true)
+    , _awakeRequested(false)
+    , _state(State::ACTIVE)
+    , _activeInterval(1.0f / 60.0f)
+    , _idleInterval(1.0f / 10.0f)
+    , _idleDelay(0.5f)
+    , _pauseDelay(0.0f)
+    , _touchListener(nullptr)
+    , _keyboardListener(nullptr)
+    , _measuring(false)
+    , _reportInterval(60.0f)
+    , _stateSeconds()
+    , _frames(0)
+    , _measureCpuUs(0)
+{
+}
+
+FrameRateManager::~FrameRateManager()
+{
+    stop();
+}
+
+void FrameRateManager::start()
+{
+    if (_started) {
+        return;
+    }
+    _started = true;
+
+    auto director = Director::getInstance();
+    director->getScheduler()->schedule([this](float dt) {
+        update(dt);
+    }, this, 0.0f, false, SCHEDULE_KEY);
+
+    // 所有触摸和按键都视为活动（点击卡牌、按钮、返回键）
+    auto touchListener = EventListenerTouchAllAtOnce::create();
+    touchListener->onTouchesBegan = [this](const std::vector<Touch*>&, Event*) { wake(); };
+    touchListener->onTouchesMoved = [this](const std::vector<Touch*>&, Event*) { wake(); };
+    touchListener->onTouchesEnded = [this](const std::vector<Touch*>&, Event*) { wake(); };
+    director->getEventDispatcher()->addEventListenerWithFixedPriority(touchListener, INPUT_LISTENER_PRIORITY);
+    _touchListener = touchListener;
+
+    auto keyboardListener = EventListenerKeyboard::create();
+    keyboardListener->onKeyPressed = [this](EventKeyboard::KeyCode, Event*) { wake(); };
+    director->getEventDispatcher()->addEventListenerWithFixedPriority(keyboardListener, INPUT_LISTENER_PRIORITY);
+    _keyboardListener = keyboardListener;
+
+    _lastActivity = Clock::now();
+    _state = State::ACTIVE;
+    director->setAnimationInterval(_activeInterval);
+    if (_measuring) {
+        resetMeasure(Clock::now());
+    }
+}
+
+void FrameRateManager::stop()
+{
+    if (!_started) {
+        return;
+    }
+    _started = false;
+
+    auto director = Director::getInstance();
+    director->getScheduler()->unschedule(SCHEDULE_KEY, this);
+    director->getEventDispatcher()->removeEventListener(_touchListener);
+    director->getEventDispatcher()->removeEventListener(_keyboardListener);
+    _touchListener = nullptr;
+    _keyboardListener = nullptr;
+    setState(State::ACTIVE);
+}
+
+void FrameRateManager::setEnabled(bool enabled)
+{
+    _enabled = enabled;
+    if (!enabled) {
+        wake();
+    }
+}
+
+void FrameRateManager::setActiveInterval(float seconds)
+{
+    _activeInterval = seconds;
+    if (_started && _state == State::ACTIVE) {
+        Director::getInstance()->setAnimationInterval(_activeInterval);
+    }
+}
+
+void FrameRateManager::setIdleInterval(float seconds)
+{
+    _idleInterval = seconds;
+    if (_started && _state == State::IDLE) {
+        Director::getInstance()->setAnimationInterval(_idleInterval);
+    }
+}
+
+void FrameRateManager::wake()
+{
+    _lastActivity = Clock::now();
+    if (_started) {
+        setState(State::ACTIVE);
+    }
+}
+
+void FrameRateManager::setMeasureEnabled(bool enabled, float reportInterval)
+{
+    _measuring = enabled;
+    _reportInterval = reportInterval > 0.0f ? reportInterval : 60.0f;
+    if (enabled) {
+        resetMeasure(Clock::now());
+    }
+}
+
+void FrameRateManager::update(float)
+{
+    auto now = Clock::now();
+
+    // 只统计动作管理器里正在运行的动作；GameView 的补间动画不走动作系统，由视图调用 keepAwake
+    if (_awakeRequested || Director::getInstance()->getActionManager()->getNumberOfRunningActions() > 0) {
+        _lastActivity = now;
+    }
+    _awakeRequested = false;
+
+    float idleFor = std::chrono::duration<float>(now - _lastActivity).count();
+    if (!_enabled || idleFor < _idleDelay) {
+        setState(State::ACTIVE);
+    }
+    else if (_pauseDelay > 0.0f && idleFor >= _pauseDelay) {
+        setState(State::PAUSED);
+    }
+    else {
+        setState(State::IDLE);
+    }
+
+    if (_measuring) {
+        // 每次调用对应一帧绘制；停止绘制期间没有调用
+        _frames++;
+        if (std::chrono::duration<float>(now - _measureStart).count() >= _reportInterval) {
+            report(Clock::now());
+        }
+    }
+}
+
+void FrameRateManager::setState(State state)
+{
+    if (state == _state) {
+        return;
+    }
+    if (_measuring) {
+        accumulateStateTime(Clock::now());
+    }
+
+    auto director = Director::getInstance();
+    State previous = _state;
+    _state = state;
+    switch (state) {
+    case State::ACTIVE:
+        director->setAnimationInterval(_activeInterval);
+        break;
+    case State::IDLE:
+        director->setAnimationInterval(_idleInterval);
+        break;
+    case State::PAUSED:
+        director->stopAnimation();
+        break;
+    }
+    if (previous == State::PAUSED) {
+        // 停止期间的时间不计入下一帧的 dt，避免动画和计时跳变
+        director->setNextDeltaTimeZero(true);
+        director->startAnimation();
+    }
+}
+
+void FrameRateManager::accumulateStateTime(Clock::time_point now)
+{
+    _stateSeconds[static_cast<int>(_state)] += std::chrono::duration<double>(now - _stateSince).count();
+    _stateSince = now;
+}
+
+void FrameRateManager::resetMeasure(Clock::time_point now)
+{
+    _measureStart = now;
+    _stateSince = now;
+    _stateSeconds[0] = _stateSeconds[1] = _stateSeconds[2] = 0.0;
+    _frames = 0;
+    _measureCpuUs = ProcessStats::getCpuTimeUs();
+}
+
+void FrameRateManager::report(Clock::time_point now)
+{
+    accumulateStateTime(now);
+    double seconds = std::chrono::duration<double>(now - _measureStart).count();
+    double minutes = seconds / 60.0;
+    uint64_t cpuUs = ProcessStats::getCpuTimeUs() - _measureCpuUs;
+
+    cocos2d::log("FrameRate%s: frames/min=%.0f cpu_ms/min=%.0f active=%.0f%% idle=%.0f%% paused=%.0f%% (%.0f s)",
+        _enabled ? "" : " [fixed]",
+        _frames / minutes,
+        cpuUs / 1000.0 / minutes,
+        _stateSeconds[static_cast<int>(State::ACTIVE)] * 100.0 / seconds,
+        _stateSeconds[static_cast<int>(State::IDLE)] * 100.0 / seconds,
+        _stateSeconds[static_cast<int>(State::PAUSED)] * 100.0 / seconds,
+        seconds);
+
+    resetMeasure(now);
+}
@@ -0,0 +1,101 @@
+#ifndef __FRAME_RATE_MANAGER_H__
+#define __FRAME_RATE_MANAGER_H__
+
+#include "cocos2d.h"
+#include <chrono>
+#include <cstdint>
+
+/**
+ * 帧率管理器（按需渲染）
+ *
+ * 牌局大部分时间是玩家在思考，画面没有任何变化。管理器每帧检查是否有活动：
+ * 动作管理器中有运行的动作、视图调用了 keepAwake（自有补间动画），或收到触摸 / 按键输入。
+ * 最近一次活动后超过 idleDelay 降到空闲帧率，超过 pauseDelay（大于 0 时）停止主循环绘制；
+ * 任何输入或新动画开始（wake）立即恢复满帧率。
+ *
+ * 测量模式下每隔 reportInterval 秒（墙钟）输出每分钟渲染帧数、每分钟 CPU 时间以及各状态的时间占比，
+ * 用于比较按需渲染前后的耗电情况（关闭管理器即固定满帧率）。
+ */
+class FrameRateManager {
+public:
+    enum class State {
+        ACTIVE = 0,      // 满帧率
+        IDLE,            // 空闲帧率
+        PAUSED           // 停止绘制，等待输入
+    };
+
+    static FrameRateManager* getInstance();
+    static void destroyInstance();
+
+    // 注册每帧检查和全局输入监听（Director 创建之后调用）
+    void start();
+    void stop();
+
+    // 关闭时始终保持满帧率（用于对比测量）
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return _enabled; }
+
+    // 满帧率下的帧间隔（默认 1/60）
+    void setActiveInterval(float seconds);
+    float getActiveInterval() const { return _activeInterval; }
+
+    // 空闲帧率下的帧间隔（默认 1/10）
+    void setIdleInterval(float seconds);
+
+    // 最近一次活动后多久进入空闲帧率（秒，默认 0.5）
+    void setIdleDelay(float seconds) { _idleDelay = seconds; }
+
+    // 最近一次活动后多久停止绘制（秒，0 表示不停止，默认 0）
+    void setPauseDelay(float seconds) { _pauseDelay = seconds; }
+
+    // 本帧仍有内容在变化（自有补间动画等），每帧调用
+    void keepAwake() { _awakeRequested = true; }
+
+    // 输入或动画开始：立即恢复满帧率
+    void wake();
+
+    // 测量模式：每 reportInterval 秒输出一次统计
+    void setMeasureEnabled(bool enabled, float reportInterval = 60.0f);
+
+    State getState() const { return _state; }
+
+    // 调度器每帧调用
+    void update(float dt);
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    FrameRateManager();
+    ~FrameRateManager();
+
+    void setState(State state);
+    void accumulateStateTime(Clock::time_point now);
+    void resetMeasure(Clock::time_point now);
+    void report(Clock::time_point now);
+
+    static FrameRateManager* s_instance;
+
+    bool _started;
+    bool _enabled;
+    bool _awakeRequested;
+    State _state;
+    float _activeInterval;
+    float _idleInterval;
+    float _idleDelay;
+    float _pauseDelay;
+    Clock::time_point _lastActivity;
+
+    cocos2d::EventListener* _touchListener;
+    cocos2d::EventListener* _keyboardListener;
+
+    // 测量
+    bool _measuring;
+    float _reportInterval;
+    Clock::time_point _measureStart;
+    Clock::time_point _stateSince;
+    double _stateSeconds[3];
+    uint64_t _frames;
+    uint64_t _measureCpuUs;
+};
+
+#endif // __FRAME_RATE_MANAGER_H__
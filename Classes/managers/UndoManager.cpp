@@ -9,6 +9,12 @@ UndoManager::~UndoManager()
     clear();
 }
 
+void UndoManager::beginLevel(LevelArena* arena, size_t maxActions)
+{
+    resetArenaVector(_undoStack, arena);
+    _undoStack.reserve(maxActions);
+}
+
 void UndoManager::recordAction(const UndoModel& action)
 {
     _undoStack.push_back(action);
@@ -27,5 +33,5 @@ bool UndoManager::popLastAction(UndoModel& outAction)
 
 void UndoManager::clear()
 {
-    _undoStack.clear();
+    resetArenaVector(_undoStack, nullptr);
 }
\ No newline at end of file
@@ -2,18 +2,24 @@
 #define __UNDO_MANAGER_H__
 
 #include "models/UndoModel.h"
+#include "utils/LevelArena.h"
 #include <vector>
 #include <functional>
 
 /**
  * 撤销管理器类
  * 管理所有的撤销操作记录
+ * 撤销栈从关卡级 LevelArena 分配，beginLevel 时按最大步数预留
  */
 class UndoManager {
 public:
     UndoManager();
     ~UndoManager();
     
+    // 开始新关卡：清空记录，改为从 arena 分配并预留 maxActions 条
+    // 每步操作消耗一张主牌区或备用牌堆的牌，撤销栈最多 P + T 条
+    void beginLevel(LevelArena* arena, size_t maxActions);
+    
     // 记录一次操作
     void recordAction(const UndoModel& action);
     
@@ -26,11 +32,11 @@ public:
     // 获取撤销栈大小
     size_t getUndoCount() const { return _undoStack.size(); }
     
-    // 清空所有记录
+    // 清空所有记录，并归还从 arena 分配的内存
     void clear();
 
 private:
-    std::vector<UndoModel> _undoStack;  // 撤销栈
+    ArenaVector<UndoModel> _undoStack;  // 撤销栈
 };
 
 #endif // __UNDO_MANAGER_H__
\ No newline at end of file
@@ -0,0 +1,397 @@
+#include "BoardState.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+
+namespace {
+
+uint64_t splitMix64(uint64_t& state)
+{
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+} // namespace
+
+bool GameMove::parseLog(const std::string& text, std::vector<GameMove>& outMoves, std::string* error)
+{
+    outMoves.clear();
+
+    size_t i = 0;
+    while (i < text.size()) {
+        char c = text[i];
+        if (std::isspace(static_cast<unsigned char>(c)) || c == ',') {
+            i++;
+            continue;
+        }
+
+        if (c == 'F' || c == 'f') {
+            outMoves.push_back(GameMove::flip());
+            i++;
+        }
+        else if (c == 'U' || c == 'u') {
+            outMoves.push_back(GameMove::undo());
+            i++;
+        }
+        else if (c == 'M' || c == 'm') {
+            size_t start = ++i;
+            while (i < text.size() && std::isdigit(static_cast<unsigned char>(text[i]))) {
+                i++;
+            }
+            if (start == i) {
+                if (error) *error = "missing card id after 'M' at offset " + std::to_string(start);
+                return false;
+            }
+            outMoves.push_back(GameMove::match(std::atoi(text.substr(start, i - start).c_str())));
+        }
+        else {
+            if (error) *error = std::string("unexpected '") + c + "' at offset " + std::to_string(i);
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string GameMove::formatLog(const std::vector<GameMove>& moves)
+{
+    std::string text;
+    for (const auto& move : moves) {
+        if (!text.empty()) {
+            text += ' ';
+        }
+        switch (move.type) {
+        case MATCH: text += 'M'; text += std::to_string(move.cardId); break;
+        case FLIP:  text += 'F'; break;
+        case UNDO:  text += 'U'; break;
+        }
+    }
+    return text;
+}
+
+std::shared_ptr<const BoardLayout> BoardLayout::build(const LevelConfig& level)
+{
+    auto layout = std::make_shared<BoardLayout>();
+
+    int playfieldCount = static_cast<int>(level.playfield.size());
+    int stackCount = static_cast<int>(level.stack.size());
+    layout->matchRule = level.matchRule;
+    layout->playfieldCount = playfieldCount;
+    layout->trayCount = stackCount > 0 ? stackCount - 1 : 0;
+
+    layout->codes.reserve(playfieldCount + stackCount);
+    for (const auto& card : level.playfield) {
+        layout->codes.push_back(static_cast<uint8_t>(LevelLayout::makeCardCode(card.face, card.suit)));
+        layout->posX.push_back(card.x);
+        layout->posY.push_back(card.y + LevelLayout::STACK_AREA_HEIGHT);
+    }
+    for (const auto& card : level.stack) {
+        layout->codes.push_back(static_cast<uint8_t>(LevelLayout::makeCardCode(card.face, card.suit)));
+    }
+
+    // 后加入的牌在上方：j > i 且重叠时 j 压住 i
+    layout->coveredBy.resize(playfieldCount);
+    layout->covers.resize(playfieldCount);
+    for (int i = 0; i < playfieldCount; i++) {
+        for (int j = i + 1; j < playfieldCount; j++) {
+            if (BoardLayout::cardsOverlap(layout->posX[i], layout->posY[i], layout->posX[j], layout->posY[j])) {
+                layout->coveredBy[i].push_back(j);
+                layout->covers[j].push_back(i);
+            }
+        }
+    }
+
+    // 固定种子生成 Zobrist 键，保证各平台结果一致
+    uint64_t seed = 0x436172644761LL;
+    layout->liveKeys.resize(playfieldCount);
+    for (auto& key : layout->liveKeys) {
+        key = splitMix64(seed);
+    }
+    layout->trayKeys.resize(layout->trayCount + 1);
+    for (auto& key : layout->trayKeys) {
+        key = splitMix64(seed);
+    }
+    for (auto& key : layout->topKeys) {
+        key = splitMix64(seed);
+    }
+
+    // 顶牌只通过它的匹配行影响之后的走法：匹配行相同的牌码共用一个键，
+    // 例如标准规则下同点数不同花色的顶牌，求解器把这些局面当作同一状态（52 个牌码归为 13 类）
+    const uint64_t* rows = MatchRules::rowsFor(level.matchRule);
+    for (int code = 1; code < LevelLayout::CARD_CODE_COUNT; code++) {
+        for (int rep = 0; rep < code; rep++) {
+            if (rows[rep] == rows[code]) {
+                layout->topKeys[code] = layout->topKeys[rep];
+                break;
+            }
+        }
+    }
+
+    return layout;
+}
+
+BoardState::BoardState()
+    : _matchRows(MatchRules::rowsFor(MatchRuleType::STANDARD))
+    , _liveCount(0)
+    , _trayRemaining(0)
+    , _hash(0)
+{
+}
+
+bool BoardState::init(const LevelConfig& level)
+{
+    if (level.stack.empty()) {
+        return false;
+    }
+    return init(BoardLayout::build(level));
+}
+
+bool BoardState::init(const std::shared_ptr<const BoardLayout>& layout)
+{
+    if (!layout || layout->getCardCount() <= layout->playfieldCount) {
+        return false;
+    }
+
+    _layout = layout;
+    _matchRows = MatchRules::rowsFor(layout->matchRule);
+    int playfieldCount = layout->playfieldCount;
+
+    _live.assign(playfieldCount, 1);
+    _exposed.assign(playfieldCount, 0);
+    _liveCount = playfieldCount;
+    _trayRemaining = layout->trayCount;
+
+    _stack.clear();
+    _stack.reserve(layout->getCardCount());
+    _stack.push_back(layout->getCardCount() - 1);
+
+    _hash = layout->trayKeys[_trayRemaining] ^ layout->topKeys[getTopCode()];
+    for (int i = 0; i < playfieldCount; i++) {
+        _hash ^= layout->liveKeys[i];
+    }
+    for (int i = 0; i < playfieldCount; i++) {
+        _exposed[i] = computeExposed(i) ? 1 : 0;
+    }
+    return true;
+}
+
+int BoardState::getNextTrayCardId() const
+{
+    if (_trayRemaining <= 0) {
+        return -1;
+    }
+    // 备用牌从 Stack 的倒数第二张开始向前翻
+    return _layout->playfieldCount + _trayRemaining - 1;
+}
+
+bool BoardState::canMatch(int cardId) const
+{
+    if (cardId < 0 || cardId >= _layout->playfieldCount) {
+        return false;
+    }
+    return _live[cardId] && _exposed[cardId] && codesMatch(_layout->codes[cardId], getTopCode());
+}
+
+bool BoardState::isDeadEnd() const
+{
+    if (isWon() || canFlip()) {
+        return false;
+    }
+    for (int i = 0; i < _layout->playfieldCount; i++) {
+        if (canMatch(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void BoardState::collectPlayable(std::vector<int>& outCardIds) const
+{
+    outCardIds.clear();
+
+    // 顶牌对应的匹配行只取一次，每个候选一次位测试
+    uint64_t row = _matchRows[getTopCode()];
+    const uint8_t* codes = _layout->codes.data();
+    for (int i = 0; i < _layout->playfieldCount; i++) {
+        if (_live[i] & _exposed[i] & static_cast<uint8_t>(row >> codes[i])) {
+            outCardIds.push_back(i);
+        }
+    }
+}
+
+bool BoardState::applyMatch(int cardId)
+{
+    if (!canMatch(cardId)) {
+        return false;
+    }
+    _hash ^= _layout->topKeys[getTopCode()];
+    removeFromPlayfield(cardId);
+    _stack.push_back(cardId);
+    _hash ^= _layout->topKeys[getTopCode()];
+    return true;
+}
+
+bool BoardState::applyFlip()
+{
+    if (!canFlip()) {
+        return false;
+    }
+    int cardId = getNextTrayCardId();
+    _hash ^= _layout->topKeys[getTopCode()] ^ _layout->trayKeys[_trayRemaining];
+    _trayRemaining--;
+    _stack.push_back(cardId);
+    _hash ^= _layout->topKeys[getTopCode()] ^ _layout->trayKeys[_trayRemaining];
+    return true;
+}
+
+bool BoardState::applyUndo()
+{
+    if (!canUndo()) {
+        return false;
+    }
+    int cardId = _stack.back();
+    _hash ^= _layout->topKeys[getTopCode()];
+    _stack.pop_back();
+
+    if (cardId < _layout->playfieldCount) {
+        // 回退匹配：牌回到主牌区
+        restoreToPlayfield(cardId);
+    }
+    else {
+        // 回退翻牌：牌回到备用牌堆
+        _hash ^= _layout->trayKeys[_trayRemaining];
+        _trayRemaining++;
+        _hash ^= _layout->trayKeys[_trayRemaining];
+    }
+    _hash ^= _layout->topKeys[getTopCode()];
+    return true;
+}
+
+bool BoardState::applyMove(const GameMove& move)
+{
+    switch (move.type) {
+    case GameMove::MATCH: return applyMatch(move.cardId);
+    case GameMove::FLIP:  return applyFlip();
+    case GameMove::UNDO:  return applyUndo();
+    }
+    return false;
+}
+
+int BoardState::replay(const std::vector<GameMove>& moves)
+{
+    int applied = 0;
+    for (const auto& move : moves) {
+        if (!applyMove(move)) {
+            break;
+        }
+        applied++;
+    }
+    return applied;
+}
+
+void BoardState::removeFromPlayfield(int cardId)
+{
+    _live[cardId] = 0;
+    _exposed[cardId] = 0;
+    _liveCount--;
+    _hash ^= _layout->liveKeys[cardId];
+
+    for (int lower : _layout->covers[cardId]) {
+        if (_live[lower] && !_exposed[lower]) {
+            _exposed[lower] = computeExposed(lower) ? 1 : 0;
+        }
+    }
+}
+
+void BoardState::restoreToPlayfield(int cardId)
+{
+    _live[cardId] = 1;
+    _liveCount++;
+    _hash ^= _layout->liveKeys[cardId];
+    _exposed[cardId] = computeExposed(cardId) ? 1 : 0;
+
+    for (int lower : _layout->covers[cardId]) {
+        if (_live[lower] && _exposed[lower]) {
+            _exposed[lower] = computeExposed(lower) ? 1 : 0;
+        }
+    }
+}
+
+bool BoardState::computeExposed(int cardId) const
+{
+    const BoardLayout& layout = *_layout;
+
+    // 只收集仍在场的上方牌
+    float upperX[BoardLayout::MAX_COVERING];
+    float upperY[BoardLayout::MAX_COVERING];
+    int upperCount = 0;
+    for (int upper : layout.coveredBy[cardId]) {
+        if (!_live[upper]) {
+            continue;
+        }
+        if (upperCount == BoardLayout::MAX_COVERING) {
+            return false;
+        }
+        upperX[upperCount] = layout.posX[upper];
+        upperY[upperCount] = layout.posY[upper];
+        upperCount++;
+    }
+    return BoardLayout::isUncovered(layout.posX[cardId], layout.posY[cardId], upperX, upperY, upperCount);
+}
+
+bool BoardLayout::isUncovered(float x, float y, const float* upperX, const float* upperY, int upperCount)
+{
+    if (upperCount == 0) {
+        return true;
+    }
+    if (upperCount > MAX_COVERING) {
+        return false;
+    }
+
+    const float halfW = LevelLayout::CARD_WIDTH * 0.5f;
+    const float halfH = LevelLayout::CARD_HEIGHT * 0.5f;
+
+    float left = x - halfW;
+    float right = x + halfW;
+    float bottom = y - halfH;
+    float top = y + halfH;
+
+    // 将被覆盖区域按上方牌的边界切分成格子，逐格判断是否被盖住
+    float xs[MAX_COVERING * 2 + 2];
+    float ys[MAX_COVERING * 2 + 2];
+    int xCount = 0;
+    int yCount = 0;
+    xs[xCount++] = left;
+    xs[xCount++] = right;
+    ys[yCount++] = bottom;
+    ys[yCount++] = top;
+
+    for (int k = 0; k < upperCount; k++) {
+        xs[xCount++] = std::min(std::max(upperX[k] - halfW, left), right);
+        xs[xCount++] = std::min(std::max(upperX[k] + halfW, left), right);
+        ys[yCount++] = std::min(std::max(upperY[k] - halfH, bottom), top);
+        ys[yCount++] = std::min(std::max(upperY[k] + halfH, bottom), top);
+    }
+
+    std::sort(xs, xs + xCount);
+    std::sort(ys, ys + yCount);
+
+    for (int xi = 0; xi + 1 < xCount; xi++) {
+        if (xs[xi + 1] - xs[xi] <= 0.0f) continue;
+        float cx = (xs[xi] + xs[xi + 1]) * 0.5f;
+        for (int yi = 0; yi + 1 < yCount; yi++) {
+            if (ys[yi + 1] - ys[yi] <= 0.0f) continue;
+            float cy = (ys[yi] + ys[yi + 1]) * 0.5f;
+
+            bool covered = false;
+            for (int k = 0; k < upperCount && !covered; k++) {
+                covered = std::abs(cx - upperX[k]) < halfW && std::abs(cy - upperY[k]) < halfH;
+            }
+            if (!covered) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
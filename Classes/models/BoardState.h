@@ -0,0 +1,153 @@
+#ifndef __BOARD_STATE_H__
+#define __BOARD_STATE_H__
+
+#include "configs/LevelConfig.h"
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * 操作记录（用于回放校验和求解器）
+ * 卡牌ID与 GameController 的编号规则一致：主牌区 0~P-1，其后依次为 Stack 中的牌
+ */
+struct GameMove {
+    enum Type : uint8_t {
+        MATCH = 0,   // 匹配主牌区的牌
+        FLIP,        // 翻备用牌
+        UNDO         // 回退
+    };
+
+    Type type;
+    int cardId;
+
+    GameMove() : type(FLIP), cardId(-1) {}
+    GameMove(Type t, int id) : type(t), cardId(id) {}
+
+    static GameMove match(int cardId) { return GameMove(MATCH, cardId); }
+    static GameMove flip() { return GameMove(FLIP, -1); }
+    static GameMove undo() { return GameMove(UNDO, -1); }
+
+    // 解析文本操作记录，格式如 "M3 F M5 U"（空格或逗号分隔）
+    static bool parseLog(const std::string& text, std::vector<GameMove>& outMoves, std::string* error = nullptr);
+
+    // 输出为文本操作记录
+    static std::string formatLog(const std::vector<GameMove>& moves);
+};
+
+/**
+ * 局面判定（后台分析的结论）
+ */
+enum class PositionStatus : uint8_t {
+    UNKNOWN = 0,     // 未分析完或超出预算
+    WINNABLE,        // 仍可通关
+    LOST             // 无论怎么走都无法通关
+};
+
+/**
+ * 关卡的静态布局数据（构建后只读，可在多个 BoardState 间共享）
+ */
+struct BoardLayout {
+    MatchRuleType matchRule;                    // 匹配规则
+    int playfieldCount;                         // 主牌区数量 P
+    int trayCount;                              // 备用牌堆数量 T
+    std::vector<uint8_t> codes;                 // 每张牌的牌码（按卡牌ID）
+    std::vector<float> posX;                    // 主牌区卡牌位置（已加堆牌区高度）
+    std::vector<float> posY;
+    std::vector<std::vector<int>> coveredBy;    // 压在该牌上方且有重叠的牌
+    std::vector<std::vector<int>> covers;       // 该牌压住的下方的牌
+    std::vector<uint64_t> liveKeys;             // Zobrist 哈希键
+    std::vector<uint64_t> trayKeys;
+    uint64_t topKeys[LevelLayout::CARD_CODE_COUNT];  // 匹配行相同的牌码共用一个键
+
+    BoardLayout() : matchRule(MatchRuleType::STANDARD), playfieldCount(0), trayCount(0), topKeys() {}
+
+    int getCardCount() const { return static_cast<int>(codes.size()); }
+
+    // 由关卡配置构建布局（配置需已通过 LevelConfigLoader::validate）
+    static std::shared_ptr<const BoardLayout> build(const LevelConfig& level);
+
+    // 两张牌（中心点坐标）是否有面积重叠
+    static bool cardsOverlap(float ax, float ay, float bx, float by)
+    {
+        return std::abs(ax - bx) < LevelLayout::CARD_WIDTH && std::abs(ay - by) < LevelLayout::CARD_HEIGHT;
+    }
+
+    // 遮挡判断：中心点 (x, y) 的牌是否未被给定的上方牌（中心点坐标）完全盖住
+    // 上方牌超过 MAX_COVERING 张时保守地认为被盖住
+    static const int MAX_COVERING = 64;
+    static bool isUncovered(float x, float y, const float* upperX, const float* upperY, int upperCount);
+};
+
+/**
+ * 无界面的棋盘状态
+ * 实现与客户端一致的规则（匹配、翻牌、回退、遮挡），供求解器、校验服务等复用
+ *
+ * 遮挡规则：主牌区中后加入的牌绘制在上方，一张牌被上方仍在场的牌完全盖住时不可点击
+ */
+class BoardState {
+public:
+    BoardState();
+
+    bool init(const LevelConfig& level);
+    bool init(const std::shared_ptr<const BoardLayout>& layout);
+
+    const BoardLayout& getLayout() const { return *_layout; }
+    const std::shared_ptr<const BoardLayout>& getLayoutPtr() const { return _layout; }
+
+    // 主牌区状态
+    int getPlayfieldCount() const { return _layout->playfieldCount; }
+    int getLiveCount() const { return _liveCount; }
+    bool isLive(int cardId) const { return _live[cardId] != 0; }
+    bool isExposed(int cardId) const { return _exposed[cardId] != 0; }
+
+    // 底牌堆与备用牌堆状态
+    int getTopCardId() const { return _stack.back(); }
+    int getTopCode() const { return _layout->codes[_stack.back()]; }
+    int getStackSize() const { return static_cast<int>(_stack.size()); }
+    const std::vector<int>& getStack() const { return _stack; }
+    int getTrayRemaining() const { return _trayRemaining; }
+    int getNextTrayCardId() const;
+
+    // 规则判断（按关卡规则查匹配位表）
+    bool codesMatch(int codeA, int codeB) const { return ((_matchRows[codeA] >> codeB) & 1) != 0; }
+    uint64_t getMatchRow(int code) const { return _matchRows[code]; }
+    bool canMatch(int cardId) const;
+    bool canFlip() const { return _trayRemaining > 0; }
+    bool canUndo() const { return _stack.size() > 1; }
+    bool isWon() const { return _liveCount == 0; }
+    bool isDeadEnd() const;
+
+    // 收集当前可匹配的主牌区卡牌（提示）
+    void collectPlayable(std::vector<int>& outCardIds) const;
+
+    // 执行操作，非法操作返回 false 且不改变状态
+    bool applyMatch(int cardId);
+    bool applyFlip();
+    bool applyUndo();
+    bool applyMove(const GameMove& move);
+
+    // 回放操作记录，返回成功执行的步数；遇到非法操作时停止
+    int replay(const std::vector<GameMove>& moves);
+
+    // 求解用状态哈希（主牌区存活集合 + 备用牌剩余数 + 顶牌的匹配类）
+    // 顶牌匹配行相同的局面哈希相同，它们能否通关、还能走几步都一样
+    uint64_t getStateHash() const { return _hash; }
+
+private:
+    void removeFromPlayfield(int cardId);
+    void restoreToPlayfield(int cardId);
+    bool computeExposed(int cardId) const;
+
+    std::shared_ptr<const BoardLayout> _layout;
+    const uint64_t* _matchRows;       // 当前规则的匹配位表
+    std::vector<uint8_t> _live;       // 主牌区是否在场
+    std::vector<uint8_t> _exposed;    // 主牌区是否可点击
+    std::vector<int> _stack;          // 底牌堆（卡牌ID）
+    int _liveCount;
+    int _trayRemaining;
+    uint64_t _hash;
+};
+
+#endif // __BOARD_STATE_H__
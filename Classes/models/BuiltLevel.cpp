@@ -0,0 +1,65 @@
+#include "BuiltLevel.h"
+#include "configs/LevelConfigLoader.h"
+
+namespace {
+
+void setError(std::string* error, const char* message)
+{
+    if (error) {
+        *error = message;
+    }
+}
+
+CardModel makeCard(int id, const LevelCardConfig& cardData, const cocos2d::Vec2& pos)
+{
+    return CardModel(id,
+        static_cast<CardFaceType>(cardData.face),
+        static_cast<CardSuitType>(cardData.suit),
+        pos);
+}
+
+} // namespace
+
+std::shared_ptr<const BuiltLevel> BuiltLevel::build(const char* data, size_t size, std::string* error)
+{
+    LevelConfig level;
+    if (!LevelConfigLoader::loadFromBuffer(data, size, level, error)) {
+        return nullptr;
+    }
+    if (level.stack.empty()) {
+        setError(error, "level has no stack cards");
+        return nullptr;
+    }
+    return build(level);
+}
+
+std::shared_ptr<const BuiltLevel> BuiltLevel::build(const LevelConfig& level)
+{
+    if (level.stack.empty()) {
+        return nullptr;
+    }
+
+    auto built = std::make_shared<BuiltLevel>();
+    built->layout = BoardLayout::build(level);
+
+    int nextCardId = 0;
+
+    // 主牌区的y坐标需要加上堆牌区高度（与 layout 中的位置一致）
+    built->playfield.reserve(level.playfield.size());
+    for (const auto& cardData : level.playfield) {
+        cocos2d::Vec2 pos(cardData.x, cardData.y + LevelLayout::STACK_AREA_HEIGHT);
+        built->playfield.push_back(makeCard(nextCardId++, cardData, pos));
+    }
+
+    // Stack中的牌：最后一张是底牌堆顶牌，前面的是备用牌
+    cocos2d::Vec2 stackPos(LevelLayout::STACK_POS_X, LevelLayout::STACK_POS_Y);
+    cocos2d::Vec2 trayPos(LevelLayout::TRAY_POS_X, LevelLayout::TRAY_POS_Y);
+    size_t trayCount = level.stack.size() - 1;
+    built->tray.reserve(trayCount);
+    for (size_t i = 0; i < trayCount; i++) {
+        built->tray.push_back(makeCard(nextCardId++, level.stack[i], trayPos));
+    }
+    built->stackTop = makeCard(nextCardId++, level.stack.back(), stackPos);
+
+    return built;
+}
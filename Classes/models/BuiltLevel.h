@@ -0,0 +1,32 @@
+#ifndef __BUILT_LEVEL_H__
+#define __BUILT_LEVEL_H__
+
+#include "models/BoardState.h"
+#include "models/CardModel.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * 构建完成的关卡（构建后只读）
+ * 解析、卡牌构造和遮挡计算都在 build 中完成，不访问 cocos 对象，可以在工作线程执行；
+ * 主线程只需按顺序把卡牌填入 GameModel，遮挡关系直接取自 layout，不再两两比较位置。
+ *
+ * 卡牌ID与 GameController 的编号规则一致：主牌区 0~P-1，其后依次为备用牌和底牌堆顶牌
+ */
+struct BuiltLevel {
+    std::shared_ptr<const BoardLayout> layout;  // 牌码、位置、遮挡关系（可与 BoardState、求解器共用）
+    std::vector<CardModel> playfield;           // 主牌区（位置已加堆牌区高度）
+    std::vector<CardModel> tray;                // 备用牌堆（自底向上）
+    CardModel stackTop;                         // 底牌堆顶牌
+
+    int getCardCount() const { return static_cast<int>(playfield.size() + tray.size()) + 1; }
+
+    // 从内存构建（JSON、二进制关卡或发牌描述），失败时返回空
+    static std::shared_ptr<const BuiltLevel> build(const char* data, size_t size, std::string* error = nullptr);
+
+    // 由已通过校验的关卡配置构建
+    static std::shared_ptr<const BuiltLevel> build(const LevelConfig& level);
+};
+
+#endif // __BUILT_LEVEL_H__
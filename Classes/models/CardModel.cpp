@@ -1,5 +1,4 @@
 #include "CardModel.h"
-#include <cmath>
 
 CardModel::CardModel()
     : _id(-1)
@@ -19,9 +18,8 @@ CardModel::CardModel(int id, CardFaceType face, CardSuitType suit, const cocos2d
 {
 }
 
-bool CardModel::canMatch(const CardModel& other) const
+bool CardModel::canMatch(const CardModel& other, MatchRuleType rule) const
 {
-    int diff = std::abs(this->getFaceValue() - other.getFaceValue());
-    // 点数相差1可以匹配，或者 K(12) 和 A(0) 也可以匹配
-    return (diff == 1) || (diff == 12);
+    // 各规则的匹配关系已在编译期展开为 52×52 位表
+    return (MatchRules::rowsFor(rule)[getCardCode()] >> other.getCardCode()) & 1;
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define __CARD_MODEL_H__
 
 #include "cocos2d.h"
+#include "MatchRules.h"
 
 /**
  * 花色类型枚举
@@ -58,14 +59,19 @@ public:
     void setOriginalPosition(const cocos2d::Vec2& pos) { _originalPosition = pos; }
     
     /**
-     * 判断两张牌是否可以匹配（点数相差1）
+     * 判断两张牌是否可以匹配（默认为标准规则：点数相差1，K 与 A 相连）
      */
-    bool canMatch(const CardModel& other) const;
+    bool canMatch(const CardModel& other, MatchRuleType rule = MatchRuleType::STANDARD) const;
     
     /**
      * 获取牌面数值（用于匹配判断）
      */
     int getFaceValue() const { return static_cast<int>(_face); }
+    
+    /**
+     * 获取牌码（花色 * 13 + 牌面），用于查匹配表
+     */
+    int getCardCode() const { return static_cast<int>(_suit) * MatchRules::FACE_COUNT + static_cast<int>(_face); }
 
 private:
     int _id;                           // 卡牌唯一ID
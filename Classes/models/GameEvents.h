@@ -0,0 +1,63 @@
+#ifndef __GAME_EVENTS_H__
+#define __GAME_EVENTS_H__
+
+#include "cocos2d.h"
+#include "BoardState.h"
+#include "utils/EventBus.h"
+
+/**
+ * 控制器与视图之间的事件
+ * 均为平凡数据，通过 GameEventBus 派发，不分配内存
+ */
+
+// 点击主牌区卡牌
+struct CardClickedEvent {
+    int cardId;
+    explicit CardClickedEvent(int id) : cardId(id) {}
+};
+
+// 点击备用牌堆
+struct TrayClickedEvent {
+};
+
+// 点击回退按钮
+struct UndoClickedEvent {
+};
+
+/**
+ * 卡牌移动动画的类型
+ */
+enum class AnimationKind : uint8_t {
+    MATCH = 0,       // 主牌区的牌移到底牌堆
+    FLIP_TRAY,       // 备用牌移到底牌堆
+    UNDO_MATCH,      // 回退匹配：底牌堆的牌回到主牌区
+    UNDO_FLIP        // 回退翻牌：底牌堆的牌回到备用牌堆
+};
+
+// 卡牌移动动画结束（视图 → 控制器）
+struct AnimationDoneEvent {
+    int cardId;
+    AnimationKind kind;
+    cocos2d::Vec2 targetPos;
+
+    AnimationDoneEvent(int id, AnimationKind k, const cocos2d::Vec2& pos) : cardId(id), kind(k), targetPos(pos) {}
+};
+
+// 一步操作已写入数据模型（控制器 → 其他订阅者）
+struct MoveCommittedEvent {
+    GameMove move;
+    explicit MoveCommittedEvent(const GameMove& m) : move(m) {}
+};
+
+// 后台分析得出当前局面的结论（控制器 → 视图等订阅者）
+struct PositionAnalyzedEvent {
+    PositionStatus status;
+    int movesLeft;           // LOST 时最多还能走几步
+
+    PositionAnalyzedEvent(PositionStatus s, int moves) : status(s), movesLeft(moves) {}
+};
+
+typedef EventBus<CardClickedEvent, TrayClickedEvent, UndoClickedEvent, AnimationDoneEvent, MoveCommittedEvent,
+                 PositionAnalyzedEvent> GameEventBus;
+
+#endif // __GAME_EVENTS_H__
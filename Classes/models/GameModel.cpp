@@ -1,6 +1,17 @@
 #include "GameModel.h"
+#include "BoardState.h"
+
+CardModel GameModel::PlayfieldCard::toCardModel() const
+{
+    CardModel card(getId(), getFace(), getSuit(), getPosition());
+    card.setOriginalPosition(getOriginalPosition());
+    return card;
+}
 
 GameModel::GameModel()
+    : _arena(nullptr)
+    , _playfieldLiveCount(0)
+    , _matchRule(MatchRuleType::STANDARD)
 {
 }
 
@@ -9,6 +20,52 @@ GameModel::~GameModel()
     clear();
 }
 
+void GameModel::beginLevel(LevelArena* arena, int playfieldCount, int trayCount)
+{
+    clear();
+    _arena = arena;
+
+    resetArenaVector(_playfieldCodes, arena);
+    resetArenaVector(_playfieldLive, arena);
+    resetArenaVector(_playfieldExposed, arena);
+    resetArenaVector(_playfieldIds, arena);
+    resetArenaVector(_playfieldPositions, arena);
+    resetArenaVector(_playfieldOriginalPositions, arena);
+    resetArenaVector(_playfieldViewHandles, arena);
+    resetArenaVector(_playfieldCoveredBy, arena);
+    resetArenaVector(_playfieldCovers, arena);
+    resetArenaVector(_stackCards, arena);
+    resetArenaVector(_trayCards, arena);
+
+    size_t playfield = static_cast<size_t>(playfieldCount);
+    _playfieldCodes.reserve(playfield);
+    _playfieldLive.reserve(playfield);
+    _playfieldExposed.reserve(playfield);
+    _playfieldIds.reserve(playfield);
+    _playfieldPositions.reserve(playfield);
+    _playfieldOriginalPositions.reserve(playfield);
+    _playfieldViewHandles.reserve(playfield);
+    _playfieldCoveredBy.reserve(playfield);
+    _playfieldCovers.reserve(playfield);
+    _stackCards.reserve(static_cast<size_t>(1 + playfieldCount + trayCount));
+    _trayCards.reserve(static_cast<size_t>(trayCount));
+}
+
+int GameModel::findPlayfieldSlot(int cardId) const
+{
+    // 主牌区卡牌ID按加载顺序从 0 编号，通常与槽位相同
+    int count = getPlayfieldSlotCount();
+    if (cardId >= 0 && cardId < count && _playfieldIds[cardId] == cardId) {
+        return cardId;
+    }
+    for (int slot = 0; slot < count; slot++) {
+        if (_playfieldIds[slot] == cardId) {
+            return slot;
+        }
+    }
+    return -1;
+}
+
 CardModel* GameModel::getTopStackCard()
 {
     if (_stackCards.empty()) {
@@ -17,9 +74,83 @@ CardModel* GameModel::getTopStackCard()
     return &_stackCards.back();
 }
 
+bool GameModel::canMatchTop(int slot) const
+{
+    if (slot < 0 || slot >= getPlayfieldSlotCount() || _stackCards.empty()) {
+        return false;
+    }
+    uint64_t row = MatchRules::rowsFor(_matchRule)[_stackCards.back().getCardCode()];
+    return _playfieldLive[slot] && _playfieldExposed[slot] && ((row >> _playfieldCodes[slot]) & 1);
+}
+
+void GameModel::collectPlayableSlots(std::vector<int>& outSlots) const
+{
+    outSlots.clear();
+    if (_stackCards.empty()) {
+        return;
+    }
+
+    // 只扫描热数据：顶牌的匹配行取一次，每个槽位一次位测试
+    uint64_t row = MatchRules::rowsFor(_matchRule)[_stackCards.back().getCardCode()];
+    const uint8_t* codes = _playfieldCodes.data();
+    const uint8_t* live = _playfieldLive.data();
+    const uint8_t* exposed = _playfieldExposed.data();
+    int count = getPlayfieldSlotCount();
+    for (int slot = 0; slot < count; slot++) {
+        if (live[slot] & exposed[slot] & static_cast<uint8_t>(row >> codes[slot])) {
+            outSlots.push_back(slot);
+        }
+    }
+}
+
 void GameModel::addPlayfieldCard(const CardModel& card)
 {
-    _playfieldCards.push_back(card);
+    int slot = appendPlayfieldSlot(card);
+    const cocos2d::Vec2& origin = _playfieldOriginalPositions[slot];
+
+    // 后加入的牌在上方，更新与之前各牌的遮挡关系
+    for (int lower = 0; lower < slot; lower++) {
+        const cocos2d::Vec2& lowerPos = _playfieldOriginalPositions[lower];
+        if (BoardLayout::cardsOverlap(lowerPos.x, lowerPos.y, origin.x, origin.y)) {
+            linkCover(lower, slot);
+        }
+    }
+}
+
+void GameModel::addPlayfieldCard(const CardModel& card, const std::vector<int>& covers)
+{
+    int slot = appendPlayfieldSlot(card);
+    for (int lower : covers) {
+        linkCover(lower, slot);
+    }
+}
+
+int GameModel::appendPlayfieldSlot(const CardModel& card)
+{
+    int slot = getPlayfieldSlotCount();
+
+    _playfieldCodes.push_back(static_cast<uint8_t>(card.getCardCode()));
+    _playfieldLive.push_back(1);
+    _playfieldExposed.push_back(1);
+    _playfieldLiveCount++;
+
+    _playfieldIds.push_back(card.getId());
+    _playfieldPositions.push_back(card.getPosition());
+    _playfieldOriginalPositions.push_back(card.getOriginalPosition());
+    _playfieldViewHandles.push_back(nullptr);
+    _playfieldCoveredBy.emplace_back(ArenaAllocator<int>(_arena));
+    _playfieldCovers.emplace_back(ArenaAllocator<int>(_arena));
+
+    return slot;
+}
+
+void GameModel::linkCover(int lower, int upper)
+{
+    _playfieldCoveredBy[lower].push_back(upper);
+    _playfieldCovers[upper].push_back(lower);
+    if (_playfieldLive[lower] && _playfieldExposed[lower]) {
+        updateExposed(lower);
+    }
 }
 
 void GameModel::addStackCard(const CardModel& card)
@@ -34,13 +165,66 @@ void GameModel::addTrayCard(const CardModel& card)
 
 bool GameModel::removePlayfieldCard(int cardId)
 {
-    for (auto it = _playfieldCards.begin(); it != _playfieldCards.end(); ++it) {
-        if (it->getId() == cardId) {
-            _playfieldCards.erase(it);
-            return true;
+    int slot = findPlayfieldSlot(cardId);
+    if (slot < 0 || !_playfieldLive[slot]) {
+        return false;
+    }
+
+    _playfieldLive[slot] = 0;
+    _playfieldExposed[slot] = 0;
+    _playfieldLiveCount--;
+
+    // 下方被它盖住的牌可能露出
+    for (int lower : _playfieldCovers[slot]) {
+        if (_playfieldLive[lower] && !_playfieldExposed[lower]) {
+            updateExposed(lower);
         }
     }
-    return false;
+    return true;
+}
+
+bool GameModel::restorePlayfieldCard(int cardId, const cocos2d::Vec2& pos)
+{
+    int slot = findPlayfieldSlot(cardId);
+    if (slot < 0 || _playfieldLive[slot]) {
+        return false;
+    }
+
+    _playfieldLive[slot] = 1;
+    _playfieldLiveCount++;
+    _playfieldPositions[slot] = pos;
+    updateExposed(slot);
+
+    // 下方的牌可能重新被盖住
+    for (int lower : _playfieldCovers[slot]) {
+        if (_playfieldLive[lower] && _playfieldExposed[lower]) {
+            updateExposed(lower);
+        }
+    }
+    return true;
+}
+
+void GameModel::updateExposed(int slot)
+{
+    // 遮挡关系按关卡中的原始位置计算，与 BoardState 保持一致
+    float upperX[BoardLayout::MAX_COVERING];
+    float upperY[BoardLayout::MAX_COVERING];
+    int upperCount = 0;
+    for (int upper : _playfieldCoveredBy[slot]) {
+        if (!_playfieldLive[upper]) {
+            continue;
+        }
+        if (upperCount == BoardLayout::MAX_COVERING) {
+            _playfieldExposed[slot] = 0;
+            return;
+        }
+        upperX[upperCount] = _playfieldOriginalPositions[upper].x;
+        upperY[upperCount] = _playfieldOriginalPositions[upper].y;
+        upperCount++;
+    }
+
+    const cocos2d::Vec2& pos = _playfieldOriginalPositions[slot];
+    _playfieldExposed[slot] = BoardLayout::isUncovered(pos.x, pos.y, upperX, upperY, upperCount) ? 1 : 0;
 }
 
 CardModel* GameModel::popTrayCard()
@@ -56,7 +240,19 @@ CardModel* GameModel::popTrayCard()
 
 void GameModel::clear()
 {
-    _playfieldCards.clear();
-    _stackCards.clear();
-    _trayCards.clear();
-}
\ No newline at end of file
+    // 换成未绑定分配器的空容器，不再引用 arena 中的内存
+    resetArenaVector(_playfieldCodes, nullptr);
+    resetArenaVector(_playfieldLive, nullptr);
+    resetArenaVector(_playfieldExposed, nullptr);
+    _playfieldLiveCount = 0;
+    resetArenaVector(_playfieldIds, nullptr);
+    resetArenaVector(_playfieldPositions, nullptr);
+    resetArenaVector(_playfieldOriginalPositions, nullptr);
+    resetArenaVector(_playfieldViewHandles, nullptr);
+    resetArenaVector(_playfieldCoveredBy, nullptr);
+    resetArenaVector(_playfieldCovers, nullptr);
+    resetArenaVector(_stackCards, nullptr);
+    resetArenaVector(_trayCards, nullptr);
+    _arena = nullptr;
+    _matchRule = MatchRuleType::STANDARD;
+}
@@ -2,50 +2,203 @@
 #define __GAME_MODEL_H__
 
 #include "CardModel.h"
+#include "utils/LevelArena.h"
+#include <cstdint>
+#include <iterator>
 #include <vector>
 
 /**
  * 游戏数据模型类
  * 存储整个游戏的状态数据
+ *
+ * 主牌区按结构数组存放：规则判断只读取热数据（牌码、在场、可点击），
+ * 位置和视图句柄等冷数据单独存放，遍历匹配时不会被带进缓存。
+ * 槽位在关卡加载时固定，移除只标记不在场，回退时恢复到原槽位。
+ *
+ * 各数组从关卡级 LevelArena 分配，beginLevel 时按最大容量预留，关卡进行中不再分配。
  */
 class GameModel {
 public:
+    /**
+     * 主牌区单张牌的只读视图（按槽位读取结构数组）
+     */
+    class PlayfieldCard {
+    public:
+        PlayfieldCard(const GameModel* model, int slot) : _model(model), _slot(slot) {}
+
+        int getSlot() const { return _slot; }
+        int getId() const { return _model->_playfieldIds[_slot]; }
+        int getCardCode() const { return _model->_playfieldCodes[_slot]; }
+        CardFaceType getFace() const { return static_cast<CardFaceType>(MatchRules::faceOf(getCardCode())); }
+        CardSuitType getSuit() const { return static_cast<CardSuitType>(MatchRules::suitOf(getCardCode())); }
+        int getFaceValue() const { return MatchRules::faceOf(getCardCode()); }
+        bool isLive() const { return _model->_playfieldLive[_slot] != 0; }
+        bool isExposed() const { return _model->_playfieldExposed[_slot] != 0; }
+        cocos2d::Vec2 getPosition() const { return _model->_playfieldPositions[_slot]; }
+        cocos2d::Vec2 getOriginalPosition() const { return _model->_playfieldOriginalPositions[_slot]; }
+
+        // 与 CardModel::canMatch 相同的规则判断
+        bool canMatch(const CardModel& other, MatchRuleType rule = MatchRuleType::STANDARD) const
+        {
+            return (MatchRules::rowsFor(rule)[getCardCode()] >> other.getCardCode()) & 1;
+        }
+
+        // 拷贝为独立的 CardModel（用于视图创建、移入底牌堆等）
+        CardModel toCardModel() const;
+
+    private:
+        const GameModel* _model;
+        int _slot;
+    };
+
+    /**
+     * 主牌区在场牌的遍历区间（跳过已移除的槽位）
+     * 解引用得到 PlayfieldCard 值，遍历时写作 for (const auto& card : ...)
+     */
+    class PlayfieldRange {
+    public:
+        class iterator {
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef PlayfieldCard value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef void pointer;
+            typedef PlayfieldCard reference;
+
+            iterator(const GameModel* model, int slot) : _model(model), _slot(slot) { skipDead(); }
+
+            PlayfieldCard operator*() const { return PlayfieldCard(_model, _slot); }
+            iterator& operator++() { _slot++; skipDead(); return *this; }
+            iterator operator++(int) { iterator old = *this; ++(*this); return old; }
+            bool operator==(const iterator& other) const { return _slot == other._slot; }
+            bool operator!=(const iterator& other) const { return _slot != other._slot; }
+
+        private:
+            void skipDead()
+            {
+                int count = _model->getPlayfieldSlotCount();
+                while (_slot < count && !_model->_playfieldLive[_slot]) {
+                    _slot++;
+                }
+            }
+
+            const GameModel* _model;
+            int _slot;
+        };
+
+        explicit PlayfieldRange(const GameModel* model) : _model(model) {}
+
+        iterator begin() const { return iterator(_model, 0); }
+        iterator end() const { return iterator(_model, _model->getPlayfieldSlotCount()); }
+        size_t size() const { return static_cast<size_t>(_model->_playfieldLiveCount); }
+        bool empty() const { return _model->_playfieldLiveCount == 0; }
+
+    private:
+        const GameModel* _model;
+    };
+
     GameModel();
     ~GameModel();
-    
-    // 主牌区的牌（桌面上的牌）
-    std::vector<CardModel>& getPlayfieldCards() { return _playfieldCards; }
-    const std::vector<CardModel>& getPlayfieldCards() const { return _playfieldCards; }
-    
+
+    // 开始新关卡：清空数据，改为从 arena 分配并按关卡规模预留容量
+    // 底牌堆最多 1 + P + T 张，备用牌堆最多 T 张
+    void beginLevel(LevelArena* arena, int playfieldCount, int trayCount);
+
+    // 主牌区的牌（桌面上仍在场的牌）
+    PlayfieldRange getPlayfieldCards() const { return PlayfieldRange(this); }
+
+    // 主牌区槽位数（含已移除的槽位），槽位与加载顺序一致
+    int getPlayfieldSlotCount() const { return static_cast<int>(_playfieldCodes.size()); }
+
+    // 按卡牌ID查找槽位，不存在返回 -1
+    int findPlayfieldSlot(int cardId) const;
+
+    // 按槽位访问主牌区的牌
+    PlayfieldCard getPlayfieldCard(int slot) const { return PlayfieldCard(this, slot); }
+    bool isPlayfieldCardLive(int slot) const { return _playfieldLive[slot] != 0; }
+    bool isPlayfieldCardExposed(int slot) const { return _playfieldExposed[slot] != 0; }
+
+    // 热数据（按槽位排列，供批量扫描）
+    const uint8_t* getPlayfieldCodes() const { return _playfieldCodes.data(); }
+    const uint8_t* getPlayfieldLiveFlags() const { return _playfieldLive.data(); }
+    const uint8_t* getPlayfieldExposedFlags() const { return _playfieldExposed.data(); }
+
+    // 更新主牌区卡牌位置（冷数据）
+    void setPlayfieldPosition(int slot, const cocos2d::Vec2& pos) { _playfieldPositions[slot] = pos; }
+
+    // 视图句柄（由视图层设置，模型不解释其含义）
+    void setPlayfieldViewHandle(int slot, void* handle) { _playfieldViewHandles[slot] = handle; }
+    void* getPlayfieldViewHandle(int slot) const { return _playfieldViewHandles[slot]; }
+
     // 底牌堆（手牌区顶部的牌）
-    std::vector<CardModel>& getStackCards() { return _stackCards; }
-    const std::vector<CardModel>& getStackCards() const { return _stackCards; }
-    
+    ArenaVector<CardModel>& getStackCards() { return _stackCards; }
+    const ArenaVector<CardModel>& getStackCards() const { return _stackCards; }
+
     // 备用牌堆（手牌区可以翻的牌）
-    std::vector<CardModel>& getTrayCards() { return _trayCards; }
-    const std::vector<CardModel>& getTrayCards() const { return _trayCards; }
-    
+    ArenaVector<CardModel>& getTrayCards() { return _trayCards; }
+    const ArenaVector<CardModel>& getTrayCards() const { return _trayCards; }
+
     // 获取底牌堆顶部的牌
     CardModel* getTopStackCard();
-    
+
+    // 关卡匹配规则
+    MatchRuleType getMatchRule() const { return _matchRule; }
+    void setMatchRule(MatchRuleType rule) { _matchRule = rule; }
+
+    // 主牌区指定槽位的牌是否在场、可点击且能与底牌堆顶牌匹配
+    bool canMatchTop(int slot) const;
+
+    // 收集当前可与顶牌匹配的主牌区槽位（提示、自动操作）
+    void collectPlayableSlots(std::vector<int>& outSlots) const;
+
     // 添加牌到各个区域
     void addPlayfieldCard(const CardModel& card);
+    // covers 为该牌压住的下方槽位（升序，来自 BoardLayout::covers），不再逐个比较位置
+    void addPlayfieldCard(const CardModel& card, const std::vector<int>& covers);
     void addStackCard(const CardModel& card);
     void addTrayCard(const CardModel& card);
-    
-    // 从主牌区移除牌
+
+    // 从主牌区移除牌（槽位保留，标记为不在场）
     bool removePlayfieldCard(int cardId);
-    
+
+    // 将移除的牌恢复到原槽位（回退）
+    bool restorePlayfieldCard(int cardId, const cocos2d::Vec2& pos);
+
     // 从备用牌堆移除顶部牌
     CardModel* popTrayCard();
-    
-    // 清空所有数据
+
+    // 清空所有数据，并归还从 arena 分配的内存（之后可安全释放 arena）
     void clear();
 
 private:
-    std::vector<CardModel> _playfieldCards;  // 主牌区
-    std::vector<CardModel> _stackCards;       // 底牌堆
-    std::vector<CardModel> _trayCards;        // 备用牌堆
+    // 追加一个主牌区槽位（尚未建立遮挡关系），返回槽位
+    int appendPlayfieldSlot(const CardModel& card);
+
+    // 记录 upper 压住 lower
+    void linkCover(int lower, int upper);
+
+    // 重新计算某槽位是否可点击（只在移除、恢复时调用）
+    void updateExposed(int slot);
+
+    LevelArena* _arena;                       // 当前关卡的分配器
+
+    // 主牌区热数据
+    ArenaVector<uint8_t> _playfieldCodes;                        // 牌码（花色 * 13 + 牌面）
+    ArenaVector<uint8_t> _playfieldLive;                         // 是否在场
+    ArenaVector<uint8_t> _playfieldExposed;                      // 是否可点击（未被完全盖住）
+    int _playfieldLiveCount;
+
+    // 主牌区冷数据
+    ArenaVector<int> _playfieldIds;                              // 卡牌ID
+    ArenaVector<cocos2d::Vec2> _playfieldPositions;              // 当前位置
+    ArenaVector<cocos2d::Vec2> _playfieldOriginalPositions;      // 原始位置
+    ArenaVector<void*> _playfieldViewHandles;                    // 视图句柄
+    ArenaVector<ArenaVector<int>> _playfieldCoveredBy;           // 压在上方且有重叠的槽位
+    ArenaVector<ArenaVector<int>> _playfieldCovers;              // 压住的下方槽位
+
+    ArenaVector<CardModel> _stackCards;       // 底牌堆
+    ArenaVector<CardModel> _trayCards;        // 备用牌堆
+    MatchRuleType _matchRule;                 // 匹配规则
 };
 
-#endif // __GAME_MODEL_H__
\ No newline at end of file
+#endif // __GAME_MODEL_H__
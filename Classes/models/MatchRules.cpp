@@ -0,0 +1,39 @@
+#include "MatchRules.h"
+#include <cstring>
+
+namespace MatchRules {
+
+namespace {
+
+const char* const RULE_NAMES[] = {
+    "standard",
+    "no_wrap",
+    "same_color",
+    "same_suit",
+    "one_or_two",
+    "wild"
+};
+
+} // namespace
+
+const char* ruleName(MatchRuleType rule)
+{
+    int index = static_cast<int>(rule);
+    if (index < 0 || index >= static_cast<int>(MatchRuleType::COUNT)) {
+        return RULE_NAMES[0];
+    }
+    return RULE_NAMES[index];
+}
+
+bool parseRuleName(const char* name, MatchRuleType& outRule)
+{
+    for (int i = 0; i < static_cast<int>(MatchRuleType::COUNT); i++) {
+        if (std::strcmp(name, RULE_NAMES[i]) == 0) {
+            outRule = static_cast<MatchRuleType>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace MatchRules
@@ -0,0 +1,139 @@
+#ifndef __MATCH_RULES_H__
+#define __MATCH_RULES_H__
+
+#include <cstdint>
+
+/**
+ * 关卡匹配规则
+ */
+enum class MatchRuleType : uint8_t {
+    STANDARD = 0,    // 点数相差1，K 与 A 可相连
+    NO_WRAP,         // 点数相差1，K 与 A 不相连
+    SAME_COLOR,      // 标准规则，且颜色相同
+    SAME_SUIT,       // 标准规则，且花色相同
+    ONE_OR_TWO,      // 点数相差1或2（K 与 A 相连）
+    WILD,            // 标准规则，J 为万能牌
+    COUNT
+};
+
+namespace MatchRules {
+
+const int FACE_COUNT = 13;
+const int CARD_CODE_COUNT = 52;   // 牌码 = 花色 * 13 + 牌面
+const int WILD_FACE = 10;         // 万能牌：J
+
+constexpr int faceOf(int code) { return code % FACE_COUNT; }
+constexpr int suitOf(int code) { return code / FACE_COUNT; }
+constexpr bool isRed(int code) { return suitOf(code) == 1 || suitOf(code) == 2; }
+constexpr int faceDiff(int a, int b) { return faceOf(a) > faceOf(b) ? faceOf(a) - faceOf(b) : faceOf(b) - faceOf(a); }
+constexpr int circularDiff(int a, int b) { return faceDiff(a, b) * 2 > FACE_COUNT ? FACE_COUNT - faceDiff(a, b) : faceDiff(a, b); }
+
+/**
+ * 各规则的匹配谓词，按模板特化选择
+ */
+template <MatchRuleType R> struct Rule;
+
+template <> struct Rule<MatchRuleType::STANDARD> {
+    static constexpr bool matches(int a, int b) { return circularDiff(a, b) == 1; }
+};
+
+template <> struct Rule<MatchRuleType::NO_WRAP> {
+    static constexpr bool matches(int a, int b) { return faceDiff(a, b) == 1; }
+};
+
+template <> struct Rule<MatchRuleType::SAME_COLOR> {
+    static constexpr bool matches(int a, int b) { return circularDiff(a, b) == 1 && isRed(a) == isRed(b); }
+};
+
+template <> struct Rule<MatchRuleType::SAME_SUIT> {
+    static constexpr bool matches(int a, int b) { return circularDiff(a, b) == 1 && suitOf(a) == suitOf(b); }
+};
+
+template <> struct Rule<MatchRuleType::ONE_OR_TWO> {
+    static constexpr bool matches(int a, int b) { return circularDiff(a, b) == 1 || circularDiff(a, b) == 2; }
+};
+
+template <> struct Rule<MatchRuleType::WILD> {
+    static constexpr bool matches(int a, int b)
+    {
+        return faceOf(a) == WILD_FACE || faceOf(b) == WILD_FACE || circularDiff(a, b) == 1;
+    }
+};
+
+/**
+ * 52×52 匹配位表：rows[a] 的第 b 位表示牌码 a 与 b 可以匹配
+ */
+struct MaskTable {
+    uint64_t rows[CARD_CODE_COUNT];
+};
+
+template <MatchRuleType R>
+constexpr MaskTable buildTable()
+{
+    MaskTable table = {};
+    for (int a = 0; a < CARD_CODE_COUNT; a++) {
+        for (int b = 0; b < CARD_CODE_COUNT; b++) {
+            if (Rule<R>::matches(a, b)) {
+                table.rows[a] |= (1ULL << b);
+            }
+        }
+    }
+    return table;
+}
+
+/**
+ * 编译期生成的匹配表，热循环中每个候选只需一次位测试
+ */
+template <MatchRuleType R>
+struct Table {
+    static constexpr MaskTable value = buildTable<R>();
+
+    static bool test(int a, int b) { return ((value.rows[a] >> b) & 1) != 0; }
+    static uint64_t row(int a) { return value.rows[a]; }
+};
+
+template <MatchRuleType R>
+constexpr MaskTable Table<R>::value;
+
+// 运行时按规则取匹配表（只在加载关卡时调用一次）
+inline const uint64_t* rowsFor(MatchRuleType rule)
+{
+    switch (rule) {
+    case MatchRuleType::NO_WRAP:    return Table<MatchRuleType::NO_WRAP>::value.rows;
+    case MatchRuleType::SAME_COLOR: return Table<MatchRuleType::SAME_COLOR>::value.rows;
+    case MatchRuleType::SAME_SUIT:  return Table<MatchRuleType::SAME_SUIT>::value.rows;
+    case MatchRuleType::ONE_OR_TWO: return Table<MatchRuleType::ONE_OR_TWO>::value.rows;
+    case MatchRuleType::WILD:       return Table<MatchRuleType::WILD>::value.rows;
+    default:                        return Table<MatchRuleType::STANDARD>::value.rows;
+    }
+}
+
+/**
+ * 将运行时规则分派到模板实例：fn 以 RuleTag<R> 为参数调用
+ * 用于求解器、模拟器等热循环，使循环体内不再按规则分支
+ */
+template <MatchRuleType R>
+struct RuleTag {
+    static const MatchRuleType value = R;
+};
+
+template <typename Fn>
+auto dispatch(MatchRuleType rule, Fn&& fn) -> decltype(fn(RuleTag<MatchRuleType::STANDARD>()))
+{
+    switch (rule) {
+    case MatchRuleType::NO_WRAP:    return fn(RuleTag<MatchRuleType::NO_WRAP>());
+    case MatchRuleType::SAME_COLOR: return fn(RuleTag<MatchRuleType::SAME_COLOR>());
+    case MatchRuleType::SAME_SUIT:  return fn(RuleTag<MatchRuleType::SAME_SUIT>());
+    case MatchRuleType::ONE_OR_TWO: return fn(RuleTag<MatchRuleType::ONE_OR_TWO>());
+    case MatchRuleType::WILD:       return fn(RuleTag<MatchRuleType::WILD>());
+    default:                        return fn(RuleTag<MatchRuleType::STANDARD>());
+    }
+}
+
+// 规则名称（关卡文件中的 "MatchRule" 字段）
+const char* ruleName(MatchRuleType rule);
+bool parseRuleName(const char* name, MatchRuleType& outRule);
+
+} // namespace MatchRules
+
+#endif // __MATCH_RULES_H__
@@ -0,0 +1,432 @@
+#include "BatchSimulator.h"
+#include "models/MatchRules.h"
+#include "utils/ProcessStats.h"
+#include "utils/ThreadPool.h"
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define BATCH_SIMD_AVX2 1
+#elif defined(__SSSE3__) || defined(__AVX__)
+#include <tmmintrin.h>
+#define BATCH_SIMD_SSSE3 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define BATCH_SIMD_NEON 1
+#endif
+
+namespace {
+
+// 每张牌的查表行长度（牌码 0~51，补齐到 64 便于整段加载）
+const int LUT_STRIDE = 64;
+
+uint64_t splitMix64(uint64_t state)
+{
+    uint64_t z = state + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// 每局的随机状态只由种子和局序号决定
+uint64_t gameSeed(uint64_t seed, uint64_t gameIndex)
+{
+    uint64_t state = splitMix64(seed ^ splitMix64(gameIndex));
+    return state != 0 ? state : 1;
+}
+
+// xorshift64*
+uint64_t nextRandom(uint64_t& state)
+{
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1DULL;
+}
+
+// 随机起点 [0, count)
+int randomStart(uint64_t random, int count)
+{
+    return static_cast<int>(((random >> 32) * static_cast<uint64_t>(count)) >> 32);
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+double BatchStats::getGamesPerCoreSecond() const
+{
+    if (cpuSeconds > 0) {
+        return games / cpuSeconds;
+    }
+    double coreSeconds = wallSeconds * (threads > 0 ? threads : 1);
+    return coreSeconds > 0 ? games / coreSeconds : 0;
+}
+
+void BatchStats::merge(const BatchStats& other)
+{
+    games += other.games;
+    wins += other.wins;
+    moves += other.moves;
+    remaining += other.remaining;
+    steps += other.steps;
+}
+
+BatchSimulator::BatchSimulator(const std::shared_ptr<const BoardLayout>& layout)
+    : _layout(layout)
+    , _playfieldCount(layout->playfieldCount)
+    , _anyCandidate(0)
+    , _active(0)
+{
+    // 顶牌牌码 t 能否与牌 c 匹配：展开为字节表，向量化时按顶牌牌码逐字节查
+    const uint64_t* rows = MatchRules::rowsFor(layout->matchRule);
+    _lut.assign(static_cast<size_t>(_playfieldCount) * LUT_STRIDE, 0);
+    for (int card = 0; card < _playfieldCount; card++) {
+        int code = layout->codes[card];
+        for (int top = 0; top < MatchRules::CARD_CODE_COUNT; top++) {
+            if ((rows[top] >> code) & 1) {
+                _lut[card * LUT_STRIDE + top] = 0xFF;
+            }
+        }
+    }
+
+    // 开局的可点击状态与 BoardState 一致
+    BoardState initial;
+    initial.init(layout);
+    _initialExposed.resize(_playfieldCount);
+    for (int card = 0; card < _playfieldCount; card++) {
+        _initialExposed[card] = initial.isExposed(card) ? 0xFF : 0;
+    }
+
+    _live.assign(static_cast<size_t>(_playfieldCount) * LANES, 0);
+    _exposed.assign(static_cast<size_t>(_playfieldCount) * LANES, 0);
+    _candBits.assign(_playfieldCount, 0);
+    std::memset(_top, 0, sizeof(_top));
+    std::memset(_trayRemaining, 0, sizeof(_trayRemaining));
+    std::memset(_liveCount, 0, sizeof(_liveCount));
+    std::memset(_moves, 0, sizeof(_moves));
+    std::memset(_rng, 0, sizeof(_rng));
+}
+
+const char* BatchSimulator::simdName()
+{
+#if defined(BATCH_SIMD_AVX2)
+    return "avx2";
+#elif defined(BATCH_SIMD_SSSE3)
+    return "ssse3";
+#elif defined(BATCH_SIMD_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+BatchStats BatchSimulator::run(uint64_t games, uint64_t seed, uint64_t firstGame)
+{
+    BatchStats stats;
+    auto wallStart = std::chrono::steady_clock::now();
+    uint64_t cpuStart = ProcessStats::getCpuTimeUs();
+
+    uint64_t nextGame = 0;
+    _active = 0;
+    for (int lane = 0; lane < LANES && nextGame < games; lane++) {
+        resetLane(lane, firstGame + nextGame++, seed);
+        _active |= 1u << lane;
+    }
+
+    GameResult result;
+    while (_active != 0) {
+        computeCandidates();
+        stats.steps++;
+
+        for (int lane = 0; lane < LANES; lane++) {
+            if (!((_active >> lane) & 1) || !stepLane(lane, result)) {
+                continue;
+            }
+            stats.games++;
+            stats.moves += result.moves;
+            if (result.won) {
+                stats.wins++;
+            }
+            else {
+                stats.remaining += result.remaining;
+            }
+            // 结束的列立即换成下一局
+            if (nextGame < games) {
+                resetLane(lane, firstGame + nextGame++, seed);
+            }
+            else {
+                _active &= ~(1u << lane);
+            }
+        }
+    }
+
+    stats.wallSeconds = secondsSince(wallStart);
+    uint64_t cpuEnd = ProcessStats::getCpuTimeUs();
+    stats.cpuSeconds = cpuEnd > cpuStart ? (cpuEnd - cpuStart) / 1e6 : 0;
+    return stats;
+}
+
+BatchStats BatchSimulator::runParallel(const std::shared_ptr<const BoardLayout>& layout, uint64_t games, uint64_t seed, int threads)
+{
+    if (threads <= 0) {
+        threads = static_cast<int>(std::thread::hardware_concurrency());
+        if (threads <= 0) {
+            threads = 1;
+        }
+    }
+
+    auto wallStart = std::chrono::steady_clock::now();
+    uint64_t cpuStart = ProcessStats::getCpuTimeUs();
+
+    // 每个线程一段连续的局序号，结果与线程数无关
+    std::vector<BatchStats> parts(threads);
+    {
+        ThreadPool pool(static_cast<size_t>(threads), 0);
+        for (int t = 0; t < threads; t++) {
+            uint64_t begin = games * t / threads;
+            uint64_t end = games * (t + 1) / threads;
+            BatchStats* part = &parts[t];
+            pool.submit([layout, seed, begin, end, part]() {
+                BatchSimulator simulator(layout);
+                *part = simulator.run(end - begin, seed, begin);
+            });
+        }
+        pool.waitIdle();
+    }
+
+    BatchStats stats;
+    for (const auto& part : parts) {
+        stats.merge(part);
+    }
+    stats.threads = threads;
+    stats.wallSeconds = secondsSince(wallStart);
+    uint64_t cpuEnd = ProcessStats::getCpuTimeUs();
+    stats.cpuSeconds = cpuEnd > cpuStart ? (cpuEnd - cpuStart) / 1e6 : 0;
+    return stats;
+}
+
+BatchSimulator::GameResult BatchSimulator::playReference(const std::shared_ptr<const BoardLayout>& layout, uint64_t seed, uint64_t gameIndex)
+{
+    GameResult result;
+    BoardState state;
+    if (!state.init(layout)) {
+        return result;
+    }
+
+    int playfieldCount = layout->playfieldCount;
+    uint64_t rng = gameSeed(seed, gameIndex);
+    while (!state.isWon()) {
+        // 与批量模拟相同：每步先取一个随机数，再按随机起点找第一张可匹配的牌
+        uint64_t random = nextRandom(rng);
+        int card = -1;
+        if (playfieldCount > 0) {
+            int start = randomStart(random, playfieldCount);
+            for (int i = 0; i < playfieldCount && card < 0; i++) {
+                int candidate = start + i < playfieldCount ? start + i : start + i - playfieldCount;
+                if (state.canMatch(candidate)) {
+                    card = candidate;
+                }
+            }
+        }
+        if (card >= 0) {
+            state.applyMatch(card);
+        }
+        else if (!state.applyFlip()) {
+            break;
+        }
+        result.moves++;
+    }
+    result.won = state.isWon();
+    result.remaining = state.getLiveCount();
+    return result;
+}
+
+void BatchSimulator::resetLane(int lane, uint64_t gameIndex, uint64_t seed)
+{
+    for (int card = 0; card < _playfieldCount; card++) {
+        _live[card * LANES + lane] = 0xFF;
+        _exposed[card * LANES + lane] = _initialExposed[card];
+    }
+    _top[lane] = _layout->codes[_layout->getCardCount() - 1];
+    _trayRemaining[lane] = _layout->trayCount;
+    _liveCount[lane] = _playfieldCount;
+    _moves[lane] = 0;
+    _rng[lane] = gameSeed(seed, gameIndex);
+}
+
+void BatchSimulator::computeCandidates()
+{
+    uint32_t any = 0;
+    const uint8_t* lut = _lut.data();
+    const uint8_t* exposed = _exposed.data();
+
+#if defined(BATCH_SIMD_AVX2)
+    // 顶牌牌码拆成低 4 位（表内下标）和高 2 位（选 4 段表中的哪一段），一步内对所有牌复用
+    __m256i top = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(_top));
+    __m256i lo = _mm256_and_si256(top, _mm256_set1_epi8(0x0F));
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(top, 4), _mm256_set1_epi8(0x0F));
+    __m256i sel[4];
+    for (int k = 0; k < 4; k++) {
+        sel[k] = _mm256_cmpeq_epi8(hi, _mm256_set1_epi8(static_cast<char>(k)));
+    }
+    for (int card = 0; card < _playfieldCount; card++) {
+        const uint8_t* row = lut + card * LUT_STRIDE;
+        __m256i match = _mm256_setzero_si256();
+        for (int k = 0; k < 4; k++) {
+            __m256i table = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row + k * 16)));
+            match = _mm256_or_si256(match, _mm256_and_si256(_mm256_shuffle_epi8(table, lo), sel[k]));
+        }
+        match = _mm256_and_si256(match, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(exposed + card * LANES)));
+        uint32_t bits = static_cast<uint32_t>(_mm256_movemask_epi8(match));
+        _candBits[card] = bits;
+        any |= bits;
+    }
+#elif defined(BATCH_SIMD_SSSE3)
+    __m128i lo[2];
+    __m128i sel[2][4];
+    for (int half = 0; half < 2; half++) {
+        __m128i top = _mm_loadu_si128(reinterpret_cast<const __m128i*>(_top + half * 16));
+        lo[half] = _mm_and_si128(top, _mm_set1_epi8(0x0F));
+        __m128i hi = _mm_and_si128(_mm_srli_epi16(top, 4), _mm_set1_epi8(0x0F));
+        for (int k = 0; k < 4; k++) {
+            sel[half][k] = _mm_cmpeq_epi8(hi, _mm_set1_epi8(static_cast<char>(k)));
+        }
+    }
+    for (int card = 0; card < _playfieldCount; card++) {
+        const uint8_t* row = lut + card * LUT_STRIDE;
+        __m128i table[4];
+        for (int k = 0; k < 4; k++) {
+            table[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + k * 16));
+        }
+        uint32_t bits = 0;
+        for (int half = 0; half < 2; half++) {
+            __m128i match = _mm_setzero_si128();
+            for (int k = 0; k < 4; k++) {
+                match = _mm_or_si128(match, _mm_and_si128(_mm_shuffle_epi8(table[k], lo[half]), sel[half][k]));
+            }
+            match = _mm_and_si128(match, _mm_loadu_si128(reinterpret_cast<const __m128i*>(exposed + card * LANES + half * 16)));
+            bits |= static_cast<uint32_t>(_mm_movemask_epi8(match)) << (half * 16);
+        }
+        _candBits[card] = bits;
+        any |= bits;
+    }
+#elif defined(BATCH_SIMD_NEON)
+    // AArch64 的 tbl 可直接查 64 字节的表，超出范围的下标得 0
+    static const uint8_t BIT_WEIGHTS[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+    uint8x16_t weights = vld1q_u8(BIT_WEIGHTS);
+    uint8x16_t top[2] = { vld1q_u8(_top), vld1q_u8(_top + 16) };
+    for (int card = 0; card < _playfieldCount; card++) {
+        uint8x16x4_t table = vld1q_u8_x4(lut + card * LUT_STRIDE);
+        uint32_t bits = 0;
+        for (int half = 0; half < 2; half++) {
+            uint8x16_t match = vandq_u8(vqtbl4q_u8(table, top[half]), vld1q_u8(exposed + card * LANES + half * 16));
+            uint8x16_t weighted = vandq_u8(match, weights);
+            uint32_t low = vaddv_u8(vget_low_u8(weighted));
+            uint32_t high = vaddv_u8(vget_high_u8(weighted));
+            bits |= (low | (high << 8)) << (half * 16);
+        }
+        _candBits[card] = bits;
+        any |= bits;
+    }
+#else
+    for (int card = 0; card < _playfieldCount; card++) {
+        const uint8_t* row = lut + card * LUT_STRIDE;
+        const uint8_t* column = exposed + card * LANES;
+        uint32_t bits = 0;
+        for (int lane = 0; lane < LANES; lane++) {
+            if (column[lane] & row[_top[lane]]) {
+                bits |= 1u << lane;
+            }
+        }
+        _candBits[card] = bits;
+        any |= bits;
+    }
+#endif
+
+    _anyCandidate = any;
+}
+
+bool BatchSimulator::stepLane(int lane, GameResult& outResult)
+{
+    if (_liveCount[lane] == 0) {
+        outResult.won = true;
+        outResult.moves = _moves[lane];
+        outResult.remaining = 0;
+        return true;
+    }
+
+    uint64_t random = nextRandom(_rng[lane]);
+    uint32_t laneBit = 1u << lane;
+
+    if (_anyCandidate & laneBit) {
+        int start = randomStart(random, _playfieldCount);
+        int card = -1;
+        for (int c = start; c < _playfieldCount && card < 0; c++) {
+            if (_candBits[c] & laneBit) {
+                card = c;
+            }
+        }
+        for (int c = 0; c < start && card < 0; c++) {
+            if (_candBits[c] & laneBit) {
+                card = c;
+            }
+        }
+
+        _live[card * LANES + lane] = 0;
+        _exposed[card * LANES + lane] = 0;
+        _liveCount[lane]--;
+        _top[lane] = _layout->codes[card];
+        _moves[lane]++;
+
+        // 只有被这张牌压住的牌可能因此露出
+        for (int lower : _layout->covers[card]) {
+            size_t index = lower * LANES + lane;
+            if (_live[index] && !_exposed[index]) {
+                _exposed[index] = computeExposed(lower, lane) ? 0xFF : 0;
+            }
+        }
+        return false;
+    }
+
+    if (_trayRemaining[lane] > 0) {
+        // 备用牌从 Stack 的倒数第二张开始向前翻
+        int cardId = _playfieldCount + _trayRemaining[lane] - 1;
+        _top[lane] = _layout->codes[cardId];
+        _trayRemaining[lane]--;
+        _moves[lane]++;
+        return false;
+    }
+
+    outResult.won = false;
+    outResult.moves = _moves[lane];
+    outResult.remaining = _liveCount[lane];
+    return true;
+}
+
+bool BatchSimulator::computeExposed(int card, int lane) const
+{
+    const BoardLayout& layout = *_layout;
+
+    // 只收集这一局中仍在场的上方牌
+    float upperX[BoardLayout::MAX_COVERING];
+    float upperY[BoardLayout::MAX_COVERING];
+    int upperCount = 0;
+    for (int upper : layout.coveredBy[card]) {
+        if (!_live[upper * LANES + lane]) {
+            continue;
+        }
+        if (upperCount == BoardLayout::MAX_COVERING) {
+            return false;
+        }
+        upperX[upperCount] = layout.posX[upper];
+        upperY[upperCount] = layout.posY[upper];
+        upperCount++;
+    }
+    return BoardLayout::isUncovered(layout.posX[card], layout.posY[card], upperX, upperY, upperCount);
+}
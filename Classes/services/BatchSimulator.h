@@ -0,0 +1,106 @@
+#ifndef __BATCH_SIMULATOR_H__
+#define __BATCH_SIMULATOR_H__
+
+#include "models/BoardState.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * 批量模拟统计
+ */
+struct BatchStats {
+    uint64_t games;        // 完成的局数
+    uint64_t wins;         // 通关局数
+    uint64_t moves;        // 总步数（匹配 + 翻牌）
+    uint64_t remaining;    // 未通关局结束时主牌区剩余张数之和
+    uint64_t steps;        // 锁步推进次数（每次推进一组 LANES 局）
+    double wallSeconds;    // 墙钟时间
+    double cpuSeconds;     // 进程 CPU 时间（所有线程之和，不支持的平台为 0）
+    int threads;
+
+    BatchStats() : games(0), wins(0), moves(0), remaining(0), steps(0), wallSeconds(0), cpuSeconds(0), threads(1) {}
+
+    double getGamesPerSecond() const { return wallSeconds > 0 ? games / wallSeconds : 0; }
+
+    // 每核每秒局数：按 CPU 时间计算，拿不到 CPU 时间时按墙钟时间乘线程数
+    double getGamesPerCoreSecond() const;
+
+    // 累加另一份统计的局数、步数（时间和线程数不累加）
+    void merge(const BatchStats& other);
+};
+
+/**
+ * 锁步批量模拟器
+ * 同一关卡的大量对局按 LANES 局一组，以结构数组存放（每张牌一行、每局一列），整组同步推进一步：
+ * 先对所有主牌区的牌和组内所有对局，向量化计算「可点击且与底牌堆顶牌匹配」（每张牌得到一个按局的位掩码），
+ * 再逐局选牌并更新遮挡。规则与 BoardState / GameController 一致，不做回退。
+ *
+ * 出牌策略：有可匹配的牌时从随机起点开始按卡牌ID取第一张，否则翻备用牌，都没有时结束。
+ * 每局的随机序列只由种子和局序号决定，结果与分组、线程数和指令集无关，可用 playReference 逐局核对。
+ * 一组中先结束的对局立即换成下一局，组内各列始终有事可做。
+ *
+ * 匹配查表：每张牌按牌码预先展开一行 64 字节（顶牌牌码 -> 0xFF/0），
+ * AVX2 一次查 32 局，SSSE3 / NEON 分两次各查 16 局，其他平台逐局查表。
+ */
+class BatchSimulator {
+public:
+    static const int LANES = 32;
+
+    /**
+     * 单局结果
+     */
+    struct GameResult {
+        bool won;
+        int moves;
+        int remaining;
+
+        GameResult() : won(false), moves(0), remaining(0) {}
+    };
+
+    explicit BatchSimulator(const std::shared_ptr<const BoardLayout>& layout);
+
+    // 单线程模拟序号 [firstGame, firstGame + games) 的对局
+    BatchStats run(uint64_t games, uint64_t seed, uint64_t firstGame = 0);
+
+    // 在 threads 个线程上分段模拟（0 时使用硬件线程数），每个线程一个模拟器
+    static BatchStats runParallel(const std::shared_ptr<const BoardLayout>& layout, uint64_t games, uint64_t seed, int threads);
+
+    // 用 BoardState 按相同策略逐局模拟一局，用于核对批量结果
+    static GameResult playReference(const std::shared_ptr<const BoardLayout>& layout, uint64_t seed, uint64_t gameIndex);
+
+    // 编译时选用的指令集（"avx2" / "ssse3" / "neon" / "scalar"）
+    static const char* simdName();
+
+private:
+    void resetLane(int lane, uint64_t gameIndex, uint64_t seed);
+
+    // 计算组内每局可匹配的牌：_candBits[card] 的第 lane 位
+    void computeCandidates();
+
+    // 组内一局推进一步，结束时返回 true 并填写 outResult
+    bool stepLane(int lane, GameResult& outResult);
+
+    bool computeExposed(int card, int lane) const;
+
+    std::shared_ptr<const BoardLayout> _layout;
+    int _playfieldCount;
+    std::vector<uint8_t> _lut;            // 每张牌 64 字节：顶牌牌码能否与它匹配
+    std::vector<uint8_t> _initialExposed; // 开局时各牌是否可点击
+
+    // 结构数组：牌 c、第 lane 局的状态位于 [c * LANES + lane]
+    std::vector<uint8_t> _live;
+    std::vector<uint8_t> _exposed;        // 0xFF 可点击；移除的牌同时清零
+    std::vector<uint32_t> _candBits;      // 每张牌一个按局的位掩码
+    uint32_t _anyCandidate;               // 有可匹配牌的局
+
+    // 每局一个的状态
+    uint8_t _top[LANES];                  // 底牌堆顶牌牌码
+    int _trayRemaining[LANES];
+    int _liveCount[LANES];
+    int _moves[LANES];
+    uint64_t _rng[LANES];
+    uint32_t _active;                     // 进行中的局
+};
+
+#endif // __BATCH_SIMULATOR_H__
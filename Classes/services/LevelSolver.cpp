@@ -0,0 +1,153 @@
+#include "LevelSolver.h"
+
+const char* SolveResult::statusName(Status status)
+{
+    switch (status) {
+    case WINNABLE:   return "winnable";
+    case UNWINNABLE: return "unwinnable";
+    case UNKNOWN:    return "unknown";
+    }
+    return "unknown";
+}
+
+LevelSolver::LevelSolver()
+    : _nodeBudget(0)
+    , _timeBudgetMs(0)
+    , _cancelFlag(nullptr)
+    , _aborted(false)
+    , _visitedCount(0)
+{
+}
+
+SolveResult LevelSolver::solve(const BoardState& state)
+{
+    _result = SolveResult();
+    _aborted = false;
+    _path.clear();
+    _visited.assign(1 << 12, 0);
+    _visitedCount = 0;
+
+    // 每一步都会消耗一张主牌区或备用牌堆的牌，路线长度不会超过剩余牌数
+    size_t maxMoves = static_cast<size_t>(state.getLiveCount() + state.getTrayRemaining()) + 1;
+    if (_candidates.size() < maxMoves) {
+        _candidates.resize(maxMoves);
+    }
+
+    if (_timeBudgetMs > 0) {
+        _deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(_timeBudgetMs);
+    }
+
+    BoardState work = state;
+    bool won = MatchRules::dispatch(state.getLayout().matchRule, [this, &work](auto tag) {
+        return this->search<decltype(tag)::value>(work, 0);
+    });
+    if (won) {
+        _result.status = SolveResult::WINNABLE;
+        _result.solution = _path;
+    }
+    else {
+        _result.status = _aborted ? SolveResult::UNKNOWN : SolveResult::UNWINNABLE;
+    }
+    return _result;
+}
+
+template <MatchRuleType R>
+bool LevelSolver::search(BoardState& state, int depth)
+{
+    if (depth > _result.maxDepth) {
+        _result.maxDepth = depth;
+    }
+    if (state.isWon()) {
+        return true;
+    }
+    if (outOfBudget()) {
+        _aborted = true;
+        return false;
+    }
+    _result.nodes++;
+
+    // 置换表：0 作为空槽，装载率超过一半时扩容
+    uint64_t hash = state.getStateHash();
+    if (hash == 0) {
+        hash = 1;
+    }
+    if ((_visitedCount + 1) * 2 > _visited.size()) {
+        std::vector<uint64_t> old;
+        old.swap(_visited);
+        _visited.assign(old.size() * 2, 0);
+        size_t mask = _visited.size() - 1;
+        for (uint64_t key : old) {
+            if (key != 0) {
+                size_t slot = static_cast<size_t>(key) & mask;
+                while (_visited[slot] != 0) slot = (slot + 1) & mask;
+                _visited[slot] = key;
+            }
+        }
+    }
+    size_t mask = _visited.size() - 1;
+    size_t slot = static_cast<size_t>(hash) & mask;
+    while (_visited[slot] != 0) {
+        if (_visited[slot] == hash) {
+            return false;   // 已搜索过且未能通关
+        }
+        slot = (slot + 1) & mask;
+    }
+    _visited[slot] = hash;
+    _visitedCount++;
+
+    // 顶牌的匹配行取自编译期表，每个候选一次位测试
+    std::vector<int>& candidates = _candidates[depth];
+    candidates.clear();
+    uint64_t row = MatchRules::Table<R>::row(state.getTopCode());
+    const uint8_t* codes = state.getLayout().codes.data();
+    int playfieldCount = state.getPlayfieldCount();
+    for (int i = 0; i < playfieldCount; i++) {
+        if (((row >> codes[i]) & 1) && state.isLive(i) && state.isExposed(i)) {
+            candidates.push_back(i);
+        }
+    }
+
+    for (size_t i = 0; i < candidates.size(); i++) {
+        int cardId = candidates[i];
+        state.applyMatch(cardId);
+        _path.push_back(GameMove::match(cardId));
+        if (search<R>(state, depth + 1)) {
+            return true;
+        }
+        _path.pop_back();
+        state.applyUndo();
+        if (_aborted) {
+            return false;
+        }
+    }
+
+    if (state.canFlip()) {
+        state.applyFlip();
+        _path.push_back(GameMove::flip());
+        if (search<R>(state, depth + 1)) {
+            return true;
+        }
+        _path.pop_back();
+        state.applyUndo();
+    }
+    return false;
+}
+
+bool LevelSolver::outOfBudget()
+{
+    if (_aborted) {
+        return true;
+    }
+    if (_nodeBudget > 0 && _result.nodes >= _nodeBudget) {
+        return true;
+    }
+    if ((_result.nodes & 1023) == 0) {
+        if (_cancelFlag && _cancelFlag->load(std::memory_order_relaxed)) {
+            return true;
+        }
+        if (_timeBudgetMs > 0 && std::chrono::steady_clock::now() >= _deadline) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,70 @@
+#ifndef __LEVEL_SOLVER_H__
+#define __LEVEL_SOLVER_H__
+
+#include "models/BoardState.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+/**
+ * 求解结果
+ */
+struct SolveResult {
+    enum Status {
+        WINNABLE = 0,     // 找到通关路线
+        UNWINNABLE,       // 搜索穷尽，无法通关
+        UNKNOWN           // 超出预算，未能确定
+    };
+
+    Status status;
+    std::vector<GameMove> solution;   // 通关路线（仅 WINNABLE）
+    uint64_t nodes;                   // 展开的状态数
+    int maxDepth;                     // 搜索到的最大步数（UNWINNABLE 时即最多还能走几步）
+
+    SolveResult() : status(UNKNOWN), nodes(0), maxDepth(0) {}
+
+    static const char* statusName(Status status);
+};
+
+/**
+ * 关卡求解器
+ * 对 BoardState 做带置换表的深度优先搜索，判断当前局面能否通关
+ * 搜索函数按关卡匹配规则做模板特化，热循环内不再按规则分支
+ */
+class LevelSolver {
+public:
+    LevelSolver();
+
+    // 最多展开的状态数，0 表示不限制
+    void setNodeBudget(uint64_t nodes) { _nodeBudget = nodes; }
+
+    // 搜索时间上限（毫秒），0 表示不限制
+    void setTimeBudget(int milliseconds) { _timeBudgetMs = milliseconds; }
+
+    // 外部取消标记，置为 true 时搜索尽快返回 UNKNOWN
+    void setCancelFlag(const std::atomic<bool>* cancelFlag) { _cancelFlag = cancelFlag; }
+
+    // 从给定局面开始求解（不修改传入的局面）
+    SolveResult solve(const BoardState& state);
+
+private:
+    // 按匹配规则实例化，候选筛选使用编译期匹配表
+    template <MatchRuleType R>
+    bool search(BoardState& state, int depth);
+    bool outOfBudget();
+
+    uint64_t _nodeBudget;
+    int _timeBudgetMs;
+    const std::atomic<bool>* _cancelFlag;
+
+    SolveResult _result;
+    bool _aborted;
+    std::chrono::steady_clock::time_point _deadline;
+    std::vector<uint64_t> _visited;       // 开放寻址置换表
+    size_t _visitedCount;
+    std::vector<GameMove> _path;
+    std::vector<std::vector<int>> _candidates;   // 每层复用的候选列表
+};
+
+#endif // __LEVEL_SOLVER_H__
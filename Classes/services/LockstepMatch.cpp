@@ -0,0 +1,323 @@
+#include "LockstepMatch.h"
+#include <algorithm>
+
+namespace {
+
+// 对方输入序号最多领先已确认的输入这么多，超出视为异常消息
+const uint32_t MAX_PENDING_INPUTS = 4096;
+
+} // namespace
+
+LockstepMatch::LockstepMatch()
+    : _level(-1)
+    , _playfieldCount(0)
+    , _localPlayer(0)
+    , _transport(nullptr)
+    , _frame(0)
+    , _localSequence(0)
+    , _moves()
+    , _finishFrame()
+    , _confirmedFrame(0)
+    , _confirmedInputs(0)
+    , _blockUnits(0)
+    , _snapshotInfo()
+    , _desynced(false)
+{
+}
+
+bool LockstepMatch::start(const std::shared_ptr<const BoardLayout>& layout, int localPlayer, IMatchTransport* transport)
+{
+    if (!transport || localPlayer < 0 || localPlayer >= PLAYER_COUNT) {
+        return false;
+    }
+    for (auto& session : _sessions) {
+        _host.destroySession(session);
+        session = SessionHandle();
+    }
+    _level = _host.addLevel(layout);
+    if (_level < 0) {
+        _transport = nullptr;
+        return false;
+    }
+    for (auto& session : _sessions) {
+        session = _host.createSession(_level);
+    }
+
+    _playfieldCount = layout->playfieldCount;
+    _localPlayer = localPlayer;
+    _transport = transport;
+    _frame = 0;
+    _localSequence = 0;
+    for (int p = 0; p < PLAYER_COUNT; p++) {
+        _moves[p] = 0;
+        _finishFrame[p] = NOT_FINISHED;
+    }
+    _result = RaceResult();
+    _confirmedFrame = 0;
+    _confirmedInputs = 0;
+    _desynced = false;
+    _stats = RollbackStats();
+
+    // 对局中不再分配：输入表和快照环一次预留好
+    _remoteInputs.clear();
+    _remoteInputs.reserve(256);
+    _frameReports.clear();
+    _frameReports.reserve(SNAPSHOT_FRAMES * 2);
+    _blockUnits = _host.getBlockUnits(_level);
+    _snapshotBlocks.assign(SNAPSHOT_FRAMES * _blockUnits, 0);
+    for (auto& info : _snapshotInfo) {
+        info.frame = NOT_FINISHED;
+    }
+    saveSnapshot(0);
+    return true;
+}
+
+bool LockstepMatch::submitLocal(const GameMove& move)
+{
+    if (!isStarted() || _finishFrame[_localPlayer] != NOT_FINISHED || _result.confirmed) {
+        return false;
+    }
+    SessionHandle session = _sessions[_localPlayer];
+    if (!_host.applyMove(session, move)) {
+        return false;
+    }
+    _moves[_localPlayer]++;
+    if (_host.isWon(session)) {
+        _finishFrame[_localPlayer] = _frame;
+    }
+
+    MatchMessage message;
+    message.kind = MatchMessage::INPUT;
+    message.player = static_cast<uint8_t>(_localPlayer);
+    message.moveType = static_cast<uint8_t>(move.type);
+    message.cardId = move.cardId;
+    message.sequence = _localSequence++;
+    message.frame = _frame;
+    _transport->send(message);
+
+    updateResult();
+    return true;
+}
+
+bool LockstepMatch::advanceFrame()
+{
+    if (!isStarted()) {
+        return false;
+    }
+
+    uint32_t dirtyFrame = receiveMessages();
+    if (dirtyFrame <= _frame) {
+        rollback(dirtyFrame);
+    }
+    updateConfirmation();
+    updateResult();
+
+    // 预测的帧数（已确认帧之后到当前帧）达到上限时等待对方
+    if (_frame + 1 - _confirmedFrame >= MAX_PREDICTION_FRAMES) {
+        _stats.stalledFrames++;
+        return false;
+    }
+
+    // 结束当前帧：本端在这一帧及之前的输入都已发出
+    MatchMessage report;
+    report.kind = MatchMessage::FRAME;
+    report.player = static_cast<uint8_t>(_localPlayer);
+    report.sequence = _localSequence;
+    report.frame = _frame;
+    report.checksum = _host.getStateChecksum(_sessions[_localPlayer]);
+    _transport->send(report);
+
+    _frame++;
+    saveSnapshot(_frame);
+    applyRemoteInputs(_frame);
+    updateResult();
+    return true;
+}
+
+uint32_t LockstepMatch::receiveMessages()
+{
+    uint32_t dirtyFrame = NOT_FINISHED;
+    int remote = getRemotePlayer();
+    MatchMessage message;
+    while (_transport->receive(message)) {
+        if (message.player != remote) {
+            continue;
+        }
+        if (message.kind == MatchMessage::FRAME) {
+            if (message.frame >= _confirmedFrame) {
+                _frameReports.push_back(message);
+            }
+            continue;
+        }
+        if (message.kind != MatchMessage::INPUT || message.sequence < _confirmedInputs) {
+            continue;
+        }
+        if (message.sequence - _confirmedInputs >= MAX_PENDING_INPUTS || message.frame < _confirmedFrame) {
+            // 已确认的帧不会再有新输入
+            _desynced = true;
+            continue;
+        }
+        if (message.sequence >= _remoteInputs.size()) {
+            _remoteInputs.resize(message.sequence + 1);
+        }
+        RemoteInput& input = _remoteInputs[message.sequence];
+        if (input.received) {
+            continue;
+        }
+        input.frame = message.frame;
+        input.move = GameMove(static_cast<GameMove::Type>(message.moveType), message.cardId);
+        input.received = true;
+
+        // 生效帧已开始：同一帧中序号更大的输入可能已经生效，从该帧开头重算；未来的帧推进到时再应用
+        if (message.frame <= _frame) {
+            dirtyFrame = std::min(dirtyFrame, message.frame);
+            if (message.frame < _frame) {
+                _stats.lateInputs++;
+            }
+        }
+    }
+    return dirtyFrame;
+}
+
+void LockstepMatch::rollback(uint32_t frame)
+{
+    if (!restoreSnapshot(frame)) {
+        // 快照已被覆盖：暂停推进保证了不会发生，发生即说明消息异常
+        _desynced = true;
+        return;
+    }
+
+    // 快照中已含生效帧更早的输入；之后的按序号（即按帧）重放，途经的帧重新存快照
+    uint32_t current = frame;
+    for (size_t sequence = _confirmedInputs; sequence < _remoteInputs.size(); sequence++) {
+        const RemoteInput& input = _remoteInputs[sequence];
+        if (!input.received || input.frame < frame || input.frame > _frame) {
+            continue;
+        }
+        while (current < input.frame) {
+            saveSnapshot(++current);
+        }
+        applyRemote(input);
+    }
+    while (current < _frame) {
+        saveSnapshot(++current);
+    }
+
+    uint32_t frames = _frame - frame + 1;
+    _stats.rollbacks++;
+    _stats.resimulatedFrames += frames;
+    _stats.maxRollbackFrames = std::max(_stats.maxRollbackFrames, frames);
+}
+
+void LockstepMatch::applyRemoteInputs(uint32_t frame)
+{
+    for (size_t sequence = _confirmedInputs; sequence < _remoteInputs.size(); sequence++) {
+        const RemoteInput& input = _remoteInputs[sequence];
+        if (input.received && input.frame == frame) {
+            applyRemote(input);
+        }
+    }
+}
+
+void LockstepMatch::applyRemote(const RemoteInput& input)
+{
+    // 与 submitLocal 一致：通关后的输入不再生效；预测中暂时非法的输入（前面的输入还没到）跳过，补齐后重算
+    int remote = getRemotePlayer();
+    if (_finishFrame[remote] != NOT_FINISHED || !_host.applyMove(_sessions[remote], input.move)) {
+        return;
+    }
+    _moves[remote]++;
+    if (_host.isWon(_sessions[remote])) {
+        _finishFrame[remote] = input.frame;
+    }
+}
+
+void LockstepMatch::saveSnapshot(uint32_t frame)
+{
+    int remote = getRemotePlayer();
+    uint32_t slot = frame % SNAPSHOT_FRAMES;
+    _host.saveState(_sessions[remote], &_snapshotBlocks[slot * _blockUnits]);
+
+    FrameInfo& info = _snapshotInfo[slot];
+    info.frame = frame;
+    info.moves = _moves[remote];
+    info.finishFrame = _finishFrame[remote];
+    info.checksum = _host.getStateChecksum(_sessions[remote]);
+}
+
+bool LockstepMatch::restoreSnapshot(uint32_t frame)
+{
+    uint32_t slot = frame % SNAPSHOT_FRAMES;
+    const FrameInfo& info = _snapshotInfo[slot];
+    if (info.frame != frame) {
+        return false;
+    }
+    int remote = getRemotePlayer();
+    _host.restoreState(_sessions[remote], &_snapshotBlocks[slot * _blockUnits]);
+    _moves[remote] = info.moves;
+    _finishFrame[remote] = info.finishFrame;
+    return true;
+}
+
+void LockstepMatch::updateConfirmation()
+{
+    // 按帧号从小到大确认：帧号更大的报告要求的输入更多，前一条不满足时后面的也不满足
+    for (;;) {
+        size_t next = _frameReports.size();
+        for (size_t i = 0; i < _frameReports.size(); i++) {
+            if (next == _frameReports.size() || _frameReports[i].frame < _frameReports[next].frame) {
+                next = i;
+            }
+        }
+        if (next == _frameReports.size()) {
+            return;
+        }
+        MatchMessage report = _frameReports[next];
+        if (report.frame < _confirmedFrame) {
+            _frameReports[next] = _frameReports.back();
+            _frameReports.pop_back();
+            continue;
+        }
+
+        // 本端还没算完该帧，或该帧之前的输入还没到齐
+        if (report.frame >= _frame || report.sequence > _remoteInputs.size()) {
+            return;
+        }
+        for (uint32_t sequence = _confirmedInputs; sequence < report.sequence; sequence++) {
+            if (!_remoteInputs[sequence].received) {
+                return;
+            }
+        }
+
+        // 该帧结束时的对方棋盘就是下一帧开头的快照
+        const FrameInfo& info = _snapshotInfo[(report.frame + 1) % SNAPSHOT_FRAMES];
+        if (info.frame != report.frame + 1 || info.checksum != report.checksum) {
+            _desynced = true;
+        }
+        _confirmedFrame = report.frame + 1;
+        _confirmedInputs = report.sequence;
+        _frameReports[next] = _frameReports.back();
+        _frameReports.pop_back();
+    }
+}
+
+void LockstepMatch::updateResult()
+{
+    if (_result.confirmed) {
+        return;
+    }
+    uint32_t first = std::min(_finishFrame[0], _finishFrame[1]);
+    _result = RaceResult();
+    if (first == NOT_FINISHED) {
+        return;
+    }
+    _result.frame = first;
+    if (_finishFrame[0] == _finishFrame[1]) {
+        _result.draw = true;
+    }
+    else {
+        _result.winner = _finishFrame[0] < _finishFrame[1] ? 0 : 1;
+    }
+    // 双方在该帧及之前的输入都已确定
+    _result.confirmed = _frame > first && _confirmedFrame > first;
+}
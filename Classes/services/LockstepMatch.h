@@ -0,0 +1,167 @@
+#ifndef __LOCKSTEP_MATCH_H__
+#define __LOCKSTEP_MATCH_H__
+
+#include "services/MatchTransport.h"
+#include "services/SessionHost.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * 对战结果
+ */
+struct RaceResult {
+    int winner;            // 先通关的玩家，平局或未分胜负时为 -1
+    bool draw;             // 双方在同一帧通关
+    uint32_t frame;        // 分出胜负的帧
+    bool confirmed;        // 双方在该帧之前的输入都已确定，结果不会再被迟到的输入改写
+
+    RaceResult() : winner(-1), draw(false), frame(0), confirmed(false) {}
+
+    bool isDecided() const { return winner >= 0 || draw; }
+};
+
+/**
+ * 回滚统计
+ */
+struct RollbackStats {
+    uint32_t rollbacks;            // 回滚次数
+    uint32_t resimulatedFrames;    // 回滚后重算的帧数之和
+    uint32_t maxRollbackFrames;    // 单次回滚最多重算的帧数
+    uint32_t lateInputs;           // 到达时生效帧已过去的对方输入
+    uint32_t stalledFrames;        // 领先对方太多、暂停推进的次数
+
+    RollbackStats() : rollbacks(0), resimulatedFrames(0), maxRollbackFrames(0), lateInputs(0), stalledFrames(0) {}
+};
+
+/**
+ * 确定性锁步对战（带回滚）
+ * 双方打同一局，谁先通关谁赢。每端各持一个 LockstepMatch，两块棋盘都放在一个 SessionHost 里，
+ * 对局状态只由双方带帧号的输入决定，两端算出的结果相同。
+ *
+ * 本端输入在当前帧立即生效并发给对方；对方的输入没到之前按「没有操作」预测，照常推进，不等网络。
+ * 对方的输入迟到（生效帧已过去）时，从快照环中取出它生效那一帧开头的对方棋盘，
+ * 按帧号把之后收到的对方输入重放到当前帧，一次回滚在同一帧内完成。
+ *
+ * 快照只是对方会话的状态块（SessionHost::saveState，几十字节的 memcpy）加三个计数，
+ * 每帧存一份，不像 GameModel 那样拷贝三个对象数组。本端棋盘只由本端输入决定，不需要快照。
+ *
+ * 每推进完一帧向对方发一条 FRAME 消息（帧号、已发出的输入数、本端棋盘校验和）：
+ * 对方据此确认哪些帧的输入已全部到达，并在确认时比较校验和，不一致即为不同步。
+ * 领先对方已确认的帧超过 MAX_PREDICTION_FRAMES 时暂停推进，快照环因此只需定长。
+ */
+class LockstepMatch {
+public:
+    static const int PLAYER_COUNT = 2;
+    static const uint32_t MAX_PREDICTION_FRAMES = 30;                     // 60 帧时为半秒
+    static const uint32_t SNAPSHOT_FRAMES = MAX_PREDICTION_FRAMES + 2;
+    static const uint32_t NOT_FINISHED = 0xFFFFFFFFu;
+
+    LockstepMatch();
+
+    LockstepMatch(const LockstepMatch&) = delete;
+    LockstepMatch& operator=(const LockstepMatch&) = delete;
+
+    // 开始对局：双方使用同一布局，localPlayer 为本端玩家序号，transport 由调用方持有
+    bool start(const std::shared_ptr<const BoardLayout>& layout, int localPlayer, IMatchTransport* transport);
+    bool isStarted() const { return _transport != nullptr; }
+
+    // 本端操作：在当前帧生效，立即应用到本端棋盘并发给对方
+    // 非法操作、本端已通关或结果已确定时返回 false，不发送
+    bool submitLocal(const GameMove& move);
+
+    // 每个逻辑帧调用一次：收取对方消息（迟到的输入触发回滚），然后结束当前帧并通知对方
+    // 领先对方已确认的帧太多时只收消息不推进，返回 false
+    bool advanceFrame();
+
+    // 当前帧（本端输入的生效帧）
+    uint32_t getFrame() const { return _frame; }
+
+    // 对方在此帧之前的输入都已到达
+    uint32_t getConfirmedFrame() const { return _confirmedFrame; }
+
+    int getLocalPlayer() const { return _localPlayer; }
+    int getRemotePlayer() const { return 1 - _localPlayer; }
+
+    // 棋盘（对方棋盘含预测：迟到的输入到达后可能改变）
+    const SessionHost& getHost() const { return _host; }
+    SessionHandle getSession(int player) const { return _sessions[player]; }
+    int getLiveCount(int player) const { return _host.getLiveCount(_sessions[player]); }
+    int getPlayfieldCount() const { return _playfieldCount; }
+    uint32_t getMoveCount(int player) const { return _moves[player]; }
+    uint32_t getFinishFrame(int player) const { return _finishFrame[player]; }
+
+    const RaceResult& getResult() const { return _result; }
+
+    // 确认时对方报告的校验和与本端重算的不一致，或调用方无法让本端棋盘与界面一致
+    bool isDesynced() const { return _desynced; }
+    void markDesynced() { _desynced = true; }
+
+    const RollbackStats& getStats() const { return _stats; }
+
+private:
+    /**
+     * 收到的对方输入，按序号存放
+     */
+    struct RemoteInput {
+        uint32_t frame;
+        GameMove move;
+        bool received;
+
+        RemoteInput() : frame(0), received(false) {}
+    };
+
+    /**
+     * 快照环中的一帧：该帧开头的对方棋盘（状态块另存）
+     */
+    struct FrameInfo {
+        uint32_t frame;
+        uint32_t moves;
+        uint32_t finishFrame;
+        uint32_t checksum;      // 对方棋盘的校验和（即上一帧结束时的状态）
+    };
+
+    // 收取对方消息，返回最早需要重算的帧（没有时为 NOT_FINISHED）
+    uint32_t receiveMessages();
+
+    // 从 frame 开头的快照恢复对方棋盘，重放收到的对方输入直到当前帧
+    void rollback(uint32_t frame);
+
+    // 应用生效帧等于 frame 的对方输入
+    void applyRemoteInputs(uint32_t frame);
+    void applyRemote(const RemoteInput& input);
+
+    void saveSnapshot(uint32_t frame);
+    bool restoreSnapshot(uint32_t frame);
+
+    // 按已收到的 FRAME 消息推进确认帧并校验
+    void updateConfirmation();
+    void updateResult();
+
+    SessionHost _host;
+    SessionHandle _sessions[PLAYER_COUNT];
+    int _level;
+    int _playfieldCount;
+    int _localPlayer;
+    IMatchTransport* _transport;
+
+    uint32_t _frame;
+    uint32_t _localSequence;                 // 本端已发出的输入数
+    uint32_t _moves[PLAYER_COUNT];
+    uint32_t _finishFrame[PLAYER_COUNT];
+    RaceResult _result;
+
+    std::vector<RemoteInput> _remoteInputs;  // 下标为序号
+    uint32_t _confirmedFrame;
+    uint32_t _confirmedInputs;               // 已确定的对方输入数（这之前的都已收到且生效帧已确认）
+    std::vector<MatchMessage> _frameReports; // 尚未确认的 FRAME 消息
+
+    size_t _blockUnits;
+    std::vector<uint16_t> _snapshotBlocks;   // SNAPSHOT_FRAMES 个对方状态块
+    FrameInfo _snapshotInfo[SNAPSHOT_FRAMES];
+
+    bool _desynced;
+    RollbackStats _stats;
+};
+
+#endif // __LOCKSTEP_MATCH_H__
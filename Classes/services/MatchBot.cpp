@@ -0,0 +1,61 @@
+#include "MatchBot.h"
+
+MatchBot::MatchBot()
+    : _thinkFrames(30)
+    , _undoPercent(0)
+    , _countdown(0)
+    , _random(1)
+{
+}
+
+bool MatchBot::start(const std::shared_ptr<const BoardLayout>& layout, int player, IMatchTransport* transport,
+    int thinkFrames, uint64_t seed)
+{
+    if (!_match.start(layout, player, transport)) {
+        return false;
+    }
+    _playable.reserve(layout->playfieldCount);
+    _thinkFrames = thinkFrames > 0 ? thinkFrames : 1;
+    _countdown = _thinkFrames;
+    _random = seed != 0 ? seed : 1;
+    return true;
+}
+
+void MatchBot::update()
+{
+    if (!_match.isStarted()) {
+        return;
+    }
+    if (--_countdown <= 0 && playOneStep()) {
+        _countdown = _thinkFrames;
+    }
+    _match.advanceFrame();
+}
+
+bool MatchBot::playOneStep()
+{
+    const SessionHost& host = _match.getHost();
+    SessionHandle session = _match.getSession(_match.getLocalPlayer());
+    if (host.isWon(session) || _match.getResult().confirmed) {
+        return false;
+    }
+
+    // xorshift64*
+    _random ^= _random >> 12;
+    _random ^= _random << 25;
+    _random ^= _random >> 27;
+    uint64_t roll = (_random * 0x2545F4914F6CDD1DULL) >> 32;
+
+    if (host.getStackSize(session) > 1 && static_cast<int>(roll % 100) < _undoPercent) {
+        return _match.submitLocal(GameMove::undo());
+    }
+    roll /= 100;
+    host.collectPlayable(session, _playable);
+    if (!_playable.empty()) {
+        return _match.submitLocal(GameMove::match(_playable[roll % _playable.size()]));
+    }
+    if (host.getTrayRemaining(session) > 0) {
+        return _match.submitLocal(GameMove::flip());
+    }
+    return false;
+}
@@ -0,0 +1,41 @@
+#ifndef __MATCH_BOT_H__
+#define __MATCH_BOT_H__
+
+#include "services/LockstepMatch.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * 对战机器人
+ * 在传输的另一端用自己的 LockstepMatch 打同一局：每隔 thinkFrames 帧出一步，
+ * 有可匹配的牌时随机选一张，否则翻牌，都没有时停手；可按比例插入回退。随机序列只由种子决定。
+ * 用于单机对战（接在 LoopbackLink 的另一端）和无界面测试。
+ */
+class MatchBot {
+public:
+    MatchBot();
+
+    bool start(const std::shared_ptr<const BoardLayout>& layout, int player, IMatchTransport* transport,
+        int thinkFrames, uint64_t seed);
+
+    // 每步选择回退的概率（%），默认 0
+    void setUndoPercent(int percent) { _undoPercent = percent; }
+
+    // 每个逻辑帧调用一次：到时间就出一步，然后推进一帧
+    void update();
+
+    LockstepMatch& getMatch() { return _match; }
+    const LockstepMatch& getMatch() const { return _match; }
+
+private:
+    bool playOneStep();
+
+    LockstepMatch _match;
+    std::vector<int> _playable;
+    int _thinkFrames;
+    int _undoPercent;
+    int _countdown;
+    uint64_t _random;
+};
+
+#endif // __MATCH_BOT_H__
@@ -0,0 +1,58 @@
+#include "MatchTransport.h"
+
+LoopbackLink::LoopbackLink(int latencyFrames, int jitterFrames, uint64_t seed)
+    : _now(0)
+    , _order(0)
+    , _latency(0)
+    , _jitter(0)
+    , _random(seed != 0 ? seed : 1)
+{
+    _endpoints[0].bind(this, 0);
+    _endpoints[1].bind(this, 1);
+    setLatency(latencyFrames, jitterFrames);
+}
+
+void LoopbackLink::setLatency(int latencyFrames, int jitterFrames)
+{
+    _latency = latencyFrames > 0 ? latencyFrames : 0;
+    _jitter = jitterFrames > 0 ? jitterFrames : 0;
+}
+
+void LoopbackLink::post(int side, const MatchMessage& message)
+{
+    Pending pending;
+    pending.due = _now + _latency;
+    if (_jitter > 0) {
+        // xorshift64*
+        _random ^= _random >> 12;
+        _random ^= _random << 25;
+        _random ^= _random >> 27;
+        pending.due += ((_random * 0x2545F4914F6CDD1DULL) >> 33) % static_cast<uint64_t>(_jitter + 1);
+    }
+    pending.order = _order++;
+    pending.message = message;
+    _queues[side].push_back(pending);
+}
+
+bool LoopbackLink::take(int side, MatchMessage& outMessage)
+{
+    // 在途消息只有几十条，线性查找最早到期的一条
+    std::vector<Pending>& queue = _queues[side];
+    size_t best = queue.size();
+    for (size_t i = 0; i < queue.size(); i++) {
+        if (queue[i].due > _now) {
+            continue;
+        }
+        if (best == queue.size() || queue[i].due < queue[best].due
+            || (queue[i].due == queue[best].due && queue[i].order < queue[best].order)) {
+            best = i;
+        }
+    }
+    if (best == queue.size()) {
+        return false;
+    }
+    outMessage = queue[best].message;
+    queue[best] = queue.back();
+    queue.pop_back();
+    return true;
+}
@@ -0,0 +1,101 @@
+#ifndef __MATCH_TRANSPORT_H__
+#define __MATCH_TRANSPORT_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * 对战消息（20 字节平凡数据，可直接写入网络包）
+ */
+struct MatchMessage {
+    enum Kind : uint8_t {
+        INPUT = 0,     // 一步操作，在 frame 帧生效；sequence 为发送方的第几个输入（从 0 起）
+        FRAME          // 发送方已推进完 frame 帧，此前共发出 sequence 个输入；checksum 为其棋盘此时的校验和
+    };
+
+    Kind kind;
+    uint8_t player;
+    uint8_t moveType;      // GameMove::Type（INPUT）
+    uint8_t reserved;
+    int32_t cardId;        // GameMove::cardId（INPUT）
+    uint32_t sequence;
+    uint32_t frame;
+    uint32_t checksum;
+
+    MatchMessage() : kind(INPUT), player(0), moveType(0), reserved(0), cardId(-1), sequence(0), frame(0), checksum(0) {}
+};
+
+/**
+ * 对战传输接口
+ * 只要求消息最终都能送达：可以迟到、乱序或重复（由 LockstepMatch 按序号去重和回滚），
+ * 丢包重传、合包等由具体实现在接口之下处理。两个方法都不阻塞。
+ */
+class IMatchTransport {
+public:
+    virtual ~IMatchTransport() {}
+
+    // 发送一条消息
+    virtual void send(const MatchMessage& message) = 0;
+
+    // 取出一条已到达的消息，没有时返回 false
+    virtual bool receive(MatchMessage& outMessage) = 0;
+};
+
+/**
+ * 本地回环：两个端点在同一进程内互发消息，代替网络用于单机对战、机器人和测试
+ * 每条消息在 latency + [0, jitter] 帧后送达（tick 推进一帧），jitter 大于 0 时后发的消息可能先到。
+ * 延迟随机数只由种子决定，同样的收发顺序每次结果相同。不加锁，与对局在同一线程使用。
+ */
+class LoopbackLink {
+public:
+    LoopbackLink(int latencyFrames = 0, int jitterFrames = 0, uint64_t seed = 1);
+
+    LoopbackLink(const LoopbackLink&) = delete;
+    LoopbackLink& operator=(const LoopbackLink&) = delete;
+
+    // 端点 0、1：从一端发出的消息由另一端收取
+    IMatchTransport& getEndpoint(int side) { return _endpoints[side]; }
+
+    // 推进一帧
+    void tick() { _now++; }
+
+    void setLatency(int latencyFrames, int jitterFrames);
+
+    // 已发出尚未被收取的消息数
+    size_t getInFlightCount() const { return _queues[0].size() + _queues[1].size(); }
+
+private:
+    class Endpoint : public IMatchTransport {
+    public:
+        Endpoint() : _link(nullptr), _side(0) {}
+
+        void bind(LoopbackLink* link, int side) { _link = link; _side = side; }
+
+        virtual void send(const MatchMessage& message) override { _link->post(1 - _side, message); }
+        virtual bool receive(MatchMessage& outMessage) override { return _link->take(_side, outMessage); }
+
+    private:
+        LoopbackLink* _link;
+        int _side;
+    };
+
+    struct Pending {
+        uint64_t due;          // 送达的帧
+        uint64_t order;        // 发送顺序，同一帧送达的按发送顺序
+        MatchMessage message;
+    };
+
+    void post(int side, const MatchMessage& message);
+    bool take(int side, MatchMessage& outMessage);
+
+    Endpoint _endpoints[2];
+    std::vector<Pending> _queues[2];   // 发往端点 side 的消息
+    uint64_t _now;
+    uint64_t _order;
+    int _latency;
+    int _jitter;
+    uint64_t _random;
+};
+
+#endif // __MATCH_TRANSPORT_H__
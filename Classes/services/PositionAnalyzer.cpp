@@ -0,0 +1,125 @@
+#include "PositionAnalyzer.h"
+
+namespace {
+
+// 默认预算：一步动画 0.3 秒内通常能给出结论
+const int DEFAULT_TIME_BUDGET_MS = 250;
+
+} // namespace
+
+PositionAnalyzer::PositionAnalyzer()
+    : _nextRequest(0)
+    , _stopping(false)
+    , _cancel(false)
+    , _timeBudgetMs(DEFAULT_TIME_BUDGET_MS)
+    , _nodeBudget(0)
+    , _request(0)
+    , _pending(false)
+{
+}
+
+PositionAnalyzer::~PositionAnalyzer()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+        _cancel.store(true);
+    }
+    _wake.notify_one();
+    if (_worker.joinable()) {
+        _worker.join();
+    }
+}
+
+uint32_t PositionAnalyzer::request(const BoardState& state)
+{
+    if (!_worker.joinable()) {
+        _worker = std::thread(&PositionAnalyzer::workerLoop, this);
+    }
+
+    _request++;
+    if (_request == 0) {
+        _request = 1;
+    }
+    _pending = true;
+    {
+        // 拷贝进 _nextState 复用它已有的容量；取消标记在锁内设置，不会被工作线程取走旧请求时清掉
+        std::lock_guard<std::mutex> lock(_mutex);
+        _nextState = state;
+        _nextRequest = _request;
+        _cancel.store(true);
+    }
+    _wake.notify_one();
+    return _request;
+}
+
+void PositionAnalyzer::cancel()
+{
+    _request++;
+    if (_request == 0) {
+        _request = 1;
+    }
+    _pending = false;
+    std::lock_guard<std::mutex> lock(_mutex);
+    _nextRequest = 0;
+    _cancel.store(true);
+}
+
+bool PositionAnalyzer::poll(PositionVerdict& outVerdict)
+{
+    std::unique_ptr<PositionVerdict> verdict = _verdicts.take();
+    if (!verdict || verdict->request != _request) {
+        return false;
+    }
+    _pending = false;
+    outVerdict = *verdict;
+    return true;
+}
+
+void PositionAnalyzer::workerLoop()
+{
+    LevelSolver solver;
+    solver.setCancelFlag(&_cancel);
+    BoardState state;
+
+    for (;;) {
+        uint32_t request = 0;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _wake.wait(lock, [this] { return _stopping || _nextRequest != 0; });
+            if (_stopping) {
+                return;
+            }
+            // 交换而不是拷贝：下一次 request 拷贝时复用这次搜索用过的缓冲区
+            std::swap(state, _nextState);
+            request = _nextRequest;
+            _nextRequest = 0;
+            _cancel.store(false);
+        }
+
+        solver.setTimeBudget(_timeBudgetMs.load());
+        solver.setNodeBudget(_nodeBudget.load());
+        SolveResult result = solver.solve(state);
+        if (_cancel.load()) {
+            // 已有更新的请求或被作废，结论不再送达
+            continue;
+        }
+
+        std::unique_ptr<PositionVerdict> verdict(new PositionVerdict());
+        verdict->request = request;
+        verdict->nodes = result.nodes;
+        switch (result.status) {
+        case SolveResult::WINNABLE:
+            verdict->status = PositionStatus::WINNABLE;
+            break;
+        case SolveResult::UNWINNABLE:
+            verdict->status = PositionStatus::LOST;
+            verdict->movesLeft = result.maxDepth;
+            break;
+        default:
+            verdict->status = PositionStatus::UNKNOWN;
+            break;
+        }
+        _verdicts.post(std::move(verdict));
+    }
+}
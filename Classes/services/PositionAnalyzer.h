@@ -0,0 +1,77 @@
+#ifndef __POSITION_ANALYZER_H__
+#define __POSITION_ANALYZER_H__
+
+#include "models/BoardState.h"
+#include "services/LevelSolver.h"
+#include "utils/Mailbox.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+/**
+ * 一次局面分析的结论
+ */
+struct PositionVerdict {
+    uint32_t request;         // 对应的请求序号
+    PositionStatus status;
+    int movesLeft;            // LOST 时：最多还能走几步（不回退）就无路可走
+    uint64_t nodes;           // 展开的状态数
+
+    PositionVerdict() : request(0), status(PositionStatus::UNKNOWN), movesLeft(0), nodes(0) {}
+};
+
+/**
+ * 后台局面分析
+ * 对局中每提交一步，主线程把当前局面交给工作线程，在时间预算内用 LevelSolver 判断还能否通关。
+ * 新的请求会立即取消进行中的搜索（求解器的取消标记）并从新局面重新开始，旧请求的结论不会送达。
+ *
+ * 主线程只做两件事：request 把局面拷进预留好的缓冲区（持锁时间只有一次拷贝），
+ * poll 从无锁信箱取结论；都不等待工作线程，不会卡帧。
+ */
+class PositionAnalyzer {
+public:
+    PositionAnalyzer();
+    ~PositionAnalyzer();
+
+    PositionAnalyzer(const PositionAnalyzer&) = delete;
+    PositionAnalyzer& operator=(const PositionAnalyzer&) = delete;
+
+    // 每次搜索的预算（毫秒 / 状态数，0 表示不限制），下一次请求起生效
+    void setTimeBudget(int milliseconds) { _timeBudgetMs.store(milliseconds); }
+    void setNodeBudget(uint64_t nodes) { _nodeBudget.store(nodes); }
+
+    // 主线程调用：提交局面，取消进行中的搜索，返回请求序号（首次调用时启动工作线程）
+    uint32_t request(const BoardState& state);
+
+    // 主线程调用：作废当前请求（换关时），之后不会再送达它的结论
+    void cancel();
+
+    // 主线程调用：取走最新请求的结论，没有或已过期时返回 false
+    bool poll(PositionVerdict& outVerdict);
+
+    // 是否有请求尚未送达结论
+    bool isPending() const { return _pending; }
+
+    // 最新的请求序号
+    uint32_t getRequest() const { return _request; }
+
+private:
+    void workerLoop();
+
+    std::thread _worker;
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    BoardState _nextState;            // 待分析的局面（持锁访问）
+    uint32_t _nextRequest;            // 待分析局面的请求序号，0 表示没有（持锁访问）
+    bool _stopping;                   // 持锁访问
+    std::atomic<bool> _cancel;        // 交给求解器的取消标记
+    std::atomic<int> _timeBudgetMs;
+    std::atomic<uint64_t> _nodeBudget;
+
+    Mailbox<PositionVerdict> _verdicts;
+    uint32_t _request;                // 主线程：最新请求序号
+    bool _pending;                    // 主线程：最新请求尚未送达
+};
+
+#endif // __POSITION_ANALYZER_H__
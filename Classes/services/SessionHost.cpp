@@ -0,0 +1,538 @@
+#include "SessionHost.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+// 状态块头部（uint16 单位）
+const int HEADER_UNITS = 4;
+const int STACK_SIZE = 0;
+const int TRAY_REMAINING = 1;
+const int LIVE_COUNT = 2;
+
+// 每页 64KB
+const size_t PAGE_UNITS = 32 * 1024;
+
+inline bool testBit(const uint16_t* bits, int index)
+{
+    return ((bits[index >> 4] >> (index & 15)) & 1) != 0;
+}
+
+inline void setBit(uint16_t* bits, int index, bool value)
+{
+    uint16_t mask = static_cast<uint16_t>(1u << (index & 15));
+    if (value) {
+        bits[index >> 4] |= mask;
+    }
+    else {
+        bits[index >> 4] &= static_cast<uint16_t>(~mask);
+    }
+}
+
+template<typename T>
+size_t vectorBytes(const std::vector<T>& v)
+{
+    return v.capacity() * sizeof(T);
+}
+
+// 布局占用的字节数（对象本身 + 各数组的容量）
+size_t layoutBytes(const BoardLayout& layout)
+{
+    size_t bytes = sizeof(BoardLayout);
+    bytes += vectorBytes(layout.codes) + vectorBytes(layout.posX) + vectorBytes(layout.posY);
+    bytes += vectorBytes(layout.coveredBy) + vectorBytes(layout.covers);
+    for (const auto& list : layout.coveredBy) {
+        bytes += vectorBytes(list);
+    }
+    for (const auto& list : layout.covers) {
+        bytes += vectorBytes(list);
+    }
+    bytes += vectorBytes(layout.liveKeys) + vectorBytes(layout.trayKeys);
+    return bytes;
+}
+
+} // namespace
+
+SessionHost::SessionHost()
+    : _freeSlot(SHARED_BLOCK)
+    , _sessionCount(0)
+{
+}
+
+SessionHost::~SessionHost()
+{
+}
+
+int SessionHost::addLevel(const std::shared_ptr<const BoardLayout>& layout)
+{
+    // 状态块中的卡牌ID和张数都是 16 位
+    if (!layout || layout->getCardCount() <= layout->playfieldCount || layout->getCardCount() > 0xFFFF
+        || _levels.size() >= FREE_LEVEL) {
+        return -1;
+    }
+    for (size_t i = 0; i < _levels.size(); i++) {
+        if (_levels[i]->layout == layout) {
+            return static_cast<int>(i);
+        }
+    }
+
+    std::unique_ptr<Level> level(new Level());
+    int playfieldCount = layout->playfieldCount;
+    level->layout = layout;
+    level->matchRows = MatchRules::rowsFor(layout->matchRule);
+    level->bitsetUnits = static_cast<uint32_t>((playfieldCount + 15) / 16);
+    uint32_t units = HEADER_UNITS + level->bitsetUnits * 2 + static_cast<uint32_t>(layout->getCardCount());
+    level->blockUnits = (units + 3) & ~3u;
+    level->blocksPerPage = static_cast<uint32_t>(std::max<size_t>(1, PAGE_UNITS / level->blockUnits));
+    level->blockCount = 0;
+    level->freeBlock = SHARED_BLOCK;
+    level->ownedBlocks = 0;
+
+    // 开局状态与 BoardState::init 一致：主牌区全部在场，底牌堆只有 Stack 的最后一张
+    BoardState state;
+    state.init(layout);
+    level->initial.assign(level->blockUnits, 0);
+    uint16_t* block = level->initial.data();
+    block[STACK_SIZE] = 1;
+    block[TRAY_REMAINING] = static_cast<uint16_t>(layout->trayCount);
+    block[LIVE_COUNT] = static_cast<uint16_t>(playfieldCount);
+    uint16_t* live = block + HEADER_UNITS;
+    uint16_t* exposed = live + level->bitsetUnits;
+    for (int i = 0; i < playfieldCount; i++) {
+        setBit(live, i, true);
+        setBit(exposed, i, state.isExposed(i));
+    }
+    uint16_t* stack = exposed + level->bitsetUnits;
+    stack[0] = static_cast<uint16_t>(state.getTopCardId());
+
+    _levels.push_back(std::move(level));
+    return static_cast<int>(_levels.size()) - 1;
+}
+
+SessionHandle SessionHost::createSession(int level)
+{
+    if (level < 0 || level >= static_cast<int>(_levels.size())) {
+        return SessionHandle();
+    }
+
+    uint32_t index;
+    if (_freeSlot != SHARED_BLOCK) {
+        index = _freeSlot;
+        _freeSlot = _slots[index].block;
+    }
+    else {
+        index = static_cast<uint32_t>(_slots.size());
+        SessionSlot slot;
+        slot.generation = 0;
+        _slots.push_back(slot);
+    }
+
+    SessionSlot& slot = _slots[index];
+    // 代数跳过 0（0 表示无效句柄）
+    slot.generation++;
+    if (slot.generation == 0) {
+        slot.generation = 1;
+    }
+    slot.block = SHARED_BLOCK;
+    slot.moves = 0;
+    slot.level = static_cast<uint16_t>(level);
+    slot.reserved = 0;
+    _sessionCount++;
+    return SessionHandle(index, slot.generation);
+}
+
+void SessionHost::destroySession(SessionHandle handle)
+{
+    if (!slotOf(handle)) {
+        return;
+    }
+    SessionSlot& slot = _slots[handle.index];
+    releaseBlock(slot);
+    slot.level = FREE_LEVEL;
+    slot.block = _freeSlot;
+    _freeSlot = handle.index;
+    _sessionCount--;
+}
+
+bool SessionHost::isAlive(SessionHandle handle) const
+{
+    return slotOf(handle) != nullptr;
+}
+
+void SessionHost::resetSession(SessionHandle handle)
+{
+    if (!slotOf(handle)) {
+        return;
+    }
+    SessionSlot& slot = _slots[handle.index];
+    releaseBlock(slot);
+    slot.moves = 0;
+}
+
+const SessionHost::SessionSlot* SessionHost::slotOf(SessionHandle handle) const
+{
+    if (!handle.isValid() || handle.index >= _slots.size()) {
+        return nullptr;
+    }
+    const SessionSlot& slot = _slots[handle.index];
+    if (slot.level == FREE_LEVEL || slot.generation != handle.generation) {
+        return nullptr;
+    }
+    return &slot;
+}
+
+uint16_t* SessionHost::blockAt(Level& level, uint32_t block)
+{
+    return level.pages[block / level.blocksPerPage].get() + (block % level.blocksPerPage) * level.blockUnits;
+}
+
+const uint16_t* SessionHost::blockAt(const Level& level, uint32_t block) const
+{
+    return level.pages[block / level.blocksPerPage].get() + (block % level.blocksPerPage) * level.blockUnits;
+}
+
+const uint16_t* SessionHost::readBlock(const SessionSlot& slot) const
+{
+    const Level& level = *_levels[slot.level];
+    return slot.block == SHARED_BLOCK ? level.initial.data() : blockAt(level, slot.block);
+}
+
+uint16_t* SessionHost::writeBlock(SessionSlot& slot)
+{
+    Level& level = *_levels[slot.level];
+    if (slot.block == SHARED_BLOCK) {
+        slot.block = allocateBlock(level);
+        std::memcpy(blockAt(level, slot.block), level.initial.data(), level.blockUnits * sizeof(uint16_t));
+    }
+    return blockAt(level, slot.block);
+}
+
+uint32_t SessionHost::allocateBlock(Level& level)
+{
+    level.ownedBlocks++;
+    if (level.freeBlock != SHARED_BLOCK) {
+        // 空闲块的前两个单位存放下一个空闲块的序号
+        uint32_t block = level.freeBlock;
+        const uint16_t* data = blockAt(level, block);
+        level.freeBlock = static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 16);
+        return block;
+    }
+    if (level.blockCount == level.pages.size() * level.blocksPerPage) {
+        level.pages.emplace_back(new uint16_t[level.blocksPerPage * level.blockUnits]);
+    }
+    return level.blockCount++;
+}
+
+void SessionHost::releaseBlock(SessionSlot& slot)
+{
+    if (slot.block == SHARED_BLOCK) {
+        return;
+    }
+    Level& level = *_levels[slot.level];
+    uint16_t* data = blockAt(level, slot.block);
+    data[0] = static_cast<uint16_t>(level.freeBlock & 0xFFFF);
+    data[1] = static_cast<uint16_t>(level.freeBlock >> 16);
+    level.freeBlock = slot.block;
+    level.ownedBlocks--;
+    slot.block = SHARED_BLOCK;
+}
+
+int SessionHost::getLiveCount(SessionHandle handle) const
+{
+    return readBlock(_slots[handle.index])[LIVE_COUNT];
+}
+
+int SessionHost::getTrayRemaining(SessionHandle handle) const
+{
+    return readBlock(_slots[handle.index])[TRAY_REMAINING];
+}
+
+int SessionHost::getStackSize(SessionHandle handle) const
+{
+    return readBlock(_slots[handle.index])[STACK_SIZE];
+}
+
+int SessionHost::getTopCardId(SessionHandle handle) const
+{
+    const SessionSlot& slot = _slots[handle.index];
+    const Level& level = *_levels[slot.level];
+    const uint16_t* block = readBlock(slot);
+    return block[HEADER_UNITS + level.bitsetUnits * 2 + block[STACK_SIZE] - 1];
+}
+
+int SessionHost::getStackCardId(SessionHandle handle, int index) const
+{
+    const SessionSlot& slot = _slots[handle.index];
+    const Level& level = *_levels[slot.level];
+    const uint16_t* block = readBlock(slot);
+    if (index < 0 || index >= block[STACK_SIZE]) {
+        return -1;
+    }
+    return block[HEADER_UNITS + level.bitsetUnits * 2 + index];
+}
+
+bool SessionHost::isLive(SessionHandle handle, int cardId) const
+{
+    const SessionSlot& slot = _slots[handle.index];
+    const Level& level = *_levels[slot.level];
+    if (cardId < 0 || cardId >= level.layout->playfieldCount) {
+        return false;
+    }
+    return testBit(readBlock(slot) + HEADER_UNITS, cardId);
+}
+
+bool SessionHost::isExposed(SessionHandle handle, int cardId) const
+{
+    const SessionSlot& slot = _slots[handle.index];
+    const Level& level = *_levels[slot.level];
+    if (cardId < 0 || cardId >= level.layout->playfieldCount) {
+        return false;
+    }
+    return testBit(readBlock(slot) + HEADER_UNITS + level.bitsetUnits, cardId);
+}
+
+bool SessionHost::canMatch(SessionHandle handle, int cardId) const
+{
+    const SessionSlot& slot = _slots[handle.index];
+    return canMatchIn(*_levels[slot.level], readBlock(slot), cardId);
+}
+
+bool SessionHost::canMatchIn(const Level& level, const uint16_t* block, int cardId) const
+{
+    const BoardLayout& layout = *level.layout;
+    if (cardId < 0 || cardId >= layout.playfieldCount) {
+        return false;
+    }
+    const uint16_t* live = block + HEADER_UNITS;
+    const uint16_t* exposed = live + level.bitsetUnits;
+    if (!testBit(live, cardId) || !testBit(exposed, cardId)) {
+        return false;
+    }
+    int top = exposed[level.bitsetUnits + block[STACK_SIZE] - 1];
+    return ((level.matchRows[layout.codes[cardId]] >> layout.codes[top]) & 1) != 0;
+}
+
+void SessionHost::collectPlayable(SessionHandle handle, std::vector<int>& outCardIds) const
+{
+    outCardIds.clear();
+    const SessionSlot& slot = _slots[handle.index];
+    const Level& level = *_levels[slot.level];
+    const uint16_t* block = readBlock(slot);
+    const uint16_t* live = block + HEADER_UNITS;
+    const uint16_t* exposed = live + level.bitsetUnits;
+    const uint8_t* codes = level.layout->codes.data();
+    int top = exposed[level.bitsetUnits + block[STACK_SIZE] - 1];
+    uint64_t row = level.matchRows[codes[top]];
+
+    // 在场且可点击的牌逐个取出（按 16 位一组）
+    for (uint32_t unit = 0; unit < level.bitsetUnits; unit++) {
+        uint32_t bits = live[unit] & exposed[unit];
+        while (bits) {
+            int bit = 0;
+            while (!((bits >> bit) & 1)) {
+                bit++;
+            }
+            bits &= bits - 1;
+            int cardId = static_cast<int>(unit * 16 + bit);
+            if ((row >> codes[cardId]) & 1) {
+                outCardIds.push_back(cardId);
+            }
+        }
+    }
+}
+
+bool SessionHost::applyMove(SessionHandle handle, const GameMove& move)
+{
+    if (!slotOf(handle)) {
+        return false;
+    }
+    SessionSlot& slot = _slots[handle.index];
+    const Level& level = *_levels[slot.level];
+    const uint16_t* current = readBlock(slot);
+    uint32_t stackOffset = HEADER_UNITS + level.bitsetUnits * 2;
+
+    // 先在只读状态上判断合法性，非法操作不触发复制
+    switch (move.type) {
+    case GameMove::MATCH: {
+        if (!canMatchIn(level, current, move.cardId)) {
+            return false;
+        }
+        uint16_t* block = writeBlock(slot);
+        removeFromPlayfield(level, block, move.cardId);
+        block[stackOffset + block[STACK_SIZE]] = static_cast<uint16_t>(move.cardId);
+        block[STACK_SIZE]++;
+        break;
+    }
+    case GameMove::FLIP: {
+        if (current[TRAY_REMAINING] == 0) {
+            return false;
+        }
+        uint16_t* block = writeBlock(slot);
+        // 备用牌从 Stack 的倒数第二张开始向前翻（与 BoardState::getNextTrayCardId 一致）
+        int cardId = level.layout->playfieldCount + block[TRAY_REMAINING] - 1;
+        block[TRAY_REMAINING]--;
+        block[stackOffset + block[STACK_SIZE]] = static_cast<uint16_t>(cardId);
+        block[STACK_SIZE]++;
+        break;
+    }
+    case GameMove::UNDO: {
+        if (current[STACK_SIZE] <= 1) {
+            return false;
+        }
+        uint16_t* block = writeBlock(slot);
+        block[STACK_SIZE]--;
+        int cardId = block[stackOffset + block[STACK_SIZE]];
+        if (cardId < level.layout->playfieldCount) {
+            restoreToPlayfield(level, block, cardId);
+        }
+        else {
+            block[TRAY_REMAINING]++;
+        }
+        // 回到开局时归还状态块，重新共享开局状态
+        if (block[STACK_SIZE] == 1) {
+            releaseBlock(slot);
+        }
+        break;
+    }
+    default:
+        return false;
+    }
+    slot.moves++;
+    return true;
+}
+
+void SessionHost::removeFromPlayfield(const Level& level, uint16_t* block, int cardId)
+{
+    uint16_t* live = block + HEADER_UNITS;
+    uint16_t* exposed = live + level.bitsetUnits;
+    setBit(live, cardId, false);
+    setBit(exposed, cardId, false);
+    block[LIVE_COUNT]--;
+
+    for (int lower : level.layout->covers[cardId]) {
+        if (testBit(live, lower) && !testBit(exposed, lower)) {
+            setBit(exposed, lower, computeExposed(level, block, lower));
+        }
+    }
+}
+
+void SessionHost::restoreToPlayfield(const Level& level, uint16_t* block, int cardId)
+{
+    uint16_t* live = block + HEADER_UNITS;
+    uint16_t* exposed = live + level.bitsetUnits;
+    setBit(live, cardId, true);
+    block[LIVE_COUNT]++;
+    setBit(exposed, cardId, computeExposed(level, block, cardId));
+
+    for (int lower : level.layout->covers[cardId]) {
+        if (testBit(live, lower) && testBit(exposed, lower)) {
+            setBit(exposed, lower, computeExposed(level, block, lower));
+        }
+    }
+}
+
+bool SessionHost::computeExposed(const Level& level, const uint16_t* block, int cardId) const
+{
+    const BoardLayout& layout = *level.layout;
+    const uint16_t* live = block + HEADER_UNITS;
+
+    // 与 BoardState::computeExposed 相同：只收集仍在场的上方牌
+    float upperX[BoardLayout::MAX_COVERING];
+    float upperY[BoardLayout::MAX_COVERING];
+    int upperCount = 0;
+    for (int upper : layout.coveredBy[cardId]) {
+        if (!testBit(live, upper)) {
+            continue;
+        }
+        if (upperCount == BoardLayout::MAX_COVERING) {
+            return false;
+        }
+        upperX[upperCount] = layout.posX[upper];
+        upperY[upperCount] = layout.posY[upper];
+        upperCount++;
+    }
+    return BoardLayout::isUncovered(layout.posX[cardId], layout.posY[cardId], upperX, upperY, upperCount);
+}
+
+bool SessionHost::toBoardState(SessionHandle handle, BoardState& outState) const
+{
+    const SessionSlot* slot = slotOf(handle);
+    if (!slot) {
+        return false;
+    }
+    const Level& level = *_levels[slot->level];
+    if (!outState.init(level.layout)) {
+        return false;
+    }
+
+    // 底牌堆就是未被回退的操作序列：主牌区的牌为匹配，其余为翻牌
+    const uint16_t* block = readBlock(*slot);
+    const uint16_t* stack = block + HEADER_UNITS + level.bitsetUnits * 2;
+    for (int i = 1; i < block[STACK_SIZE]; i++) {
+        bool applied = stack[i] < level.layout->playfieldCount ? outState.applyMatch(stack[i]) : outState.applyFlip();
+        if (!applied) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void SessionHost::saveState(SessionHandle handle, uint16_t* outState) const
+{
+    const SessionSlot& slot = _slots[handle.index];
+    std::memcpy(outState, readBlock(slot), _levels[slot.level]->blockUnits * sizeof(uint16_t));
+}
+
+void SessionHost::restoreState(SessionHandle handle, const uint16_t* state)
+{
+    SessionSlot& slot = _slots[handle.index];
+    if (state[STACK_SIZE] <= 1) {
+        releaseBlock(slot);
+        return;
+    }
+    std::memcpy(writeBlock(slot), state, _levels[slot.level]->blockUnits * sizeof(uint16_t));
+}
+
+uint32_t SessionHost::getStateChecksum(SessionHandle handle) const
+{
+    // FNV-1a：底牌堆决定了整个状态，只哈希它的有效部分
+    const SessionSlot& slot = _slots[handle.index];
+    const uint16_t* block = readBlock(slot);
+    const uint16_t* stack = block + HEADER_UNITS + _levels[slot.level]->bitsetUnits * 2;
+    uint32_t hash = 0x811C9DC5u;
+    for (int i = 0; i < block[STACK_SIZE]; i++) {
+        hash = (hash ^ stack[i]) * 0x01000193u;
+    }
+    return hash;
+}
+
+size_t SessionHost::getSessionBytes(SessionHandle handle) const
+{
+    const SessionSlot* slot = slotOf(handle);
+    if (!slot) {
+        return 0;
+    }
+    size_t bytes = sizeof(SessionSlot);
+    if (slot->block != SHARED_BLOCK) {
+        bytes += getBlockBytes(slot->level);
+    }
+    return bytes;
+}
+
+SessionMemoryReport SessionHost::getMemoryReport() const
+{
+    SessionMemoryReport report;
+    report.sessions = _sessionCount;
+    report.levels = _levels.size();
+    report.slotBytes = vectorBytes(_slots);
+    report.levelBytes = vectorBytes(_levels);
+    for (const auto& level : _levels) {
+        size_t blockBytes = level->blockUnits * sizeof(uint16_t);
+        report.ownedSessions += level->ownedBlocks;
+        report.blockBytes += level->ownedBlocks * blockBytes;
+        report.pageBytes += level->pages.size() * level->blocksPerPage * blockBytes + vectorBytes(level->pages);
+        report.levelBytes += sizeof(Level) + layoutBytes(*level->layout) + vectorBytes(level->initial);
+    }
+    report.totalBytes = sizeof(SessionHost) + report.slotBytes + report.pageBytes + report.levelBytes;
+    return report;
+}
@@ -0,0 +1,173 @@
+#ifndef __SESSION_HOST_H__
+#define __SESSION_HOST_H__
+
+#include "models/BoardState.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * 会话句柄（槽位 + 代数，槽位复用后旧句柄失效）
+ */
+struct SessionHandle {
+    uint32_t index;
+    uint32_t generation;
+
+    SessionHandle() : index(0), generation(0) {}
+    SessionHandle(uint32_t i, uint32_t g) : index(i), generation(g) {}
+
+    bool isValid() const { return generation != 0; }
+};
+
+/**
+ * 内存统计（字节，均为精确值，不含系统分配器自身的开销）
+ */
+struct SessionMemoryReport {
+    size_t sessions;             // 存活的会话数
+    size_t ownedSessions;        // 已写入、持有自己状态块的会话数（其余仍共享关卡的开局状态）
+    size_t levels;
+    size_t levelBytes;           // 所有关卡共享的只读数据（布局 + 开局状态块）
+    size_t slotBytes;            // 会话槽位（按已分配容量）
+    size_t blockBytes;           // 会话持有的状态块
+    size_t pageBytes;            // 状态块所在的页（含空闲块）
+    size_t totalBytes;           // 以上之和加上宿主对象本身（slotBytes + pageBytes + levelBytes + sizeof）
+
+    SessionMemoryReport()
+        : sessions(0), ownedSessions(0), levels(0), levelBytes(0), slotBytes(0), blockBytes(0), pageBytes(0), totalBytes(0) {}
+
+    // 平均每个会话的字节数（槽位 + 页，不含共享数据）
+    double getBytesPerSession() const { return sessions > 0 ? static_cast<double>(slotBytes + pageBytes) / sessions : 0.0; }
+};
+
+/**
+ * 无界面多会话宿主
+ * 在一个进程里托管大量对局（云游戏、机器人），规则与 BoardState 一致（匹配、翻牌、回退、遮挡）。
+ *
+ * 每个会话只有一个 16 字节的槽位；可变状态（底牌堆、在场 / 可点击位图、备用牌剩余数）
+ * 是一个定长状态块，同一关卡的状态块从按页分配的块池中取用，大小只取决于牌数：
+ * 头部 8 字节 + 两个位图各 ⌈P/16⌉×2 字节 + 底牌堆每张 2 字节（最多 1 + P + T 张），按 8 字节对齐。
+ *
+ * 写时复制：关卡布局（BoardLayout）和开局状态块由所有会话共享；新会话不分配任何状态块，
+ * 第一次成功执行操作时才复制一份开局状态；回退到开局时归还状态块，重新共享。
+ * 非法操作不会触发复制。
+ *
+ * 宿主不加锁，只在一个线程中使用；多线程托管时每个线程一个宿主，各宿主共享同一份 BoardLayout。
+ */
+class SessionHost {
+public:
+    SessionHost();
+    ~SessionHost();
+
+    SessionHost(const SessionHost&) = delete;
+    SessionHost& operator=(const SessionHost&) = delete;
+
+    // 登记关卡，返回关卡序号；同一份布局只登记一次。布局无效时返回 -1
+    int addLevel(const std::shared_ptr<const BoardLayout>& layout);
+    int getLevelCount() const { return static_cast<int>(_levels.size()); }
+    const BoardLayout& getLayout(int level) const { return *_levels[level]->layout; }
+
+    // 创建会话（开局状态，不分配状态块），关卡序号无效时返回无效句柄
+    SessionHandle createSession(int level);
+    void destroySession(SessionHandle handle);
+    bool isAlive(SessionHandle handle) const;
+
+    // 回到开局（归还状态块）
+    void resetSession(SessionHandle handle);
+
+    // 执行操作，非法操作或句柄无效时返回 false 且不改变状态
+    bool applyMove(SessionHandle handle, const GameMove& move);
+
+    // 状态查询（句柄需有效）
+    int getLevel(SessionHandle handle) const { return _slots[handle.index].level; }
+    int getLiveCount(SessionHandle handle) const;
+    int getTrayRemaining(SessionHandle handle) const;
+    int getStackSize(SessionHandle handle) const;
+    int getTopCardId(SessionHandle handle) const;
+    int getStackCardId(SessionHandle handle, int index) const;   // 0 为开局顶牌，之后每张对应一步
+    bool isLive(SessionHandle handle, int cardId) const;
+    bool isExposed(SessionHandle handle, int cardId) const;
+    bool canMatch(SessionHandle handle, int cardId) const;
+    bool isWon(SessionHandle handle) const { return getLiveCount(handle) == 0; }
+    uint32_t getMoveCount(SessionHandle handle) const { return _slots[handle.index].moves; }
+
+    // 收集当前可匹配的主牌区卡牌
+    void collectPlayable(SessionHandle handle, std::vector<int>& outCardIds) const;
+
+    // 按底牌堆重放出等价的 BoardState（校验、交给求解器或分析服务）
+    bool toBoardState(SessionHandle handle, BoardState& outState) const;
+
+    // 快照：把会话的状态块原样拷出 / 拷回（getBlockUnits 个 uint16），用于回滚
+    // 恢复到开局状态时归还状态块；操作数不在状态块中，不随快照恢复
+    void saveState(SessionHandle handle, uint16_t* outState) const;
+    void restoreState(SessionHandle handle, const uint16_t* state);
+
+    // 状态校验和（由底牌堆决定，两端状态相同时相同），用于检测对局双方不同步
+    uint32_t getStateChecksum(SessionHandle handle) const;
+
+    // 单个会话当前占用的字节数（槽位 + 持有的状态块）
+    size_t getSessionBytes(SessionHandle handle) const;
+
+    // 关卡的状态块字节数
+    size_t getBlockBytes(int level) const { return _levels[level]->blockUnits * sizeof(uint16_t); }
+    size_t getBlockUnits(int level) const { return _levels[level]->blockUnits; }
+
+    SessionMemoryReport getMemoryReport() const;
+
+private:
+    static const uint32_t SHARED_BLOCK = 0xFFFFFFFFu;   // 仍共享开局状态
+    static const uint16_t FREE_LEVEL = 0xFFFF;           // 空闲槽位
+
+    /**
+     * 会话槽位（16 字节）
+     */
+    struct SessionSlot {
+        uint32_t generation;
+        uint32_t block;          // 状态块序号；空闲槽位时为下一个空闲槽位
+        uint32_t moves;          // 已执行的操作数
+        uint16_t level;
+        uint16_t reserved;
+    };
+
+    /**
+     * 一个关卡：共享的只读数据和该关卡状态块的块池
+     * 状态块以 uint16 为单位：[0] 底牌堆张数 [1] 备用牌剩余 [2] 在场张数 [3] 保留，
+     * 之后依次为在场位图、可点击位图（各 bitsetUnits 个）和底牌堆（卡牌ID）
+     */
+    struct Level {
+        std::shared_ptr<const BoardLayout> layout;
+        const uint64_t* matchRows;
+        uint32_t bitsetUnits;
+        uint32_t blockUnits;
+        uint32_t blocksPerPage;
+        std::vector<uint16_t> initial;                  // 开局状态块
+        std::vector<std::unique_ptr<uint16_t[]>> pages;
+        uint32_t blockCount;                            // 已切出的块数
+        uint32_t freeBlock;                             // 空闲块链表头（SHARED_BLOCK 表示空）
+        uint32_t ownedBlocks;
+    };
+
+    const SessionSlot* slotOf(SessionHandle handle) const;
+
+    // 只读访问：未持有状态块时返回开局状态
+    const uint16_t* readBlock(const SessionSlot& slot) const;
+
+    // 写访问：未持有状态块时复制开局状态
+    uint16_t* writeBlock(SessionSlot& slot);
+
+    uint16_t* blockAt(Level& level, uint32_t block);
+    const uint16_t* blockAt(const Level& level, uint32_t block) const;
+    uint32_t allocateBlock(Level& level);
+    void releaseBlock(SessionSlot& slot);
+
+    bool canMatchIn(const Level& level, const uint16_t* block, int cardId) const;
+    bool computeExposed(const Level& level, const uint16_t* block, int cardId) const;
+    void removeFromPlayfield(const Level& level, uint16_t* block, int cardId);
+    void restoreToPlayfield(const Level& level, uint16_t* block, int cardId);
+
+    std::vector<std::unique_ptr<Level>> _levels;
+    std::vector<SessionSlot> _slots;
+    uint32_t _freeSlot;
+    size_t _sessionCount;
+};
+
+#endif // __SESSION_HOST_H__
@@ -0,0 +1,259 @@
+#include "TelemetryRecorder.h"
+#include "zlib.h"
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+namespace {
+
+const size_t WRITE_BATCH = 512;
+
+void writeLE(unsigned char* out, uint64_t value, int bytes)
+{
+    for (int i = 0; i < bytes; i++) {
+        out[i] = static_cast<unsigned char>((value >> (i * 8)) & 0xFF);
+    }
+}
+
+uint64_t readLE(const unsigned char* data, int bytes)
+{
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; i++) {
+        value |= static_cast<uint64_t>(data[i]) << (i * 8);
+    }
+    return value;
+}
+
+} // namespace
+
+const char TelemetryRecorder::FILE_MAGIC[4] = { 'C', 'G', 'T', 'M' };
+
+void TelemetryRecord::encode(unsigned char* out) const
+{
+    std::memset(out, 0, RECORD_SIZE);
+    writeLE(out + 0, timeUs, 8);
+    writeLE(out + 8, decideUs, 4);
+    writeLE(out + 12, levelSeq, 4);
+    writeLE(out + 16, moveIndex, 2);
+    writeLE(out + 18, static_cast<uint16_t>(cardId), 2);
+    writeLE(out + 20, liveCount, 2);
+    writeLE(out + 22, trayRemaining, 2);
+    writeLE(out + 24, undoDepth, 2);
+    out[26] = type;
+    out[27] = matchRule;
+    out[28] = playableCount;
+}
+
+TelemetryRecord TelemetryRecord::decode(const unsigned char* data)
+{
+    TelemetryRecord rec;
+    rec.timeUs = readLE(data + 0, 8);
+    rec.decideUs = static_cast<uint32_t>(readLE(data + 8, 4));
+    rec.levelSeq = static_cast<uint32_t>(readLE(data + 12, 4));
+    rec.moveIndex = static_cast<uint16_t>(readLE(data + 16, 2));
+    rec.cardId = static_cast<int16_t>(readLE(data + 18, 2));
+    rec.liveCount = static_cast<uint16_t>(readLE(data + 20, 2));
+    rec.trayRemaining = static_cast<uint16_t>(readLE(data + 22, 2));
+    rec.undoDepth = static_cast<uint16_t>(readLE(data + 24, 2));
+    rec.type = data[26];
+    rec.matchRule = data[27];
+    rec.playableCount = data[28];
+    return rec;
+}
+
+const char* TelemetryRecord::typeName(uint8_t type)
+{
+    switch (type) {
+    case LEVEL_START: return "level_start";
+    case MATCH:       return "match";
+    case FLIP:        return "flip";
+    case UNDO:        return "undo";
+    case REJECTED:    return "rejected";
+    case DEAD_END:    return "dead_end";
+    case LEVEL_WON:   return "level_won";
+    }
+    return "unknown";
+}
+
+TelemetryRecorder::TelemetryRecorder()
+    : _queueCapacity(4096)
+    , _maxFileBytes(1 << 20)
+    , _maxFiles(8)
+    , _flushIntervalMs(200)
+    , _queue(nullptr)
+    , _running(false)
+    , _startTime(std::chrono::steady_clock::now())
+    , _file(nullptr)
+    , _fileBytes(0)
+    , _fileIndex(0)
+    , _recorded(0)
+    , _dropped(0)
+    , _written(0)
+{
+}
+
+TelemetryRecorder::~TelemetryRecorder()
+{
+    stop();
+}
+
+bool TelemetryRecorder::start(const std::string& directory, const std::string& prefix)
+{
+    if (_running.load()) {
+        return false;
+    }
+
+    _directory = directory;
+    if (!_directory.empty() && _directory.back() != '/' && _directory.back() != '\\') {
+        _directory += '/';
+    }
+    _prefix = prefix;
+
+    // 以启动时刻区分不同运行写出的文件
+    char tag[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(tag, sizeof(tag), "%Y%m%d_%H%M%S", std::localtime(&now));
+    _sessionTag = tag;
+    _fileIndex = 0;
+    _files.clear();
+
+    delete _queue;
+    _queue = new SpscQueue<TelemetryRecord>(_queueCapacity);
+    _encodeBuffer.resize(WRITE_BATCH * TelemetryRecord::RECORD_SIZE);
+    _startTime = std::chrono::steady_clock::now();
+
+    _running.store(true);
+    _writer = std::thread(&TelemetryRecorder::writerLoop, this);
+    return true;
+}
+
+void TelemetryRecorder::stop()
+{
+    if (!_running.exchange(false)) {
+        return;
+    }
+    if (_writer.joinable()) {
+        _writer.join();
+    }
+    delete _queue;
+    _queue = nullptr;
+}
+
+bool TelemetryRecorder::record(TelemetryRecord rec)
+{
+    if (!_running.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    rec.timeUs = nowUs();
+    if (!_queue->push(rec)) {
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    _recorded.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+uint64_t TelemetryRecorder::nowUs() const
+{
+    auto elapsed = std::chrono::steady_clock::now() - _startTime;
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+}
+
+void TelemetryRecorder::writerLoop()
+{
+    TelemetryRecord batch[WRITE_BATCH];
+    bool unflushed = false;
+
+    while (true) {
+        bool running = _running.load();
+        size_t count = _queue->popBatch(batch, WRITE_BATCH);
+        if (count > 0) {
+            writeBatch(batch, count);
+            unflushed = true;
+            continue;   // 队列可能还有积压，继续取
+        }
+        if (!running) {
+            break;
+        }
+
+        // 空闲时把已写内容刷到磁盘，避免进程被杀时丢失太多
+        if (unflushed && _file) {
+            gzflush(static_cast<gzFile>(_file), Z_SYNC_FLUSH);
+            unflushed = false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(_flushIntervalMs));
+    }
+
+    closeFile();
+}
+
+void TelemetryRecorder::writeBatch(const TelemetryRecord* records, size_t count)
+{
+    size_t i = 0;
+    while (i < count) {
+        if (!_file || _fileBytes >= _maxFileBytes) {
+            if (!openNextFile()) {
+                _dropped.fetch_add(count - i, std::memory_order_relaxed);
+                return;
+            }
+        }
+
+        // 不跨越文件大小上限
+        size_t room = (_maxFileBytes - _fileBytes + TelemetryRecord::RECORD_SIZE - 1) / TelemetryRecord::RECORD_SIZE;
+        size_t n = count - i < room ? count - i : room;
+        for (size_t k = 0; k < n; k++) {
+            records[i + k].encode(&_encodeBuffer[k * TelemetryRecord::RECORD_SIZE]);
+        }
+        unsigned int bytes = static_cast<unsigned int>(n * TelemetryRecord::RECORD_SIZE);
+        if (gzwrite(static_cast<gzFile>(_file), _encodeBuffer.data(), bytes) != static_cast<int>(bytes)) {
+            _dropped.fetch_add(count - i, std::memory_order_relaxed);
+            closeFile();
+            return;
+        }
+        _fileBytes += bytes;
+        _written.fetch_add(n, std::memory_order_relaxed);
+        i += n;
+    }
+}
+
+bool TelemetryRecorder::openNextFile()
+{
+    closeFile();
+
+    // 超过保留数量时删除最早的文件
+    while (_maxFiles > 0 && static_cast<int>(_files.size()) >= _maxFiles) {
+        std::remove(_files.front().c_str());
+        _files.erase(_files.begin());
+    }
+
+    char name[64];
+    std::snprintf(name, sizeof(name), "_%s_%03d.cgt.gz", _sessionTag.c_str(), _fileIndex++);
+    std::string path = _directory + _prefix + name;
+
+    gzFile file = gzopen(path.c_str(), "wb6");
+    if (!file) {
+        return false;
+    }
+
+    unsigned char header[FILE_HEADER_SIZE] = { 0 };
+    std::memcpy(header, FILE_MAGIC, sizeof(FILE_MAGIC));
+    header[4] = FILE_VERSION;
+    header[5] = static_cast<unsigned char>(TelemetryRecord::RECORD_SIZE);
+    if (gzwrite(file, header, sizeof(header)) != static_cast<int>(sizeof(header))) {
+        gzclose(file);
+        return false;
+    }
+
+    _file = file;
+    _fileBytes = 0;
+    _files.push_back(path);
+    return true;
+}
+
+void TelemetryRecorder::closeFile()
+{
+    if (_file) {
+        gzclose(static_cast<gzFile>(_file));
+        _file = nullptr;
+    }
+}
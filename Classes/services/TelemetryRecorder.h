@@ -0,0 +1,129 @@
+#ifndef __TELEMETRY_RECORDER_H__
+#define __TELEMETRY_RECORDER_H__
+
+#include "utils/SpscQueue.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * 单条遥测记录（定长，文件中按小端序占 RECORD_SIZE 字节）
+ */
+struct TelemetryRecord {
+    enum Type : uint8_t {
+        LEVEL_START = 1,     // 关卡开始
+        MATCH,               // 匹配
+        FLIP,                // 翻牌
+        UNDO,                // 回退
+        REJECTED,            // 点击了不能匹配的牌
+        DEAD_END,            // 无牌可走（未通关且备用牌已翻完）
+        LEVEL_WON            // 通关
+    };
+
+    static const size_t RECORD_SIZE = 32;
+
+    uint64_t timeUs;          // 距录制开始的微秒数
+    uint32_t decideUs;        // 距上一步提交（或关卡开始）到本次点击的时间
+    uint32_t levelSeq;        // 本次运行中的第几个关卡
+    uint16_t moveIndex;       // 本关第几步
+    int16_t cardId;           // 相关卡牌ID，无则为 -1
+    uint16_t liveCount;       // 主牌区剩余张数
+    uint16_t trayRemaining;   // 备用牌堆剩余张数
+    uint16_t undoDepth;       // 撤销栈深度
+    uint8_t type;
+    uint8_t matchRule;
+    uint8_t playableCount;    // 当前可匹配的牌数（最多 255）
+
+    TelemetryRecord()
+        : timeUs(0), decideUs(0), levelSeq(0), moveIndex(0), cardId(-1)
+        , liveCount(0), trayRemaining(0), undoDepth(0), type(0), matchRule(0), playableCount(0)
+    {
+    }
+
+    void encode(unsigned char* out) const;
+    static TelemetryRecord decode(const unsigned char* data);
+    static const char* typeName(uint8_t type);
+};
+
+/**
+ * 异步遥测写入器
+ *
+ * 主线程 record() 只把定长记录放进无锁 SPSC 队列（满时丢弃并计数），不做任何 IO；
+ * 后台线程定期批量取出，写入 gzip 压缩的本地文件。单个文件达到 maxFileBytes（未压缩）后轮转，
+ * 最多保留 maxFiles 个本次运行写出的文件。内存占用固定为队列容量加一个批次缓冲。
+ *
+ * 文件格式：gzip 流，解压后为 8 字节文件头 "CGTM" + 版本(u8) + 记录大小(u8) + 保留(u16)，之后是连续的记录。
+ * 可用 tools/telemetry_reader 转为 CSV。
+ */
+class TelemetryRecorder {
+public:
+    static const char FILE_MAGIC[4];
+    static const unsigned char FILE_VERSION = 1;
+    static const size_t FILE_HEADER_SIZE = 8;
+
+    TelemetryRecorder();
+    ~TelemetryRecorder();
+
+    // 以下设置需在 start 之前调用
+    void setQueueCapacity(size_t records) { _queueCapacity = records; }
+    void setMaxFileBytes(size_t bytes) { _maxFileBytes = bytes; }
+    void setMaxFiles(int count) { _maxFiles = count; }
+    void setFlushInterval(int milliseconds) { _flushIntervalMs = milliseconds; }
+
+    // 启动后台写线程，文件写入 directory（需已存在），文件名以 prefix 开头
+    bool start(const std::string& directory, const std::string& prefix = "telemetry");
+
+    // 写完队列中剩余记录后停止
+    void stop();
+
+    bool isRunning() const { return _running.load(std::memory_order_relaxed); }
+
+    // 主线程调用：填上时间戳后入队；未启动或队列满时返回 false
+    bool record(TelemetryRecord rec);
+
+    // 距录制开始的微秒数
+    uint64_t nowUs() const;
+
+    // 统计
+    uint64_t getRecordedCount() const { return _recorded.load(std::memory_order_relaxed); }
+    uint64_t getDroppedCount() const { return _dropped.load(std::memory_order_relaxed); }
+    uint64_t getWrittenCount() const { return _written.load(std::memory_order_relaxed); }
+
+private:
+    TelemetryRecorder(const TelemetryRecorder&) = delete;
+    TelemetryRecorder& operator=(const TelemetryRecorder&) = delete;
+
+    void writerLoop();
+    bool openNextFile();
+    void closeFile();
+    void writeBatch(const TelemetryRecord* records, size_t count);
+
+    size_t _queueCapacity;
+    size_t _maxFileBytes;
+    int _maxFiles;
+    int _flushIntervalMs;
+
+    SpscQueue<TelemetryRecord>* _queue;
+    std::thread _writer;
+    std::atomic<bool> _running;
+    std::chrono::steady_clock::time_point _startTime;
+
+    // 以下只在写线程中访问
+    std::string _directory;
+    std::string _prefix;
+    std::string _sessionTag;
+    void* _file;                          // gzFile
+    size_t _fileBytes;
+    int _fileIndex;
+    std::vector<std::string> _files;      // 本次运行写出的文件（用于轮转删除）
+    std::vector<unsigned char> _encodeBuffer;
+
+    std::atomic<uint64_t> _recorded;
+    std::atomic<uint64_t> _dropped;
+    std::atomic<uint64_t> _written;
+};
+
+#endif // __TELEMETRY_RECORDER_H__
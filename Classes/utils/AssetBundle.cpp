@@ -0,0 +1,349 @@
+#include "AssetBundle.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char BUNDLE_MAGIC[4] = { 'C', 'G', 'P', 'K' };
+
+void setError(std::string* error, const std::string& msg)
+{
+    if (error) {
+        *error = msg;
+    }
+}
+
+uint32_t readU32(const unsigned char* p)
+{
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8)
+        | (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint64_t readU64(const unsigned char* p)
+{
+    return static_cast<uint64_t>(readU32(p)) | (static_cast<uint64_t>(readU32(p + 4)) << 32);
+}
+
+void writeU32(unsigned char* p, uint32_t value)
+{
+    for (int i = 0; i < 4; i++) {
+        p[i] = static_cast<unsigned char>((value >> (i * 8)) & 0xFF);
+    }
+}
+
+void writeU64(unsigned char* p, uint64_t value)
+{
+    writeU32(p, static_cast<uint32_t>(value));
+    writeU32(p + 4, static_cast<uint32_t>(value >> 32));
+}
+
+// 条目字段偏移
+const size_t ENTRY_OFFSET = 0;
+const size_t ENTRY_SIZE_FIELD = 8;
+const size_t ENTRY_HASH = 16;
+const size_t ENTRY_NAME_OFFSET = 24;
+const size_t ENTRY_NAME_LENGTH = 28;
+
+// 按字节序比较路径（与 std::string 的比较一致）
+int compareNames(const char* a, size_t aLength, const char* b, size_t bLength)
+{
+    int result = std::memcmp(a, b, std::min(aLength, bLength));
+    if (result != 0) {
+        return result;
+    }
+    return aLength < bLength ? -1 : (aLength > bLength ? 1 : 0);
+}
+
+size_t alignUp(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+AssetBundle::AssetBundle()
+    : _base(nullptr)
+    , _size(0)
+    , _entryCount(0)
+    , _strings(nullptr)
+#if defined(_WIN32)
+    , _file(INVALID_HANDLE_VALUE)
+    , _mapping(nullptr)
+#endif
+{
+}
+
+AssetBundle::~AssetBundle()
+{
+    close();
+}
+
+bool AssetBundle::open(const std::string& path, std::string* error)
+{
+    close();
+
+#if defined(_WIN32)
+    int wideLength = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+    std::wstring widePath(wideLength > 0 ? wideLength : 1, L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, &widePath[0], wideLength);
+    HANDLE file = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        setError(error, "cannot open " + path);
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < static_cast<LONGLONG>(HEADER_SIZE)) {
+        CloseHandle(file);
+        setError(error, "truncated bundle " + path);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        setError(error, "cannot map " + path);
+        return false;
+    }
+    _file = file;
+    _mapping = mapping;
+    _size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        setError(error, "cannot open " + path);
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(HEADER_SIZE)) {
+        ::close(fd);
+        setError(error, "truncated bundle " + path);
+        return false;
+    }
+    void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    // 映射建立后文件描述符不再需要
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        setError(error, "cannot map " + path);
+        return false;
+    }
+    _size = static_cast<size_t>(st.st_size);
+#endif
+    _base = static_cast<const unsigned char*>(view);
+
+    // 文件头
+    uint32_t entryCount = readU32(_base + 8);
+    uint32_t stringTableSize = readU32(_base + 12);
+    uint64_t totalSize = readU64(_base + 16);
+    size_t indexSize = static_cast<size_t>(entryCount) * ENTRY_SIZE + stringTableSize;
+    if (std::memcmp(_base, BUNDLE_MAGIC, 4) != 0 || readU32(_base + 4) != VERSION) {
+        close();
+        setError(error, "not an asset bundle: " + path);
+        return false;
+    }
+    if (totalSize != _size || entryCount > (_size - HEADER_SIZE) / ENTRY_SIZE || indexSize > _size - HEADER_SIZE) {
+        close();
+        setError(error, "truncated bundle " + path);
+        return false;
+    }
+    if (hashBytes(HASH_SEED, _base + HEADER_SIZE, indexSize) != readU64(_base + 24)) {
+        close();
+        setError(error, "corrupt bundle index " + path);
+        return false;
+    }
+    _entryCount = entryCount;
+    _strings = reinterpret_cast<const char*>(_base + HEADER_SIZE + static_cast<size_t>(entryCount) * ENTRY_SIZE);
+
+    // 条目范围和排序（二分查找依赖排序），这里检查一次，之后访问不再检查
+    for (uint32_t i = 0; i < entryCount; i++) {
+        const unsigned char* entry = entryAt(static_cast<int>(i));
+        uint64_t offset = readU64(entry + ENTRY_OFFSET);
+        uint64_t size = readU64(entry + ENTRY_SIZE_FIELD);
+        uint32_t nameOffset = readU32(entry + ENTRY_NAME_OFFSET);
+        uint32_t nameLength = readU32(entry + ENTRY_NAME_LENGTH);
+        bool valid = offset <= _size && size <= _size - offset
+            && nameOffset <= stringTableSize && nameLength <= stringTableSize - nameOffset;
+        if (valid && i > 0) {
+            const unsigned char* prev = entryAt(static_cast<int>(i - 1));
+            valid = compareNames(_strings + readU32(prev + ENTRY_NAME_OFFSET), readU32(prev + ENTRY_NAME_LENGTH),
+                                 _strings + nameOffset, nameLength) < 0;
+        }
+        if (!valid) {
+            close();
+            setError(error, "corrupt bundle entry in " + path);
+            return false;
+        }
+    }
+    return true;
+}
+
+void AssetBundle::close()
+{
+    if (_base) {
+#if defined(_WIN32)
+        UnmapViewOfFile(_base);
+#else
+        munmap(const_cast<unsigned char*>(_base), _size);
+#endif
+    }
+#if defined(_WIN32)
+    if (_mapping) {
+        CloseHandle(_mapping);
+        _mapping = nullptr;
+    }
+    if (_file != INVALID_HANDLE_VALUE) {
+        CloseHandle(_file);
+        _file = INVALID_HANDLE_VALUE;
+    }
+#endif
+    _base = nullptr;
+    _size = 0;
+    _entryCount = 0;
+    _strings = nullptr;
+}
+
+int AssetBundle::find(const char* name, size_t length) const
+{
+    int low = 0;
+    int high = static_cast<int>(_entryCount) - 1;
+    while (low <= high) {
+        int mid = low + (high - low) / 2;
+        const unsigned char* entry = entryAt(mid);
+        int result = compareNames(_strings + readU32(entry + ENTRY_NAME_OFFSET), readU32(entry + ENTRY_NAME_LENGTH), name, length);
+        if (result == 0) {
+            return mid;
+        }
+        if (result < 0) {
+            low = mid + 1;
+        }
+        else {
+            high = mid - 1;
+        }
+    }
+    return -1;
+}
+
+std::string AssetBundle::getName(int index) const
+{
+    const unsigned char* entry = entryAt(index);
+    return std::string(_strings + readU32(entry + ENTRY_NAME_OFFSET), readU32(entry + ENTRY_NAME_LENGTH));
+}
+
+const unsigned char* AssetBundle::getData(int index) const
+{
+    return _base + readU64(entryAt(index) + ENTRY_OFFSET);
+}
+
+size_t AssetBundle::getSize(int index) const
+{
+    return static_cast<size_t>(readU64(entryAt(index) + ENTRY_SIZE_FIELD));
+}
+
+uint64_t AssetBundle::getHash(int index) const
+{
+    return readU64(entryAt(index) + ENTRY_HASH);
+}
+
+bool AssetBundle::verify(int index) const
+{
+    return hashBytes(HASH_SEED, getData(index), getSize(index)) == getHash(index);
+}
+
+int AssetBundle::verifyAll() const
+{
+    for (uint32_t i = 0; i < _entryCount; i++) {
+        if (!verify(static_cast<int>(i))) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+bool AssetBundle::build(const std::vector<std::string>& names, const std::vector<std::string>& contents,
+                        std::vector<unsigned char>& outData, std::string* error)
+{
+    if (names.size() != contents.size()) {
+        setError(error, "names and contents differ in size");
+        return false;
+    }
+
+    std::vector<size_t> order(names.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&names](size_t a, size_t b) { return names[a] < names[b]; });
+    for (size_t i = 1; i < order.size(); i++) {
+        if (names[order[i]] == names[order[i - 1]]) {
+            setError(error, "duplicate path " + names[order[i]]);
+            return false;
+        }
+    }
+
+    size_t stringTableSize = 0;
+    for (const auto& name : names) {
+        stringTableSize += name.size();
+    }
+    size_t dataStart = alignUp(HEADER_SIZE + names.size() * ENTRY_SIZE + stringTableSize, DATA_ALIGNMENT);
+    size_t totalSize = dataStart;
+    for (size_t index : order) {
+        totalSize = alignUp(totalSize, DATA_ALIGNMENT) + contents[index].size();
+    }
+    if (names.size() > 0xFFFFFFFFu || stringTableSize > 0xFFFFFFFFu) {
+        setError(error, "too many files");
+        return false;
+    }
+
+    outData.assign(totalSize, 0);
+    unsigned char* base = outData.data();
+    unsigned char* strings = base + HEADER_SIZE + names.size() * ENTRY_SIZE;
+    size_t nameOffset = 0;
+    size_t dataOffset = dataStart;
+    for (size_t i = 0; i < order.size(); i++) {
+        const std::string& name = names[order[i]];
+        const std::string& content = contents[order[i]];
+        dataOffset = alignUp(dataOffset, DATA_ALIGNMENT);
+
+        unsigned char* entry = base + HEADER_SIZE + i * ENTRY_SIZE;
+        writeU64(entry + ENTRY_OFFSET, dataOffset);
+        writeU64(entry + ENTRY_SIZE_FIELD, content.size());
+        writeU64(entry + ENTRY_HASH, hashBytes(HASH_SEED, content.data(), content.size()));
+        writeU32(entry + ENTRY_NAME_OFFSET, static_cast<uint32_t>(nameOffset));
+        writeU32(entry + ENTRY_NAME_LENGTH, static_cast<uint32_t>(name.size()));
+
+        std::memcpy(strings + nameOffset, name.data(), name.size());
+        if (!content.empty()) {
+            std::memcpy(base + dataOffset, content.data(), content.size());
+        }
+        nameOffset += name.size();
+        dataOffset += content.size();
+    }
+
+    std::memcpy(base, BUNDLE_MAGIC, 4);
+    writeU32(base + 4, VERSION);
+    writeU32(base + 8, static_cast<uint32_t>(names.size()));
+    writeU32(base + 12, static_cast<uint32_t>(stringTableSize));
+    writeU64(base + 16, totalSize);
+    writeU64(base + 24, hashBytes(HASH_SEED, base + HEADER_SIZE, names.size() * ENTRY_SIZE + stringTableSize));
+    return true;
+}
+
+uint64_t AssetBundle::hashBytes(uint64_t hash, const void* data, size_t size)
+{
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= p[i];
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
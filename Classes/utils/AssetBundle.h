@@ -0,0 +1,76 @@
+#ifndef __ASSET_BUNDLE_H__
+#define __ASSET_BUNDLE_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * 资源包（tools/assetpack 生成的 .cgpk）
+ *
+ * 文件布局（小端）：
+ *   文件头    magic "CGPK"、版本、条目数、字符串表大小、文件总大小、索引哈希（32 字节）
+ *   条目表    每条 32 字节：数据偏移、大小、内容哈希、路径在字符串表中的偏移和长度，按路径字节序排序
+ *   字符串表  所有路径（相对资源根目录，分隔符为 '/'）
+ *   数据      每个文件按 16 字节对齐
+ *
+ * 整个文件只读映射到内存：查找是对条目表的二分查找，读取直接返回映射中的指针，不产生系统调用和拷贝。
+ * 哈希为 FNV-1a 64 位；打开时校验文件头和索引，内容哈希由 verify 按需校验。
+ * 不依赖 cocos2d，游戏（BundleFileUtils）和打包工具共用。
+ */
+class AssetBundle {
+public:
+    static const uint32_t VERSION = 1;
+    static const size_t HEADER_SIZE = 32;
+    static const size_t ENTRY_SIZE = 32;
+    static const size_t DATA_ALIGNMENT = 16;
+    static const uint64_t HASH_SEED = 0xCBF29CE484222325ULL;
+
+    AssetBundle();
+    ~AssetBundle();
+
+    // 映射并检查资源包；失败时保持关闭状态
+    bool open(const std::string& path, std::string* error = nullptr);
+    void close();
+    bool isOpen() const { return _base != nullptr; }
+
+    // 按相对路径查找（如 "res/card_general.png"），不存在时返回 -1
+    int find(const char* name, size_t length) const;
+    int find(const std::string& name) const { return find(name.data(), name.size()); }
+
+    int getEntryCount() const { return static_cast<int>(_entryCount); }
+    std::string getName(int index) const;
+    const unsigned char* getData(int index) const;
+    size_t getSize(int index) const;
+    uint64_t getHash(int index) const;
+
+    // 重新计算内容哈希并与索引比较
+    bool verify(int index) const;
+
+    // 校验所有条目，返回第一个损坏的条目；全部正确时返回 -1
+    int verifyAll() const;
+
+    // 生成资源包，names 与 contents 一一对应（路径可以无序，不能重复）
+    static bool build(const std::vector<std::string>& names, const std::vector<std::string>& contents,
+                      std::vector<unsigned char>& outData, std::string* error = nullptr);
+
+    static uint64_t hashBytes(uint64_t hash, const void* data, size_t size);
+
+private:
+    AssetBundle(const AssetBundle&) = delete;
+    AssetBundle& operator=(const AssetBundle&) = delete;
+
+    const unsigned char* entryAt(int index) const { return _base + HEADER_SIZE + static_cast<size_t>(index) * ENTRY_SIZE; }
+
+    const unsigned char* _base;      // 映射起始地址，未打开时为空
+    size_t _size;
+    uint32_t _entryCount;
+    const char* _strings;            // 字符串表
+#if defined(_WIN32)
+    void* _file;
+    void* _mapping;
+#endif
+};
+
+#endif // __ASSET_BUNDLE_H__
@@ -0,0 +1,297 @@
+#include "AssetVariantLoader.h"
+#include "base/etc1.h"
+#include <algorithm>
+
+USING_NS_CC;
+
+namespace {
+
+// 与 tools/assetc/PvrWriter 一致
+const uint32_t PVR3_VERSION = 0x03525650;            // "PVR\3"
+const uint32_t PVR3_FLAG_PREMULTIPLIED = 0x02;
+const size_t PVR3_HEADER_SIZE = 52;
+const uint64_t PVR3_ETC1 = 6;
+const uint64_t PVR3_RGBA8888 = 0x0808080861626772ULL;
+const uint64_t PVR3_RGBA4444 = 0x0404040461626772ULL;
+const uint64_t PVR3_RGB565 = 0x0005060500626772ULL;
+
+// initWithMipmaps 不设置预乘标记，由这里按文件头补上；
+// GL 上下文重建后旧的纹理名已失效，可能已分配给其他纹理，重新上传前清零而不删除
+class VariantTexture : public Texture2D {
+public:
+    void setPremultipliedAlpha(bool premultiplied) { _hasPremultipliedAlpha = premultiplied; }
+    void forgetGLTexture() { _name = 0; }
+};
+
+void setError(std::string* error, const std::string& msg)
+{
+    if (error) {
+        *error = msg;
+    }
+}
+
+uint32_t readU32(const unsigned char* p)
+{
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8)
+        | (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+struct PvrTexture {
+    Texture2D::PixelFormat format;
+    bool etc1;
+    bool premultiplied;
+    int width;
+    int height;
+    std::vector<MipmapInfo> levels;     // 指向文件数据
+
+    PvrTexture() : format(Texture2D::PixelFormat::NONE), etc1(false), premultiplied(false), width(0), height(0) {}
+};
+
+bool parsePvr(const Data& data, PvrTexture& out, std::string* error)
+{
+    const unsigned char* bytes = data.getBytes();
+    size_t size = static_cast<size_t>(data.getSize());
+    if (size < PVR3_HEADER_SIZE || readU32(bytes) != PVR3_VERSION) {
+        setError(error, "not a PVR v3 file");
+        return false;
+    }
+
+    uint64_t pixelFormat = readU32(bytes + 8) | (static_cast<uint64_t>(readU32(bytes + 12)) << 32);
+    int bytesPerPixel = 0;
+    if (pixelFormat == PVR3_ETC1) {
+        out.format = Texture2D::PixelFormat::ETC;
+        out.etc1 = true;
+    }
+    else if (pixelFormat == PVR3_RGBA8888) {
+        out.format = Texture2D::PixelFormat::RGBA8888;
+        bytesPerPixel = 4;
+    }
+    else if (pixelFormat == PVR3_RGBA4444) {
+        out.format = Texture2D::PixelFormat::RGBA4444;
+        bytesPerPixel = 2;
+    }
+    else if (pixelFormat == PVR3_RGB565) {
+        out.format = Texture2D::PixelFormat::RGB565;
+        bytesPerPixel = 2;
+    }
+    else {
+        setError(error, "unsupported pixel format");
+        return false;
+    }
+    out.premultiplied = (readU32(bytes + 4) & PVR3_FLAG_PREMULTIPLIED) != 0;
+    out.height = static_cast<int>(readU32(bytes + 24));
+    out.width = static_cast<int>(readU32(bytes + 28));
+    uint32_t levelCount = readU32(bytes + 44);
+    size_t offset = PVR3_HEADER_SIZE + readU32(bytes + 48);
+    if (out.width <= 0 || out.height <= 0 || levelCount == 0) {
+        setError(error, "invalid PVR header");
+        return false;
+    }
+
+    // 各级依次存放，ETC1 不足 4 的边按整块计
+    for (uint32_t i = 0; i < levelCount; i++) {
+        int width = std::max(1, out.width >> i);
+        int height = std::max(1, out.height >> i);
+        size_t levelSize = out.etc1
+            ? static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * 8
+            : static_cast<size_t>(width) * height * bytesPerPixel;
+        if (offset + levelSize > size) {
+            setError(error, "truncated PVR data");
+            return false;
+        }
+        MipmapInfo level;
+        level.address = const_cast<unsigned char*>(bytes + offset);
+        level.len = static_cast<int>(levelSize);
+        out.levels.push_back(level);
+        offset += levelSize;
+    }
+    return true;
+}
+
+// 读取 path 并上传到 texture（已有纹理时替换），outPremultiplied 为文件头中的预乘标记
+bool uploadTexture(VariantTexture* texture, const std::string& path, bool* outPremultiplied, std::string* error)
+{
+    Data data = FileUtils::getInstance()->getDataFromFile(path);
+    if (data.isNull()) {
+        setError(error, path + ": cannot read");
+        return false;
+    }
+    PvrTexture pvr;
+    std::string parseError;
+    if (!parsePvr(data, pvr, &parseError)) {
+        setError(error, path + ": " + parseError);
+        return false;
+    }
+
+    // 没有 ETC1 硬件解码时逐级解码为 RGB888
+    std::vector<std::vector<unsigned char>> decoded;
+    if (pvr.etc1 && !Configuration::getInstance()->supportsETC()) {
+        decoded.resize(pvr.levels.size());
+        for (size_t i = 0; i < pvr.levels.size(); i++) {
+            int width = std::max(1, pvr.width >> i);
+            int height = std::max(1, pvr.height >> i);
+            decoded[i].resize(static_cast<size_t>(width) * height * 3);
+            if (etc1_decode_image(pvr.levels[i].address, decoded[i].data(), width, height, 3, width * 3) != 0) {
+                setError(error, path + ": cannot decode ETC1");
+                return false;
+            }
+            pvr.levels[i].address = decoded[i].data();
+            pvr.levels[i].len = static_cast<int>(decoded[i].size());
+        }
+        pvr.format = Texture2D::PixelFormat::RGB888;
+    }
+
+    if (!texture->initWithMipmaps(pvr.levels.data(), static_cast<int>(pvr.levels.size()), pvr.format, pvr.width, pvr.height)) {
+        setError(error, path + ": cannot create texture");
+        return false;
+    }
+    if (outPremultiplied) {
+        *outPremultiplied = pvr.premultiplied;
+    }
+    return true;
+}
+
+VariantTexture* createTexture(const std::string& path, std::string* error)
+{
+    auto texture = new (std::nothrow) VariantTexture();
+    if (!texture) {
+        return nullptr;
+    }
+    texture->autorelease();
+    bool premultiplied = false;
+    if (!uploadTexture(texture, path, &premultiplied, error)) {
+        return nullptr;
+    }
+    texture->setPremultipliedAlpha(premultiplied);
+    return texture;
+}
+
+} // namespace
+
+AssetVariantLoader* AssetVariantLoader::s_instance = nullptr;
+
+AssetVariantLoader* AssetVariantLoader::getInstance()
+{
+    if (!s_instance) {
+        s_instance = new AssetVariantLoader();
+    }
+    return s_instance;
+}
+
+void AssetVariantLoader::destroyInstance()
+{
+    CC_SAFE_DELETE(s_instance);
+}
+
+AssetVariantLoader::AssetVariantLoader()
+    : _rendererListener(nullptr)
+{
+}
+
+AssetVariantLoader::~AssetVariantLoader()
+{
+    unload();
+}
+
+bool AssetVariantLoader::load(const AssetVariantManifest& manifest, size_t variantIndex, std::string* error)
+{
+    unload();
+    if (variantIndex >= manifest.variants.size()) {
+        setError(error, "invalid variant");
+        return false;
+    }
+    const AssetVariant& variant = manifest.variants[variantIndex];
+    auto fileUtils = FileUtils::getInstance();
+
+    Map<std::string, SpriteFrame*> frames;
+    Vector<Texture2D*> textures;
+    std::vector<std::string> texturePaths;
+    for (const auto& file : manifest.files) {
+        std::string path = AssetVariants::variantPath(variant, file.path);
+        auto texture = createTexture(path, error);
+        if (!texture) {
+            return false;
+        }
+        textures.pushBack(texture);
+        texturePaths.push_back(path);
+
+        // 带透明像素的图片才有 alpha 纹理；挂上后颜色纹理按预乘 alpha 混合
+        std::string alphaPath = AssetVariants::alphaPath(variant, file.path);
+        if (fileUtils->isFileExist(alphaPath)) {
+            auto alpha = createTexture(alphaPath, error);
+            if (!alpha) {
+                return false;
+            }
+            texture->setAlphaTexture(alpha);
+            textures.pushBack(alpha);
+            texturePaths.push_back(alphaPath);
+        }
+
+        // 图片在纹理左上角，矩形和原始尺寸都以像素计
+        Rect rect(0.0f, 0.0f, static_cast<float>(file.widths[variantIndex]), static_cast<float>(file.heights[variantIndex]));
+        frames.insert(file.path, SpriteFrame::createWithTexture(texture, rect, false, Vec2::ZERO, rect.size));
+    }
+    _frames = frames;
+    _textures = textures;
+    _texturePaths = texturePaths;
+
+#if CC_ENABLE_CACHE_TEXTURE_DATA
+    // GL 上下文重建时 TextureCache 在同一事件之后才重新上传自己的纹理（先删除旧纹理名），
+    // 这里先清掉失效的纹理名，下一帧再上传，新分配的纹理名不会被误删
+    _rendererListener = EventListenerCustom::create(EVENT_RENDERER_RECREATED, [this](EventCustom*) {
+        for (auto texture : _textures) {
+            static_cast<VariantTexture*>(texture)->forgetGLTexture();
+        }
+        Director::getInstance()->getScheduler()->performFunctionInCocosThread([this]() {
+            reloadTextures();
+        });
+    });
+    Director::getInstance()->getEventDispatcher()->addEventListenerWithFixedPriority(_rendererListener, 1);
+#endif
+    return true;
+}
+
+void AssetVariantLoader::unload()
+{
+    if (_rendererListener) {
+        Director::getInstance()->getEventDispatcher()->removeEventListener(_rendererListener);
+        _rendererListener = nullptr;
+    }
+    _frames.clear();
+    _textures.clear();
+    _texturePaths.clear();
+}
+
+void AssetVariantLoader::reloadTextures()
+{
+    for (ssize_t i = 0; i < _textures.size(); i++) {
+        std::string error;
+        if (!uploadTexture(static_cast<VariantTexture*>(_textures.at(i)), _texturePaths[i], nullptr, &error)) {
+            CCLOG("AssetVariantLoader: %s", error.c_str());
+        }
+    }
+}
+
+SpriteFrame* AssetVariantLoader::getSpriteFrame(const std::string& file) const
+{
+    return _frames.at(file);
+}
+
+Sprite* AssetVariantLoader::createSprite(const std::string& file) const
+{
+    SpriteFrame* frame = getSpriteFrame(file);
+    return frame ? Sprite::createWithSpriteFrame(frame) : Sprite::create(file);
+}
+
+void AssetVariantLoader::setSpriteTexture(Sprite* sprite, const std::string& file) const
+{
+    SpriteFrame* frame = getSpriteFrame(file);
+    if (!frame) {
+        sprite->setTexture(file);
+        return;
+    }
+    // 精灵初始化时按空纹理选的着色器；有 alpha 纹理时换成 ETC1 分离 alpha 着色器
+    sprite->setGLProgramState(GLProgramState::getOrCreateWithGLProgramName(
+        GLProgram::SHADER_NAME_POSITION_TEXTURE_COLOR_NO_MVP, frame->getTexture()));
+    sprite->setSpriteFrame(frame);
+}
@@ -0,0 +1,56 @@
+#ifndef __ASSET_VARIANT_LOADER_H__
+#define __ASSET_VARIANT_LOADER_H__
+
+#include "cocos2d.h"
+#include "configs/AssetVariants.h"
+#include <string>
+#include <vector>
+
+/**
+ * 资源变体加载
+ *
+ * 把 AssetVariants 选中的一档纹理加载为以原图路径命名的精灵帧：纹理补齐到 2 次幂，帧只取左上角的图片区域，
+ * 大小与原图按 contentScaleFactor 换算后一致。
+ *
+ * PVR 文件在这里解析，按每级 mipmap 的实际大小上传：cocos2d::Image 的 PVR 解析把宽或高不足 2 个块的级别
+ * 按 2 个块计算（PVRTC 的规则），ETC1 的 4x4 以下各级会上传失败。ETC1 的 alpha 纹理通过 Texture2D::setAlphaTexture
+ * 挂到颜色纹理上，精灵随之使用 ETC1 分离 alpha 着色器；设备不支持 ETC1（iOS、桌面 GL）时逐级软件解码为 RGB888。
+ *
+ * 调用方用 createSprite / setSpriteTexture 代替 Sprite::create(file) / setTexture(file)，没有加载变体时照常使用原图。
+ */
+class AssetVariantLoader {
+public:
+    static AssetVariantLoader* getInstance();
+    static void destroyInstance();
+
+    // 加载清单中第 variantIndex 档的全部纹理；任何一张失败时不保留已加载的部分，返回 false（继续使用原图）
+    // 精灵帧按当前 contentScaleFactor 把像素换算为点，需要先设置好 contentScaleFactor
+    bool load(const AssetVariantManifest& manifest, size_t variantIndex, std::string* error = nullptr);
+    void unload();
+    bool isLoaded() const { return !_frames.empty(); }
+
+    // file 为原图路径（如 "res/card_general.png"），没有对应的变体时返回 nullptr
+    cocos2d::SpriteFrame* getSpriteFrame(const std::string& file) const;
+
+    // 有变体时从精灵帧创建，否则同 Sprite::create(file)
+    cocos2d::Sprite* createSprite(const std::string& file) const;
+
+    // 有变体时换成精灵帧（并按纹理重新选择着色器），否则同 sprite->setTexture(file)
+    void setSpriteTexture(cocos2d::Sprite* sprite, const std::string& file) const;
+
+private:
+    AssetVariantLoader();
+    ~AssetVariantLoader();
+
+    // GL 上下文重建后重新上传全部纹理
+    void reloadTextures();
+
+    static AssetVariantLoader* s_instance;
+
+    cocos2d::Map<std::string, cocos2d::SpriteFrame*> _frames;
+    cocos2d::Vector<cocos2d::Texture2D*> _textures;     // 颜色和 alpha 纹理
+    std::vector<std::string> _texturePaths;             // 与 _textures 一一对应
+    cocos2d::EventListener* _rendererListener;
+};
+
+#endif // __ASSET_VARIANT_LOADER_H__
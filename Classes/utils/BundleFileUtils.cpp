@@ -0,0 +1,130 @@
+#include "BundleFileUtils.h"
+#include <cstring>
+
+USING_NS_CC;
+
+BundleFileUtils* BundleFileUtils::s_installed = nullptr;
+
+bool BundleFileUtils::install(const std::string& bundleFile, std::string* error)
+{
+    // 用当前实现解析资源包位置（资源包本身不在包里）
+    std::string fullPath = FileUtils::getInstance()->fullPathForFilename(bundleFile);
+    if (fullPath.empty()) {
+        if (error) {
+            *error = "bundle not found: " + bundleFile;
+        }
+        return false;
+    }
+
+    auto utils = new (std::nothrow) BundleFileUtils();
+    if (!utils || !utils->init() || !utils->_bundle.open(fullPath, error)) {
+        delete utils;
+        return false;
+    }
+
+    // setDelegate 会删除原来的实例
+    FileUtils::setDelegate(utils);
+    s_installed = utils;
+    CCLOG("BundleFileUtils: %d file(s) from %s", utils->_bundle.getEntryCount(), fullPath.c_str());
+    return true;
+}
+
+BundleFileUtils::BundleFileUtils()
+#if COCOS2D_DEBUG > 0
+    : _verifyContents(true)
+#else
+    : _verifyContents(false)
+#endif
+{
+}
+
+BundleFileUtils::~BundleFileUtils()
+{
+    if (s_installed == this) {
+        s_installed = nullptr;
+    }
+}
+
+int BundleFileUtils::findEntry(const std::string& fullPath) const
+{
+    // 完整路径为 资源根目录 + 包内路径；绝对路径或其他目录下的文件不在包中
+    const std::string& root = _defaultResRootPath;
+    if (fullPath.compare(0, root.size(), root) == 0) {
+        return _bundle.find(fullPath.data() + root.size(), fullPath.size() - root.size());
+    }
+    if (isAbsolutePath(fullPath)) {
+        return -1;
+    }
+    return _bundle.find(fullPath);
+}
+
+bool BundleFileUtils::isFileExistInternal(const std::string& filename) const
+{
+    return findEntry(filename) >= 0 || PlatformFileUtils::isFileExistInternal(filename);
+}
+
+FileUtils::Status BundleFileUtils::getContents(const std::string& filename, ResizableBuffer* buffer) const
+{
+    int index = filename.empty() ? -1 : findEntry(fullPathForFilename(filename));
+    if (index < 0) {
+        return PlatformFileUtils::getContents(filename, buffer);
+    }
+    if (_verifyContents && !_bundle.verify(index)) {
+        CCLOG("BundleFileUtils: content hash mismatch for %s", _bundle.getName(index).c_str());
+        return Status::ReadFailed;
+    }
+
+    size_t size = _bundle.getSize(index);
+    buffer->resize(size);
+    if (size > 0) {
+        std::memcpy(buffer->buffer(), _bundle.getData(index), size);
+    }
+    return Status::OK;
+}
+
+bool BundleFileUtils::getMappedData(const std::string& filename, const unsigned char** outData, ssize_t* outSize) const
+{
+    int index = filename.empty() ? -1 : findEntry(fullPathForFilename(filename));
+    if (index < 0 || (_verifyContents && !_bundle.verify(index))) {
+        return false;
+    }
+    *outData = _bundle.getData(index);
+    *outSize = static_cast<ssize_t>(_bundle.getSize(index));
+    return true;
+}
+
+int BundleFileUtils::preloadImages(const std::string& prefix)
+{
+    static const char* IMAGE_EXTENSIONS[] = { ".png", ".jpg", ".pvr", ".webp" };
+
+    auto textureCache = Director::getInstance()->getTextureCache();
+    int loaded = 0;
+    for (int i = 0; i < _bundle.getEntryCount(); i++) {
+        std::string name = _bundle.getName(i);
+        if (name.compare(0, prefix.size(), prefix) != 0) {
+            continue;
+        }
+        std::string ext = getFileExtension(name);
+        bool isImage = false;
+        for (const char* imageExt : IMAGE_EXTENSIONS) {
+            isImage = isImage || ext == imageExt;
+        }
+        if (!isImage) {
+            continue;
+        }
+
+        // 纹理缓存以完整路径为键，与 TextureCache::addImage(path) 的查找方式一致
+        std::string fullPath = fullPathForFilename(name);
+        const unsigned char* data = nullptr;
+        ssize_t size = 0;
+        if (fullPath.empty() || textureCache->getTextureForKey(fullPath) || !getMappedData(name, &data, &size)) {
+            continue;
+        }
+        auto image = new (std::nothrow) Image();
+        if (image && image->initWithImageData(data, size) && textureCache->addImage(image, fullPath)) {
+            loaded++;
+        }
+        CC_SAFE_RELEASE(image);
+    }
+    return loaded;
+}
@@ -0,0 +1,72 @@
+#ifndef __BUNDLE_FILE_UTILS_H__
+#define __BUNDLE_FILE_UTILS_H__
+
+#include "cocos2d.h"
+#include "AssetBundle.h"
+
+#if CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
+#include "platform/win32/CCFileUtils-win32.h"
+typedef cocos2d::FileUtilsWin32 PlatformFileUtils;
+#elif CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID
+#include "platform/android/CCFileUtils-android.h"
+typedef cocos2d::FileUtilsAndroid PlatformFileUtils;
+#elif CC_TARGET_PLATFORM == CC_PLATFORM_IOS || CC_TARGET_PLATFORM == CC_PLATFORM_MAC
+#include "platform/apple/CCFileUtils-apple.h"
+typedef cocos2d::FileUtilsApple PlatformFileUtils;
+#else
+#include "platform/linux/CCFileUtils-linux.h"
+typedef cocos2d::FileUtilsLinux PlatformFileUtils;
+#endif
+
+/**
+ * 从资源包读取资源的 FileUtils
+ *
+ * 继承当前平台的 FileUtils 实现，只替换“文件是否存在”和“读取内容”：
+ * 路径在资源包中时直接从内存映射返回，不打开文件；不在包中的路径（可写目录、未打包的文件）交给平台实现。
+ * 搜索路径、文件名映射等解析规则不变，包内路径即相对资源根目录的路径。
+ *
+ * 通过 getDataFromFile 读取时仍会拷贝一次到 Data（Data 拥有自己的内存）；
+ * getMappedData 和 preloadImages 直接使用映射中的数据，不拷贝。
+ * Android 上资源在 APK 内无法直接映射，install 返回 false，继续使用平台实现。
+ */
+class BundleFileUtils : public PlatformFileUtils {
+public:
+    // 打开资源包并替换 FileUtils 单例；资源包不存在或损坏时保持原实现并返回 false
+    // 需要在读取任何资源、添加搜索路径之前调用
+    static bool install(const std::string& bundleFile, std::string* error = nullptr);
+
+    // 已安装的实例，未安装时返回 nullptr
+    static BundleFileUtils* getInstalled() { return s_installed; }
+
+    virtual ~BundleFileUtils();
+
+    // 文件在资源包中时返回映射中的数据（零拷贝，实例存在期间有效）；filename 按 FileUtils 规则解析
+    bool getMappedData(const std::string& filename, const unsigned char** outData, ssize_t* outSize) const;
+
+    // 把包中 prefix 开头的图片直接从映射解码并加入 TextureCache，之后 Sprite::create 等直接命中缓存
+    // 返回加载的纹理数
+    int preloadImages(const std::string& prefix);
+
+    // 读取时校验内容哈希（调试版默认开启）；损坏的文件按读取失败处理
+    void setVerifyContents(bool verify) { _verifyContents = verify; }
+
+    const AssetBundle& getBundle() const { return _bundle; }
+
+    virtual Status getContents(const std::string& filename, cocos2d::ResizableBuffer* buffer) const override;
+
+protected:
+    virtual bool isFileExistInternal(const std::string& filename) const override;
+
+private:
+    BundleFileUtils();
+
+    // 完整路径对应的包内条目，不在包中时返回 -1
+    int findEntry(const std::string& fullPath) const;
+
+    static BundleFileUtils* s_installed;
+
+    AssetBundle _bundle;
+    bool _verifyContents;
+};
+
+#endif // __BUNDLE_FILE_UTILS_H__
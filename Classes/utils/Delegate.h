@@ -0,0 +1,74 @@
+#ifndef __DELEGATE_H__
+#define __DELEGATE_H__
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template <typename Signature>
+class Delegate;
+
+/**
+ * 不分配内存的回调
+ * 可调用对象按值存放在内部固定大小的缓冲区中，要求可平凡拷贝、可平凡析构
+ * （如只捕获 this、ID、坐标的 lambda，或通过 bind 绑定的成员函数），超出容量时编译报错。
+ * 用于代替控制器与视图之间的 std::function，拷贝、调用都不会触发堆分配。
+ */
+template <typename R, typename... Args>
+class Delegate<R(Args...)> {
+public:
+    static const size_t STORAGE_SIZE = sizeof(void*) * 3;
+
+    Delegate() : _invoke(nullptr) {}
+    Delegate(std::nullptr_t) : _invoke(nullptr) {}
+
+    template <typename F, typename = typename std::enable_if<!std::is_same<typename std::decay<F>::type, Delegate>::value>::type>
+    Delegate(F callable)
+    {
+        static_assert(sizeof(F) <= STORAGE_SIZE, "Delegate: callable too large for inline storage");
+        static_assert(alignof(F) <= alignof(Storage), "Delegate: callable over-aligned");
+        static_assert(std::is_trivially_copyable<F>::value && std::is_trivially_destructible<F>::value,
+                      "Delegate: callable must be trivially copyable (capture only ids, pointers, PODs)");
+        new (&_storage) F(callable);
+        _invoke = &invokeCallable<F>;
+    }
+
+    // 绑定成员函数：Delegate<void(int)>::bind<GameView, &GameView::onCardClicked>(this)
+    template <typename T, R (T::*Method)(Args...)>
+    static Delegate bind(T* object)
+    {
+        Delegate d;
+        new (&d._storage) T*(object);
+        d._invoke = &invokeMethod<T, Method>;
+        return d;
+    }
+
+    R operator()(Args... args) const { return _invoke(&_storage, std::forward<Args>(args)...); }
+
+    explicit operator bool() const { return _invoke != nullptr; }
+
+    void reset() { _invoke = nullptr; }
+
+private:
+    typedef typename std::aligned_storage<STORAGE_SIZE, alignof(void*)>::type Storage;
+    typedef R (*InvokeFn)(const Storage*, Args&&...);
+
+    template <typename F>
+    static R invokeCallable(const Storage* storage, Args&&... args)
+    {
+        return (*const_cast<F*>(reinterpret_cast<const F*>(storage)))(std::forward<Args>(args)...);
+    }
+
+    template <typename T, R (T::*Method)(Args...)>
+    static R invokeMethod(const Storage* storage, Args&&... args)
+    {
+        T* object = *reinterpret_cast<T* const*>(storage);
+        return (object->*Method)(std::forward<Args>(args)...);
+    }
+
+    Storage _storage;
+    InvokeFn _invoke;
+};
+
+#endif // __DELEGATE_H__
@@ -0,0 +1,165 @@
+#ifndef __EVENT_BUS_H__
+#define __EVENT_BUS_H__
+
+#include "Delegate.h"
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+
+/**
+ * 订阅句柄
+ * 编码为 通道(8 位) | 槽位(8 位) | 代数(16 位)，槽位复用后旧句柄因代数不同而失效
+ */
+struct EventHandle {
+    uint32_t value;
+
+    EventHandle() : value(0) {}
+    explicit EventHandle(uint32_t v) : value(v) {}
+
+    bool isValid() const { return value != 0; }
+    int getChannel() const { return static_cast<int>(value >> 24); }
+    int getSlot() const { return static_cast<int>((value >> 16) & 0xFF); }
+    uint16_t getGeneration() const { return static_cast<uint16_t>(value & 0xFFFF); }
+
+    static EventHandle make(int channel, int slot, uint16_t generation)
+    {
+        return EventHandle((static_cast<uint32_t>(channel) << 24) | (static_cast<uint32_t>(slot) << 16) | generation);
+    }
+};
+
+/**
+ * 单一事件类型的订阅表（固定容量，不分配内存）
+ * 派发时按槽位顺序调用，处理函数中可以安全地订阅或取消订阅
+ */
+template <typename E, int Capacity = 8>
+class EventChannel {
+public:
+    typedef Delegate<void(const E&)> Handler;
+
+    EventChannel()
+    {
+        for (int i = 0; i < Capacity; i++) {
+            _generations[i] = 1;
+        }
+    }
+
+    // 订阅，没有空槽时返回无效句柄
+    EventHandle subscribe(int channelIndex, const Handler& handler)
+    {
+        for (int i = 0; i < Capacity; i++) {
+            if (!_handlers[i]) {
+                _handlers[i] = handler;
+                return EventHandle::make(channelIndex, i, _generations[i]);
+            }
+        }
+        return EventHandle();
+    }
+
+    bool unsubscribe(EventHandle handle)
+    {
+        int slot = handle.getSlot();
+        if (slot >= Capacity || !_handlers[slot] || _generations[slot] != handle.getGeneration()) {
+            return false;
+        }
+        _handlers[slot].reset();
+        // 代数跳过 0，保证句柄值非 0
+        if (++_generations[slot] == 0) {
+            _generations[slot] = 1;
+        }
+        return true;
+    }
+
+    void publish(const E& event) const
+    {
+        for (int i = 0; i < Capacity; i++) {
+            if (_handlers[i]) {
+                _handlers[i](event);
+            }
+        }
+    }
+
+    void clear()
+    {
+        for (int i = 0; i < Capacity; i++) {
+            if (_handlers[i]) {
+                _handlers[i].reset();
+                if (++_generations[i] == 0) {
+                    _generations[i] = 1;
+                }
+            }
+        }
+    }
+
+private:
+    Handler _handlers[Capacity];
+    uint16_t _generations[Capacity];
+};
+
+template <typename E, typename... Events>
+struct EventIndex;
+
+template <typename E, typename... Rest>
+struct EventIndex<E, E, Rest...> : std::integral_constant<int, 0> {};
+
+template <typename E, typename First, typename... Rest>
+struct EventIndex<E, First, Rest...> : std::integral_constant<int, 1 + EventIndex<E, Rest...>::value> {};
+
+/**
+ * 类型化事件总线
+ * 事件类型在编译期列出，每种事件一个固定容量的订阅表；订阅、派发都不分配内存
+ *
+ *   GameEventBus bus;
+ *   EventHandle h = bus.subscribe<CardClickedEvent>([this](const CardClickedEvent& e) { ... });
+ *   bus.publish(CardClickedEvent(3));
+ *   bus.unsubscribe(h);
+ */
+template <typename... Events>
+class EventBus {
+public:
+    static_assert(sizeof...(Events) < 256, "EventBus: too many event types");
+
+    template <typename E>
+    EventHandle subscribe(const Delegate<void(const E&)>& handler)
+    {
+        return channel<E>().subscribe(EventIndex<E, Events...>::value, handler);
+    }
+
+    template <typename E>
+    void publish(const E& event) const
+    {
+        std::get<EventChannel<E>>(_channels).publish(event);
+    }
+
+    // 取消订阅并将句柄置为无效
+    bool unsubscribe(EventHandle& handle)
+    {
+        if (!handle.isValid()) {
+            return false;
+        }
+        bool removed = false;
+        int expand[] = { 0, (removed = unsubscribeFrom<Events>(handle) || removed, 0)... };
+        (void)expand;
+        handle = EventHandle();
+        return removed;
+    }
+
+    void clear()
+    {
+        int expand[] = { 0, (channel<Events>().clear(), 0)... };
+        (void)expand;
+    }
+
+private:
+    template <typename E>
+    EventChannel<E>& channel() { return std::get<EventChannel<E>>(_channels); }
+
+    template <typename E>
+    bool unsubscribeFrom(EventHandle handle)
+    {
+        return handle.getChannel() == EventIndex<E, Events...>::value && channel<E>().unsubscribe(handle);
+    }
+
+    std::tuple<EventChannel<Events>...> _channels;
+};
+
+#endif // __EVENT_BUS_H__
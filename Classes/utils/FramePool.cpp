@@ -0,0 +1,124 @@
+#include "FramePool.h"
+#include <new>
+
+namespace {
+
+const size_t MIN_CLASS_SIZE = 64;
+const int CLASS_COUNT = 7;                 // 64, 128, ..., 4096
+const size_t CHUNK_SIZE = 32 * 1024;
+
+struct FreeBlock {
+    FreeBlock* next;
+};
+
+struct Chunk {
+    Chunk* next;
+};
+
+struct PoolState {
+    FreeBlock* freeLists[CLASS_COUNT];
+    Chunk* chunks;
+    FramePool::Stats stats;
+
+    PoolState() : freeLists(), chunks(nullptr), stats() {}
+
+    ~PoolState()
+    {
+        while (chunks) {
+            Chunk* next = chunks->next;
+            ::operator delete(chunks);
+            chunks = next;
+        }
+    }
+};
+
+PoolState& state()
+{
+    static PoolState s_state;
+    return s_state;
+}
+
+// 返回档位，超过最大档位时返回 -1
+int classOf(size_t bytes)
+{
+    size_t size = MIN_CLASS_SIZE;
+    for (int i = 0; i < CLASS_COUNT; i++) {
+        if (bytes <= size) {
+            return i;
+        }
+        size <<= 1;
+    }
+    return -1;
+}
+
+size_t classSize(int sizeClass)
+{
+    return MIN_CLASS_SIZE << sizeClass;
+}
+
+// 新申请一块，全部切成该档位的空闲帧
+void refill(PoolState& pool, int sizeClass)
+{
+    Chunk* chunk = static_cast<Chunk*>(::operator new(CHUNK_SIZE));
+    chunk->next = pool.chunks;
+    pool.chunks = chunk;
+    pool.stats.chunkCount++;
+
+    // 块头之后按档位大小对齐切分（档位至少 64 字节，满足协程帧的对齐要求）
+    size_t blockSize = classSize(sizeClass);
+    unsigned char* begin = reinterpret_cast<unsigned char*>(chunk) + MIN_CLASS_SIZE;
+    unsigned char* end = reinterpret_cast<unsigned char*>(chunk) + CHUNK_SIZE;
+    for (unsigned char* p = begin; p + blockSize <= end; p += blockSize) {
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(p);
+        block->next = pool.freeLists[sizeClass];
+        pool.freeLists[sizeClass] = block;
+    }
+}
+
+} // namespace
+
+namespace FramePool {
+
+void* allocate(size_t bytes)
+{
+    PoolState& pool = state();
+    pool.stats.allocationCount++;
+    pool.stats.liveFrames++;
+
+    int sizeClass = classOf(bytes);
+    if (sizeClass < 0) {
+        pool.stats.largeCount++;
+        return ::operator new(bytes);
+    }
+    if (!pool.freeLists[sizeClass]) {
+        refill(pool, sizeClass);
+    }
+    FreeBlock* block = pool.freeLists[sizeClass];
+    pool.freeLists[sizeClass] = block->next;
+    return block;
+}
+
+void deallocate(void* p, size_t bytes)
+{
+    if (!p) {
+        return;
+    }
+    PoolState& pool = state();
+    pool.stats.liveFrames--;
+
+    int sizeClass = classOf(bytes);
+    if (sizeClass < 0) {
+        ::operator delete(p);
+        return;
+    }
+    FreeBlock* block = static_cast<FreeBlock*>(p);
+    block->next = pool.freeLists[sizeClass];
+    pool.freeLists[sizeClass] = block;
+}
+
+Stats getStats()
+{
+    return state().stats;
+}
+
+} // namespace FramePool
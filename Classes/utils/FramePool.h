@@ -0,0 +1,32 @@
+#ifndef __FRAME_POOL_H__
+#define __FRAME_POOL_H__
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * 协程帧池
+ * 动画脚本（Sequence）的协程帧按大小分档（64 字节 ~ 4KB，2 的幂）从固定大小的块中切出，
+ * 释放后挂回对应档位的空闲链表复用，不归还系统；超过 4KB 的帧直接向系统申请。
+ * 脚本反复启动、结束时不再产生堆分配。只在主线程使用，不加锁。
+ */
+namespace FramePool {
+
+void* allocate(size_t bytes);
+void deallocate(void* p, size_t bytes);
+
+/**
+ * 统计
+ */
+struct Stats {
+    size_t chunkCount;          // 向系统申请的块数
+    size_t liveFrames;          // 当前未释放的帧
+    uint64_t allocationCount;   // allocate 调用次数
+    uint64_t largeCount;        // 超过最大档位、直接向系统申请的次数
+};
+
+Stats getStats();
+
+} // namespace FramePool
+
+#endif // __FRAME_POOL_H__
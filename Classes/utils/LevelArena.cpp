@@ -0,0 +1,101 @@
+#include "LevelArena.h"
+#include <cstdlib>
+
+namespace {
+
+size_t alignUp(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace
+
+LevelArena::LevelArena(size_t chunkSize)
+    : _chunkSize(chunkSize > 0 ? chunkSize : 1024)
+    , _head(nullptr)
+    , _offset(0)
+    , _chunkCount(0)
+    , _allocationCount(0)
+    , _deallocationCount(0)
+    , _bytesAllocated(0)
+    , _upstreamCount(0)
+{
+}
+
+LevelArena::~LevelArena()
+{
+    while (_head) {
+        Chunk* next = _head->next;
+        std::free(_head);
+        _head = next;
+    }
+}
+
+void* LevelArena::allocate(size_t bytes, size_t alignment)
+{
+    if (bytes == 0) {
+        bytes = 1;
+    }
+    if (alignment < alignof(Chunk)) {
+        alignment = alignof(Chunk);
+    }
+
+    size_t start = alignUp(_offset, alignment);
+    if (!_head || start + bytes > _head->size) {
+        addChunk(bytes + alignment);
+        start = 0;
+    }
+
+    void* p = chunkData(_head) + start;
+    _offset = start + bytes;
+    _allocationCount++;
+    _bytesAllocated += bytes;
+    return p;
+}
+
+void LevelArena::deallocate(void* p, size_t bytes)
+{
+    // 单调分配：内存在 release() 时统一归还
+    (void)p;
+    (void)bytes;
+    _deallocationCount++;
+}
+
+void LevelArena::release()
+{
+    // 只保留最早申请的一块（链表尾），其余全部归还
+    Chunk* keep = nullptr;
+    while (_head) {
+        Chunk* next = _head->next;
+        if (next == nullptr && _head->size == _chunkSize) {
+            keep = _head;
+        }
+        else {
+            std::free(_head);
+        }
+        _head = next;
+    }
+
+    _head = keep;
+    _offset = 0;
+    _chunkCount = keep ? 1 : 0;
+    _allocationCount = 0;
+    _deallocationCount = 0;
+    _bytesAllocated = 0;
+    _upstreamCount = 0;
+}
+
+void LevelArena::addChunk(size_t minBytes)
+{
+    size_t size = minBytes > _chunkSize ? minBytes : _chunkSize;
+    Chunk* chunk = static_cast<Chunk*>(std::malloc(sizeof(Chunk) + size));
+    if (!chunk) {
+        throw std::bad_alloc();
+    }
+    chunk->next = _head;
+    chunk->size = size;
+    _head = chunk;
+    _offset = 0;
+    _chunkCount++;
+    _upstreamCount++;
+}
@@ -0,0 +1,119 @@
+#ifndef __LEVEL_ARENA_H__
+#define __LEVEL_ARENA_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+/**
+ * 关卡级单调分配器
+ * 按块向系统申请内存，分配只移动指针，释放只计数；关卡结束时 release() 一次性归还。
+ * 配合 ArenaAllocator / ArenaVector 使用（C++14 下代替 std::pmr::monotonic_buffer_resource）。
+ *
+ * 统计计数用于确认关卡进行中不再分配：加载关卡时按最大容量预留后，
+ * 每步操作前后的 getAllocationCount() 应保持不变。
+ */
+class LevelArena {
+public:
+    // chunkSize 为每次向系统申请的块大小，超过块大小的请求单独成块
+    explicit LevelArena(size_t chunkSize = 16 * 1024);
+    ~LevelArena();
+
+    void* allocate(size_t bytes, size_t alignment);
+    void deallocate(void* p, size_t bytes);
+
+    // 归还所有内存（保留第一块供下个关卡复用），并清零统计
+    // 调用前必须确保没有容器仍持有本分配器的内存
+    void release();
+
+    // 统计
+    uint64_t getAllocationCount() const { return _allocationCount; }       // allocate 调用次数
+    uint64_t getDeallocationCount() const { return _deallocationCount; }   // deallocate 调用次数
+    uint64_t getBytesAllocated() const { return _bytesAllocated; }         // 累计分配字节数
+    uint64_t getUpstreamCount() const { return _upstreamCount; }           // 向系统申请块的次数
+    size_t getChunkCount() const { return _chunkCount; }
+
+private:
+    struct Chunk {
+        Chunk* next;
+        size_t size;   // 数据区大小
+    };
+
+    LevelArena(const LevelArena&) = delete;
+    LevelArena& operator=(const LevelArena&) = delete;
+
+    // 申请新块并设为当前块
+    void addChunk(size_t minBytes);
+
+    static unsigned char* chunkData(Chunk* chunk) { return reinterpret_cast<unsigned char*>(chunk + 1); }
+
+    size_t _chunkSize;
+    Chunk* _head;            // 当前块（链表头）
+    size_t _offset;          // 当前块已使用字节数
+    size_t _chunkCount;
+
+    uint64_t _allocationCount;
+    uint64_t _deallocationCount;
+    uint64_t _bytesAllocated;
+    uint64_t _upstreamCount;
+};
+
+/**
+ * 从 LevelArena 分配的 STL 分配器
+ * 未绑定分配器（默认构造）时退回全局 new/delete
+ */
+template <typename T>
+class ArenaAllocator {
+public:
+    typedef T value_type;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    ArenaAllocator() : _arena(nullptr) {}
+    explicit ArenaAllocator(LevelArena* arena) : _arena(arena) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : _arena(other.getArena()) {}
+
+    T* allocate(size_t n)
+    {
+        if (_arena) {
+            return static_cast<T*>(_arena->allocate(n * sizeof(T), alignof(T)));
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n)
+    {
+        if (_arena) {
+            _arena->deallocate(p, n * sizeof(T));
+        }
+        else {
+            ::operator delete(p);
+        }
+    }
+
+    LevelArena* getArena() const { return _arena; }
+
+private:
+    LevelArena* _arena;
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) { return a.getArena() == b.getArena(); }
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) { return a.getArena() != b.getArena(); }
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+// 丢弃容器内容并改为从 arena 分配（arena 为 nullptr 时改回全局堆）
+template <typename T>
+void resetArenaVector(ArenaVector<T>& vec, LevelArena* arena)
+{
+    vec = ArenaVector<T>(ArenaAllocator<T>(arena));
+}
+
+#endif // __LEVEL_ARENA_H__
@@ -0,0 +1,39 @@
+#ifndef __MAILBOX_H__
+#define __MAILBOX_H__
+
+#include <atomic>
+#include <memory>
+
+/**
+ * 单槽无锁信箱
+ * 工作线程把构建好的对象整体投递进来，主线程每帧取一次；只保留最新的一件，
+ * 未取走的旧对象在投递时释放。投递和取出都是一次原子交换，不加锁、不阻塞。
+ */
+template <typename T>
+class Mailbox {
+public:
+    Mailbox() : _slot(nullptr) {}
+    ~Mailbox() { delete _slot.exchange(nullptr, std::memory_order_acquire); }
+
+    Mailbox(const Mailbox&) = delete;
+    Mailbox& operator=(const Mailbox&) = delete;
+
+    // 任意线程调用，取代尚未取走的旧对象
+    void post(std::unique_ptr<T> item)
+    {
+        delete _slot.exchange(item.release(), std::memory_order_acq_rel);
+    }
+
+    // 取走当前对象，没有时返回空
+    std::unique_ptr<T> take()
+    {
+        return std::unique_ptr<T>(_slot.exchange(nullptr, std::memory_order_acq_rel));
+    }
+
+    bool isEmpty() const { return _slot.load(std::memory_order_acquire) == nullptr; }
+
+private:
+    std::atomic<T*> _slot;
+};
+
+#endif // __MAILBOX_H__
@@ -0,0 +1,21 @@
+#ifndef __PROCESS_STATS_H__
+#define __PROCESS_STATS_H__
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * 进程资源统计（Windows / Apple / Linux、Android）
+ * 用于长时间运行时观察内存增长和 CPU 占用，不支持的平台返回 0
+ */
+namespace ProcessStats {
+
+// 当前常驻内存（字节）
+size_t getResidentBytes();
+
+// 进程累计 CPU 时间（用户态 + 内核态，微秒）
+uint64_t getCpuTimeUs();
+
+} // namespace ProcessStats
+
+#endif // __PROCESS_STATS_H__
@@ -0,0 +1,213 @@
+#ifndef __SEQUENCE_H__
+#define __SEQUENCE_H__
+
+#include "utils/FramePool.h"
+#include "utils/SequenceScheduler.h"
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+/**
+ * 动画脚本（C++20 协程）
+ * 多步的表现（发牌、连续回退、通关庆祝）写成一个顺序执行的函数，不再拆成嵌套的回调：
+ *
+ *   Sequence dealCards(PresentationHost* host)
+ *   {
+ *       for (int id : ids) {
+ *           co_await Work(1);           // 占用本帧的工作预算，用完时等到下一帧
+ *           host->dealCard(id, 0.25f);
+ *           co_await Delay(0.03f);
+ *       }
+ *       co_await waitUntil([host] { return !host->isAnimating(); });
+ *       co_await celebrate(host);      // 等待子脚本执行完毕
+ *   }
+ *
+ * 脚本创建后不会立即执行，交给 startSequence 后由 SequenceScheduler::update 驱动；
+ * 被 co_await 的子脚本使用父脚本的调度器，执行完毕后直接回到父脚本。
+ * 协程帧从 FramePool 分配。脚本内不应抛出异常，出现时终止程序。
+ *
+ * 包含本头文件的翻译单元需要以 C++20 编译。
+ */
+class Sequence {
+public:
+    struct promise_type {
+        SequenceScheduler* scheduler;
+        std::coroutine_handle<> continuation;   // 等待本脚本的父脚本，顶层脚本为空
+
+        promise_type() : scheduler(nullptr) {}
+
+        static void* operator new(size_t bytes) { return FramePool::allocate(bytes); }
+        static void operator delete(void* p, size_t bytes) { FramePool::deallocate(p, bytes); }
+
+        Sequence get_return_object()
+        {
+            return Sequence(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        struct FinalAwaiter {
+            bool await_ready() noexcept { return false; }
+
+            // 子脚本直接切回父脚本；顶层脚本交给调度器在本帧末销毁
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+            {
+                promise_type& promise = handle.promise();
+                if (promise.continuation) {
+                    return promise.continuation;
+                }
+                if (promise.scheduler) {
+                    promise.scheduler->finishRoot(handle.address());
+                }
+                return std::noop_coroutine();
+            }
+
+            void await_resume() noexcept {}
+        };
+
+        FinalAwaiter final_suspend() noexcept { return {}; }
+
+        void return_void() {}
+
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    typedef std::coroutine_handle<promise_type> Handle;
+
+    Sequence() {}
+    explicit Sequence(Handle handle) : _handle(handle) {}
+
+    Sequence(Sequence&& other) noexcept : _handle(std::exchange(other._handle, nullptr)) {}
+
+    Sequence& operator=(Sequence&& other) noexcept
+    {
+        if (this != &other) {
+            destroy();
+            _handle = std::exchange(other._handle, nullptr);
+        }
+        return *this;
+    }
+
+    Sequence(const Sequence&) = delete;
+    Sequence& operator=(const Sequence&) = delete;
+
+    ~Sequence() { destroy(); }
+
+    bool isValid() const { return static_cast<bool>(_handle); }
+
+    // 交出协程句柄（startSequence 把所有权转给调度器）
+    Handle release() { return std::exchange(_handle, nullptr); }
+
+    /**
+     * 等待子脚本：子脚本继承调度器，立即开始执行，结束后恢复父脚本
+     */
+    struct Awaiter {
+        Handle child;
+
+        bool await_ready() const noexcept { return !child || child.done(); }
+
+        template<typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> parent) noexcept
+        {
+            child.promise().scheduler = parent.promise().scheduler;
+            child.promise().continuation = parent;
+            return child;
+        }
+
+        void await_resume() noexcept {}
+    };
+
+    // 子脚本的帧由父脚本中这个临时 Sequence 持有，父脚本被取消时一并销毁
+    Awaiter operator co_await() & noexcept { return Awaiter{ _handle }; }
+    Awaiter operator co_await() && noexcept { return Awaiter{ _handle }; }
+
+private:
+    void destroy()
+    {
+        if (_handle) {
+            _handle.destroy();
+            _handle = nullptr;
+        }
+    }
+
+    Handle _handle;
+};
+
+/**
+ * 等待若干秒（按调度器的累计时间，随 update 的 dt 推进）
+ */
+struct Delay {
+    float seconds;
+
+    explicit Delay(float s) : seconds(s) {}
+
+    bool await_ready() const noexcept { return seconds <= 0.0f; }
+
+    void await_suspend(std::coroutine_handle<Sequence::promise_type> handle) const
+    {
+        handle.promise().scheduler->resumeAfter(handle.address(), seconds);
+    }
+
+    void await_resume() const noexcept {}
+};
+
+/**
+ * 等待到下一帧
+ */
+struct NextFrame {
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<Sequence::promise_type> handle) const
+    {
+        handle.promise().scheduler->resumeNextFrame(handle.address());
+    }
+
+    void await_resume() const noexcept {}
+};
+
+/**
+ * 占用本帧 cost 个单位的工作预算，不足时挂起，在之后的帧按排队顺序取得预算后继续
+ */
+struct Work {
+    int cost;
+    SequenceScheduler* scheduler;
+
+    explicit Work(int c = 1) : cost(c), scheduler(nullptr) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    // 预算足够时不挂起（返回 false 直接继续）
+    bool await_suspend(std::coroutine_handle<Sequence::promise_type> handle)
+    {
+        scheduler = handle.promise().scheduler;
+        if (scheduler->consumeWork(cost)) {
+            return false;
+        }
+        scheduler->waitForWork(handle.address(), cost);
+        return true;
+    }
+
+    void await_resume() const noexcept {}
+};
+
+// 每帧检查一次条件，成立时返回（条件一开始就成立时不等待）
+template<typename Predicate>
+Sequence waitUntil(Predicate predicate)
+{
+    while (!predicate()) {
+        co_await NextFrame();
+    }
+}
+
+// 把脚本交给调度器，下一次 update 时开始执行
+inline void startSequence(SequenceScheduler& scheduler, Sequence sequence)
+{
+    Sequence::Handle handle = sequence.release();
+    if (!handle) {
+        return;
+    }
+    handle.promise().scheduler = &scheduler;
+    scheduler.addRoot(handle.address());
+}
+
+#endif // __SEQUENCE_H__
@@ -0,0 +1,144 @@
+#include "SequenceScheduler.h"
+#include <algorithm>
+#include <coroutine>
+
+// 本文件以 C++20 编译（协程句柄）
+
+namespace {
+
+void resumeFrame(void* frame)
+{
+    std::coroutine_handle<>::from_address(frame).resume();
+}
+
+} // namespace
+
+SequenceScheduler::SequenceScheduler()
+    : _time(0.0f)
+    , _workBudget(DEFAULT_WORK_BUDGET)
+    , _workLeft(DEFAULT_WORK_BUDGET)
+    , _workUsed(false)
+{
+}
+
+SequenceScheduler::~SequenceScheduler()
+{
+    cancelAll();
+}
+
+void SequenceScheduler::setWorkBudget(int units)
+{
+    _workBudget = units > 1 ? units : 1;
+}
+
+void SequenceScheduler::addRoot(void* frame)
+{
+    _roots.push_back(frame);
+    _ready.push_back(frame);
+}
+
+void SequenceScheduler::resumeNextFrame(void* frame)
+{
+    _ready.push_back(frame);
+}
+
+void SequenceScheduler::resumeAfter(void* frame, float seconds)
+{
+    Timer timer;
+    timer.frame = frame;
+    timer.time = _time + seconds;
+    _timers.push_back(timer);
+}
+
+bool SequenceScheduler::consumeWork(int cost)
+{
+    // 已有脚本在排队时不插队
+    if (!_workWaiters.empty()) {
+        return false;
+    }
+    return tryConsumeWork(cost);
+}
+
+bool SequenceScheduler::tryConsumeWork(int cost)
+{
+    if (_workUsed && cost > _workLeft) {
+        return false;
+    }
+    _workUsed = true;
+    _workLeft -= cost;
+    return true;
+}
+
+void SequenceScheduler::waitForWork(void* frame, int cost)
+{
+    WorkWaiter waiter;
+    waiter.frame = frame;
+    waiter.cost = cost;
+    _workWaiters.push_back(waiter);
+}
+
+void SequenceScheduler::finishRoot(void* frame)
+{
+    _finished.push_back(frame);
+}
+
+void SequenceScheduler::update(float dt)
+{
+    _time += dt;
+    _workLeft = _workBudget;
+    _workUsed = false;
+
+    // 等待预算的脚本先按顺序取用本帧预算；恢复后再次请求的排到队尾
+    while (!_workWaiters.empty() && tryConsumeWork(_workWaiters.front().cost)) {
+        void* frame = _workWaiters.front().frame;
+        _workWaiters.pop_front();
+        resumeFrame(frame);
+    }
+
+    // 到期的计时器并入本帧恢复的列表
+    size_t kept = 0;
+    for (size_t i = 0; i < _timers.size(); i++) {
+        if (_timers[i].time <= _time) {
+            _ready.push_back(_timers[i].frame);
+        }
+        else {
+            _timers[kept++] = _timers[i];
+        }
+    }
+    _timers.resize(kept);
+
+    // 恢复期间新挂起到下一帧的脚本进入新的 _ready，本帧不再恢复
+    _resuming.swap(_ready);
+    for (void* frame : _resuming) {
+        resumeFrame(frame);
+    }
+    _resuming.clear();
+
+    destroyFinished();
+}
+
+void SequenceScheduler::destroyFinished()
+{
+    for (void* frame : _finished) {
+        auto it = std::find(_roots.begin(), _roots.end(), frame);
+        if (it != _roots.end()) {
+            _roots.erase(it);
+        }
+        std::coroutine_handle<>::from_address(frame).destroy();
+    }
+    _finished.clear();
+}
+
+void SequenceScheduler::cancelAll()
+{
+    // 顶层脚本的帧销毁时，其中正在等待的子脚本随之销毁；先清空等待列表，避免恢复已销毁的帧
+    _ready.clear();
+    _timers.clear();
+    _workWaiters.clear();
+    destroyFinished();
+    std::vector<void*> roots;
+    roots.swap(_roots);
+    for (void* frame : roots) {
+        std::coroutine_handle<>::from_address(frame).destroy();
+    }
+}
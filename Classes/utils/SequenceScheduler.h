@@ -0,0 +1,92 @@
+#ifndef __SEQUENCE_SCHEDULER_H__
+#define __SEQUENCE_SCHEDULER_H__
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+/**
+ * 动画脚本调度器
+ * 驱动 Sequence 协程（utils/Sequence.h）：脚本等待下一帧、等待一段时间或等待工作预算时挂起，
+ * 由拥有者每帧调用 update 统一恢复。调度器只在主线程使用。
+ *
+ * 工作预算：脚本在做有开销的事（创建节点、启动动画）前先 co_await Work(n)，
+ * 本帧预算用完时挂起到下一帧，长脚本被自然地摊到多帧，不会在一帧内集中完成造成卡顿。
+ *
+ * 本头文件不依赖 <coroutine>，协程帧以 void* 句柄传递，C++14 的翻译单元也可以持有和驱动调度器；
+ * 编写脚本（包含 Sequence.h）的翻译单元需要以 C++20 编译。
+ */
+class SequenceScheduler {
+public:
+    static const int DEFAULT_WORK_BUDGET = 8;
+
+    SequenceScheduler();
+    ~SequenceScheduler();
+
+    SequenceScheduler(const SequenceScheduler&) = delete;
+    SequenceScheduler& operator=(const SequenceScheduler&) = delete;
+
+    // 推进时间并恢复到期的脚本，然后重置本帧的工作预算
+    void update(float dt);
+
+    // 销毁所有脚本（包括被等待的子脚本），不再恢复；不能在脚本内部调用
+    void cancelAll();
+
+    // 没有进行中的脚本
+    bool isIdle() const { return _roots.empty(); }
+
+    // 进行中的顶层脚本数
+    size_t getRunningCount() const { return _roots.size(); }
+
+    // 每帧的工作预算（至少 1）
+    void setWorkBudget(int units);
+    int getWorkBudget() const { return _workBudget; }
+
+    // 以下由 Sequence 的 promise 和等待体调用，frame 为协程句柄的地址
+
+    // 登记顶层脚本，下一次 update 时开始执行
+    void addRoot(void* frame);
+
+    // 挂起到下一次 update
+    void resumeNextFrame(void* frame);
+
+    // 挂起 seconds 秒
+    void resumeAfter(void* frame, float seconds);
+
+    // 从本帧预算中扣除 cost，预算不足或已有脚本在排队时返回 false（调用者应调用 waitForWork 挂起）
+    // 每帧第一次请求总能通过，cost 超过整帧预算的工作也不会永远等待
+    bool consumeWork(int cost);
+
+    // 排队等待工作预算，之后的帧按先后顺序扣除预算并恢复
+    void waitForWork(void* frame, int cost);
+
+    // 顶层脚本执行完毕（在其 final_suspend 中调用），本帧末销毁
+    void finishRoot(void* frame);
+
+private:
+    struct Timer {
+        void* frame;
+        float time;
+    };
+
+    struct WorkWaiter {
+        void* frame;
+        int cost;
+    };
+
+    bool tryConsumeWork(int cost);
+    void destroyFinished();
+
+    std::vector<void*> _roots;       // 进行中的顶层脚本
+    std::vector<void*> _ready;       // 下一次 update 恢复
+    std::vector<void*> _resuming;    // 本次 update 正在恢复的（与 _ready 交换）
+    std::vector<Timer> _timers;
+    std::deque<WorkWaiter> _workWaiters;
+    std::vector<void*> _finished;
+    float _time;
+    int _workBudget;
+    int _workLeft;
+    bool _workUsed;                  // 本帧是否已有工作通过
+};
+
+#endif // __SEQUENCE_SCHEDULER_H__
@@ -0,0 +1,74 @@
+#ifndef __SPSC_QUEUE_H__
+#define __SPSC_QUEUE_H__
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+/**
+ * 单生产者单消费者无锁环形队列
+ * 容量在构造时固定（向上取 2 的幂），之后不再分配内存；队列满时 push 返回 false。
+ * 读写下标各占一条缓存行，避免生产者与消费者互相失效。
+ */
+template <typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(size_t capacity)
+        : _head(0)
+        , _tail(0)
+    {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        _buffer.resize(size);
+        _mask = size - 1;
+    }
+
+    size_t getCapacity() const { return _buffer.size(); }
+
+    // 生产者线程调用
+    bool push(const T& item)
+    {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _head.load(std::memory_order_acquire) == _buffer.size()) {
+            return false;
+        }
+        _buffer[tail & _mask] = item;
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 消费者线程调用，一次最多取出 maxCount 个，返回实际个数
+    size_t popBatch(T* out, size_t maxCount)
+    {
+        size_t head = _head.load(std::memory_order_relaxed);
+        size_t available = _tail.load(std::memory_order_acquire) - head;
+        size_t count = available < maxCount ? available : maxCount;
+        for (size_t i = 0; i < count; i++) {
+            out[i] = _buffer[(head + i) & _mask];
+        }
+        _head.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    // 近似的当前长度（任意线程可调用）
+    size_t getSize() const
+    {
+        return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire);
+    }
+
+private:
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    std::vector<T> _buffer;
+    size_t _mask;
+    char _padHead[64];
+    std::atomic<size_t> _head;   // 消费者写
+    char _padTail[64];
+    std::atomic<size_t> _tail;   // 生产者写
+    char _padEnd[64];
+};
+
+#endif // __SPSC_QUEUE_H__
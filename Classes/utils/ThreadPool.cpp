@@ -0,0 +1,114 @@
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(size_t threadCount, size_t queueCapacity)
+    : _capacity(queueCapacity)
+    , _running(0)
+    , _stopping(false)
+{
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+        if (threadCount == 0) {
+            threadCount = 2;
+        }
+    }
+
+    _workers.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; i++) {
+        _workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    shutdown();
+}
+
+bool ThreadPool::submit(Task task)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _notFull.wait(lock, [this]() {
+        return _stopping || _capacity == 0 || _queue.size() < _capacity;
+    });
+    if (_stopping) {
+        return false;
+    }
+    _queue.push_back(std::move(task));
+    lock.unlock();
+    _notEmpty.notify_one();
+    return true;
+}
+
+bool ThreadPool::trySubmit(Task task)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (_stopping || (_capacity > 0 && _queue.size() >= _capacity)) {
+        return false;
+    }
+    _queue.push_back(std::move(task));
+    lock.unlock();
+    _notEmpty.notify_one();
+    return true;
+}
+
+void ThreadPool::waitIdle()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _idle.wait(lock, [this]() {
+        return _queue.empty() && _running == 0;
+    });
+}
+
+void ThreadPool::shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_stopping) {
+            return;
+        }
+        _stopping = true;
+    }
+    _notEmpty.notify_all();
+    _notFull.notify_all();
+
+    for (auto& worker : _workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+size_t ThreadPool::getQueueSize() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _queue.size();
+}
+
+void ThreadPool::workerLoop()
+{
+    for (;;) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _notEmpty.wait(lock, [this]() {
+                return _stopping || !_queue.empty();
+            });
+            if (_queue.empty()) {
+                return;   // 已关闭且队列清空
+            }
+            task = std::move(_queue.front());
+            _queue.pop_front();
+            _running++;
+        }
+        _notFull.notify_one();
+
+        task();
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _running--;
+            if (_queue.empty() && _running == 0) {
+                _idle.notify_all();
+            }
+        }
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef __THREAD_POOL_H__
+#define __THREAD_POOL_H__
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * 固定线程数、有界任务队列的线程池
+ * 队列满时 submit 阻塞等待，trySubmit 直接返回 false，用于向调用方施加背压
+ */
+class ThreadPool {
+public:
+    typedef std::function<void()> Task;
+
+    // threadCount 为 0 时使用硬件线程数；queueCapacity 为 0 时不限制队列长度
+    ThreadPool(size_t threadCount, size_t queueCapacity);
+    ~ThreadPool();
+
+    // 提交任务，队列满时阻塞；线程池已关闭时返回 false
+    bool submit(Task task);
+
+    // 提交任务，队列满时立即返回 false
+    bool trySubmit(Task task);
+
+    // 等待队列中及正在执行的任务全部完成
+    void waitIdle();
+
+    // 停止接收任务，执行完已入队任务后退出所有线程
+    void shutdown();
+
+    size_t getThreadCount() const { return _workers.size(); }
+    size_t getQueueCapacity() const { return _capacity; }
+    size_t getQueueSize() const;
+
+private:
+    void workerLoop();
+
+    std::vector<std::thread> _workers;
+    std::deque<Task> _queue;
+    size_t _capacity;
+    size_t _running;
+    bool _stopping;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _notEmpty;
+    std::condition_variable _notFull;
+    std::condition_variable _idle;
+};
+
+#endif // __THREAD_POOL_H__
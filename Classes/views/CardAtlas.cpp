@@ -0,0 +1,133 @@
+#include "CardAtlas.h"
+#include "CardView.h"
+#include "utils/AssetVariantLoader.h"
+#include <algorithm>
+
+USING_NS_CC;
+
+namespace {
+
+Size maxContentSize(const std::vector<Sprite*>& sprites)
+{
+    Size size;
+    for (auto sprite : sprites) {
+        size.width = std::max(size.width, sprite->getContentSize().width);
+        size.height = std::max(size.height, sprite->getContentSize().height);
+    }
+    return size;
+}
+
+// 把图片画在格子中央
+void drawIntoCell(Renderer* renderer, Sprite* sprite, const CardAtlasSection& section, int index)
+{
+    float x = 0.0f;
+    float y = 0.0f;
+    section.cellOrigin(index, x, y);
+    sprite->setPosition(Vec2(x + section.cellWidth / 2, y + section.cellHeight / 2));
+    sprite->visit(renderer, Mat4::IDENTITY, 0);
+}
+
+} // namespace
+
+CardAtlas* CardAtlas::create()
+{
+    CardAtlas* ret = new (std::nothrow) CardAtlas();
+    if (ret && ret->init()) {
+        ret->autorelease();
+        return ret;
+    }
+    CC_SAFE_DELETE(ret);
+    return nullptr;
+}
+
+CardAtlas::CardAtlas()
+    : _renderTexture(nullptr)
+{
+}
+
+CardAtlas::~CardAtlas()
+{
+    CC_SAFE_RELEASE(_renderTexture);
+}
+
+bool CardAtlas::init()
+{
+    // 按图集中的格子顺序加载：数字为黑 A~K、红 A~K，花色为梅花、方块、红桃、黑桃
+    auto variants = AssetVariantLoader::getInstance();
+    auto back = variants->createSprite(CardGlyphs::backFile());
+    if (!back) {
+        return false;
+    }
+    std::vector<Sprite*> smallNumbers;
+    std::vector<Sprite*> bigNumbers;
+    std::vector<Sprite*> suits;
+    for (int color = 0; color < 2; color++) {
+        int suit = color == 0 ? 0 : 1;   // 梅花为黑色，方块为红色
+        for (int face = 0; face < 13; face++) {
+            auto small = variants->createSprite(CardView::getNumberFile(false, face, suit));
+            auto big = variants->createSprite(CardView::getNumberFile(true, face, suit));
+            if (!small || !big) {
+                return false;
+            }
+            smallNumbers.push_back(small);
+            bigNumbers.push_back(big);
+        }
+    }
+    for (int suit = 0; suit < CardAtlasLayout::SUIT_COUNT; suit++) {
+        auto sprite = variants->createSprite(CardView::getSuitFile(suit));
+        if (!sprite) {
+            return false;
+        }
+        suits.push_back(sprite);
+    }
+
+    _cardSize = back->getContentSize();
+    Size smallSize = maxContentSize(smallNumbers);
+    Size bigSize = maxContentSize(bigNumbers);
+    Size suitSize = maxContentSize(suits);
+    if (!_layout.compute(_cardSize.width, _cardSize.height,
+                         smallSize.width, smallSize.height,
+                         bigSize.width, bigSize.height,
+                         suitSize.width, suitSize.height,
+                         CardAtlasLayout::MAX_WIDTH, CardAtlasLayout::PADDING)) {
+        return false;
+    }
+
+    _renderTexture = RenderTexture::create(static_cast<int>(_layout.width), static_cast<int>(_layout.height), Texture2D::PixelFormat::RGBA8888);
+    if (!_renderTexture) {
+        return false;
+    }
+    _renderTexture->retain();
+
+    // 透明底，图片按预乘 alpha 画入，格子之间互不重叠
+    auto renderer = Director::getInstance()->getRenderer();
+    _renderTexture->beginWithClear(0.0f, 0.0f, 0.0f, 0.0f);
+    drawIntoCell(renderer, back, _layout.back, 0);
+    for (int i = 0; i < CardAtlasLayout::NUMBER_COUNT; i++) {
+        drawIntoCell(renderer, smallNumbers[i], _layout.smallNumber, i);
+        drawIntoCell(renderer, bigNumbers[i], _layout.bigNumber, i);
+    }
+    for (int i = 0; i < CardAtlasLayout::SUIT_COUNT; i++) {
+        drawIntoCell(renderer, suits[i], _layout.suit, i);
+    }
+    _renderTexture->end();
+
+    // 立即执行，之后临时精灵即可释放（同 utils::captureNode）
+    renderer->render();
+
+    // 小数字和花色缩小显示，使用线性过滤
+    getTexture()->setAntiAliasTexParameters();
+    return true;
+}
+
+Texture2D* CardAtlas::getTexture() const
+{
+    return _renderTexture->getSprite()->getTexture();
+}
+
+Size CardAtlas::getTextureSize() const
+{
+    Texture2D* texture = getTexture();
+    float scale = Director::getInstance()->getContentScaleFactor();
+    return Size(texture->getPixelsWide() / scale, texture->getPixelsHigh() / scale);
+}
@@ -0,0 +1,36 @@
+#ifndef __CARD_ATLAS_H__
+#define __CARD_ATLAS_H__
+
+#include "cocos2d.h"
+#include "CardBatchBuilder.h"
+
+/**
+ * 卡牌图集
+ * 启动时把牌背、26 个小数字、26 个大数字和 4 个花色画进一张 RenderTexture，布局见 CardAtlasLayout。
+ * 与 CardView 使用同一套图片，美术资源不需要另外打包图集。
+ */
+class CardAtlas : public cocos2d::Ref {
+public:
+    // 任一图片缺失或纹理创建失败时返回 nullptr
+    static CardAtlas* create();
+
+    cocos2d::Texture2D* getTexture() const;
+    const CardAtlasLayout& getLayout() const { return _layout; }
+
+    // 纹理实际尺寸（点）；不支持非 2 次幂纹理时大于布局尺寸，纹理坐标按此换算
+    cocos2d::Size getTextureSize() const;
+
+    // 牌背尺寸（点）
+    const cocos2d::Size& getCardSize() const { return _cardSize; }
+
+private:
+    CardAtlas();
+    virtual ~CardAtlas();
+    bool init();
+
+    cocos2d::RenderTexture* _renderTexture;
+    CardAtlasLayout _layout;
+    cocos2d::Size _cardSize;
+};
+
+#endif // __CARD_ATLAS_H__
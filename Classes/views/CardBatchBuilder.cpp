@@ -0,0 +1,216 @@
+#include "CardBatchBuilder.h"
+#include <algorithm>
+#include <cmath>
+
+const float CardAtlasLayout::MAX_WIDTH = 1024.0f;
+const float CardAtlasLayout::PADDING = 2.0f;
+
+void CardAtlasSection::cellOrigin(int index, float& outX, float& outY) const
+{
+    int row = index / columns;
+    int column = index - row * columns;
+    outX = x + column * cellWidth;
+    outY = y + row * cellHeight;
+}
+
+namespace {
+
+/**
+ * 逐行摆放各区（简单的货架式排布）
+ */
+class ShelfPacker {
+public:
+    explicit ShelfPacker(float maxWidth)
+        : _maxWidth(maxWidth)
+        , _x(0.0f)
+        , _y(0.0f)
+        , _shelfHeight(0.0f)
+        , _usedWidth(0.0f)
+    {
+    }
+
+    bool place(CardAtlasSection& section, float cellWidth, float cellHeight, int count)
+    {
+        if (cellWidth > _maxWidth) {
+            return false;
+        }
+        section.cellWidth = cellWidth;
+        section.cellHeight = cellHeight;
+        section.count = count;
+
+        // 当前行剩余宽度能放下的列数；放不下一列、或块高超过当前行（行非空）时换行
+        int columns = std::min(count, static_cast<int>((_maxWidth - _x) / cellWidth));
+        int rows = columns > 0 ? (count + columns - 1) / columns : 0;
+        if (columns <= 0 || (_x > 0.0f && rows * cellHeight > _shelfHeight)) {
+            newShelf();
+            columns = std::min(count, static_cast<int>(_maxWidth / cellWidth));
+            rows = (count + columns - 1) / columns;
+        }
+
+        section.columns = columns;
+        section.x = _x;
+        section.y = _y;
+        _x += columns * cellWidth;
+        _shelfHeight = std::max(_shelfHeight, rows * cellHeight);
+        _usedWidth = std::max(_usedWidth, _x);
+        return true;
+    }
+
+    float getWidth() const { return _usedWidth; }
+    float getHeight() const { return _y + _shelfHeight; }
+
+private:
+    void newShelf()
+    {
+        _y += _shelfHeight;
+        _x = 0.0f;
+        _shelfHeight = 0.0f;
+    }
+
+    float _maxWidth;
+    float _x;
+    float _y;
+    float _shelfHeight;
+    float _usedWidth;
+};
+
+} // namespace
+
+bool CardAtlasLayout::compute(float backWidth, float backHeight,
+                              float smallWidth, float smallHeight,
+                              float bigWidth, float bigHeight,
+                              float suitWidth, float suitHeight,
+                              float maxWidth, float padding)
+{
+    // 格子按整数点对齐，避免格子边界落在像素中间
+    float pad = std::ceil(padding) * 2.0f;
+    ShelfPacker packer(maxWidth);
+    if (!packer.place(back, std::ceil(backWidth) + pad, std::ceil(backHeight) + pad, 1)
+        || !packer.place(bigNumber, std::ceil(bigWidth) + pad, std::ceil(bigHeight) + pad, NUMBER_COUNT)
+        || !packer.place(smallNumber, std::ceil(smallWidth) + pad, std::ceil(smallHeight) + pad, NUMBER_COUNT)
+        || !packer.place(suit, std::ceil(suitWidth) + pad, std::ceil(suitHeight) + pad, SUIT_COUNT)) {
+        return false;
+    }
+    width = packer.getWidth();
+    height = packer.getHeight();
+    return true;
+}
+
+int CardAtlasLayout::numberIndex(int face, int suit)
+{
+    bool red = (suit == 1 || suit == 2);
+    return (red ? 13 : 0) + face;
+}
+
+namespace CardGlyphs {
+
+CardGlyphPlacement smallNumber(float cardWidth, float cardHeight)
+{
+    (void)cardWidth;
+    CardGlyphPlacement placement = { 35.0f, cardHeight - 40.0f, 0.9f };
+    return placement;
+}
+
+CardGlyphPlacement suit(float cardWidth, float cardHeight)
+{
+    CardGlyphPlacement placement = { cardWidth - 35.0f, cardHeight - 40.0f, 0.6f };
+    return placement;
+}
+
+CardGlyphPlacement bigNumber(float cardWidth, float cardHeight)
+{
+    CardGlyphPlacement placement = { cardWidth / 2.0f, cardHeight / 2.0f - 10.0f, 1.0f };
+    return placement;
+}
+
+std::string backFile()
+{
+    return "res/card_general.png";
+}
+
+std::string numberFile(bool big, int face, int suit)
+{
+    static const char* FACE_NAMES[] = { "A", "2", "3", "4", "5", "6", "7", "8", "9", "10", "J", "Q", "K" };
+    const char* faceStr = (face >= 0 && face < 13) ? FACE_NAMES[face] : FACE_NAMES[0];
+    bool red = (suit == 1 || suit == 2);
+    return std::string("res/number/") + (big ? "big_" : "small_") + (red ? "red" : "black") + "_" + faceStr + ".png";
+}
+
+std::string suitFile(int suit)
+{
+    switch (suit) {
+    case 0: return "res/suits/club.png";
+    case 1: return "res/suits/diamond.png";
+    case 2: return "res/suits/heart.png";
+    case 3: return "res/suits/spade.png";
+    default: return "res/suits/club.png";
+    }
+}
+
+} // namespace CardGlyphs
+
+void CardBatchBuilder::clear()
+{
+    _instances.clear();
+}
+
+bool CardBatchBuilder::addCard(float x, float y, float z, int face, int suit)
+{
+    if (_instances.size() >= MAX_CARDS) {
+        return false;
+    }
+    Instance instance;
+    instance.x = x;
+    instance.y = y;
+    instance.z = z;
+    instance.face = static_cast<uint8_t>(face);
+    instance.suit = static_cast<uint8_t>(suit);
+    _instances.push_back(instance);
+    return true;
+}
+
+void CardBatchBuilder::build(float cardWidth, float cardHeight)
+{
+    size_t count = _instances.size();
+
+    // 插入排序：调用方通常已按层级顺序添加，近乎有序时是线性的，且稳定、不分配内存
+    _order.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        uint32_t current = static_cast<uint32_t>(i);
+        size_t j = i;
+        while (j > 0 && _instances[_order[j - 1]].z > _instances[current].z) {
+            _order[j] = _order[j - 1];
+            j--;
+        }
+        _order[j] = current;
+    }
+
+    _vertices.resize(count * 4);
+    _indices.resize(count * 6);
+    float halfWidth = cardWidth / 2.0f;
+    float halfHeight = cardHeight / 2.0f;
+    for (size_t i = 0; i < count; i++) {
+        const Instance& instance = _instances[_order[i]];
+        float left = instance.x - halfWidth;
+        float right = instance.x + halfWidth;
+        float bottom = instance.y - halfHeight;
+        float top = instance.y + halfHeight;
+        float face = instance.face;
+        float suit = instance.suit;
+
+        CardVertex* quad = &_vertices[i * 4];
+        quad[0] = { left, bottom, 0.0f, 0.0f, 0.0f, face, suit };
+        quad[1] = { right, bottom, 0.0f, 1.0f, 0.0f, face, suit };
+        quad[2] = { left, top, 0.0f, 0.0f, 1.0f, face, suit };
+        quad[3] = { right, top, 0.0f, 1.0f, 1.0f, face, suit };
+
+        uint16_t base = static_cast<uint16_t>(i * 4);
+        uint16_t* index = &_indices[i * 6];
+        index[0] = base;
+        index[1] = static_cast<uint16_t>(base + 1);
+        index[2] = static_cast<uint16_t>(base + 2);
+        index[3] = static_cast<uint16_t>(base + 2);
+        index[4] = static_cast<uint16_t>(base + 1);
+        index[5] = static_cast<uint16_t>(base + 3);
+    }
+}
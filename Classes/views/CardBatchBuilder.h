@@ -0,0 +1,132 @@
+#ifndef __CARD_BATCH_BUILDER_H__
+#define __CARD_BATCH_BUILDER_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * 图集中的一类格子（同类图片格子大小相同，图片居中放在格子里）
+ * 坐标单位为点，原点在图集左下角
+ */
+struct CardAtlasSection {
+    float x;
+    float y;
+    float cellWidth;
+    float cellHeight;
+    int columns;
+    int count;
+
+    CardAtlasSection() : x(0.0f), y(0.0f), cellWidth(0.0f), cellHeight(0.0f), columns(1), count(0) {}
+
+    // 第 index 格的左下角
+    void cellOrigin(int index, float& outX, float& outY) const;
+};
+
+/**
+ * 卡牌图集布局：牌背 1 格，小数字、大数字各 26 格（黑 13 + 红 13），花色 4 格
+ * 着色器只需要各区的起点、格子尺寸和列数，就能由牌面和花色算出纹理坐标
+ */
+struct CardAtlasLayout {
+    static const int NUMBER_COUNT = 26;
+    static const int SUIT_COUNT = 4;
+
+    // CardAtlas 使用的最大宽度和格子留白（点）
+    static const float MAX_WIDTH;
+    static const float PADDING;
+
+    float width;
+    float height;
+    CardAtlasSection back;
+    CardAtlasSection smallNumber;
+    CardAtlasSection bigNumber;
+    CardAtlasSection suit;
+
+    CardAtlasLayout() : width(0.0f), height(0.0f) {}
+
+    // 按各类图片的最大尺寸排布，每格四周留 padding 防止线性采样串到相邻格子
+    // 逐行摆放各区，一行放不下时换行；maxWidth 小于任何一格时返回 false
+    bool compute(float backWidth, float backHeight,
+                 float smallWidth, float smallHeight,
+                 float bigWidth, float bigHeight,
+                 float suitWidth, float suitHeight,
+                 float maxWidth, float padding);
+
+    // 数字格子序号：黑色 0~12，红色 13~25
+    static int numberIndex(int face, int suit);
+};
+
+/**
+ * 卡牌上一个元素的位置（卡牌左下角为原点，与 CardView::setupCardTexture 一致）
+ */
+struct CardGlyphPlacement {
+    float x;
+    float y;
+    float scale;
+};
+
+namespace CardGlyphs {
+    CardGlyphPlacement smallNumber(float cardWidth, float cardHeight);
+    CardGlyphPlacement suit(float cardWidth, float cardHeight);
+    CardGlyphPlacement bigNumber(float cardWidth, float cardHeight);
+
+    // 各元素的图片（相对 Resources）
+    std::string backFile();
+    std::string numberFile(bool big, int face, int suit);
+    std::string suitFile(int suit);
+}
+
+/**
+ * 批量绘制的顶点：每张牌一个四边形，四个顶点携带相同的牌面和花色
+ * 着色器据此在图集中选择牌背、数字和花色区域，一张牌只需一个四边形
+ */
+struct CardVertex {
+    float x;
+    float y;
+    float z;
+    float u;         // 卡牌内坐标 0~1
+    float v;
+    float face;
+    float suit;
+};
+
+/**
+ * 卡牌顶点流生成（纯 CPU，不依赖 cocos2d / GL）
+ *
+ * 每帧（或卡牌变化时）清空后逐张添加，build 按 z 稳定排序（z 相同保持添加顺序）后生成
+ * 4 个顶点 + 6 个索引 / 张。z 只决定绘制顺序，顶点 z 固定为 0，避免透视投影下改变大小。
+ * 容器跨帧复用，牌数不超过历史最大值时不分配内存。
+ */
+class CardBatchBuilder {
+public:
+    // 16 位索引上限
+    static const size_t MAX_CARDS = 65536 / 4;
+
+    void clear();
+
+    // position 为卡牌中心；超过 MAX_CARDS 时忽略并返回 false
+    bool addCard(float x, float y, float z, int face, int suit);
+
+    void build(float cardWidth, float cardHeight);
+
+    size_t getCardCount() const { return _instances.size(); }
+    const std::vector<CardVertex>& getVertices() const { return _vertices; }
+    const std::vector<uint16_t>& getIndices() const { return _indices; }
+
+private:
+    struct Instance {
+        float x;
+        float y;
+        float z;
+        uint8_t face;
+        uint8_t suit;
+    };
+
+    std::vector<Instance> _instances;
+    std::vector<uint32_t> _order;
+    std::vector<CardVertex> _vertices;
+    std::vector<uint16_t> _indices;
+};
+
+#endif // __CARD_BATCH_BUILDER_H__
@@ -0,0 +1,157 @@
+#include "CardBatchNode.h"
+#include <cstddef>
+
+USING_NS_CC;
+
+const char* CardBatchNode::VERTEX_SHADER_FILE = "shaders/card_batch.vsh";
+const char* CardBatchNode::FRAGMENT_SHADER_FILE = "shaders/card_batch.fsh";
+
+CardBatchNode* CardBatchNode::create(CardAtlas* atlas)
+{
+    CardBatchNode* ret = new (std::nothrow) CardBatchNode();
+    if (ret && ret->init(atlas)) {
+        ret->autorelease();
+        return ret;
+    }
+    CC_SAFE_DELETE(ret);
+    return nullptr;
+}
+
+CardBatchNode::CardBatchNode()
+    : _atlas(nullptr)
+    , _buffersDirty(false)
+{
+    _buffers[0] = 0;
+    _buffers[1] = 0;
+}
+
+CardBatchNode::~CardBatchNode()
+{
+    if (_buffers[0]) {
+        glDeleteBuffers(2, _buffers);
+    }
+    CC_SAFE_RELEASE(_atlas);
+}
+
+bool CardBatchNode::init(CardAtlas* atlas)
+{
+    if (!Node::init() || !atlas) {
+        return false;
+    }
+    _atlas = atlas;
+    _atlas->retain();
+
+    if (!setupProgram()) {
+        return false;
+    }
+    setupBuffers();
+
+#if CC_ENABLE_CACHE_TEXTURE_DATA
+    // GL 上下文重建后着色器和缓冲区都已失效
+    auto listener = EventListenerCustom::create(EVENT_RENDERER_RECREATED, [this](EventCustom*) {
+        auto program = getGLProgram();
+        program->reset();
+        program->initWithFilenames(VERTEX_SHADER_FILE, FRAGMENT_SHADER_FILE);
+        program->link();
+        program->updateUniforms();
+        setupBuffers();
+    });
+    _eventDispatcher->addEventListenerWithSceneGraphPriority(listener, this);
+#endif
+
+    return true;
+}
+
+bool CardBatchNode::setupProgram()
+{
+    auto program = GLProgram::createWithFilenames(VERTEX_SHADER_FILE, FRAGMENT_SHADER_FILE);
+    if (!program) {
+        return false;
+    }
+    auto state = GLProgramState::getOrCreateWithGLProgram(program);
+    setGLProgramState(state);
+
+    // 图集布局和元素位置在整个运行期间不变，只设置一次
+    const CardAtlasLayout& layout = _atlas->getLayout();
+    const Size& cardSize = _atlas->getCardSize();
+    Size textureSize = _atlas->getTextureSize();
+    CardGlyphPlacement smallPlace = CardGlyphs::smallNumber(cardSize.width, cardSize.height);
+    CardGlyphPlacement suitPlace = CardGlyphs::suit(cardSize.width, cardSize.height);
+    CardGlyphPlacement bigPlace = CardGlyphs::bigNumber(cardSize.width, cardSize.height);
+
+    state->setUniformVec2("u_cardSize", Vec2(cardSize.width, cardSize.height));
+    state->setUniformVec2("u_atlasSize", Vec2(textureSize.width, textureSize.height));
+    state->setUniformVec4("u_back", Vec4(layout.back.x, layout.back.y, layout.back.cellWidth, layout.back.cellHeight));
+    state->setUniformVec4("u_smallNumber", Vec4(layout.smallNumber.x, layout.smallNumber.y, layout.smallNumber.cellWidth, layout.smallNumber.cellHeight));
+    state->setUniformVec4("u_bigNumber", Vec4(layout.bigNumber.x, layout.bigNumber.y, layout.bigNumber.cellWidth, layout.bigNumber.cellHeight));
+    state->setUniformVec4("u_suit", Vec4(layout.suit.x, layout.suit.y, layout.suit.cellWidth, layout.suit.cellHeight));
+    state->setUniformVec3("u_columns", Vec3(static_cast<float>(layout.smallNumber.columns), static_cast<float>(layout.bigNumber.columns), static_cast<float>(layout.suit.columns)));
+    state->setUniformVec3("u_smallPlace", Vec3(smallPlace.x, smallPlace.y, smallPlace.scale));
+    state->setUniformVec3("u_suitPlace", Vec3(suitPlace.x, suitPlace.y, suitPlace.scale));
+    state->setUniformVec3("u_bigPlace", Vec3(bigPlace.x, bigPlace.y, bigPlace.scale));
+    state->setUniformTexture("CC_Texture0", _atlas->getTexture());
+    return true;
+}
+
+void CardBatchNode::setupBuffers()
+{
+    glGenBuffers(2, _buffers);
+    _buffersDirty = true;
+}
+
+void CardBatchNode::clearCards()
+{
+    _builder.clear();
+}
+
+void CardBatchNode::addCard(const Vec2& position, float z, int face, int suit)
+{
+    _builder.addCard(position.x, position.y, z, face, suit);
+}
+
+void CardBatchNode::commitCards()
+{
+    const Size& cardSize = _atlas->getCardSize();
+    _builder.build(cardSize.width, cardSize.height);
+    _buffersDirty = true;
+}
+
+void CardBatchNode::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
+{
+    if (_builder.getCardCount() == 0) {
+        return;
+    }
+    _customCommand.init(_globalZOrder, transform, flags);
+    _customCommand.func = CC_CALLBACK_0(CardBatchNode::onDraw, this, transform, flags);
+    renderer->addCommand(&_customCommand);
+}
+
+void CardBatchNode::onDraw(const Mat4& transform, uint32_t)
+{
+    const auto& vertices = _builder.getVertices();
+    const auto& indices = _builder.getIndices();
+
+    getGLProgramState()->apply(transform);
+    GL::blendFunc(BlendFunc::ALPHA_PREMULTIPLIED.src, BlendFunc::ALPHA_PREMULTIPLIED.dst);
+    GL::bindVAO(0);
+
+    glBindBuffer(GL_ARRAY_BUFFER, _buffers[0]);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffers[1]);
+    if (_buffersDirty) {
+        glBufferData(GL_ARRAY_BUFFER, sizeof(CardVertex) * vertices.size(), vertices.data(), GL_DYNAMIC_DRAW);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint16_t) * indices.size(), indices.data(), GL_DYNAMIC_DRAW);
+        _buffersDirty = false;
+    }
+
+    GL::enableVertexAttribs(GL::VERTEX_ATTRIB_FLAG_POSITION | GL::VERTEX_ATTRIB_FLAG_TEX_COORD | (1 << GLProgram::VERTEX_ATTRIB_TEX_COORD1));
+    glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(CardVertex), reinterpret_cast<GLvoid*>(offsetof(CardVertex, x)));
+    glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_TEX_COORD, 2, GL_FLOAT, GL_FALSE, sizeof(CardVertex), reinterpret_cast<GLvoid*>(offsetof(CardVertex, u)));
+    glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_TEX_COORD1, 2, GL_FLOAT, GL_FALSE, sizeof(CardVertex), reinterpret_cast<GLvoid*>(offsetof(CardVertex, face)));
+
+    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_SHORT, nullptr);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    CC_INCREMENT_GL_DRAWN_BATCHES_AND_VERTICES(1, vertices.size());
+    CHECK_GL_ERROR_DEBUG();
+}
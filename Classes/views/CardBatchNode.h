@@ -0,0 +1,52 @@
+#ifndef __CARD_BATCH_NODE_H__
+#define __CARD_BATCH_NODE_H__
+
+#include "cocos2d.h"
+#include "CardAtlas.h"
+#include "CardBatchBuilder.h"
+
+/**
+ * 批量卡牌绘制节点
+ *
+ * 所有卡牌合成一条顶点流（每张牌一个四边形），一次 glDrawElements 画完。
+ * 着色器（shaders/card_batch.vsh / .fsh）根据顶点上的牌面和花色在 CardAtlas 中选择牌背、
+ * 小数字、花色和大数字区域，代替每张牌一个底图精灵加三个子精灵。
+ * 卡牌变化时由调用方 clearCards / addCard / commitCards 重建顶点，之后每帧只提交一个绘制命令。
+ */
+class CardBatchNode : public cocos2d::Node {
+public:
+    // 着色器编译失败时返回 nullptr，调用方退回逐张精灵绘制
+    static CardBatchNode* create(CardAtlas* atlas);
+
+    void clearCards();
+
+    // position 为卡牌中心，z 只决定绘制顺序（相同 z 按添加顺序）
+    void addCard(const cocos2d::Vec2& position, float z, int face, int suit);
+
+    // 生成顶点流，下一次绘制前上传
+    void commitCards();
+
+    size_t getCardCount() const { return _builder.getCardCount(); }
+
+    virtual void draw(cocos2d::Renderer* renderer, const cocos2d::Mat4& transform, uint32_t flags) override;
+
+private:
+    CardBatchNode();
+    virtual ~CardBatchNode();
+    bool init(CardAtlas* atlas);
+
+    bool setupProgram();
+    void setupBuffers();
+    void onDraw(const cocos2d::Mat4& transform, uint32_t flags);
+
+    static const char* VERTEX_SHADER_FILE;
+    static const char* FRAGMENT_SHADER_FILE;
+
+    CardAtlas* _atlas;
+    CardBatchBuilder _builder;
+    cocos2d::CustomCommand _customCommand;
+    GLuint _buffers[2];          // 顶点、索引
+    bool _buffersDirty;
+};
+
+#endif // __CARD_BATCH_NODE_H__
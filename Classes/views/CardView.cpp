@@ -1,4 +1,7 @@
 #include "CardView.h"
+#include "configs/LevelConfig.h"
+#include "CardBatchBuilder.h"
+#include "utils/AssetVariantLoader.h"
 
 USING_NS_CC;
 
@@ -13,7 +16,18 @@ CardView* CardView::create(const CardModel& model)
     return nullptr;
 }
 
-bool CardView::init(const CardModel& model)
+CardView* CardView::createProxy(const CardModel& model)
+{
+    CardView* ret = new (std::nothrow) CardView();
+    if (ret && ret->init(model, false)) {
+        ret->autorelease();
+        return ret;
+    }
+    CC_SAFE_DELETE(ret);
+    return nullptr;
+}
+
+bool CardView::init(const CardModel& model, bool withSprites)
 {
     if (!Sprite::init()) {
         return false;
@@ -22,7 +36,14 @@ bool CardView::init(const CardModel& model)
     _cardModel = model;
     _cardId = model.getId();
     
-    setupCardTexture();
+    if (withSprites) {
+        setupCardTexture();
+    }
+    else {
+        // 只用于点击检测和记录位置，不参与绘制
+        this->setContentSize(Size(LevelLayout::CARD_WIDTH, LevelLayout::CARD_HEIGHT));
+        this->setVisible(false);
+    }
     setupTouchListener();
     
     this->setPosition(model.getPosition());
@@ -37,46 +58,13 @@ void CardView::setupCardTexture()
     int face = static_cast<int>(_cardModel.getFace());
 
     // 加载卡牌背景
-    this->setTexture("res/card_general.png");
+    auto variants = AssetVariantLoader::getInstance();
+    variants->setSpriteTexture(this, CardGlyphs::backFile());
 
     Size cardSize = this->getContentSize();
 
-    // 判断是红色还是黑色花色
-    bool isRed = (suit == 1 || suit == 2);  // 方块或红桃是红色
-    std::string colorPrefix = isRed ? "red" : "black";
-
-    // 获取牌面字符串
-    std::string faceStr;
-    switch (face) {
-    case 0:  faceStr = "A"; break;
-    case 1:  faceStr = "2"; break;
-    case 2:  faceStr = "3"; break;
-    case 3:  faceStr = "4"; break;
-    case 4:  faceStr = "5"; break;
-    case 5:  faceStr = "6"; break;
-    case 6:  faceStr = "7"; break;
-    case 7:  faceStr = "8"; break;
-    case 8:  faceStr = "9"; break;
-    case 9:  faceStr = "10"; break;
-    case 10: faceStr = "J"; break;
-    case 11: faceStr = "Q"; break;
-    case 12: faceStr = "K"; break;
-    default: faceStr = "A"; break;
-    }
-
-    // 花色文件
-    std::string suitFile;
-    switch (suit) {
-    case 0: suitFile = "res/suits/club.png"; break;
-    case 1: suitFile = "res/suits/diamond.png"; break;
-    case 2: suitFile = "res/suits/heart.png"; break;
-    case 3: suitFile = "res/suits/spade.png"; break;
-    default: suitFile = "res/suits/club.png"; break;
-    }
-
     // 左上角数字（稍微往下移，不贴着上边沿）
-    std::string smallNumFile = "res/number/small_" + colorPrefix + "_" + faceStr + ".png";
-    auto leftNumSprite = Sprite::create(smallNumFile);
+    auto leftNumSprite = variants->createSprite(getNumberFile(false, face, suit));
     if (leftNumSprite) {
         leftNumSprite->setPosition(Vec2(35, cardSize.height - 40));
         leftNumSprite->setScale(0.9f);
@@ -84,7 +72,7 @@ void CardView::setupCardTexture()
     }
 
     // 右上角花色（和左上角数字一样大，位置对称）
-    auto rightSuitSprite = Sprite::create(suitFile);
+    auto rightSuitSprite = variants->createSprite(getSuitFile(suit));
     if (rightSuitSprite) {
         rightSuitSprite->setPosition(Vec2(cardSize.width - 35, cardSize.height - 40));
         rightSuitSprite->setScale(0.6f);
@@ -92,8 +80,7 @@ void CardView::setupCardTexture()
     }
 
     // 中间大数字
-    std::string bigNumFile = "res/number/big_" + colorPrefix + "_" + faceStr + ".png";
-    auto bigNumSprite = Sprite::create(bigNumFile);
+    auto bigNumSprite = variants->createSprite(getNumberFile(true, face, suit));
     if (bigNumSprite) {
         bigNumSprite->setPosition(Vec2(cardSize.width / 2, cardSize.height / 2 - 10));
         bigNumSprite->setScale(1.0f);
@@ -101,6 +88,16 @@ void CardView::setupCardTexture()
     }
 }
 
+std::string CardView::getNumberFile(bool big, int face, int suit)
+{
+    return CardGlyphs::numberFile(big, face, suit);
+}
+
+std::string CardView::getSuitFile(int suit)
+{
+    return CardGlyphs::suitFile(suit);
+}
+
 void CardView::setupTouchListener()
 {
     auto listener = EventListenerTouchOneByOne::create();
@@ -132,19 +129,6 @@ void CardView::setupTouchListener()
     _eventDispatcher->addEventListenerWithSceneGraphPriority(listener, this);
 }
 
-void CardView::playMoveAnimation(const Vec2& targetPos, float duration, const std::function<void()>& callback)
-{
-    auto moveTo = MoveTo::create(duration, targetPos);
-    
-    if (callback) {
-        auto callFunc = CallFunc::create(callback);
-        auto sequence = Sequence::create(moveTo, callFunc, nullptr);
-        this->runAction(sequence);
-    } else {
-        this->runAction(moveTo);
-    }
-}
-
 void CardView::updateCardModel(const CardModel& model)
 {
     _cardModel = model;
@@ -3,17 +3,26 @@
 
 #include "cocos2d.h"
 #include "models/CardModel.h"
-#include <functional>
+#include "utils/Delegate.h"
 
 /**
  * 卡牌视图类
  * 负责单张卡牌的显示和交互
+ * 代理模式下不创建纹理和子精灵，只保留位置、层级和点击区域，由 CardBatchNode 统一绘制
  */
 class CardView : public cocos2d::Sprite {
 public:
     static CardView* create(const CardModel& model);
     
-    bool init(const CardModel& model);
+    // 创建不绘制的代理视图（批量绘制时使用）
+    static CardView* createProxy(const CardModel& model);
+    
+    bool init(const CardModel& model, bool withSprites = true);
+    
+    // 资源路径（批量绘制的图集使用同一套图片）
+    static std::string getNumberFile(bool big, int face, int suit);
+    static std::string getSuitFile(int suit);
+    static bool isRedSuit(int suit) { return suit == 1 || suit == 2; }  // 方块或红桃是红色
     
     // 获取卡牌ID
     int getCardId() const { return _cardId; }
@@ -22,10 +31,7 @@ public:
     const CardModel& getCardModel() const { return _cardModel; }
     
     // 设置点击回调
-    void setClickCallback(const std::function<void(int)>& callback) { _clickCallback = callback; }
-    
-    // 播放移动动画
-    void playMoveAnimation(const cocos2d::Vec2& targetPos, float duration, const std::function<void()>& callback = nullptr);
+    void setClickCallback(const Delegate<void(int)>& callback) { _clickCallback = callback; }
     
     // 更新卡牌数据
     void updateCardModel(const CardModel& model);
@@ -39,7 +45,7 @@ private:
     
     int _cardId;
     CardModel _cardModel;
-    std::function<void(int)> _clickCallback;
+    Delegate<void(int)> _clickCallback;
 };
 
 #endif // __CARD_VIEW_H__
\ No newline at end of file
@@ -1,8 +1,24 @@
 #include "GameView.h"
 #include "ui/CocosGUI.h"
+#include "managers/FrameRateManager.h"
+#include "CardBatchNode.h"
 
 USING_NS_CC;
 
+const float GameView::MOVE_DURATION = 0.3f;
+
+namespace {
+
+// 补间的附加信息：低 8 位为动画类型，NOTIFY_BIT 表示结束时派发 AnimationDoneEvent
+const uint32_t NOTIFY_BIT = 0x100;
+
+uint32_t makeTweenTag(AnimationKind kind, bool notify)
+{
+    return static_cast<uint32_t>(kind) | (notify ? NOTIFY_BIT : 0);
+}
+
+} // namespace
+
 GameView* GameView::create()
 {
     GameView* ret = new (std::nothrow) GameView();
@@ -22,13 +38,75 @@ bool GameView::init()
     
     _traySprite = nullptr;
     _stackSprite = nullptr;
+    _eventBus = nullptr;
+    _positionLabel = nullptr;
+    _bannerLabel = nullptr;
+    _clearCelebrated = false;
+    _backgrounds[0] = nullptr;
+    _backgrounds[1] = nullptr;
+    _staticCache = nullptr;
+    _staticCacheEnabled = true;
+    _staticDirty = true;
+    _staticBakeCount = 0;
+    _cardBatch = nullptr;
+    _model = nullptr;
+    _reconcileDirty = false;
+    _lastReconcileOpCount = 0;
+    _liveStackCards = ViewReconciler::DEFAULT_LIVE_STACK_CARDS;
+    _maxCreatesPerFrame = DEFAULT_MAX_CREATES_PER_FRAME;
     
+    setupStaticCache();
+    setupCardBatch();
     setupBackground();
     setupUI();
     
+    this->scheduleUpdate();
+    
     return true;
 }
 
+void GameView::setupStaticCache()
+{
+    // 与窗口同尺寸，放在最底层；烘焙时按窗口坐标绘制
+    auto winSize = Director::getInstance()->getWinSize();
+    _staticCache = RenderTexture::create(static_cast<int>(winSize.width), static_cast<int>(winSize.height), Texture2D::PixelFormat::RGBA8888);
+    if (!_staticCache) {
+        _staticCacheEnabled = false;
+        return;
+    }
+    _staticCache->setPosition(Vec2(winSize.width / 2, winSize.height / 2));
+    this->addChild(_staticCache, -2);
+
+    // GL 上下文重建后纹理内容丢失，重新烘焙
+    auto listener = EventListenerCustom::create(EVENT_RENDERER_RECREATED, [this](EventCustom*) {
+        invalidateStaticLayer();
+    });
+    _eventDispatcher->addEventListenerWithSceneGraphPriority(listener, this);
+}
+
+void GameView::setupCardBatch()
+{
+    // 图集或着色器不可用时退回逐张精灵绘制（配合静态层缓存）
+    auto atlas = CardAtlas::create();
+    _cardBatch = atlas ? CardBatchNode::create(atlas) : nullptr;
+    if (!_cardBatch) {
+        CCLOG("Card batch unavailable, drawing cards as sprites");
+        return;
+    }
+    this->addChild(_cardBatch, 0);
+
+    // 所有卡牌已经在一次绘制中完成，不再需要静态层
+    if (_staticCache) {
+        _staticCacheEnabled = false;
+        _staticCache->setVisible(false);
+    }
+}
+
+CardView* GameView::createCardView(const CardModel& model)
+{
+    return _cardBatch ? CardView::createProxy(model) : CardView::create(model);
+}
+
 void GameView::setupBackground()
 {
     auto visibleSize = Director::getInstance()->getVisibleSize();
@@ -37,11 +115,13 @@ void GameView::setupBackground()
     auto topBg = LayerColor::create(Color4B(139, 90, 43, 255), 1080, 1500);
     topBg->setPosition(Vec2(0, 580));
     this->addChild(topBg, -1);
+    _backgrounds[0] = topBg;
 
     // 创建下方手牌区背景（紫色）
     auto bottomBg = LayerColor::create(Color4B(156, 89, 182, 255), 1080, 580);
     bottomBg->setPosition(Vec2(0, 0));
     this->addChild(bottomBg, -1);
+    _backgrounds[1] = bottomBg;
 }
 
 void GameView::setupUI()
@@ -52,7 +132,7 @@ void GameView::setupUI()
     auto undoLabel = Label::createWithSystemFont("回退", "Arial", 40);
     undoLabel->setPosition(Vec2(900, 290));
     undoLabel->setTextColor(Color4B::WHITE);
-    this->addChild(undoLabel, 100);
+    this->addChild(undoLabel, ViewReconciler::MOVING_Z + 1);
 
     // 为文字添加点击事件
     auto listener = EventListenerTouchOneByOne::create();
@@ -68,177 +148,424 @@ void GameView::setupUI()
         Size size = undoLabel->getContentSize();
         Rect rect = Rect(0, 0, size.width, size.height);
         if (rect.containsPoint(locationInNode)) {
-            if (_undoClickCallback) {
-                _undoClickCallback();
+            if (_eventBus) {
+                _eventBus->publish(UndoClickedEvent());
             }
         }
         };
     _eventDispatcher->addEventListenerWithSceneGraphPriority(listener, undoLabel);
+
+    // 无法通关提示（手牌区上方），收到分析结论时显示
+    _positionLabel = Label::createWithSystemFont("", "Arial", 36);
+    _positionLabel->setPosition(Vec2(visibleSize.width / 2, 520));
+    _positionLabel->setTextColor(Color4B(255, 220, 120, 255));
+    _positionLabel->setVisible(false);
+    this->addChild(_positionLabel, ViewReconciler::MOVING_Z + 1);
+
+    // 表现脚本的横幅（主牌区中央）
+    _bannerLabel = Label::createWithSystemFont("", "Arial", 96);
+    _bannerLabel->setPosition(Vec2(visibleSize.width / 2, 1330));
+    _bannerLabel->setTextColor(Color4B(255, 235, 120, 255));
+    _bannerLabel->setVisible(false);
+    this->addChild(_bannerLabel, ViewReconciler::MOVING_Z + 1);
+}
+
+void GameView::setEventBus(GameEventBus* eventBus)
+{
+    if (_eventBus) {
+        _eventBus->unsubscribe(_positionSubscription);
+    }
+    _eventBus = eventBus;
+    if (_eventBus) {
+        _positionSubscription = _eventBus->subscribe<PositionAnalyzedEvent>([this](const PositionAnalyzedEvent& event) {
+            this->onPositionAnalyzed(event);
+        });
+    }
+}
+
+void GameView::onPositionAnalyzed(const PositionAnalyzedEvent& event)
+{
+    if (!_positionLabel) {
+        return;
+    }
+    // 仍可通关或尚无结论时不提示
+    bool lost = (event.status == PositionStatus::LOST);
+    if (lost) {
+        _positionLabel->setString(StringUtils::format("已无法通关，最多还能走 %d 步", event.movesLeft));
+    }
+    _positionLabel->setVisible(lost);
+    FrameRateManager::getInstance()->wake();
 }
 
 void GameView::initWithModel(GameModel* model)
 {
-    if (!model) return;
+    // 重新加载关卡时丢弃上一局的动画和脚本（不派发结束事件）
+    _sequences.cancelAll();
+    hideBanner();
+    revealUndealt();
+    for (size_t i = 0; i < _tweens.size(); i++) {
+        _reconciler.invalidate(_tweens.getCardId(i));
+    }
+    _tweens.clear();
+    
+    _model = model;
+    if (!model) {
+        clearCards();
+        return;
+    }
     
-    setupPlayfieldCards(model);
-    setupStackCards(model);
-    setupTrayCards(model);
+    // 主牌区的牌先进入待发状态，由发牌脚本逐张发出
+    for (const auto& card : model->getPlayfieldCards()) {
+        int cardId = card.getId();
+        if (cardId < 0) {
+            continue;
+        }
+        if (cardId >= static_cast<int>(_undealt.size())) {
+            _undealt.resize(cardId + 1, 0);
+        }
+        _undealt[cardId] = 1;
+        _dealOrder.push_back(cardId);
+    }
+    for (int cardId : _dealOrder) {
+        CardView* cardView = getCardView(cardId);
+        if (cardView) {
+            cardView->setVisible(false);
+        }
+    }
+    _clearCelebrated = model->getPlayfieldCards().empty();
+    reconcileViews();
+    invalidateStaticLayer();
+    PresentationScripts::startDeal(_sequences, this);
+    FrameRateManager::getInstance()->wake();
 }
 
-void GameView::setupPlayfieldCards(GameModel* model)
+void GameView::revealUndealt()
 {
-    auto& cards = model->getPlayfieldCards();
-    for (auto& cardModel : cards) {
-        auto cardView = CardView::create(cardModel);
+    for (int cardId : _dealOrder) {
+        if (!isUndealt(cardId)) {
+            continue;
+        }
+        _undealt[cardId] = 0;
+        // 静态层开启时由下一次烘焙决定可见性
+        CardView* cardView = getCardView(cardId);
         if (cardView) {
-            cardView->setClickCallback([this](int cardId) {
-                if (_cardClickCallback) {
-                    _cardClickCallback(cardId);
-                }
-            });
-            this->addChild(cardView, 10);
-            _cardViews[cardModel.getId()] = cardView;
+            cardView->setVisible(true);
         }
     }
+    _dealOrder.clear();
+    invalidateStaticLayer();
 }
 
-void GameView::setupStackCards(GameModel* model)
+bool GameView::isUndealt(int cardId) const
 {
-    // 底牌堆位置（右侧）
-    Vec2 stackPos = Vec2(700, 290);
+    return cardId >= 0 && cardId < static_cast<int>(_undealt.size()) && _undealt[cardId] != 0;
+}
 
-    auto& cards = model->getStackCards();
-    if (!cards.empty()) {
-        auto& topCard = cards.back();
-        // 更新卡牌位置
-        CardModel updatedCard = topCard;
-        updatedCard.setPosition(stackPos);
+void GameView::dealCard(int cardId, float duration)
+{
+    CardView* cardView = getCardView(cardId);
+    if (!isUndealt(cardId) || !cardView) {
+        return;
+    }
+    _undealt[cardId] = 0;
 
-        auto cardView = CardView::create(updatedCard);
-        if (cardView) {
-            cardView->setPosition(stackPos);
-            this->addChild(cardView, 5);
-            _cardViews[topCard.getId()] = cardView;
-        }
+    // 从备用牌堆的位置飞到对齐后的位置；与回退匹配一样是移入主牌区，只是不派发事件
+    Vec2 target = cardView->getPosition();
+    cardView->setPosition(ViewReconciler::trayPosition(0));
+    cardView->setVisible(true);
+    startTween(cardView, AnimationKind::UNDO_MATCH, target, duration, false, TweenEasing::EASE_OUT);
+}
+
+void GameView::requestUndo()
+{
+    if (_eventBus) {
+        _eventBus->publish(UndoClickedEvent());
     }
 }
 
-void GameView::setupTrayCards(GameModel* model)
+void GameView::playRewind(int steps)
 {
-    // 备用牌堆位置（左侧）
-    Vec2 trayBasePos = Vec2(300, 290);
+    PresentationScripts::startRewind(_sequences, this, steps);
+    FrameRateManager::getInstance()->wake();
+}
 
-    auto& cards = model->getTrayCards();
+void GameView::showBanner(const std::string& text)
+{
+    if (!_bannerLabel) {
+        return;
+    }
+    _bannerLabel->setString(text);
+    _bannerLabel->setScale(1.0f);
+    _bannerLabel->setVisible(true);
+}
 
-    CCLOG("Tray cards count: %d", (int)cards.size());
+void GameView::setBannerScale(float scale)
+{
+    if (_bannerLabel) {
+        _bannerLabel->setScale(scale);
+    }
+}
 
-    // 显示所有备用牌堆的牌（左右错开，上下不错开）
-    for (size_t i = 0; i < cards.size(); i++) {
-        auto& card = cards[i];
+void GameView::hideBanner()
+{
+    if (_bannerLabel) {
+        _bannerLabel->setVisible(false);
+    }
+}
 
-        // 每张牌左右错开50像素，和主牌区一致
-        Vec2 cardPos = Vec2(trayBasePos.x + i * 50, trayBasePos.y);
+void GameView::checkCleared()
+{
+    // 回退后主牌区重新有牌时，下一次清空再庆祝
+    bool cleared = _model->getPlayfieldCards().empty();
+    if (cleared && !_clearCelebrated) {
+        PresentationScripts::startClear(_sequences, this);
+    }
+    _clearCelebrated = cleared;
+}
 
-        // 更新卡牌模型的位置
-        CardModel displayCard(card.getId(), card.getFace(), card.getSuit(), cardPos);
-        displayCard.setOriginalPosition(cardPos);
+void GameView::syncWithModel()
+{
+    _reconcileDirty = true;
+    FrameRateManager::getInstance()->wake();
+}
 
-        auto cardView = CardView::create(displayCard);
-        if (cardView) {
-            cardView->setPosition(cardPos);
-            // 所有备用牌都可以点击（点击后移动到底牌堆）
-            cardView->setClickCallback([this](int cardId) {
-                if (_trayClickCallback) {
-                    _trayClickCallback();
-                }
-                });
-            this->addChild(cardView, 5 + (int)i);
-            _cardViews[card.getId()] = cardView;
-        }
+void GameView::setLiveStackCardCount(int count)
+{
+    _liveStackCards = count > 1 ? count : 1;
+    syncWithModel();
+}
 
-        CCLOG("Added tray card %d at position (%f, %f)", card.getId(), cardPos.x, cardPos.y);
+void GameView::setMaxCreatesPerFrame(int count)
+{
+    _maxCreatesPerFrame = count > 0 ? count : -1;
+}
+
+void GameView::clearCards()
+{
+    for (auto& entry : _cardViews) {
+        entry.second->removeFromParent();
     }
+    _cardViews.clear();
+    _reconciler.reset();
+    invalidateStaticLayer();
 }
 
-void GameView::playMatchAnimation(int cardId, const Vec2& targetPos, const std::function<void()>& callback)
+void GameView::reconcileViews()
 {
-    auto it = _cardViews.find(cardId);
-    if (it != _cardViews.end()) {
-        CardView* cardView = it->second;
-        // 提升层级，确保移动的牌显示在最上面
-        cardView->setLocalZOrder(100);
-        it->second->playMoveAnimation(targetPos, 0.3f, [this, cardId, callback]() {
-            // 动画完成后，设置为底牌堆的层级
-            auto it = _cardViews.find(cardId);
-            if (it != _cardViews.end()) {
-                it->second->setLocalZOrder(50);
-            }
-            if (callback) {
-                callback();
-            }
-            });
+    _reconcileDirty = false;
+    if (!_model) {
+        return;
+    }
+
+    // 移动中的牌由动画持有，结束后再对齐
+    ViewReconciler::collectPlacements(*_model, _targetPlacements, _liveStackCards);
+    bool complete = _reconciler.reconcile(_targetPlacements, _tweens.getCardIds(), static_cast<int>(_tweens.size()),
+        _viewOps, _maxCreatesPerFrame);
+    if (!complete) {
+        // 大关卡的节点分几帧创建，剩下的留到下一帧
+        _reconcileDirty = true;
+        FrameRateManager::getInstance()->keepAwake();
+    }
+
+    for (const auto& op : _viewOps) {
+        applyViewOp(op);
+    }
+    _lastReconcileOpCount = _viewOps.size();
+    if (!_viewOps.empty()) {
+        invalidateStaticLayer();
     }
+    checkCleared();
 }
 
-void GameView::playFlipTrayAnimation(const CardModel& card, const Vec2& targetPos, const std::function<void()>& callback)
+void GameView::applyViewOp(const ViewOp& op)
 {
-    auto it = _cardViews.find(card.getId());
-    if (it != _cardViews.end()) {
-        CardView* cardView = it->second;
-        // 提升层级，确保移动的牌显示在最上面
-        cardView->setLocalZOrder(100);
-        cardView->playMoveAnimation(targetPos, 0.3f, [this, card, callback]() {
-            // 动画完成后，设置为底牌堆的层级
-            auto it = _cardViews.find(card.getId());
-            if (it != _cardViews.end()) {
-                it->second->setLocalZOrder(50);
-            }
-            if (callback) {
-                callback();
-            }
-            });
+    const CardPlacement& placement = op.placement;
+    switch (op.type) {
+    case ViewOp::DESTROY: {
+        auto it = _cardViews.find(placement.cardId);
+        if (it != _cardViews.end()) {
+            it->second->removeFromParent();
+            _cardViews.erase(it);
+        }
+        // 槽位仍属于这张牌时清除视图句柄（换关后槽位可能已属于别的牌）
+        if (placement.zone == CardZone::PLAYFIELD && placement.index < _model->getPlayfieldSlotCount()
+            && _model->getPlayfieldCard(placement.index).getId() == placement.cardId) {
+            _model->setPlayfieldViewHandle(placement.index, nullptr);
+        }
+        break;
+    }
+    case ViewOp::CREATE: {
+        CardModel cardModel(placement.cardId,
+            static_cast<CardFaceType>(MatchRules::faceOf(placement.cardCode)),
+            static_cast<CardSuitType>(MatchRules::suitOf(placement.cardCode)),
+            placement.position);
+        auto cardView = createCardView(cardModel);
+        if (cardView) {
+            cardView->setPosition(placement.position);
+            cardView->setVisible(!isUndealt(placement.cardId));
+            this->addChild(cardView, placement.zOrder);
+            _cardViews[placement.cardId] = cardView;
+            bindCardView(cardView, placement);
+        }
+        break;
+    }
+    case ViewOp::UPDATE: {
+        auto cardView = getCardView(placement.cardId);
+        if (!cardView) {
+            break;
+        }
+        if (op.changes & ViewOp::CHANGE_POSITION) {
+            cardView->setPosition(placement.position);
+        }
+        if (op.changes & ViewOp::CHANGE_Z_ORDER) {
+            cardView->setLocalZOrder(placement.zOrder);
+        }
+        if (op.changes & ViewOp::CHANGE_ZONE) {
+            bindCardView(cardView, placement);
+        }
+        break;
+    }
     }
 }
 
-void GameView::playUndoAnimation(int cardId, const Vec2& targetPos, const std::function<void()>& callback)
+void GameView::bindCardView(CardView* cardView, const CardPlacement& placement)
+{
+    switch (placement.zone) {
+    case CardZone::PLAYFIELD:
+        cardView->setClickCallback(Delegate<void(int)>::bind<GameView, &GameView::onPlayfieldCardClicked>(this));
+        _model->setPlayfieldViewHandle(placement.index, cardView);
+        break;
+    case CardZone::TRAY:
+        // 所有备用牌都可以点击（点击后移动到底牌堆）
+        cardView->setClickCallback(Delegate<void(int)>::bind<GameView, &GameView::onTrayCardClicked>(this));
+        break;
+    default:
+        // 底牌堆的牌不响应点击
+        cardView->setClickCallback(Delegate<void(int)>());
+        break;
+    }
+}
+
+void GameView::playMatchAnimation(int cardId, const Vec2& targetPos)
+{
+    startMove(cardId, AnimationKind::MATCH, targetPos);
+}
+
+void GameView::playFlipTrayAnimation(const CardModel& card, const Vec2& targetPos)
+{
+    startMove(card.getId(), AnimationKind::FLIP_TRAY, targetPos);
+}
+
+void GameView::playUndoAnimation(int cardId, const Vec2& targetPos, AnimationKind kind)
 {
     CCLOG("playUndoAnimation: cardId=%d, targetPos=(%f, %f)", cardId, targetPos.x, targetPos.y);
 
-    auto it = _cardViews.find(cardId);
-    if (it != _cardViews.end()) {
-        CardView* cardView = it->second;
-        // 移动到原始位置，动画完成后调用回调
-        cardView->playMoveAnimation(targetPos, 0.3f, callback);
+    // 备用牌回到视图中备用牌堆的下一格（模型中备用牌的位置与视图布局不同）
+    if (kind == AnimationKind::UNDO_FLIP && _model) {
+        startMove(cardId, kind, ViewReconciler::trayPosition(static_cast<int>(_model->getTrayCards().size())));
+        return;
     }
-    else {
+    startMove(cardId, kind, targetPos);
+}
+
+void GameView::startMove(int cardId, AnimationKind kind, const Vec2& targetPos)
+{
+    auto it = _cardViews.find(cardId);
+    if (it == _cardViews.end()) {
         CCLOG("Card view not found for id: %d", cardId);
-        // 如果找不到视图，直接调用回调
-        if (callback) {
-            callback();
+        // 找不到视图时直接通知动画结束
+        if (_eventBus) {
+            _eventBus->publish(AnimationDoneEvent(cardId, kind, targetPos));
         }
+        return;
+    }
+
+    // 还没发出的牌被操作时直接显示
+    if (isUndealt(cardId)) {
+        _undealt[cardId] = 0;
+        it->second->setVisible(true);
     }
+    startTween(it->second, kind, targetPos, MOVE_DURATION, true, TweenEasing::LINEAR);
 }
 
-void GameView::removeCardView(int cardId)
+void GameView::startTween(CardView* cardView, AnimationKind kind, const Vec2& targetPos, float duration, bool notify,
+    TweenEasing easing)
 {
-    auto it = _cardViews.find(cardId);
-    if (it != _cardViews.end()) {
-        it->second->removeFromParent();
-        _cardViews.erase(it);
+    int cardId = cardView->getCardId();
+
+    // 同一张牌的旧动画立即结束
+    int previous = _tweens.find(cardId);
+    if (previous >= 0) {
+        completeTween(_tweens.finish(previous));
+    }
+
+    cardView->setLocalZOrder(ViewReconciler::MOVING_Z);
+    _reconciler.invalidate(cardId);
+    // 移动中的牌直接绘制，静态层里去掉它
+    if (_staticCacheEnabled) {
+        cardView->setVisible(true);
     }
+    invalidateStaticLayer();
+
+    Vec2 from = cardView->getPosition();
+    _tweens.start(cardId, cardView, makeTweenTag(kind, notify), from.x, from.y, targetPos.x, targetPos.y, duration, easing);
+
+    // 空闲降帧时立即恢复满帧率
+    FrameRateManager::getInstance()->wake();
 }
 
-void GameView::addCardView(const CardModel& model)
+void GameView::completeTween(const TweenCompletion& completion)
 {
-    auto cardView = CardView::create(model);
-    if (cardView) {
-        cardView->setClickCallback([this](int cardId) {
-            if (_cardClickCallback) {
-                _cardClickCallback(cardId);
-            }
-        });
-        this->addChild(cardView, 10);
-        _cardViews[model.getId()] = cardView;
+    Vec2 target(completion.x, completion.y);
+    static_cast<CardView*>(completion.handle)->setPosition(target);
+    // 落定后并入静态层（底牌堆顶或回到原位）；层级和点击回调在控制器更新模型后的对齐中设置
+    invalidateStaticLayer();
+    _reconcileDirty = true;
+    if ((completion.tag & NOTIFY_BIT) && _eventBus) {
+        AnimationKind kind = static_cast<AnimationKind>(completion.tag & 0xFF);
+        _eventBus->publish(AnimationDoneEvent(completion.cardId, kind, target));
+    }
+}
+
+void GameView::update(float dt)
+{
+    if (!_tweens.empty()) {
+        FrameRateManager::getInstance()->keepAwake();
+
+        // 一次推进所有补间，再把位置写回节点；结束的补间在全部推进后成批处理
+        _tweens.step(dt, _completedTweens);
+        for (size_t i = 0; i < _tweens.size(); i++) {
+            static_cast<CardView*>(_tweens.getHandle(i))->setPosition(Vec2(_tweens.getX(i), _tweens.getY(i)));
+        }
+        // 派发事件时控制器可能开始新的动画，不影响已取出的列表
+        for (size_t i = 0; i < _completedTweens.size(); i++) {
+            completeTween(_completedTweens[i]);
+        }
+        _completedTweens.clear();
+    }
+
+    // 脚本在动画推进之后执行，本帧结束的动画对脚本可见
+    if (!_sequences.isIdle()) {
+        _sequences.update(dt);
+        FrameRateManager::getInstance()->keepAwake();
+    }
+}
+
+void GameView::onPlayfieldCardClicked(int cardId)
+{
+    if (isUndealt(cardId)) {
+        return;
+    }
+    if (_eventBus) {
+        _eventBus->publish(CardClickedEvent(cardId));
+    }
+}
+
+void GameView::onTrayCardClicked(int cardId)
+{
+    // 所有备用牌都可以点击（点击后移动到底牌堆）
+    if (_eventBus) {
+        _eventBus->publish(TrayClickedEvent());
     }
 }
 
@@ -251,15 +578,93 @@ CardView* GameView::getCardView(int cardId)
     return nullptr;
 }
 
-void GameView::updateStackDisplay(const CardModel& topCard)
+bool GameView::isMoving(int cardId) const
 {
-    // 更新底牌堆顶部显示
-    auto it = _cardViews.find(topCard.getId());
-    if (it == _cardViews.end()) {
-        auto cardView = CardView::create(topCard);
-        if (cardView) {
-            this->addChild(cardView, 5);
-            _cardViews[topCard.getId()] = cardView;
+    return _tweens.find(cardId) >= 0;
+}
+
+void GameView::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags)
+{
+    // 本帧积累的模型变化一次对齐
+    if (_reconcileDirty) {
+        reconcileViews();
+    }
+    if (_cardBatch) {
+        // 有牌在移动时每帧更新顶点，否则只在卡牌变化后更新一次
+        if (_staticDirty || !_tweens.empty()) {
+            rebuildCardBatch();
+        }
+    }
+    else if (_staticCacheEnabled && _staticDirty && _visible) {
+        bakeStaticLayer(renderer, parentTransform);
+    }
+    Layer::visit(renderer, parentTransform, parentFlags);
+}
+
+void GameView::bakeStaticLayer(Renderer* renderer, const Mat4& parentTransform)
+{
+    _staticDirty = false;
+    _staticBakeCount++;
+
+    // 子节点按层级排序后依次画入纹理，与直接绘制时的遮挡顺序一致
+    sortAllChildren();
+    Mat4 transform = parentTransform * getNodeToParentTransform();
+
+    _staticCache->beginWithClear(0.0f, 0.0f, 0.0f, 1.0f);
+    for (auto child : _children) {
+        bool isBackground = (child == _backgrounds[0] || child == _backgrounds[1]);
+        auto cardView = dynamic_cast<CardView*>(child);
+        if (!isBackground && (!cardView || isMoving(cardView->getCardId()) || isUndealt(cardView->getCardId()))) {
+            continue;
+        }
+        // 渲染命令在 visit 时已记录变换和顶点，画完即可隐藏
+        child->setVisible(true);
+        child->visit(renderer, transform, FLAGS_TRANSFORM_DIRTY);
+        child->setVisible(false);
+    }
+    _staticCache->end();
+}
+
+void GameView::rebuildCardBatch()
+{
+    _staticDirty = false;
+
+    // 按层级顺序添加，与逐张绘制时的遮挡顺序一致
+    sortAllChildren();
+    _cardBatch->clearCards();
+    for (auto child : _children) {
+        auto cardView = dynamic_cast<CardView*>(child);
+        if (cardView && !isUndealt(cardView->getCardId())) {
+            const CardModel& model = cardView->getCardModel();
+            _cardBatch->addCard(cardView->getPosition(), static_cast<float>(cardView->getLocalZOrder()),
+                static_cast<int>(model.getFace()), static_cast<int>(model.getSuit()));
+        }
+    }
+    _cardBatch->commitCards();
+}
+
+void GameView::showStaticNodes()
+{
+    for (auto child : _children) {
+        auto cardView = dynamic_cast<CardView*>(child);
+        if (child != _staticCache && child != _positionLabel && child != _bannerLabel
+            && !(cardView && isUndealt(cardView->getCardId()))) {
+            child->setVisible(true);
         }
     }
-}
\ No newline at end of file
+}
+
+void GameView::setStaticCacheEnabled(bool enabled)
+{
+    if (!_staticCache || _cardBatch || enabled == _staticCacheEnabled) {
+        return;
+    }
+    _staticCacheEnabled = enabled;
+    _staticCache->setVisible(enabled);
+    if (enabled) {
+        invalidateStaticLayer();
+    }
+    else {
+        showStaticNodes();
+    }
+}
@@ -3,67 +3,193 @@
 
 #include "cocos2d.h"
 #include "CardView.h"
-#include "models/GameModel.h"
-#include <functional>
+#include "IGameView.h"
+#include "CardBatchNode.h"
+#include "ViewReconciler.h"
+#include "TweenEngine.h"
+#include "PresentationScripts.h"
+#include "utils/SequenceScheduler.h"
 #include <map>
+#include <vector>
 
 /**
  * 游戏主视图类
  * 负责整个游戏界面的显示
+ * 点击和动画结束通过 GameEventBus 通知控制器；移动动画由 TweenEngine 在 update 中统一推进，不创建 cocos Action，
+ * 一帧内结束的动画在推进完成后按开始顺序成批派发 AnimationDoneEvent
+ *
+ * 静态层缓存：背景和所有不在移动中的卡牌烘焙到一张 RenderTexture，每帧只画这一张纹理、移动中的牌和按钮。
+ * 卡牌开始或结束移动（露出的牌、底牌堆顶发生变化）以及增删卡牌时标记失效，下一次 visit 前重新烘焙。
+ * 烘焙后的卡牌节点设为不可见但仍留在场景中，触摸监听和层级顺序不变。
+ *
+ * 批量绘制：CardAtlas 和卡牌着色器可用时，卡牌视图只作为不绘制的代理（位置、层级、点击），
+ * 所有卡牌由 CardBatchNode 一次绘制；此时不使用静态层，卡牌变化或移动时重建顶点流。
+ *
+ * 视图对齐：卡牌视图由 ViewReconciler 按模型增量对齐，加载关卡、动画结束和 syncWithModel 后
+ * 在下一次绘制前统一执行一次，只创建、移动、调整层级或销毁有变化的牌。
+ * 底牌堆只有最上面几张有视图节点，其余的只保留在模型中，回退露出时由对齐重新创建。
+ *
+ * 表现脚本：发牌、通关庆祝和连续回退由 PresentationScripts 的协程脚本编排，在 update 中由 _sequences 驱动。
+ * 发牌前主牌区的牌处于「待发」状态：视图照常创建但不显示、不绘制、不响应点击。
  */
-class GameView : public cocos2d::Layer {
+class GameView : public cocos2d::Layer, public IGameView, public PresentationHost {
 public:
     static GameView* create();
     
     virtual bool init() override;
     
-    // 初始化游戏视图
-    void initWithModel(GameModel* model);
+    // 初始化游戏视图（可重复调用）：丢弃进行中的动画和脚本，按模型对齐卡牌视图，ID 和牌面相同的视图直接复用，然后播放发牌
+    virtual void initWithModel(GameModel* model) override;
     
-    // 设置卡牌点击回调
-    void setCardClickCallback(const std::function<void(int)>& callback) { _cardClickCallback = callback; }
+    // 模型被直接修改后（撤销到开局、加载快照），在下一次绘制前对齐
+    virtual void syncWithModel() override;
     
-    // 设置备用牌点击回调
-    void setTrayClickCallback(const std::function<void()>& callback) { _trayClickCallback = callback; }
-    
-    // 设置回退按钮点击回调
-    void setUndoClickCallback(const std::function<void()>& callback) { _undoClickCallback = callback; }
+    // 设置事件总线（点击事件发往总线，动画结束时派发 AnimationDoneEvent；订阅局面分析结论）
+    virtual void setEventBus(GameEventBus* eventBus) override;
     
     // 播放卡牌匹配动画
-    void playMatchAnimation(int cardId, const cocos2d::Vec2& targetPos, const std::function<void()>& callback = nullptr);
+    virtual void playMatchAnimation(int cardId, const cocos2d::Vec2& targetPos) override;
     
     // 播放翻牌动画
-    void playFlipTrayAnimation(const CardModel& card, const cocos2d::Vec2& targetPos, const std::function<void()>& callback = nullptr);
+    virtual void playFlipTrayAnimation(const CardModel& card, const cocos2d::Vec2& targetPos) override;
+    
+    // 播放回退动画（kind 为 UNDO_MATCH 或 UNDO_FLIP）
+    virtual void playUndoAnimation(int cardId, const cocos2d::Vec2& targetPos, AnimationKind kind) override;
     
-    // 播放回退动画
-    void playUndoAnimation(int cardId, const cocos2d::Vec2& targetPos, const std::function<void()>& callback = nullptr);
+    // 推进移动动画和表现脚本
+    virtual void update(float dt) override;
     
-    // 移除卡牌视图
-    void removeCardView(int cardId);
+    // 静态层失效时先重新烘焙，再正常绘制
+    virtual void visit(cocos2d::Renderer* renderer, const cocos2d::Mat4& parentTransform, uint32_t parentFlags) override;
     
-    // 添加卡牌视图
-    void addCardView(const CardModel& model);
+    // 开关静态层缓存（关闭时所有卡牌每帧直接绘制，用于对比；批量绘制时无效）
+    void setStaticCacheEnabled(bool enabled);
+    
+    // 静态层烘焙次数（统计用）
+    uint32_t getStaticBakeCount() const { return _staticBakeCount; }
     
     // 获取卡牌视图
     CardView* getCardView(int cardId);
     
-    // 更新底牌堆显示
-    void updateStackDisplay(const CardModel& topCard);
+    // 最近一次对齐执行的视图操作数（统计用）
+    size_t getLastReconcileOpCount() const { return _lastReconcileOpCount; }
+    
+    // 底牌堆保留视图的张数（至少 1，默认 ViewReconciler::DEFAULT_LIVE_STACK_CARDS）
+    void setLiveStackCardCount(int count);
+    
+    // 当前卡牌视图节点数（统计用）
+    size_t getCardViewCount() const { return _cardViews.size(); }
+    
+    // 每帧最多创建的卡牌视图数，超出的留到后面几帧（0 或负数不限）
+    static const int DEFAULT_MAX_CREATES_PER_FRAME = 64;
+    void setMaxCreatesPerFrame(int count);
+    
+    // 连续回退 steps 步（逐步播放动画）
+    void playRewind(int steps);
+    
+    // 表现脚本调度器（可调整每帧工作预算）
+    SequenceScheduler& getSequenceScheduler() { return _sequences; }
+    
+    // PresentationHost
+    virtual int getDealCardCount() const override { return static_cast<int>(_dealOrder.size()); }
+    virtual int getDealCardId(int index) const override { return _dealOrder[index]; }
+    virtual bool isUndealt(int cardId) const override;
+    virtual bool hasCardView(int cardId) const override { return _cardViews.count(cardId) != 0; }
+    virtual void dealCard(int cardId, float duration) override;
+    virtual bool isAnimating() const override { return !_tweens.empty(); }
+    virtual void requestUndo() override;
+    virtual void showBanner(const std::string& text) override;
+    virtual void setBannerScale(float scale) override;
+    virtual void hideBanner() override;
 
 private:
+    static const float MOVE_DURATION;
+    
+    // 开始移动动画；同一张牌已有动画时先让旧动画立即结束
+    // 移动中的牌在最上层，结束后由下一次对齐放到所在区域的层级
+    // notify 为 false 时结束不派发 AnimationDoneEvent（表现脚本的移动）
+    void startMove(int cardId, AnimationKind kind, const cocos2d::Vec2& targetPos);
+    void startTween(CardView* cardView, AnimationKind kind, const cocos2d::Vec2& targetPos, float duration, bool notify,
+        TweenEasing easing);
+    
+    // 动画结束：落到终点，需要时派发 AnimationDoneEvent
+    void completeTween(const TweenCompletion& completion);
+    
+    // 待发的牌全部直接显示（换关、取消发牌时）
+    void revealUndealt();
+    
+    // 主牌区清空时播放一次通关庆祝
+    void checkCleared();
+    
+    // 局面分析结论：无法通关时提示
+    void onPositionAnalyzed(const PositionAnalyzedEvent& event);
+    
+    // 卡牌点击（绑定到 CardView 的 Delegate）
+    void onPlayfieldCardClicked(int cardId);
+    void onTrayCardClicked(int cardId);
+    
+    // 当前是否在移动中
+    bool isMoving(int cardId) const;
+    
+    // 标记静态层需要重新烘焙（批量绘制时为重建顶点流）
+    void invalidateStaticLayer() { _staticDirty = true; }
+    
+    // 按当前卡牌视图重建批量顶点流
+    void rebuildCardBatch();
+    
+    // 按模型对齐卡牌视图（跳过移动中的牌）
+    void reconcileViews();
+    void applyViewOp(const ViewOp& op);
+    
+    // 按区域设置点击回调和模型中的视图句柄
+    void bindCardView(CardView* cardView, const CardPlacement& placement);
+    
+    // 批量绘制时创建代理视图，否则创建完整的精灵视图
+    CardView* createCardView(const CardModel& model);
+    
+    // 把背景和静止的卡牌画进 _staticCache，并隐藏这些节点
+    void bakeStaticLayer(cocos2d::Renderer* renderer, const cocos2d::Mat4& parentTransform);
+    
+    // 恢复所有被烘焙隐藏的节点
+    void showStaticNodes();
+    
+    void clearCards();
+    void setupStaticCache();
+    void setupCardBatch();
     void setupBackground();
     void setupUI();
-    void setupPlayfieldCards(GameModel* model);
-    void setupStackCards(GameModel* model);
-    void setupTrayCards(GameModel* model);
     
     std::map<int, CardView*> _cardViews;  // 卡牌ID到视图的映射
     cocos2d::Sprite* _traySprite;          // 备用牌堆精灵
     cocos2d::Sprite* _stackSprite;         // 底牌堆精灵
+    cocos2d::Node* _backgrounds[2];        // 主牌区和手牌区背景
+    
+    cocos2d::RenderTexture* _staticCache;  // 静态层（背景 + 静止的卡牌）
+    bool _staticCacheEnabled;
+    bool _staticDirty;
+    uint32_t _staticBakeCount;
+    CardBatchNode* _cardBatch;             // 批量绘制卡牌，不可用时为空
+    
+    GameModel* _model;
+    ViewReconciler _reconciler;
+    std::vector<CardPlacement> _targetPlacements;
+    std::vector<ViewOp> _viewOps;
+    bool _reconcileDirty;
+    size_t _lastReconcileOpCount;
+    int _liveStackCards;
+    int _maxCreatesPerFrame;
+    
+    GameEventBus* _eventBus;
+    EventHandle _positionSubscription;
+    cocos2d::Label* _positionLabel;        // 无法通关提示
+    cocos2d::Label* _bannerLabel;          // 表现脚本的横幅
+    TweenEngine _tweens;
+    std::vector<TweenCompletion> _completedTweens;
     
-    std::function<void(int)> _cardClickCallback;
-    std::function<void()> _trayClickCallback;
-    std::function<void()> _undoClickCallback;
+    SequenceScheduler _sequences;
+    std::vector<int> _dealOrder;           // 本局发牌顺序
+    std::vector<char> _undealt;            // 按卡牌ID：是否还在等待发牌
+    bool _clearCelebrated;
 };
 
 #endif // __GAME_VIEW_H__
\ No newline at end of file
@@ -0,0 +1,38 @@
+#ifndef __I_GAME_VIEW_H__
+#define __I_GAME_VIEW_H__
+
+#include "cocos2d.h"
+#include "models/GameModel.h"
+#include "models/GameEvents.h"
+
+/**
+ * 游戏视图接口
+ * GameController 只通过该接口驱动视图，可替换为 GameView（cocos 场景）、NullGameView 或 RecordingGameView。
+ *
+ * 约定：每个 play*Animation 调用最终都必须在事件总线上派发一次对应的 AnimationDoneEvent，
+ * 控制器在收到后才把操作写入数据模型。允许在 play*Animation 内同步派发。
+ */
+class IGameView {
+public:
+    virtual ~IGameView() {}
+
+    // 设置事件总线（点击事件发往总线，动画结束时派发 AnimationDoneEvent）
+    virtual void setEventBus(GameEventBus* eventBus) = 0;
+
+    // 按模型重建视图（加载关卡时调用，可重复调用）
+    virtual void initWithModel(GameModel* model) = 0;
+
+    // 模型在动画之外被修改（撤销到开局、加载快照）后，让视图与模型对齐，不播放动画、不派发事件
+    virtual void syncWithModel() = 0;
+
+    // 主牌区的牌移到底牌堆
+    virtual void playMatchAnimation(int cardId, const cocos2d::Vec2& targetPos) = 0;
+
+    // 备用牌移到底牌堆
+    virtual void playFlipTrayAnimation(const CardModel& card, const cocos2d::Vec2& targetPos) = 0;
+
+    // 底牌堆的牌回到原位置（kind 为 UNDO_MATCH 或 UNDO_FLIP）
+    virtual void playUndoAnimation(int cardId, const cocos2d::Vec2& targetPos, AnimationKind kind) = 0;
+};
+
+#endif // __I_GAME_VIEW_H__
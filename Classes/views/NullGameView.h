@@ -0,0 +1,44 @@
+#ifndef __NULL_GAME_VIEW_H__
+#define __NULL_GAME_VIEW_H__
+
+#include "IGameView.h"
+
+/**
+ * 空视图
+ * 不创建任何节点，动画请求立即同步完成，控制器以纯 CPU 速度运行（服务端模拟、基准测试）
+ */
+class NullGameView : public IGameView {
+public:
+    NullGameView() : _eventBus(nullptr) {}
+
+    virtual void setEventBus(GameEventBus* eventBus) override { _eventBus = eventBus; }
+    virtual void initWithModel(GameModel*) override {}
+    virtual void syncWithModel() override {}
+
+    virtual void playMatchAnimation(int cardId, const cocos2d::Vec2& targetPos) override
+    {
+        complete(cardId, AnimationKind::MATCH, targetPos);
+    }
+
+    virtual void playFlipTrayAnimation(const CardModel& card, const cocos2d::Vec2& targetPos) override
+    {
+        complete(card.getId(), AnimationKind::FLIP_TRAY, targetPos);
+    }
+
+    virtual void playUndoAnimation(int cardId, const cocos2d::Vec2& targetPos, AnimationKind kind) override
+    {
+        complete(cardId, kind, targetPos);
+    }
+
+private:
+    void complete(int cardId, AnimationKind kind, const cocos2d::Vec2& targetPos)
+    {
+        if (_eventBus) {
+            _eventBus->publish(AnimationDoneEvent(cardId, kind, targetPos));
+        }
+    }
+
+    GameEventBus* _eventBus;
+};
+
+#endif // __NULL_GAME_VIEW_H__
@@ -0,0 +1,88 @@
+#include "PresentationScripts.h"
+#include "utils/Sequence.h"
+
+// 本文件以 C++20 编译（协程）
+
+namespace {
+
+const float DEAL_DURATION = 0.25f;
+const float DEAL_INTERVAL = 0.03f;
+
+Sequence waitForAnimations(PresentationHost* host)
+{
+    co_await waitUntil([host] { return !host->isAnimating(); });
+}
+
+Sequence dealCards(PresentationHost* host)
+{
+    // 发牌顺序只在换关时改变，换关会先取消所有脚本
+    for (int i = 0; i < host->getDealCardCount(); i++) {
+        int cardId = host->getDealCardId(i);
+        // 大关卡的视图分几帧创建；已被其他操作显示出来的牌跳过
+        co_await waitUntil([host, cardId] { return host->hasCardView(cardId) || !host->isUndealt(cardId); });
+        if (!host->isUndealt(cardId)) {
+            continue;
+        }
+        co_await Work(1);
+        host->dealCard(cardId, DEAL_DURATION);
+        co_await Delay(DEAL_INTERVAL);
+    }
+}
+
+Sequence pulseBanner(PresentationHost* host, float from, float to, float duration)
+{
+    float elapsed = 0.0f;
+    while (elapsed < duration) {
+        host->setBannerScale(from + (to - from) * (elapsed / duration));
+        co_await Delay(1.0f / 60.0f);
+        elapsed += 1.0f / 60.0f;
+    }
+    host->setBannerScale(to);
+}
+
+Sequence celebrateClear(PresentationHost* host)
+{
+    // 最后一张牌落定后再显示
+    co_await waitForAnimations(host);
+    host->showBanner("通关！");
+    for (int i = 0; i < 2; i++) {
+        co_await pulseBanner(host, 0.6f, 1.2f, 0.2f);
+        co_await pulseBanner(host, 1.2f, 1.0f, 0.15f);
+    }
+    co_await Delay(1.5f);
+    host->hideBanner();
+}
+
+Sequence rewind(PresentationHost* host, int steps)
+{
+    for (int i = 0; i < steps; i++) {
+        co_await waitForAnimations(host);
+        host->requestUndo();
+        // 没有开始新的动画说明已经回退到开局
+        if (!host->isAnimating()) {
+            break;
+        }
+    }
+    co_await waitForAnimations(host);
+}
+
+} // namespace
+
+namespace PresentationScripts {
+
+void startDeal(SequenceScheduler& scheduler, PresentationHost* host)
+{
+    startSequence(scheduler, dealCards(host));
+}
+
+void startClear(SequenceScheduler& scheduler, PresentationHost* host)
+{
+    startSequence(scheduler, celebrateClear(host));
+}
+
+void startRewind(SequenceScheduler& scheduler, PresentationHost* host, int steps)
+{
+    startSequence(scheduler, rewind(host, steps));
+}
+
+} // namespace PresentationScripts
@@ -0,0 +1,57 @@
+#ifndef __PRESENTATION_SCRIPTS_H__
+#define __PRESENTATION_SCRIPTS_H__
+
+#include "cocos2d.h"
+#include "utils/SequenceScheduler.h"
+#include <string>
+
+/**
+ * 表现脚本操作的视图（GameView 实现）
+ * 脚本只通过这些操作读写视图，不直接持有卡牌节点，节点被对齐销毁后脚本也不会访问到悬空指针。
+ */
+class PresentationHost {
+public:
+    virtual ~PresentationHost() {}
+
+    // 本局发牌的顺序（已经发出的牌仍在列表中，用 isUndealt 区分）
+    virtual int getDealCardCount() const = 0;
+    virtual int getDealCardId(int index) const = 0;
+
+    // 卡牌是否还等待发牌 / 视图是否已创建
+    virtual bool isUndealt(int cardId) const = 0;
+    virtual bool hasCardView(int cardId) const = 0;
+
+    // 把牌从发牌位置移到它在牌桌上的位置并显示出来（不派发 AnimationDoneEvent）
+    virtual void dealCard(int cardId, float duration) = 0;
+
+    // 还有移动动画在播放
+    virtual bool isAnimating() const = 0;
+
+    // 请求回退一步（与点击回退按钮相同）
+    virtual void requestUndo() = 0;
+
+    // 屏幕中央的横幅
+    virtual void showBanner(const std::string& text) = 0;
+    virtual void setBannerScale(float scale) = 0;
+    virtual void hideBanner() = 0;
+};
+
+/**
+ * 表现脚本
+ * 发牌、通关庆祝和连续回退写成协程脚本（views/PresentationScripts.cpp，以 C++20 编译），
+ * 这里只提供启动函数，调用者不需要包含协程头文件。
+ */
+namespace PresentationScripts {
+
+// 依次发出所有尚未发出的牌；视图还没创建的牌等待分帧创建完成，每发一张占用 1 个单位的工作预算
+void startDeal(SequenceScheduler& scheduler, PresentationHost* host);
+
+// 通关横幅
+void startClear(SequenceScheduler& scheduler, PresentationHost* host);
+
+// 连续回退 steps 步，每步等上一步动画结束；无法再回退时提前结束
+void startRewind(SequenceScheduler& scheduler, PresentationHost* host, int steps);
+
+} // namespace PresentationScripts
+
+#endif // __PRESENTATION_SCRIPTS_H__
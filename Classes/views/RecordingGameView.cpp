@@ -0,0 +1,76 @@
+#include "RecordingGameView.h"
+
+USING_NS_CC;
+
+RecordingGameView::RecordingGameView()
+    : _eventBus(nullptr)
+    , _autoComplete(true)
+    , _pendingHead(0)
+{
+}
+
+void RecordingGameView::initWithModel(GameModel*)
+{
+    // 新关卡：上一局未完成的动画直接丢弃
+    _pending.clear();
+    _pendingHead = 0;
+    _calls.push_back(Call(Call::INIT, -1, AnimationKind::MATCH, Vec2::ZERO));
+}
+
+void RecordingGameView::syncWithModel()
+{
+    _calls.push_back(Call(Call::SYNC, -1, AnimationKind::MATCH, Vec2::ZERO));
+}
+
+void RecordingGameView::playMatchAnimation(int cardId, const Vec2& targetPos)
+{
+    onAnimation(cardId, AnimationKind::MATCH, targetPos);
+}
+
+void RecordingGameView::playFlipTrayAnimation(const CardModel& card, const Vec2& targetPos)
+{
+    onAnimation(card.getId(), AnimationKind::FLIP_TRAY, targetPos);
+}
+
+void RecordingGameView::playUndoAnimation(int cardId, const Vec2& targetPos, AnimationKind kind)
+{
+    onAnimation(cardId, kind, targetPos);
+}
+
+void RecordingGameView::onAnimation(int cardId, AnimationKind kind, const Vec2& targetPos)
+{
+    Call call(Call::ANIMATION, cardId, kind, targetPos);
+    _calls.push_back(call);
+
+    if (_autoComplete) {
+        if (_eventBus) {
+            _eventBus->publish(AnimationDoneEvent(cardId, kind, targetPos));
+        }
+        return;
+    }
+    _pending.push_back(call);
+}
+
+bool RecordingGameView::completeNext()
+{
+    if (_pendingHead >= _pending.size()) {
+        return false;
+    }
+
+    // 先出队再派发：处理函数里可能再次请求动画
+    Call call = _pending[_pendingHead++];
+    if (_pendingHead == _pending.size()) {
+        _pending.clear();
+        _pendingHead = 0;
+    }
+    if (_eventBus) {
+        _eventBus->publish(AnimationDoneEvent(call.cardId, call.kind, call.targetPos));
+    }
+    return true;
+}
+
+void RecordingGameView::completeAll()
+{
+    while (completeNext()) {
+    }
+}
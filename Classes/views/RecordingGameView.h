@@ -0,0 +1,65 @@
+#ifndef __RECORDING_GAME_VIEW_H__
+#define __RECORDING_GAME_VIEW_H__
+
+#include "IGameView.h"
+#include <vector>
+
+/**
+ * 记录视图
+ * 不创建任何节点，只记录控制器发出的每个视图请求，用于测试和回放比对。
+ * 默认动画立即完成；关闭自动完成后请求进入待完成队列，由调用方用 completeNext / completeAll 推进，
+ * 可以检查动画进行中（模型尚未更新）的中间状态。
+ */
+class RecordingGameView : public IGameView {
+public:
+    /**
+     * 一次视图请求
+     */
+    struct Call {
+        enum Type {
+            INIT = 0,        // initWithModel
+            ANIMATION,       // play*Animation
+            SYNC             // syncWithModel
+        };
+
+        Type type;
+        int cardId;
+        AnimationKind kind;
+        cocos2d::Vec2 targetPos;
+
+        Call(Type t, int id, AnimationKind k, const cocos2d::Vec2& pos) : type(t), cardId(id), kind(k), targetPos(pos) {}
+    };
+
+    RecordingGameView();
+
+    virtual void setEventBus(GameEventBus* eventBus) override { _eventBus = eventBus; }
+    virtual void initWithModel(GameModel* model) override;
+    virtual void syncWithModel() override;
+    virtual void playMatchAnimation(int cardId, const cocos2d::Vec2& targetPos) override;
+    virtual void playFlipTrayAnimation(const CardModel& card, const cocos2d::Vec2& targetPos) override;
+    virtual void playUndoAnimation(int cardId, const cocos2d::Vec2& targetPos, AnimationKind kind) override;
+
+    // 是否在请求时立即完成动画（默认 true）
+    void setAutoComplete(bool autoComplete) { _autoComplete = autoComplete; }
+
+    // 完成最早的一个待完成动画，没有时返回 false
+    bool completeNext();
+
+    // 按顺序完成所有待完成动画
+    void completeAll();
+
+    size_t getPendingCount() const { return _pending.size() - _pendingHead; }
+    const std::vector<Call>& getCalls() const { return _calls; }
+    void clearCalls() { _calls.clear(); }
+
+private:
+    void onAnimation(int cardId, AnimationKind kind, const cocos2d::Vec2& targetPos);
+
+    GameEventBus* _eventBus;
+    bool _autoComplete;
+    std::vector<Call> _calls;
+    std::vector<Call> _pending;
+    size_t _pendingHead;
+};
+
+#endif // __RECORDING_GAME_VIEW_H__
@@ -0,0 +1,202 @@
+#include "TweenEngine.h"
+
+namespace {
+
+const size_t DEFAULT_CAPACITY = 64;
+
+void easingCoefficients(TweenEasing easing, float& a, float& b)
+{
+    switch (easing) {
+    case TweenEasing::EASE_IN:
+        a = 0.0f;
+        b = 1.0f;
+        break;
+    case TweenEasing::EASE_OUT:
+        a = 2.0f;
+        b = -1.0f;
+        break;
+    default:
+        a = 1.0f;
+        b = 0.0f;
+        break;
+    }
+}
+
+// 各数组互不重叠（__restrict），编译器不需要插入别名检查即可向量化
+void advanceTweens(size_t count, float dt, float* __restrict elapsed, const float* __restrict invDuration,
+    const float* __restrict easeA, const float* __restrict easeB,
+    const float* __restrict fromX, const float* __restrict fromY,
+    const float* __restrict deltaX, const float* __restrict deltaY,
+    float* __restrict x, float* __restrict y)
+{
+    for (size_t i = 0; i < count; i++) {
+        float e = elapsed[i] + dt;
+        elapsed[i] = e;
+        float t = e * invDuration[i];
+        t = t < 1.0f ? t : 1.0f;
+        float eased = t * (easeA[i] + easeB[i] * t);
+        x[i] = fromX[i] + deltaX[i] * eased;
+        y[i] = fromY[i] + deltaY[i] * eased;
+    }
+}
+
+} // namespace
+
+TweenEngine::TweenEngine()
+{
+    reserve(DEFAULT_CAPACITY);
+}
+
+void TweenEngine::reserve(size_t count)
+{
+    _fromX.reserve(count);
+    _fromY.reserve(count);
+    _deltaX.reserve(count);
+    _deltaY.reserve(count);
+    _elapsed.reserve(count);
+    _invDuration.reserve(count);
+    _easeA.reserve(count);
+    _easeB.reserve(count);
+    _x.reserve(count);
+    _y.reserve(count);
+    _cardIds.reserve(count);
+    _tags.reserve(count);
+    _handles.reserve(count);
+}
+
+void TweenEngine::start(int cardId, void* handle, uint32_t tag, float fromX, float fromY, float toX, float toY,
+    float duration, TweenEasing easing)
+{
+    float a = 1.0f;
+    float b = 0.0f;
+    easingCoefficients(easing, a, b);
+
+    _fromX.push_back(fromX);
+    _fromY.push_back(fromY);
+    _deltaX.push_back(toX - fromX);
+    _deltaY.push_back(toY - fromY);
+    _elapsed.push_back(0.0f);
+    // 时长为 0 的补间在下一次 step 时直接结束
+    _invDuration.push_back(duration > 0.0f ? 1.0f / duration : 1.0e30f);
+    _easeA.push_back(a);
+    _easeB.push_back(b);
+    _x.push_back(fromX);
+    _y.push_back(fromY);
+    _cardIds.push_back(cardId);
+    _tags.push_back(tag);
+    _handles.push_back(handle);
+}
+
+void TweenEngine::step(float dt, std::vector<TweenCompletion>& outCompleted)
+{
+    size_t count = _cardIds.size();
+    if (count == 0) {
+        return;
+    }
+
+    // 推进：只有乘加和取最小值，编译器可以向量化
+    advanceTweens(count, dt, _elapsed.data(), _invDuration.data(), _easeA.data(), _easeB.data(),
+        _fromX.data(), _fromY.data(), _deltaX.data(), _deltaY.data(), _x.data(), _y.data());
+
+    // 压实：结束的补间按顺序取出，其余前移（保持开始顺序）
+    size_t kept = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (_elapsed[i] * _invDuration[i] >= 1.0f) {
+            TweenCompletion completion;
+            completion.cardId = _cardIds[i];
+            completion.tag = _tags[i];
+            completion.handle = _handles[i];
+            completion.x = _fromX[i] + _deltaX[i];
+            completion.y = _fromY[i] + _deltaY[i];
+            outCompleted.push_back(completion);
+            continue;
+        }
+        if (kept != i) {
+            _fromX[kept] = _fromX[i];
+            _fromY[kept] = _fromY[i];
+            _deltaX[kept] = _deltaX[i];
+            _deltaY[kept] = _deltaY[i];
+            _elapsed[kept] = _elapsed[i];
+            _invDuration[kept] = _invDuration[i];
+            _easeA[kept] = _easeA[i];
+            _easeB[kept] = _easeB[i];
+            _x[kept] = _x[i];
+            _y[kept] = _y[i];
+            _cardIds[kept] = _cardIds[i];
+            _tags[kept] = _tags[i];
+            _handles[kept] = _handles[i];
+        }
+        kept++;
+    }
+    if (kept != count) {
+        _fromX.resize(kept);
+        _fromY.resize(kept);
+        _deltaX.resize(kept);
+        _deltaY.resize(kept);
+        _elapsed.resize(kept);
+        _invDuration.resize(kept);
+        _easeA.resize(kept);
+        _easeB.resize(kept);
+        _x.resize(kept);
+        _y.resize(kept);
+        _cardIds.resize(kept);
+        _tags.resize(kept);
+        _handles.resize(kept);
+    }
+}
+
+TweenCompletion TweenEngine::finish(size_t index)
+{
+    TweenCompletion completion;
+    completion.cardId = _cardIds[index];
+    completion.tag = _tags[index];
+    completion.handle = _handles[index];
+    completion.x = _fromX[index] + _deltaX[index];
+    completion.y = _fromY[index] + _deltaY[index];
+    removeAt(index);
+    return completion;
+}
+
+void TweenEngine::removeAt(size_t index)
+{
+    _fromX.erase(_fromX.begin() + index);
+    _fromY.erase(_fromY.begin() + index);
+    _deltaX.erase(_deltaX.begin() + index);
+    _deltaY.erase(_deltaY.begin() + index);
+    _elapsed.erase(_elapsed.begin() + index);
+    _invDuration.erase(_invDuration.begin() + index);
+    _easeA.erase(_easeA.begin() + index);
+    _easeB.erase(_easeB.begin() + index);
+    _x.erase(_x.begin() + index);
+    _y.erase(_y.begin() + index);
+    _cardIds.erase(_cardIds.begin() + index);
+    _tags.erase(_tags.begin() + index);
+    _handles.erase(_handles.begin() + index);
+}
+
+void TweenEngine::clear()
+{
+    _fromX.clear();
+    _fromY.clear();
+    _deltaX.clear();
+    _deltaY.clear();
+    _elapsed.clear();
+    _invDuration.clear();
+    _easeA.clear();
+    _easeB.clear();
+    _x.clear();
+    _y.clear();
+    _cardIds.clear();
+    _tags.clear();
+    _handles.clear();
+}
+
+int TweenEngine::find(int cardId) const
+{
+    for (size_t i = 0; i < _cardIds.size(); i++) {
+        if (_cardIds[i] == cardId) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
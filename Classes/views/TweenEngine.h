@@ -0,0 +1,91 @@
+#ifndef __TWEEN_ENGINE_H__
+#define __TWEEN_ENGINE_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * 缓动曲线
+ * 都是 t 的二次多项式 a·t + b·t²，每个补间只存两个系数，推进时不需要按曲线分支
+ */
+enum class TweenEasing : uint8_t {
+    LINEAR = 0,     // t
+    EASE_IN,        // t²
+    EASE_OUT        // 2t - t²
+};
+
+/**
+ * 结束的补间（一帧内结束的按开始顺序成批返回）
+ */
+struct TweenCompletion {
+    int cardId;
+    uint32_t tag;       // 开始时传入的附加信息（GameView 用来存动画类型和是否派发事件）
+    void* handle;       // 开始时传入的句柄（GameView 中为 CardView*）
+    float x;            // 终点
+    float y;
+};
+
+/**
+ * 卡牌补间引擎
+ * 所有进行中的移动按结构数组连续存放（起点、终点、已用时间、时长倒数、缓动系数、卡牌ID），
+ * step 先用一个没有分支、可向量化的循环推进全部补间并写出当前位置，再一次压实数组、成批取出结束的补间。
+ * 每个补间没有单独的堆对象，容量按需增长后复用，数量不设上限。
+ *
+ * 纯 CPU 实现，不依赖 cocos2d；位置写回节点由使用者完成。只在主线程使用。
+ */
+class TweenEngine {
+public:
+    TweenEngine();
+
+    // 预留容量，之后开始不超过该数量的补间不再分配内存
+    void reserve(size_t count);
+
+    // 开始一个补间；同一张牌已有补间时先调用 find / finish 结束它（本函数不检查）
+    void start(int cardId, void* handle, uint32_t tag, float fromX, float fromY, float toX, float toY,
+        float duration, TweenEasing easing = TweenEasing::LINEAR);
+
+    // 推进 dt 秒：更新所有补间的当前位置，把结束的补间按开始顺序追加到 outCompleted 并移除
+    void step(float dt, std::vector<TweenCompletion>& outCompleted);
+
+    // 立即结束第 index 个补间（保持其余补间的顺序）
+    TweenCompletion finish(size_t index);
+
+    // 清空，不产生结束记录
+    void clear();
+
+    // 卡牌所在的下标，没有时返回 -1
+    int find(int cardId) const;
+
+    size_t size() const { return _cardIds.size(); }
+    bool empty() const { return _cardIds.empty(); }
+
+    // 第 index 个补间（step 之后为当前位置）
+    int getCardId(size_t index) const { return _cardIds[index]; }
+    void* getHandle(size_t index) const { return _handles[index]; }
+    float getX(size_t index) const { return _x[index]; }
+    float getY(size_t index) const { return _y[index]; }
+
+    // 所有补间的卡牌ID（连续数组，长度为 size()）
+    const int* getCardIds() const { return _cardIds.data(); }
+
+private:
+    void removeAt(size_t index);
+
+    // 结构数组：第 i 个补间的各项位于各数组的 [i]
+    std::vector<float> _fromX;
+    std::vector<float> _fromY;
+    std::vector<float> _deltaX;       // 终点 - 起点
+    std::vector<float> _deltaY;
+    std::vector<float> _elapsed;
+    std::vector<float> _invDuration;
+    std::vector<float> _easeA;        // 缓动系数：a·t + b·t²
+    std::vector<float> _easeB;
+    std::vector<float> _x;            // 当前位置
+    std::vector<float> _y;
+    std::vector<int> _cardIds;
+    std::vector<uint32_t> _tags;
+    std::vector<void*> _handles;
+};
+
+#endif // __TWEEN_ENGINE_H__
@@ -0,0 +1,174 @@
+#include "ViewReconciler.h"
+#include "configs/LevelConfig.h"
+
+USING_NS_CC;
+
+const float ViewReconciler::TRAY_SPACING = 50.0f;
+
+namespace {
+
+// 备用牌堆第一张的位置（视图布局，模型中备用牌的位置只用作回退目标）
+const float TRAY_BASE_X = 300.0f;
+
+} // namespace
+
+ViewReconciler::ViewReconciler()
+    : _pass(0)
+{
+}
+
+Vec2 ViewReconciler::trayPosition(int index)
+{
+    return Vec2(TRAY_BASE_X + index * TRAY_SPACING, LevelLayout::TRAY_POS_Y);
+}
+
+void ViewReconciler::collectPlacements(const GameModel& model, std::vector<CardPlacement>& outPlacements, int liveStackCards)
+{
+    outPlacements.clear();
+
+    CardPlacement placement;
+    for (const auto& card : model.getPlayfieldCards()) {
+        placement.cardId = card.getId();
+        placement.cardCode = card.getCardCode();
+        placement.zone = CardZone::PLAYFIELD;
+        placement.index = card.getSlot();
+        placement.position = card.getPosition();
+        placement.zOrder = PLAYFIELD_Z + card.getSlot();
+        outPlacements.push_back(placement);
+    }
+
+    const auto& trayCards = model.getTrayCards();
+    for (size_t i = 0; i < trayCards.size(); i++) {
+        placement.cardId = trayCards[i].getId();
+        placement.cardCode = trayCards[i].getCardCode();
+        placement.zone = CardZone::TRAY;
+        placement.index = static_cast<int>(i);
+        placement.position = trayPosition(static_cast<int>(i));
+        placement.zOrder = TRAY_Z + static_cast<int>(i);
+        outPlacements.push_back(placement);
+    }
+
+    // 底牌堆的牌叠在同一位置，后加入的在上；层级按在整个底牌堆中的序号，与保留几张无关
+    const auto& stackCards = model.getStackCards();
+    size_t firstLive = stackCards.size() > static_cast<size_t>(liveStackCards) ? stackCards.size() - liveStackCards : 0;
+    for (size_t i = firstLive; i < stackCards.size(); i++) {
+        placement.cardId = stackCards[i].getId();
+        placement.cardCode = stackCards[i].getCardCode();
+        placement.zone = CardZone::STACK;
+        placement.index = static_cast<int>(i);
+        placement.position = Vec2(LevelLayout::STACK_POS_X, LevelLayout::STACK_POS_Y);
+        placement.zOrder = STACK_Z + static_cast<int>(i);
+        outPlacements.push_back(placement);
+    }
+}
+
+bool ViewReconciler::reconcile(const std::vector<CardPlacement>& target, const int* skipIds, int skipCount, std::vector<ViewOp>& outOps,
+                               int maxCreates)
+{
+    outOps.clear();
+    _pending.clear();
+    _pass++;
+    bool complete = true;
+
+    // 跳过的牌记为本轮已出现：既不更新也不销毁
+    for (int i = 0; i < skipCount; i++) {
+        int cardId = skipIds[i];
+        if (cardId >= 0 && cardId < static_cast<int>(_applied.size())) {
+            _applied[cardId].seen = _pass;
+        }
+    }
+
+    for (const auto& placement : target) {
+        if (placement.cardId < 0) {
+            continue;
+        }
+        if (placement.cardId >= static_cast<int>(_applied.size())) {
+            _applied.resize(placement.cardId + 1);
+        }
+        Applied& applied = _applied[placement.cardId];
+        if (applied.seen == _pass) {
+            continue;
+        }
+        applied.seen = _pass;
+
+        const CardPlacement& current = applied.placement;
+        if (current.zone != CardZone::NONE && current.cardCode != placement.cardCode) {
+            // 同一 ID 换了牌面（换关后 ID 重新编号）：重建视图
+            outOps.push_back(ViewOp(ViewOp::DESTROY, 0, current));
+            applied.placement.zone = CardZone::NONE;
+        }
+        if (current.zone == CardZone::NONE) {
+            if (maxCreates == 0) {
+                // 本次的创建配额已用完，保持未创建（已标记出现，不会被当作多余视图）
+                complete = false;
+                continue;
+            }
+            if (maxCreates > 0) {
+                maxCreates--;
+            }
+            _pending.push_back(ViewOp(ViewOp::CREATE, 0, placement));
+        }
+        else {
+            uint8_t changes = 0;
+            if (applied.stale) {
+                changes = ViewOp::CHANGE_POSITION | ViewOp::CHANGE_Z_ORDER | ViewOp::CHANGE_ZONE;
+            }
+            else {
+                if (current.position != placement.position) {
+                    changes |= ViewOp::CHANGE_POSITION;
+                }
+                if (current.zOrder != placement.zOrder) {
+                    changes |= ViewOp::CHANGE_Z_ORDER;
+                }
+                if (current.zone != placement.zone) {
+                    changes |= ViewOp::CHANGE_ZONE;
+                }
+            }
+            if (changes != 0) {
+                _pending.push_back(ViewOp(ViewOp::UPDATE, changes, placement));
+            }
+        }
+        applied.placement = placement;
+        applied.stale = false;
+    }
+
+    // 不在目标中的视图销毁
+    for (auto& applied : _applied) {
+        if (applied.placement.zone != CardZone::NONE && applied.seen != _pass) {
+            outOps.push_back(ViewOp(ViewOp::DESTROY, 0, applied.placement));
+            applied.placement.zone = CardZone::NONE;
+            applied.stale = false;
+        }
+    }
+
+    outOps.insert(outOps.end(), _pending.begin(), _pending.end());
+    return complete;
+}
+
+void ViewReconciler::invalidate(int cardId)
+{
+    if (cardId >= 0 && cardId < static_cast<int>(_applied.size())) {
+        _applied[cardId].stale = true;
+    }
+}
+
+void ViewReconciler::forget(int cardId)
+{
+    if (cardId >= 0 && cardId < static_cast<int>(_applied.size())) {
+        _applied[cardId].placement.zone = CardZone::NONE;
+        _applied[cardId].stale = false;
+    }
+}
+
+void ViewReconciler::reset()
+{
+    _applied.clear();
+}
+
+const CardPlacement* ViewReconciler::getApplied(int cardId) const
+{
+    if (cardId < 0 || cardId >= static_cast<int>(_applied.size()) || _applied[cardId].placement.zone == CardZone::NONE) {
+        return nullptr;
+    }
+    return &_applied[cardId].placement;
+}
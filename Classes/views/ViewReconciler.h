@@ -0,0 +1,126 @@
+#ifndef __VIEW_RECONCILER_H__
+#define __VIEW_RECONCILER_H__
+
+#include "cocos2d.h"
+#include "models/GameModel.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * 卡牌所在区域
+ */
+enum class CardZone : uint8_t {
+    NONE = 0,        // 没有视图
+    PLAYFIELD,       // 主牌区，index 为槽位
+    TRAY,            // 备用牌堆，index 为从底到顶的序号
+    STACK            // 底牌堆，index 为从底到顶的序号
+};
+
+/**
+ * 一张牌的视图应处的状态（由模型算出）
+ */
+struct CardPlacement {
+    int cardId;
+    int cardCode;
+    CardZone zone;
+    int index;
+    cocos2d::Vec2 position;
+    int zOrder;
+
+    CardPlacement() : cardId(-1), cardCode(0), zone(CardZone::NONE), index(0), zOrder(0) {}
+};
+
+/**
+ * 一次视图操作
+ * UPDATE 的 changes 为 CHANGE_* 的组合
+ */
+struct ViewOp {
+    enum Type {
+        DESTROY = 0,
+        CREATE,
+        UPDATE
+    };
+
+    static const uint8_t CHANGE_POSITION = 1 << 0;
+    static const uint8_t CHANGE_Z_ORDER = 1 << 1;
+    static const uint8_t CHANGE_ZONE = 1 << 2;      // 区域变化，需要重新绑定点击回调
+
+    Type type;
+    uint8_t changes;
+    CardPlacement placement;     // DESTROY 时只有 cardId 和原区域有效
+
+    ViewOp(Type t, uint8_t c, const CardPlacement& p) : type(t), changes(c), placement(p) {}
+};
+
+/**
+ * 视图对齐
+ *
+ * 撤销到开局、重新开始、加载快照等多张牌同时变化时，视图按模型重新对齐：由模型算出每张牌应处的区域、
+ * 位置和层级，与上次已应用的状态比较，只对有变化的牌输出创建、移动、调整层级和销毁操作。
+ * 没有变化的牌只做一次整数和坐标比较，节点操作的数量与变化量成正比。
+ *
+ * 层级按区域分段并在段内按槽位/序号递增，每张牌的层级唯一，遮挡顺序不依赖节点加入的先后。
+ * 移动中的牌由动画持有：调用 invalidate 标记后，对齐时跳过，动画结束后的下一次对齐整体更新。
+ * 不依赖 cocos2d 节点，只使用 Vec2。
+ */
+class ViewReconciler {
+public:
+    ViewReconciler();
+
+    // 层级分段：主牌区 1000 + 槽位，备用牌堆 3000 + 序号，底牌堆 5000 + 序号，移动中 9000
+    static const int PLAYFIELD_Z = 1000;
+    static const int TRAY_Z = 3000;
+    static const int STACK_Z = 5000;
+    static const int MOVING_Z = 9000;
+
+    // 备用牌堆左右错开的间距
+    static const float TRAY_SPACING;
+
+    // 底牌堆默认只为最上面几张保留视图：顶牌和回退时露出的下一张，再留一张余量应对连续回退
+    static const int DEFAULT_LIVE_STACK_CARDS = 3;
+
+    // 按模型计算所有应有视图的牌，按层级从低到高输出
+    // 底牌堆只输出最上面 liveStackCards 张，下面的牌被完全盖住，只保留在模型中，回退露出时再创建视图
+    static void collectPlacements(const GameModel& model, std::vector<CardPlacement>& outPlacements,
+                                  int liveStackCards = DEFAULT_LIVE_STACK_CARDS);
+
+    // 备用牌堆第 index 张的位置
+    static cocos2d::Vec2 trayPosition(int index);
+
+    // 与上次已应用的状态比较，输出操作（先销毁，再按层级从低到高创建和更新），并记为已应用
+    // skipIds 中的牌（移动中）不处理；outOps 先被清空
+    // maxCreates 限制本次创建的视图数（负数不限），超出的牌不记为已应用，留到下次对齐；
+    // 返回 false 表示还有牌等待创建
+    bool reconcile(const std::vector<CardPlacement>& target, const int* skipIds, int skipCount, std::vector<ViewOp>& outOps,
+                   int maxCreates = -1);
+
+    // 视图被外部改动（动画），下次对齐时这张牌整体更新
+    void invalidate(int cardId);
+
+    // 视图已被外部销毁
+    void forget(int cardId);
+
+    // 清空已应用的状态（所有视图已销毁）
+    void reset();
+
+    // 已应用的状态，没有视图时 zone 为 NONE
+    const CardPlacement* getApplied(int cardId) const;
+
+private:
+    /**
+     * 已应用的状态（按卡牌ID索引）
+     */
+    struct Applied {
+        CardPlacement placement;
+        bool stale;
+        uint32_t seen;           // 最近一次出现在目标中的对齐序号
+
+        Applied() : stale(false), seen(0) {}
+    };
+
+    std::vector<Applied> _applied;
+    std::vector<ViewOp> _pending;    // 本次的创建和更新，排在销毁之后输出
+    uint32_t _pass;
+};
+
+#endif // __VIEW_RECONCILER_H__
@@ -0,0 +1,258 @@
+#include "Etc1Encoder.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+namespace {
+
+// 修正表（OES_compressed_ETC1_RGB8_texture 表 3.17.2）
+const int MODIFIER_TABLES[8][2] = {
+    { 2, 8 }, { 5, 17 }, { 9, 29 }, { 13, 42 }, { 18, 60 }, { 24, 80 }, { 33, 106 }, { 47, 183 }
+};
+
+// 索引值（msb lsb）对应的修正量：00 为 +a，01 为 +b，10 为 -a，11 为 -b
+inline int modifier(int table, int index)
+{
+    int value = MODIFIER_TABLES[table][index & 1];
+    return (index & 2) ? -value : value;
+}
+
+inline int clamp(int value, int low, int high)
+{
+    return value < low ? low : (value > high ? high : value);
+}
+
+inline int expand4(int value)
+{
+    return (value << 4) | value;
+}
+
+inline int expand5(int value)
+{
+    return (value << 3) | (value >> 2);
+}
+
+// 一个子块（2x4 或 4x2）的 8 个像素
+struct Subblock {
+    int rgb[8][3];
+    int position[8];     // 块内索引 x * 4 + y，即像素索引在两个 16 位平面中的位号
+    float average[3];
+};
+
+struct SubblockFit {
+    int error;
+    int table;
+    int indices[8];
+
+    SubblockFit() : error(INT_MAX), table(0) {}
+};
+
+// 用给定基色（已扩展为 8 位）编码子块：穷举修正表，每个像素取误差最小的修正量
+SubblockFit fitSubblock(const Subblock& sub, const int base[3])
+{
+    SubblockFit best;
+    for (int table = 0; table < 8; table++) {
+        SubblockFit fit;
+        fit.table = table;
+        fit.error = 0;
+        for (int p = 0; p < 8 && fit.error < best.error; p++) {
+            int pixelError = INT_MAX;
+            for (int index = 0; index < 4; index++) {
+                int m = modifier(table, index);
+                int error = 0;
+                for (int c = 0; c < 3; c++) {
+                    int diff = clamp(base[c] + m, 0, 255) - sub.rgb[p][c];
+                    error += diff * diff;
+                }
+                if (error < pixelError) {
+                    pixelError = error;
+                    fit.indices[p] = index;
+                }
+            }
+            fit.error += pixelError;
+        }
+        if (fit.error < best.error) {
+            best = fit;
+        }
+    }
+    return best;
+}
+
+struct BlockCandidate {
+    int error;
+    bool differential;
+    bool flip;
+    int colors[2][3];    // 量化后的基色（4 位或 5 位）
+    SubblockFit fits[2];
+    const Subblock* subs;
+
+    BlockCandidate() : error(INT_MAX), differential(false), flip(false), subs(nullptr) {}
+};
+
+// 为子块选 bits 位基色（每通道限制在 [low, high]）：先试平均色及其整体亮一级、暗一级，
+// 再按选中的修正量反推基色（各像素减去修正量后取平均）迭代两次
+SubblockFit fitColor(const Subblock& sub, int bits, const int low[3], const int high[3], int outColor[3])
+{
+    static const int SHIFTS[3] = { 0, -1, 1 };
+
+    SubblockFit best;
+    auto tryColor = [&](const float target[3], int shift) {
+        int color[3];
+        int base[3];
+        for (int c = 0; c < 3; c++) {
+            int q = static_cast<int>(std::lround(target[c] * ((1 << bits) - 1) / 255.0f));
+            color[c] = clamp(q + shift, low[c], high[c]);
+            base[c] = bits == 4 ? expand4(color[c]) : expand5(color[c]);
+        }
+        SubblockFit fit = fitSubblock(sub, base);
+        if (fit.error < best.error) {
+            best = fit;
+            std::copy(color, color + 3, outColor);
+        }
+    };
+
+    for (int shift : SHIFTS) {
+        tryColor(sub.average, shift);
+    }
+    for (int iteration = 0; iteration < 2; iteration++) {
+        float target[3] = { 0.0f, 0.0f, 0.0f };
+        for (int p = 0; p < 8; p++) {
+            int m = modifier(best.table, best.indices[p]);
+            for (int c = 0; c < 3; c++) {
+                target[c] += (sub.rgb[p][c] - m) / 8.0f;
+            }
+        }
+        tryColor(target, 0);
+    }
+    return best;
+}
+
+void trySubblockPair(const Subblock subs[2], bool flip, BlockCandidate& best)
+{
+    static const int LOW[3] = { 0, 0, 0 };
+    static const int HIGH4[3] = { 15, 15, 15 };
+    static const int HIGH5[3] = { 31, 31, 31 };
+
+    // 各自 4 位：两个子块独立选基色
+    BlockCandidate individual;
+    individual.flip = flip;
+    individual.subs = subs;
+    individual.fits[0] = fitColor(subs[0], 4, LOW, HIGH4, individual.colors[0]);
+    individual.fits[1] = fitColor(subs[1], 4, LOW, HIGH4, individual.colors[1]);
+    individual.error = individual.fits[0].error + individual.fits[1].error;
+    if (individual.error < best.error) {
+        best = individual;
+    }
+
+    // 5 位加差值：第二个子块的基色限制在第一个的 [-4, 3] 范围内
+    BlockCandidate differential;
+    differential.differential = true;
+    differential.flip = flip;
+    differential.subs = subs;
+    differential.fits[0] = fitColor(subs[0], 5, LOW, HIGH5, differential.colors[0]);
+    int low[3];
+    int high[3];
+    for (int c = 0; c < 3; c++) {
+        low[c] = std::max(0, differential.colors[0][c] - 4);
+        high[c] = std::min(31, differential.colors[0][c] + 3);
+    }
+    differential.fits[1] = fitColor(subs[1], 5, low, high, differential.colors[1]);
+    differential.error = differential.fits[0].error + differential.fits[1].error;
+    if (differential.error < best.error) {
+        best = differential;
+    }
+}
+
+// block 为 16 个像素的 RGB，按 y * 4 + x 排列；输出 8 字节（大端）
+void encodeBlock(const int block[16][3], uint8_t out[8])
+{
+    // flip 为 0 时左右两个 2x4 子块，为 1 时上下两个 4x2 子块
+    Subblock split[2][2];
+    BlockCandidate best;
+    for (int flip = 0; flip < 2; flip++) {
+        Subblock* subs = split[flip];
+        int counts[2] = { 0, 0 };
+        for (int y = 0; y < 4; y++) {
+            for (int x = 0; x < 4; x++) {
+                int s = flip ? (y >= 2) : (x >= 2);
+                Subblock& sub = subs[s];
+                int p = counts[s]++;
+                std::copy(block[y * 4 + x], block[y * 4 + x] + 3, sub.rgb[p]);
+                sub.position[p] = x * 4 + y;
+            }
+        }
+        for (int s = 0; s < 2; s++) {
+            for (int c = 0; c < 3; c++) {
+                int sum = 0;
+                for (int p = 0; p < 8; p++) {
+                    sum += subs[s].rgb[p][c];
+                }
+                subs[s].average[c] = sum / 8.0f;
+            }
+        }
+        trySubblockPair(subs, flip != 0, best);
+    }
+
+    uint32_t high = 0;
+    if (best.differential) {
+        for (int c = 0; c < 3; c++) {
+            int delta = best.colors[1][c] - best.colors[0][c];
+            high |= static_cast<uint32_t>((best.colors[0][c] << 3) | (delta & 7)) << (24 - c * 8);
+        }
+        high |= 2;
+    }
+    else {
+        for (int c = 0; c < 3; c++) {
+            high |= static_cast<uint32_t>((best.colors[0][c] << 4) | best.colors[1][c]) << (24 - c * 8);
+        }
+    }
+    high |= static_cast<uint32_t>(best.fits[0].table << 5) | static_cast<uint32_t>(best.fits[1].table << 2);
+    high |= best.flip ? 1 : 0;
+
+    uint32_t low = 0;
+    for (int s = 0; s < 2; s++) {
+        for (int p = 0; p < 8; p++) {
+            int index = best.fits[s].indices[p];
+            int position = best.subs[s].position[p];
+            low |= static_cast<uint32_t>(index >> 1) << (16 + position);
+            low |= static_cast<uint32_t>(index & 1) << position;
+        }
+    }
+
+    for (int i = 0; i < 4; i++) {
+        out[i] = static_cast<uint8_t>(high >> (24 - i * 8));
+        out[4 + i] = static_cast<uint8_t>(low >> (24 - i * 8));
+    }
+}
+
+} // namespace
+
+namespace Etc1Encoder {
+
+size_t encodedSize(int width, int height)
+{
+    return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * 8;
+}
+
+void encode(const uint8_t* rgb, int width, int height, std::vector<uint8_t>& out)
+{
+    for (int by = 0; by < height; by += 4) {
+        for (int bx = 0; bx < width; bx += 4) {
+            // 不足 4 的边（小于 4 的 mipmap 级）重复边缘像素，解码时不会用到
+            int block[16][3];
+            for (int y = 0; y < 4; y++) {
+                for (int x = 0; x < 4; x++) {
+                    const uint8_t* p = rgb + (static_cast<size_t>(std::min(by + y, height - 1)) * width + std::min(bx + x, width - 1)) * 3;
+                    for (int c = 0; c < 3; c++) {
+                        block[y * 4 + x][c] = p[c];
+                    }
+                }
+            }
+            uint8_t encoded[8];
+            encodeBlock(block, encoded);
+            out.insert(out.end(), encoded, encoded + 8);
+        }
+    }
+}
+
+} // namespace Etc1Encoder
@@ -0,0 +1,126 @@
+#include "PvrWriter.h"
+#include "Etc1Encoder.h"
+
+namespace {
+
+const uint32_t PVR3_VERSION = 0x03525650;            // "PVR\3"
+const uint32_t PVR3_FLAG_PREMULTIPLIED = 0x02;
+const size_t PVR3_HEADER_SIZE = 52;
+
+// 压缩格式为编号，非压缩格式为通道名 + 位数，与 cocos2d::Image 中的 PVR3TexturePixelFormat 一致
+const uint64_t PVR3_ETC1 = 6;
+const uint64_t PVR3_RGBA8888 = 0x0808080861626772ULL;
+const uint64_t PVR3_RGBA4444 = 0x0404040461626772ULL;
+const uint64_t PVR3_RGB565 = 0x0005060500626772ULL;
+
+void putU32(std::vector<uint8_t>& out, uint32_t value)
+{
+    for (int i = 0; i < 4; i++) {
+        out.push_back(static_cast<uint8_t>(value >> (i * 8)));
+    }
+}
+
+void putU64(std::vector<uint8_t>& out, uint64_t value)
+{
+    putU32(out, static_cast<uint32_t>(value));
+    putU32(out, static_cast<uint32_t>(value >> 32));
+}
+
+void putHeader(std::vector<uint8_t>& out, uint64_t pixelFormat, bool premultiplied, const std::vector<TextureImage>& levels)
+{
+    putU32(out, PVR3_VERSION);
+    putU32(out, premultiplied ? PVR3_FLAG_PREMULTIPLIED : 0);
+    putU64(out, pixelFormat);
+    putU32(out, 0);                                     // 颜色空间：线性
+    putU32(out, 0);                                     // 通道类型：无符号归一化
+    putU32(out, static_cast<uint32_t>(levels[0].getHeight()));
+    putU32(out, static_cast<uint32_t>(levels[0].getWidth()));
+    putU32(out, 1);                                     // 深度
+    putU32(out, 1);                                     // 表面数
+    putU32(out, 1);                                     // 面数
+    putU32(out, static_cast<uint32_t>(levels.size()));  // mipmap 级数
+    putU32(out, 0);                                     // 元数据长度
+}
+
+} // namespace
+
+namespace PvrWriter {
+
+bool parseFormat(const std::string& name, PvrFormat& outFormat)
+{
+    if (name == "etc1") {
+        outFormat = PvrFormat::ETC1;
+    }
+    else if (name == "rgba8888") {
+        outFormat = PvrFormat::RGBA8888;
+    }
+    else if (name == "rgba4444") {
+        outFormat = PvrFormat::RGBA4444;
+    }
+    else if (name == "rgb565") {
+        outFormat = PvrFormat::RGB565;
+    }
+    else {
+        return false;
+    }
+    return true;
+}
+
+const char* formatName(PvrFormat format)
+{
+    switch (format) {
+    case PvrFormat::ETC1:     return "etc1";
+    case PvrFormat::RGBA8888: return "rgba8888";
+    case PvrFormat::RGBA4444: return "rgba4444";
+    case PvrFormat::RGB565:   return "rgb565";
+    }
+    return "rgba8888";
+}
+
+void encode(const std::vector<TextureImage>& levels, PvrFormat format, std::vector<uint8_t>& out)
+{
+    uint64_t pixelFormat = PVR3_RGBA8888;
+    if (format == PvrFormat::ETC1) {
+        pixelFormat = PVR3_ETC1;
+    }
+    else if (format == PvrFormat::RGBA4444) {
+        pixelFormat = PVR3_RGBA4444;
+    }
+    else if (format == PvrFormat::RGB565) {
+        pixelFormat = PVR3_RGB565;
+    }
+    putHeader(out, pixelFormat, format != PvrFormat::ETC1, levels);
+
+    std::vector<uint8_t> rgb;
+    for (const auto& level : levels) {
+        switch (format) {
+        case PvrFormat::ETC1:
+            rgb.clear();
+            level.toStraightRgb(rgb);
+            Etc1Encoder::encode(rgb.data(), level.getWidth(), level.getHeight(), out);
+            break;
+        case PvrFormat::RGBA8888: level.appendRgba8888(out); break;
+        case PvrFormat::RGBA4444: level.appendRgba4444(out); break;
+        case PvrFormat::RGB565:   level.appendRgb565(out); break;
+        }
+    }
+}
+
+void encodeAlpha(const std::vector<TextureImage>& levels, std::vector<uint8_t>& out)
+{
+    putHeader(out, PVR3_ETC1, false, levels);
+
+    std::vector<uint8_t> rgb;
+    for (const auto& level : levels) {
+        rgb.clear();
+        level.toAlphaRgb(rgb);
+        Etc1Encoder::encode(rgb.data(), level.getWidth(), level.getHeight(), out);
+    }
+}
+
+size_t dataSize(const std::vector<uint8_t>& file)
+{
+    return file.size() > PVR3_HEADER_SIZE ? file.size() - PVR3_HEADER_SIZE : 0;
+}
+
+} // namespace PvrWriter
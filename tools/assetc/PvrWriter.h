@@ -0,0 +1,39 @@
+#ifndef __PVR_WRITER_H__
+#define __PVR_WRITER_H__
+
+#include "TextureImage.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * 输出像素格式
+ */
+enum class PvrFormat {
+    ETC1 = 0,        // 每像素 4 位，颜色不预乘；带透明像素时 alpha 另存一张 ETC1 纹理（cocos2d 的 ETC1 分离 alpha）
+    RGBA8888,
+    RGBA4444,        // 16 位，ETC1 不可用时的备选
+    RGB565           // 只用于不透明图片
+};
+
+/**
+ * PVR v3 写入
+ * 52 字节文件头（无元数据），随后从大到小依次存放各级 mipmap；非压缩格式标记为预乘 alpha
+ */
+namespace PvrWriter {
+
+bool parseFormat(const std::string& name, PvrFormat& outFormat);
+const char* formatName(PvrFormat format);
+
+// levels[0] 为原尺寸，之后每级各边减半
+void encode(const std::vector<TextureImage>& levels, PvrFormat format, std::vector<uint8_t>& out);
+
+// ETC1 的分离 alpha 纹理：各级 alpha 写入 RGB 后压缩
+void encodeAlpha(const std::vector<TextureImage>& levels, std::vector<uint8_t>& out);
+
+// 文件头之后的数据大小
+size_t dataSize(const std::vector<uint8_t>& file);
+
+} // namespace PvrWriter
+
+#endif // __PVR_WRITER_H__
@@ -0,0 +1,235 @@
+#include "TextureImage.h"
+#include <png.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+void setError(std::string* error, const std::string& msg)
+{
+    if (error) {
+        *error = msg;
+    }
+}
+
+// 按面积平均把一行（或一列）从 srcCount 个样本缩放到 dstCount 个，stride 为相邻样本间隔（float 个数）
+void resampleLine(const float* src, int srcCount, size_t srcStride, float* dst, int dstCount, size_t dstStride)
+{
+    double ratio = static_cast<double>(srcCount) / dstCount;
+    for (int i = 0; i < dstCount; i++) {
+        double begin = i * ratio;
+        double end = begin + ratio;
+        float sum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        for (int s = static_cast<int>(begin); s < srcCount && s < end; s++) {
+            // 源样本 [s, s+1) 与目标区间 [begin, end) 的重叠长度
+            double weight = std::min<double>(s + 1, end) - std::max<double>(s, begin);
+            const float* p = src + s * srcStride;
+            for (int c = 0; c < 4; c++) {
+                sum[c] += static_cast<float>(p[c] * weight);
+            }
+        }
+        float* out = dst + i * dstStride;
+        for (int c = 0; c < 4; c++) {
+            out[c] = static_cast<float>(sum[c] / ratio);
+        }
+    }
+}
+
+inline int quantize(float value, int maxValue)
+{
+    int q = static_cast<int>(value * maxValue + 0.5f);
+    return q < 0 ? 0 : (q > maxValue ? maxValue : q);
+}
+
+} // namespace
+
+TextureImage::TextureImage(int width, int height)
+    : _width(width)
+    , _height(height)
+    , _pixels(static_cast<size_t>(width) * height * 4, 0.0f)
+{
+}
+
+bool TextureImage::loadPng(const std::string& path, std::string* error)
+{
+    png_image image;
+    std::memset(&image, 0, sizeof(image));
+    image.version = PNG_IMAGE_VERSION;
+    if (!png_image_begin_read_from_file(&image, path.c_str())) {
+        setError(error, image.message);
+        return false;
+    }
+
+    image.format = PNG_FORMAT_RGBA;
+    std::vector<uint8_t> rgba(PNG_IMAGE_SIZE(image));
+    if (!png_image_finish_read(&image, nullptr, rgba.data(), 0, nullptr)) {
+        setError(error, image.message);
+        png_image_free(&image);
+        return false;
+    }
+
+    _width = static_cast<int>(image.width);
+    _height = static_cast<int>(image.height);
+    _pixels.resize(static_cast<size_t>(_width) * _height * 4);
+    for (size_t i = 0; i < rgba.size(); i += 4) {
+        float alpha = rgba[i + 3] / 255.0f;
+        _pixels[i] = rgba[i] / 255.0f * alpha;
+        _pixels[i + 1] = rgba[i + 1] / 255.0f * alpha;
+        _pixels[i + 2] = rgba[i + 2] / 255.0f * alpha;
+        _pixels[i + 3] = alpha;
+    }
+    return true;
+}
+
+bool TextureImage::isOpaque() const
+{
+    for (size_t i = 3; i < _pixels.size(); i += 4) {
+        if (_pixels[i] < 1.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TextureImage TextureImage::resized(int width, int height) const
+{
+    // 先横向再纵向，两次一维面积平均等价于二维盒式滤波
+    TextureImage horizontal(width, _height);
+    for (int y = 0; y < _height; y++) {
+        resampleLine(pixel(0, y), _width, 4, &horizontal._pixels[static_cast<size_t>(y) * width * 4], width, 4);
+    }
+    TextureImage result(width, height);
+    for (int x = 0; x < width; x++) {
+        resampleLine(horizontal.pixel(x, 0), _height, static_cast<size_t>(width) * 4,
+            &result._pixels[static_cast<size_t>(x) * 4], height, static_cast<size_t>(width) * 4);
+    }
+    return result;
+}
+
+TextureImage TextureImage::nextMipmap() const
+{
+    return resized(std::max(1, _width / 2), std::max(1, _height / 2));
+}
+
+TextureImage TextureImage::padded(int width, int height) const
+{
+    TextureImage result(width, height);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            const float* src = pixel(std::min(x, _width - 1), std::min(y, _height - 1));
+            std::copy(src, src + 4, &result._pixels[(static_cast<size_t>(y) * width + x) * 4]);
+        }
+    }
+    return result;
+}
+
+void TextureImage::appendRgba8888(std::vector<uint8_t>& out) const
+{
+    for (size_t i = 0; i < _pixels.size(); i++) {
+        out.push_back(static_cast<uint8_t>(quantize(_pixels[i], 255)));
+    }
+}
+
+void TextureImage::appendRgba4444(std::vector<uint8_t>& out) const
+{
+    // GL_UNSIGNED_SHORT_4_4_4_4：R 在最高 4 位
+    for (size_t i = 0; i < _pixels.size(); i += 4) {
+        uint16_t value = static_cast<uint16_t>((quantize(_pixels[i], 15) << 12)
+            | (quantize(_pixels[i + 1], 15) << 8)
+            | (quantize(_pixels[i + 2], 15) << 4)
+            | quantize(_pixels[i + 3], 15));
+        out.push_back(static_cast<uint8_t>(value & 0xFF));
+        out.push_back(static_cast<uint8_t>(value >> 8));
+    }
+}
+
+void TextureImage::appendRgb565(std::vector<uint8_t>& out) const
+{
+    for (size_t i = 0; i < _pixels.size(); i += 4) {
+        uint16_t value = static_cast<uint16_t>((quantize(_pixels[i], 31) << 11)
+            | (quantize(_pixels[i + 1], 63) << 5)
+            | quantize(_pixels[i + 2], 31));
+        out.push_back(static_cast<uint8_t>(value & 0xFF));
+        out.push_back(static_cast<uint8_t>(value >> 8));
+    }
+}
+
+void TextureImage::toStraightRgb(std::vector<uint8_t>& out) const
+{
+    // 8 位量化后 alpha 为 0 的像素视为全透明
+    const float TRANSPARENT_ALPHA = 0.5f / 255.0f;
+
+    size_t count = static_cast<size_t>(_width) * _height;
+    std::vector<float> rgb(count * 3, 0.0f);
+    std::vector<char> filled(count, 0);
+    for (size_t i = 0; i < count; i++) {
+        float alpha = _pixels[i * 4 + 3];
+        if (alpha >= TRANSPARENT_ALPHA) {
+            for (int c = 0; c < 3; c++) {
+                rgb[i * 3 + c] = std::min(1.0f, _pixels[i * 4 + c] / alpha);
+            }
+            filled[i] = 1;
+        }
+    }
+
+    // 逐圈向外扩散：未填充的像素取相邻 8 个已填充像素的平均色，直到填满（全透明图片保持黑色）
+    std::vector<size_t> frontier;
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        frontier.clear();
+        for (int y = 0; y < _height; y++) {
+            for (int x = 0; x < _width; x++) {
+                size_t i = static_cast<size_t>(y) * _width + x;
+                if (filled[i]) {
+                    continue;
+                }
+                float sum[3] = { 0.0f, 0.0f, 0.0f };
+                int neighbors = 0;
+                for (int dy = -1; dy <= 1; dy++) {
+                    for (int dx = -1; dx <= 1; dx++) {
+                        int nx = x + dx;
+                        int ny = y + dy;
+                        if (nx < 0 || ny < 0 || nx >= _width || ny >= _height) {
+                            continue;
+                        }
+                        size_t n = static_cast<size_t>(ny) * _width + nx;
+                        if (filled[n] == 1) {
+                            for (int c = 0; c < 3; c++) {
+                                sum[c] += rgb[n * 3 + c];
+                            }
+                            neighbors++;
+                        }
+                    }
+                }
+                if (neighbors > 0) {
+                    for (int c = 0; c < 3; c++) {
+                        rgb[i * 3 + c] = sum[c] / neighbors;
+                    }
+                    // 本圈填充的像素下一圈才作为来源
+                    filled[i] = 2;
+                    frontier.push_back(i);
+                    changed = true;
+                }
+            }
+        }
+        for (size_t i : frontier) {
+            filled[i] = 1;
+        }
+    }
+
+    for (float value : rgb) {
+        out.push_back(static_cast<uint8_t>(quantize(value, 255)));
+    }
+}
+
+void TextureImage::toAlphaRgb(std::vector<uint8_t>& out) const
+{
+    for (size_t i = 3; i < _pixels.size(); i += 4) {
+        uint8_t alpha = static_cast<uint8_t>(quantize(_pixels[i], 255));
+        out.push_back(alpha);
+        out.push_back(alpha);
+        out.push_back(alpha);
+    }
+}
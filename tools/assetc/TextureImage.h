@@ -0,0 +1,57 @@
+#ifndef __TEXTURE_IMAGE_H__
+#define __TEXTURE_IMAGE_H__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * 预乘 alpha 的 RGBA 浮点图像（0~1）
+ * 缩放和生成 mipmap 都在预乘空间中做，透明边缘不会混入黑边
+ */
+class TextureImage {
+public:
+    TextureImage() : _width(0), _height(0) {}
+
+    // 读取 PNG（任意颜色类型），转为预乘 RGBA
+    bool loadPng(const std::string& path, std::string* error = nullptr);
+
+    int getWidth() const { return _width; }
+    int getHeight() const { return _height; }
+
+    // 所有像素 alpha 都为 1
+    bool isOpaque() const;
+
+    // 按面积平均缩放到 width x height（只用于缩小）
+    TextureImage resized(int width, int height) const;
+
+    // 下一级 mipmap（各边减半，最小为 1）
+    TextureImage nextMipmap() const;
+
+    // 扩展到 width x height（不小于原尺寸），原图在左上角，右侧和下方重复边缘像素
+    // 与 GL_CLAMP_TO_EDGE 采样原图边缘的结果相同
+    TextureImage padded(int width, int height) const;
+
+    // 量化为 GL 像素格式（小端），追加到 out
+    void appendRgba8888(std::vector<uint8_t>& out) const;
+    void appendRgba4444(std::vector<uint8_t>& out) const;
+    void appendRgb565(std::vector<uint8_t>& out) const;
+
+    // 8 位 RGB（供 ETC1 压缩），自上而下逐行
+    // 颜色去预乘；全透明像素的颜色取自最近的不透明像素，过滤和 mipmap 时边缘不会混入黑色
+    void toStraightRgb(std::vector<uint8_t>& out) const;
+    // alpha 写入 RGB 三个通道（ETC1 分离 alpha 纹理，着色器读 R 通道）
+    void toAlphaRgb(std::vector<uint8_t>& out) const;
+
+    // 第 y 行（自上而下）第 x 列的预乘 RGBA
+    const float* pixel(int x, int y) const { return &_pixels[(static_cast<size_t>(y) * _width + x) * 4]; }
+
+private:
+    TextureImage(int width, int height);
+
+    int _width;
+    int _height;
+    std::vector<float> _pixels;   // 自上而下逐行，与 PNG 行序一致
+};
+
+#endif // __TEXTURE_IMAGE_H__
@@ -0,0 +1,278 @@
+#include "TextureImage.h"
+#include "PvrWriter.h"
+#include "../common/FileSystemUtils.h"
+#include "configs/AssetVariants.h"
+#include "utils/ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+/**
+ * 资源变体生成工具
+ * 把 PNG 素材按每档缩放（默认与 AppDelegate 的三档分辨率一致）缩小，补齐到 2 次幂尺寸后
+ * 输出带完整 mipmap 链的 PVR v3 纹理（默认 ETC1，带透明像素时另存 alpha 纹理）和清单，
+ * 运行时由 AssetVariants 按 contentScaleFactor 选择一档。
+ *
+ *   assetc [options] <file|dir>...
+ *
+ * 输入路径相对资源根目录（-C），目录递归处理其中的 .png。
+ * 输出到 <out>/variants/<档位名>/<原相对路径>.pvr（alpha 为同名 .pvr@alpha），清单为 <out>/variants/variants.json。
+ */
+namespace {
+
+struct Options {
+    std::string root;
+    std::string outDir;
+    PvrFormat format;
+    bool mipmaps;
+    std::vector<AssetVariant> variants;
+    size_t jobs;
+    bool quiet;
+
+    Options() : root("."), format(PvrFormat::ETC1), mipmaps(true), jobs(0), quiet(false) {}
+};
+
+struct JobResult {
+    bool ok;
+    std::string error;
+    size_t sourceBytes;                  // 原图按 RGBA8888 解码后的显存
+    std::vector<size_t> variantBytes;    // 各档的纹理数据大小（不含文件头，含 alpha 纹理）
+    std::vector<int> variantLevels;
+    AssetVariantFile file;               // 清单条目：各档中图片本身的尺寸
+
+    JobResult() : ok(false), sourceBytes(0) {}
+};
+
+void printUsage()
+{
+    std::printf(
+        "usage: assetc [options] <file|dir>...\n"
+        "  -C, --root <dir>        resource root that inputs are relative to (default: .)\n"
+        "  -o, --out <dir>         output root (default: the resource root)\n"
+        "  -f, --format <fmt>      etc1 (default, separate alpha texture), rgba4444, rgba8888,\n"
+        "                          or rgb565 (opaque images only)\n"
+        "  --variant <name=scale>  add a scale variant (default: large, medium, small)\n"
+        "  --mipmaps <on|off>      full mipmap chains (default: on)\n"
+        "  -j, --jobs <n>          worker threads (default: hardware threads)\n"
+        "  -q, --quiet             only print problems and the summary\n");
+}
+
+int nextPowerOfTwo(int value)
+{
+    int result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+bool parseVariant(const std::string& text, AssetVariant& outVariant)
+{
+    size_t eq = text.find('=');
+    if (eq == std::string::npos || eq == 0) {
+        return false;
+    }
+    float scale = static_cast<float>(std::atof(text.c_str() + eq + 1));
+    if (scale <= 0.0f || scale >= 1.0f) {
+        return false;
+    }
+    std::string name = text.substr(0, eq);
+    outVariant = AssetVariant(name, scale, "variants/" + name);
+    return true;
+}
+
+void runJob(const std::string& file, const Options& options, JobResult& result)
+{
+    TextureImage source;
+    if (!source.loadPng(FileSystemUtils::joinPath(options.root, file), &result.error)) {
+        return;
+    }
+    result.sourceBytes = static_cast<size_t>(source.getWidth()) * source.getHeight() * 4;
+    result.file.path = file;
+
+    // 565 没有 alpha，带透明像素的图片改用 4444；ETC1 只给带透明像素的图片生成 alpha 纹理
+    bool opaque = source.isOpaque();
+    PvrFormat format = options.format;
+    if (format == PvrFormat::RGB565 && !opaque) {
+        format = PvrFormat::RGBA4444;
+    }
+
+    for (const auto& variant : options.variants) {
+        int width = std::max(1, static_cast<int>(std::lround(source.getWidth() * variant.scale)));
+        int height = std::max(1, static_cast<int>(std::lround(source.getHeight() * variant.scale)));
+        result.file.widths.push_back(width);
+        result.file.heights.push_back(height);
+
+        // 缩小后补齐到 2 次幂，mipmap 链一直到 1x1，GLES2 才能用 mipmap 过滤采样
+        std::vector<TextureImage> levels;
+        levels.push_back(source.resized(width, height).padded(nextPowerOfTwo(width), nextPowerOfTwo(height)));
+        while (options.mipmaps && (levels.back().getWidth() > 1 || levels.back().getHeight() > 1)) {
+            levels.push_back(levels.back().nextMipmap());
+        }
+
+        std::vector<uint8_t> data;
+        PvrWriter::encode(levels, format, data);
+        std::vector<uint8_t> alpha;
+        if (format == PvrFormat::ETC1 && !opaque) {
+            PvrWriter::encodeAlpha(levels, alpha);
+        }
+
+        std::string outPath = FileSystemUtils::joinPath(options.outDir, AssetVariants::variantPath(variant, file));
+        std::string alphaPath = FileSystemUtils::joinPath(options.outDir, AssetVariants::alphaPath(variant, file));
+        if (!FileSystemUtils::createDirectories(FileSystemUtils::parentPath(outPath))
+            || !FileSystemUtils::writeFile(outPath, data.data(), data.size())) {
+            result.error = "cannot write " + outPath;
+            return;
+        }
+        // 换用不带 alpha 纹理的格式重新生成时删除旧的 alpha 纹理，运行时不会误用
+        if (alpha.empty() ? (FileSystemUtils::fileExists(alphaPath) && std::remove(alphaPath.c_str()) != 0)
+                          : !FileSystemUtils::writeFile(alphaPath, alpha.data(), alpha.size())) {
+            result.error = "cannot write " + alphaPath;
+            return;
+        }
+        result.variantBytes.push_back(PvrWriter::dataSize(data) + PvrWriter::dataSize(alpha));
+        result.variantLevels.push_back(static_cast<int>(levels.size()));
+    }
+    result.ok = true;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    std::vector<std::string> inputs;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (arg == "--help" || arg == "-h") {
+            printUsage();
+            return 0;
+        }
+        else if (arg == "-q" || arg == "--quiet") options.quiet = true;
+        else if (arg[0] == '-') {
+            if (!value) {
+                printUsage();
+                return 1;
+            }
+            bool valid = true;
+            if (arg == "-C" || arg == "--root")        options.root = value;
+            else if (arg == "-o" || arg == "--out")    options.outDir = value;
+            else if (arg == "-f" || arg == "--format") valid = PvrWriter::parseFormat(value, options.format);
+            else if (arg == "-j" || arg == "--jobs")   options.jobs = static_cast<size_t>(std::atoi(value));
+            else if (arg == "--variant") {
+                AssetVariant variant;
+                valid = parseVariant(value, variant);
+                options.variants.push_back(variant);
+            }
+            else if (arg == "--mipmaps") {
+                std::string mode = value;
+                if (mode == "on")       options.mipmaps = true;
+                else if (mode == "off") options.mipmaps = false;
+                else valid = false;
+            }
+            else {
+                valid = false;
+            }
+            if (!valid) {
+                printUsage();
+                return 1;
+            }
+            i++;
+        }
+        else {
+            inputs.push_back(arg);
+        }
+    }
+    if (inputs.empty()) {
+        printUsage();
+        return 1;
+    }
+    if (options.outDir.empty()) {
+        options.outDir = options.root;
+    }
+    if (options.variants.empty()) {
+        AssetVariants::getDefaultVariants(options.variants);
+    }
+
+    // 展开目录，清单中的路径相对资源根目录
+    std::vector<std::string> files;
+    for (const auto& input : inputs) {
+        std::string path = FileSystemUtils::joinPath(options.root, input);
+        if (FileSystemUtils::isDirectory(path)) {
+            std::vector<std::string> listed;
+            if (!FileSystemUtils::listFiles(path, listed)) {
+                std::fprintf(stderr, "%s: cannot list directory\n", path.c_str());
+                return 1;
+            }
+            for (const auto& file : listed) {
+                if (FileSystemUtils::extension(file) == ".png") {
+                    files.push_back(FileSystemUtils::joinPath(input, file));
+                }
+            }
+        }
+        else {
+            files.push_back(input);
+        }
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+    std::vector<JobResult> results(files.size());
+    {
+        ThreadPool pool(options.jobs, 0);
+        for (size_t i = 0; i < files.size(); i++) {
+            pool.submit([&, i]() {
+                runJob(files[i], options, results[i]);
+            });
+        }
+        pool.waitIdle();
+    }
+
+    AssetVariantManifest manifest;
+    manifest.format = PvrWriter::formatName(options.format);
+    manifest.variants = options.variants;
+    int failed = 0;
+    size_t sourceBytes = 0;
+    std::vector<size_t> variantBytes(options.variants.size(), 0);
+    for (size_t i = 0; i < files.size(); i++) {
+        const JobResult& result = results[i];
+        if (!result.ok) {
+            std::fprintf(stderr, "%s: error: %s\n", files[i].c_str(), result.error.c_str());
+            failed++;
+            continue;
+        }
+        manifest.files.push_back(result.file);
+        sourceBytes += result.sourceBytes;
+        for (size_t v = 0; v < options.variants.size(); v++) {
+            variantBytes[v] += result.variantBytes[v];
+        }
+        if (!options.quiet) {
+            std::printf("%s (%d mip level(s))\n", files[i].c_str(), result.variantLevels.empty() ? 0 : result.variantLevels.back());
+        }
+    }
+
+    // 有失败时不写清单，避免运行时重定向到缺失的文件
+    if (failed == 0) {
+        std::string json = AssetVariants::toJson(manifest);
+        std::string manifestPath = FileSystemUtils::joinPath(options.outDir, AssetVariants::MANIFEST_FILE);
+        if (!FileSystemUtils::createDirectories(FileSystemUtils::parentPath(manifestPath))
+            || !FileSystemUtils::writeFile(manifestPath, json.data(), json.size())) {
+            std::fprintf(stderr, "assetc: cannot write %s\n", manifestPath.c_str());
+            failed++;
+        }
+    }
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    std::printf("%d texture(s), %d failed, %s, source %zu KB as rgba8888 in %.0f ms\n",
+        static_cast<int>(files.size()), failed, manifest.format.c_str(), sourceBytes / 1024, ms);
+    for (size_t v = 0; v < options.variants.size(); v++) {
+        std::printf("  %-8s x%.4f  %zu KB (%.1f%%)\n", options.variants[v].name.c_str(), options.variants[v].scale,
+            variantBytes[v] / 1024, sourceBytes > 0 ? variantBytes[v] * 100.0 / sourceBytes : 0.0);
+    }
+    return failed > 0 ? 1 : 0;
+}
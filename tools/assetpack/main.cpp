@@ -0,0 +1,169 @@
+#include "../common/FileSystemUtils.h"
+#include "utils/AssetBundle.h"
+#include <chrono>
+#include <cstdio>
+#include <set>
+#include <string>
+#include <vector>
+
+/**
+ * 资源打包工具
+ * 把资源目录下的文件打成一个 .cgpk 资源包（格式见 AssetBundle），游戏启动时由 BundleFileUtils 映射到内存读取。
+ *
+ *   assetpack [options] <file|dir>...
+ *   assetpack --verify <bundle>
+ *
+ * 输入路径相对资源根目录（-C），目录递归处理；包内路径即相对资源根目录的路径，与游戏中 FileUtils 使用的路径一致。
+ */
+namespace {
+
+const char* DEFAULT_BUNDLE_NAME = "assets.cgpk";
+
+struct Options {
+    std::string root;
+    std::string outPath;
+    std::string verifyPath;
+    std::set<std::string> excludes;     // 扩展名，含 '.'
+    bool quiet;
+
+    Options() : root("."), quiet(false) {}
+};
+
+void printUsage()
+{
+    std::printf(
+        "usage: assetpack [options] <file|dir>...\n"
+        "       assetpack --verify <bundle>\n"
+        "  -C, --root <dir>     resource root that inputs are relative to (default: .)\n"
+        "  -o, --out <file>     output bundle (default: <root>/%s)\n"
+        "  --exclude <ext>      skip files with this extension, e.g. .psd (repeatable)\n"
+        "  --verify <bundle>    check the index and content hashes of a bundle\n"
+        "  -q, --quiet          only print problems and the summary\n", DEFAULT_BUNDLE_NAME);
+}
+
+int verifyBundle(const Options& options)
+{
+    AssetBundle bundle;
+    std::string error;
+    if (!bundle.open(options.verifyPath, &error)) {
+        std::fprintf(stderr, "%s: error: %s\n", options.verifyPath.c_str(), error.c_str());
+        return 1;
+    }
+    int failed = 0;
+    size_t bytes = 0;
+    for (int i = 0; i < bundle.getEntryCount(); i++) {
+        bytes += bundle.getSize(i);
+        if (!bundle.verify(i)) {
+            std::fprintf(stderr, "%s: content hash mismatch\n", bundle.getName(i).c_str());
+            failed++;
+        }
+        else if (!options.quiet) {
+            std::printf("%016llx %8zu %s\n", static_cast<unsigned long long>(bundle.getHash(i)), bundle.getSize(i), bundle.getName(i).c_str());
+        }
+    }
+    std::printf("%d file(s), %d corrupt, %zu KB\n", bundle.getEntryCount(), failed, bytes / 1024);
+    return failed > 0 ? 1 : 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    std::vector<std::string> inputs;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (arg == "--help" || arg == "-h") {
+            printUsage();
+            return 0;
+        }
+        else if (arg == "-q" || arg == "--quiet") options.quiet = true;
+        else if (arg[0] == '-') {
+            if (!value) {
+                printUsage();
+                return 1;
+            }
+            if (arg == "-C" || arg == "--root")     options.root = value;
+            else if (arg == "-o" || arg == "--out") options.outPath = value;
+            else if (arg == "--exclude")            options.excludes.insert(FileSystemUtils::extension(std::string("x") + value));
+            else if (arg == "--verify")             options.verifyPath = value;
+            else {
+                printUsage();
+                return 1;
+            }
+            i++;
+        }
+        else {
+            inputs.push_back(arg);
+        }
+    }
+    if (!options.verifyPath.empty()) {
+        return verifyBundle(options);
+    }
+    if (inputs.empty()) {
+        printUsage();
+        return 1;
+    }
+    if (options.outPath.empty()) {
+        options.outPath = FileSystemUtils::joinPath(options.root, DEFAULT_BUNDLE_NAME);
+    }
+    // 旧的资源包不打进新包
+    options.excludes.insert(FileSystemUtils::extension(DEFAULT_BUNDLE_NAME));
+
+    std::vector<std::string> files;
+    for (const auto& input : inputs) {
+        std::string path = FileSystemUtils::joinPath(options.root, input);
+        if (FileSystemUtils::isDirectory(path)) {
+            std::vector<std::string> listed;
+            if (!FileSystemUtils::listFiles(path, listed)) {
+                std::fprintf(stderr, "%s: cannot list directory\n", path.c_str());
+                return 1;
+            }
+            for (const auto& file : listed) {
+                files.push_back(input == "." ? file : FileSystemUtils::joinPath(input, file));
+            }
+        }
+        else {
+            files.push_back(input);
+        }
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+    std::vector<std::string> names;
+    std::vector<std::string> contents;
+    size_t bytes = 0;
+    for (const auto& file : files) {
+        if (options.excludes.count(FileSystemUtils::extension(file))) {
+            continue;
+        }
+        std::string data;
+        if (!FileSystemUtils::readFile(FileSystemUtils::joinPath(options.root, file), data)) {
+            std::fprintf(stderr, "%s: error: cannot read\n", file.c_str());
+            return 1;
+        }
+        if (!options.quiet) {
+            std::printf("%8zu %s\n", data.size(), file.c_str());
+        }
+        bytes += data.size();
+        names.push_back(file);
+        contents.push_back(std::move(data));
+    }
+
+    std::vector<unsigned char> bundle;
+    std::string error;
+    if (!AssetBundle::build(names, contents, bundle, &error)) {
+        std::fprintf(stderr, "assetpack: %s\n", error.c_str());
+        return 1;
+    }
+    if (!FileSystemUtils::writeFile(options.outPath, bundle.data(), bundle.size())) {
+        std::fprintf(stderr, "assetpack: cannot write %s\n", options.outPath.c_str());
+        return 1;
+    }
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    std::printf("%d file(s), %zu KB of content, bundle %zu KB in %.0f ms -> %s\n",
+        static_cast<int>(names.size()), bytes / 1024, bundle.size() / 1024, ms, options.outPath.c_str());
+    return 0;
+}
@@ -0,0 +1,146 @@
+#include "../common/FileSystemUtils.h"
+#include "configs/LevelConfigLoader.h"
+#include "services/BatchSimulator.h"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+/**
+ * 批量对局模拟工具
+ * 用 BatchSimulator 锁步模拟同一关卡的大量对局，输出通关率、平均步数和吞吐量（每秒局数、每核每秒局数）。
+ *
+ *   batchsim [options] <level>
+ *
+ * --verify 用 BoardState 逐局重放前 n 局并与批量结果比对，确认向量化实现与游戏规则一致。
+ */
+namespace {
+
+struct Options {
+    uint64_t games;
+    uint64_t seed;
+    int threads;
+    uint64_t verify;
+
+    Options() : games(1000000), seed(1), threads(0), verify(0) {}
+};
+
+void printUsage()
+{
+    std::printf(
+        "usage: batchsim [options] <level>\n"
+        "  -n, --games <n>      games to simulate (default 1000000)\n"
+        "  -j, --threads <n>    worker threads (default: hardware threads)\n"
+        "  --seed <n>           random seed (default 1)\n"
+        "  --verify <n>         replay the first n games with BoardState and compare\n");
+}
+
+bool verifyGames(const std::shared_ptr<const BoardLayout>& layout, const Options& options)
+{
+    BatchSimulator simulator(layout);
+    BatchStats batch = simulator.run(options.verify, options.seed);
+
+    BatchStats reference;
+    for (uint64_t game = 0; game < options.verify; game++) {
+        BatchSimulator::GameResult result = BatchSimulator::playReference(layout, options.seed, game);
+        reference.games++;
+        reference.moves += result.moves;
+        if (result.won) {
+            reference.wins++;
+        }
+        else {
+            reference.remaining += result.remaining;
+        }
+    }
+
+    bool same = batch.games == reference.games && batch.wins == reference.wins
+        && batch.moves == reference.moves && batch.remaining == reference.remaining;
+    std::printf("verify %llu games: %s (wins %llu/%llu, moves %llu/%llu, left %llu/%llu)\n",
+        static_cast<unsigned long long>(options.verify), same ? "ok" : "MISMATCH",
+        static_cast<unsigned long long>(batch.wins), static_cast<unsigned long long>(reference.wins),
+        static_cast<unsigned long long>(batch.moves), static_cast<unsigned long long>(reference.moves),
+        static_cast<unsigned long long>(batch.remaining), static_cast<unsigned long long>(reference.remaining));
+    return same;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    std::string input;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (arg == "--help" || arg == "-h") {
+            printUsage();
+            return 0;
+        }
+        else if (arg[0] == '-') {
+            if (!value) {
+                printUsage();
+                return 1;
+            }
+            if (arg == "-n" || arg == "--games")        options.games = std::strtoull(value, nullptr, 10);
+            else if (arg == "-j" || arg == "--threads") options.threads = std::atoi(value);
+            else if (arg == "--seed")                   options.seed = std::strtoull(value, nullptr, 10);
+            else if (arg == "--verify")                 options.verify = std::strtoull(value, nullptr, 10);
+            else {
+                printUsage();
+                return 1;
+            }
+            i++;
+        }
+        else if (input.empty()) {
+            input = arg;
+        }
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+    if (input.empty()) {
+        printUsage();
+        return 1;
+    }
+
+    std::string data;
+    if (!FileSystemUtils::readFile(input, data)) {
+        std::fprintf(stderr, "%s: cannot read file\n", input.c_str());
+        return 1;
+    }
+    LevelConfig level;
+    std::string error;
+    if (!LevelConfigLoader::loadFromBuffer(data.data(), data.size(), level, &error)) {
+        std::fprintf(stderr, "%s: %s\n", input.c_str(), error.c_str());
+        return 1;
+    }
+    if (level.stack.empty()) {
+        std::fprintf(stderr, "%s: level has no stack cards\n", input.c_str());
+        return 1;
+    }
+    auto layout = BoardLayout::build(level);
+
+    if (options.verify > 0 && !verifyGames(layout, options)) {
+        return 1;
+    }
+
+    BatchStats stats = BatchSimulator::runParallel(layout, options.games, options.seed, options.threads);
+    double games = stats.games > 0 ? static_cast<double>(stats.games) : 1.0;
+    uint64_t lost = stats.games - stats.wins;
+    std::printf("%s: %llu games, win %.2f%%, avg moves %.2f, avg left when lost %.2f\n",
+        input.c_str(),
+        static_cast<unsigned long long>(stats.games),
+        stats.wins * 100.0 / games,
+        stats.moves / games,
+        lost > 0 ? static_cast<double>(stats.remaining) / lost : 0.0);
+    std::printf("%s x %d threads: %.3fs wall, %.3fs cpu, %.0f games/s, %.0f games/s per core (%llu lockstep steps)\n",
+        BatchSimulator::simdName(),
+        stats.threads,
+        stats.wallSeconds,
+        stats.cpuSeconds,
+        stats.getGamesPerSecond(),
+        stats.getGamesPerCoreSecond(),
+        static_cast<unsigned long long>(stats.steps));
+    return 0;
+}
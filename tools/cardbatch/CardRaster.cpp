@@ -0,0 +1,317 @@
+#include "CardRaster.h"
+#include "../assetc/TextureImage.h"
+#include "../common/FileSystemUtils.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+void setError(std::string* error, const std::string& msg)
+{
+    if (error) {
+        *error = msg;
+    }
+}
+
+bool loadImage(const std::string& resourceRoot, const std::string& file, Canvas& out, std::string* error)
+{
+    TextureImage image;
+    std::string path = FileSystemUtils::joinPath(resourceRoot, file);
+    std::string loadError;
+    if (!image.loadPng(path, &loadError)) {
+        setError(error, path + ": " + loadError);
+        return false;
+    }
+    out.reset(image.getWidth(), image.getHeight());
+    for (int y = 0; y < out.height; y++) {
+        // PNG 自上而下，画布自下而上
+        const float* src = image.pixel(0, out.height - 1 - y);
+        std::copy(src, src + static_cast<size_t>(out.width) * 4, out.pixel(0, y));
+    }
+    return true;
+}
+
+void maxSize(const std::vector<Canvas>& images, float& outWidth, float& outHeight)
+{
+    outWidth = 0.0f;
+    outHeight = 0.0f;
+    for (const auto& image : images) {
+        outWidth = std::max(outWidth, static_cast<float>(image.width));
+        outHeight = std::max(outHeight, static_cast<float>(image.height));
+    }
+}
+
+// 预乘 alpha 的 "over"：src 叠加在 dst 上
+void blendOver(float* dst, const float* src)
+{
+    float keep = 1.0f - src[3];
+    for (int c = 0; c < 4; c++) {
+        dst[c] = src[c] + dst[c] * keep;
+    }
+}
+
+// 像素中心落在 [low, high) 内的像素范围
+void coveredRange(float low, float high, int limit, int& outFirst, int& outLast)
+{
+    outFirst = std::max(0, static_cast<int>(std::ceil(low - 0.5f)));
+    outLast = std::min(limit - 1, static_cast<int>(std::ceil(high - 0.5f)) - 1);
+}
+
+void drawIntoCell(Canvas& atlas, const Canvas& image, const CardAtlasSection& section, int index)
+{
+    float x = 0.0f;
+    float y = 0.0f;
+    section.cellOrigin(index, x, y);
+    CardRaster::drawImage(atlas, image, x + section.cellWidth / 2, y + section.cellHeight / 2, 1.0f);
+}
+
+struct CellOrigin {
+    float x;
+    float y;
+};
+
+// 同 card_batch.vsh 的 cellOrigin，单位为像素
+CellOrigin cellOrigin(const CardAtlasSection& section, float index)
+{
+    float columns = static_cast<float>(section.columns);
+    float row = std::floor((index + 0.5f) / columns);
+    float column = index - row * columns;
+    CellOrigin origin = { section.x + column * section.cellWidth, section.y + row * section.cellHeight };
+    return origin;
+}
+
+// 同 card_batch.fsh 的 glyph：元素格子覆盖 local 时返回该处颜色，否则返回透明
+void glyph(const Canvas& atlas, const CardGlyphPlacement& place, const CellOrigin& origin,
+           const CardAtlasSection& section, float localX, float localY, float out[4])
+{
+    float tx = (localX - place.x) / (section.cellWidth * place.scale) + 0.5f;
+    float ty = (localY - place.y) / (section.cellHeight * place.scale) + 0.5f;
+    if (tx < 0.0f || ty < 0.0f || tx > 1.0f || ty > 1.0f) {
+        out[0] = out[1] = out[2] = out[3] = 0.0f;
+        return;
+    }
+    atlas.sample(origin.x + tx * section.cellWidth, origin.y + ty * section.cellHeight, out);
+}
+
+} // namespace
+
+void Canvas::reset(int w, int h)
+{
+    width = w;
+    height = h;
+    pixels.assign(static_cast<size_t>(w) * h * 4, 0.0f);
+}
+
+void Canvas::sample(float x, float y, float out[4]) const
+{
+    float fx = x - 0.5f;
+    float fy = y - 0.5f;
+    float x0f = std::floor(fx);
+    float y0f = std::floor(fy);
+    float wx = fx - x0f;
+    float wy = fy - y0f;
+    int x0 = std::min(std::max(static_cast<int>(x0f), 0), width - 1);
+    int y0 = std::min(std::max(static_cast<int>(y0f), 0), height - 1);
+    int x1 = std::min(std::max(static_cast<int>(x0f) + 1, 0), width - 1);
+    int y1 = std::min(std::max(static_cast<int>(y0f) + 1, 0), height - 1);
+    const float* p00 = pixel(x0, y0);
+    const float* p10 = pixel(x1, y0);
+    const float* p01 = pixel(x0, y1);
+    const float* p11 = pixel(x1, y1);
+    for (int c = 0; c < 4; c++) {
+        float bottom = p00[c] + (p10[c] - p00[c]) * wx;
+        float top = p01[c] + (p11[c] - p01[c]) * wx;
+        out[c] = bottom + (top - bottom) * wy;
+    }
+}
+
+void Canvas::quantize()
+{
+    for (auto& value : pixels) {
+        value = std::round(std::min(std::max(value, 0.0f), 1.0f) * 255.0f) / 255.0f;
+    }
+}
+
+void Canvas::toRgba8888(std::vector<unsigned char>& out) const
+{
+    out.resize(pixels.size());
+    for (size_t i = 0; i < pixels.size(); i++) {
+        out[i] = static_cast<unsigned char>(std::round(std::min(std::max(pixels[i], 0.0f), 1.0f) * 255.0f));
+    }
+}
+
+void Canvas::fromRgba8888(int w, int h, const unsigned char* data)
+{
+    reset(w, h);
+    for (size_t i = 0; i < pixels.size(); i++) {
+        pixels[i] = data[i] / 255.0f;
+    }
+}
+
+bool CardImages::load(const std::string& resourceRoot, std::string* error)
+{
+    smallNumbers.assign(CardAtlasLayout::NUMBER_COUNT, Canvas());
+    bigNumbers.assign(CardAtlasLayout::NUMBER_COUNT, Canvas());
+    suits.assign(CardAtlasLayout::SUIT_COUNT, Canvas());
+    if (!loadImage(resourceRoot, CardGlyphs::backFile(), back, error)) {
+        return false;
+    }
+    for (int color = 0; color < 2; color++) {
+        int suit = color == 0 ? 0 : 1;   // 梅花为黑色，方块为红色
+        for (int face = 0; face < 13; face++) {
+            int index = CardAtlasLayout::numberIndex(face, suit);
+            if (!loadImage(resourceRoot, CardGlyphs::numberFile(false, face, suit), smallNumbers[index], error)
+                || !loadImage(resourceRoot, CardGlyphs::numberFile(true, face, suit), bigNumbers[index], error)) {
+                return false;
+            }
+        }
+    }
+    for (int suit = 0; suit < CardAtlasLayout::SUIT_COUNT; suit++) {
+        if (!loadImage(resourceRoot, CardGlyphs::suitFile(suit), suits[suit], error)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CardImages::computeLayout(CardAtlasLayout& outLayout) const
+{
+    float smallWidth, smallHeight, bigWidth, bigHeight, suitWidth, suitHeight;
+    maxSize(smallNumbers, smallWidth, smallHeight);
+    maxSize(bigNumbers, bigWidth, bigHeight);
+    maxSize(suits, suitWidth, suitHeight);
+    return outLayout.compute(static_cast<float>(back.width), static_cast<float>(back.height),
+                             smallWidth, smallHeight, bigWidth, bigHeight, suitWidth, suitHeight,
+                             CardAtlasLayout::MAX_WIDTH, CardAtlasLayout::PADDING);
+}
+
+namespace CardRaster {
+
+void drawImage(Canvas& canvas, const Canvas& image, float centerX, float centerY, float scale)
+{
+    float width = image.width * scale;
+    float height = image.height * scale;
+    float left = centerX - width / 2;
+    float bottom = centerY - height / 2;
+    int firstX, lastX, firstY, lastY;
+    coveredRange(left, left + width, canvas.width, firstX, lastX);
+    coveredRange(bottom, bottom + height, canvas.height, firstY, lastY);
+
+    float color[4];
+    for (int y = firstY; y <= lastY; y++) {
+        for (int x = firstX; x <= lastX; x++) {
+            image.sample((x + 0.5f - left) / scale, (y + 0.5f - bottom) / scale, color);
+            blendOver(canvas.pixel(x, y), color);
+        }
+    }
+}
+
+void composeAtlas(const CardImages& images, const CardAtlasLayout& layout, Canvas& outAtlas)
+{
+    outAtlas.reset(static_cast<int>(layout.width), static_cast<int>(layout.height));
+    drawIntoCell(outAtlas, images.back, layout.back, 0);
+    for (int i = 0; i < CardAtlasLayout::NUMBER_COUNT; i++) {
+        drawIntoCell(outAtlas, images.smallNumbers[i], layout.smallNumber, i);
+        drawIntoCell(outAtlas, images.bigNumbers[i], layout.bigNumber, i);
+    }
+    for (int i = 0; i < CardAtlasLayout::SUIT_COUNT; i++) {
+        drawIntoCell(outAtlas, images.suits[i], layout.suit, i);
+    }
+    outAtlas.quantize();
+}
+
+void drawCardView(Canvas& canvas, const CardImages& images, float x, float y, int face, int suit)
+{
+    float cardWidth = static_cast<float>(images.back.width);
+    float cardHeight = static_cast<float>(images.back.height);
+    float left = x - cardWidth / 2;
+    float bottom = y - cardHeight / 2;
+    int number = CardAtlasLayout::numberIndex(face, suit);
+    CardGlyphPlacement smallPlace = CardGlyphs::smallNumber(cardWidth, cardHeight);
+    CardGlyphPlacement suitPlace = CardGlyphs::suit(cardWidth, cardHeight);
+    CardGlyphPlacement bigPlace = CardGlyphs::bigNumber(cardWidth, cardHeight);
+
+    // 子精灵按添加顺序绘制：左上数字、右上花色、中间大数字
+    drawImage(canvas, images.back, x, y, 1.0f);
+    drawImage(canvas, images.smallNumbers[number], left + smallPlace.x, bottom + smallPlace.y, smallPlace.scale);
+    drawImage(canvas, images.suits[suit], left + suitPlace.x, bottom + suitPlace.y, suitPlace.scale);
+    drawImage(canvas, images.bigNumbers[number], left + bigPlace.x, bottom + bigPlace.y, bigPlace.scale);
+}
+
+void drawBatch(Canvas& canvas, const Canvas& atlas, const CardAtlasLayout& layout,
+               float cardWidth, float cardHeight, const std::vector<CardVertex>& vertices)
+{
+    CardGlyphPlacement smallPlace = CardGlyphs::smallNumber(cardWidth, cardHeight);
+    CardGlyphPlacement suitPlace = CardGlyphs::suit(cardWidth, cardHeight);
+    CardGlyphPlacement bigPlace = CardGlyphs::bigNumber(cardWidth, cardHeight);
+    float backX = layout.back.x + (layout.back.cellWidth - cardWidth) * 0.5f;
+    float backY = layout.back.y + (layout.back.cellHeight - cardHeight) * 0.5f;
+
+    for (size_t i = 0; i + 3 < vertices.size(); i += 4) {
+        // 四边形轴对齐：0 为左下，3 为右上
+        const CardVertex& lb = vertices[i];
+        const CardVertex& rt = vertices[i + 3];
+        float suit = lb.suit;
+        float number = ((suit > 0.5f && suit < 2.5f) ? 13.0f : 0.0f) + lb.face;
+        CellOrigin smallCell = cellOrigin(layout.smallNumber, number);
+        CellOrigin suitCell = cellOrigin(layout.suit, suit);
+        CellOrigin bigCell = cellOrigin(layout.bigNumber, number);
+
+        int firstX, lastX, firstY, lastY;
+        coveredRange(lb.x, rt.x, canvas.width, firstX, lastX);
+        coveredRange(lb.y, rt.y, canvas.height, firstY, lastY);
+        float color[4];
+        float layer[4];
+        for (int y = firstY; y <= lastY; y++) {
+            for (int x = firstX; x <= lastX; x++) {
+                // 纹理坐标在四边形内线性插值，乘以卡牌尺寸得到卡牌内坐标
+                float u = lb.u + (rt.u - lb.u) * (x + 0.5f - lb.x) / (rt.x - lb.x);
+                float v = lb.v + (rt.v - lb.v) * (y + 0.5f - lb.y) / (rt.y - lb.y);
+                float localX = u * cardWidth;
+                float localY = v * cardHeight;
+
+                atlas.sample(backX + localX, backY + localY, color);
+                glyph(atlas, smallPlace, smallCell, layout.smallNumber, localX, localY, layer);
+                blendOver(color, layer);
+                glyph(atlas, suitPlace, suitCell, layout.suit, localX, localY, layer);
+                blendOver(color, layer);
+                glyph(atlas, bigPlace, bigCell, layout.bigNumber, localX, localY, layer);
+                blendOver(color, layer);
+                blendOver(canvas.pixel(x, y), color);
+            }
+        }
+    }
+}
+
+CanvasDiff compare(const Canvas& a, const Canvas& b, float threshold)
+{
+    CanvasDiff diff;
+    if (a.width != b.width || a.height != b.height) {
+        diff.maxError = 1.0f;
+        diff.meanError = 1.0f;
+        return diff;
+    }
+    size_t count = static_cast<size_t>(a.width) * a.height;
+    double total = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        const float* pa = &a.pixels[i * 4];
+        const float* pb = &b.pixels[i * 4];
+        if (pa[3] <= 0.0f && pb[3] <= 0.0f) {
+            continue;
+        }
+        float error = 0.0f;
+        for (int c = 0; c < 4; c++) {
+            error = std::max(error, std::fabs(pa[c] - pb[c]));
+        }
+        diff.pixels++;
+        diff.maxError = std::max(diff.maxError, error);
+        total += error;
+        if (error > threshold) {
+            diff.overThreshold++;
+        }
+    }
+    diff.meanError = diff.pixels > 0 ? static_cast<float>(total / diff.pixels) : 0.0f;
+    return diff;
+}
+
+} // namespace CardRaster
@@ -0,0 +1,86 @@
+#ifndef __CARD_RASTER_H__
+#define __CARD_RASTER_H__
+
+#include "views/CardBatchBuilder.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * 预乘 alpha 的 RGBA 浮点画布（0~1）
+ * 原点在左下角、自下而上逐行，与 GL 帧缓冲、glTexImage2D 的行序一致
+ */
+struct Canvas {
+    int width;
+    int height;
+    std::vector<float> pixels;
+
+    Canvas() : width(0), height(0) {}
+
+    // 清为全透明
+    void reset(int w, int h);
+
+    float* pixel(int x, int y) { return &pixels[(static_cast<size_t>(y) * width + x) * 4]; }
+    const float* pixel(int x, int y) const { return &pixels[(static_cast<size_t>(y) * width + x) * 4]; }
+
+    // 双线性采样，坐标单位为像素（像素中心在 +0.5），越界取边缘像素（同 GL_CLAMP_TO_EDGE）
+    void sample(float x, float y, float out[4]) const;
+
+    // 量化到 8 位（同 RGBA8888 纹理）
+    void quantize();
+
+    // 转为 RGBA8888，行序不变
+    void toRgba8888(std::vector<unsigned char>& out) const;
+    void fromRgba8888(int w, int h, const unsigned char* data);
+};
+
+/**
+ * 卡牌用到的全部图片，顺序与图集格子一致：数字为黑 A~K、红 A~K，花色为梅花、方块、红桃、黑桃
+ */
+struct CardImages {
+    Canvas back;
+    std::vector<Canvas> smallNumbers;
+    std::vector<Canvas> bigNumbers;
+    std::vector<Canvas> suits;
+
+    // resourceRoot 为 Resources 目录，文件名见 CardGlyphs
+    bool load(const std::string& resourceRoot, std::string* error = nullptr);
+
+    // 与 CardAtlas::init 相同：各类图片取最大尺寸排布
+    bool computeLayout(CardAtlasLayout& outLayout) const;
+};
+
+/**
+ * 两张画布的逐像素差异（取 RGBA 中误差最大的通道），只统计任一画布不透明度大于 0 的像素
+ */
+struct CanvasDiff {
+    float maxError;
+    float meanError;
+    size_t overThreshold;    // 误差超过阈值的像素数
+    size_t pixels;           // 参与统计的像素数
+
+    CanvasDiff() : maxError(0.0f), meanError(0.0f), overThreshold(0), pixels(0) {}
+};
+
+/**
+ * 卡牌的 CPU 光栅化（1 点 = 1 像素）
+ * 逐张精灵的绘制与批量着色器分别实现，二者的结果应当一致。
+ */
+namespace CardRaster {
+    // 同 cocos 精灵：像素中心落在四边形内的像素双线性采样图片，按预乘 alpha 叠加
+    void drawImage(Canvas& canvas, const Canvas& image, float centerX, float centerY, float scale);
+
+    // 按 CardAtlas::init 把图片画在各自格子的中央（透明底），结果量化为 8 位
+    void composeAtlas(const CardImages& images, const CardAtlasLayout& layout, Canvas& outAtlas);
+
+    // 逐张精灵绘制一张牌：牌背加 CardView::setupCardTexture 的三个子精灵，(x, y) 为卡牌中心
+    void drawCardView(Canvas& canvas, const CardImages& images, float x, float y, int face, int suit);
+
+    // card_batch.vsh/.fsh 的 CPU 版：逐张绘制顶点流中的四边形
+    void drawBatch(Canvas& canvas, const Canvas& atlas, const CardAtlasLayout& layout,
+                   float cardWidth, float cardHeight, const std::vector<CardVertex>& vertices);
+
+    CanvasDiff compare(const Canvas& a, const Canvas& b, float threshold);
+}
+
+#endif // __CARD_RASTER_H__
@@ -0,0 +1,255 @@
+#include "GlCardRenderer.h"
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <GLES2/gl2.h>
+#include <cstddef>
+
+namespace {
+
+// 与 GLProgram::VERTEX_ATTRIB_* 相同的属性位置
+const GLuint ATTRIB_POSITION = 0;
+const GLuint ATTRIB_TEX_COORD = 2;
+const GLuint ATTRIB_TEX_COORD1 = 3;
+
+// cocos 在移动端编译着色器时加在源码前的默认精度和内置 uniform（只保留卡牌着色器用到的）
+const char* VERTEX_HEADER =
+    "precision highp float;\n"
+    "precision highp int;\n"
+    "uniform mat4 CC_MVPMatrix;\n"
+    "uniform sampler2D CC_Texture0;\n"
+    "#line 1\n";
+const char* FRAGMENT_HEADER =
+    "precision mediump float;\n"
+    "precision mediump int;\n"
+    "uniform mat4 CC_MVPMatrix;\n"
+    "uniform sampler2D CC_Texture0;\n"
+    "#line 1\n";
+
+void setError(std::string* error, const std::string& msg)
+{
+    if (error) {
+        *error = msg;
+    }
+}
+
+GLuint compileShader(GLenum type, const char* header, const std::string& source, std::string* error)
+{
+    GLuint shader = glCreateShader(type);
+    const char* sources[] = { header, source.c_str() };
+    glShaderSource(shader, 2, sources, nullptr);
+    glCompileShader(shader);
+    GLint status = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+    if (status != GL_TRUE) {
+        char log[1024] = {};
+        glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+        setError(error, std::string(type == GL_VERTEX_SHADER ? "vertex" : "fragment") + " shader: " + log);
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+EGLDisplay openDisplay()
+{
+    // 优先用不需要窗口系统的 surfaceless 平台
+    auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (getPlatformDisplay) {
+        EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+        if (display != EGL_NO_DISPLAY) {
+            return display;
+        }
+    }
+    return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+} // namespace
+
+GlCardRenderer::GlCardRenderer()
+    : _display(EGL_NO_DISPLAY)
+    , _context(EGL_NO_CONTEXT)
+    , _program(0)
+    , _texture(0)
+{
+    _buffers[0] = 0;
+    _buffers[1] = 0;
+}
+
+GlCardRenderer::~GlCardRenderer()
+{
+    if (_context != EGL_NO_CONTEXT) {
+        glDeleteBuffers(2, _buffers);
+        glDeleteTextures(1, &_texture);
+        glDeleteProgram(_program);
+        eglMakeCurrent(_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        eglDestroyContext(_display, _context);
+    }
+    if (_display != EGL_NO_DISPLAY) {
+        eglTerminate(_display);
+    }
+}
+
+bool GlCardRenderer::init(const std::string& vertexSource, const std::string& fragmentSource, std::string* error)
+{
+    EGLDisplay display = openDisplay();
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr)) {
+        setError(error, "cannot initialize EGL");
+        return false;
+    }
+    _display = display;
+    eglBindAPI(EGL_OPENGL_ES_API);
+
+    // 只画离屏帧缓冲，不需要 EGLSurface；没有 configless 扩展时退回任一 GLES2 配置
+    EGLConfig config = EGL_NO_CONFIG_KHR;
+    const char* extensions = eglQueryString(display, EGL_EXTENSIONS);
+    if (!extensions || std::string(extensions).find("EGL_KHR_no_config_context") == std::string::npos) {
+        const EGLint configAttribs[] = { EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT, EGL_NONE };
+        EGLint count = 0;
+        if (!eglChooseConfig(display, configAttribs, &config, 1, &count) || count == 0) {
+            setError(error, "no GLES2 config");
+            return false;
+        }
+    }
+    const EGLint contextAttribs[] = { EGL_CONTEXT_CLIENT_VERSION, 2, EGL_NONE };
+    EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttribs);
+    if (context == EGL_NO_CONTEXT) {
+        setError(error, "cannot create GLES2 context");
+        return false;
+    }
+    _context = context;
+    if (!eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context)) {
+        setError(error, "cannot make the context current (EGL_KHR_surfaceless_context)");
+        return false;
+    }
+
+    GLuint vertexShader = compileShader(GL_VERTEX_SHADER, VERTEX_HEADER, vertexSource, error);
+    if (!vertexShader) {
+        return false;
+    }
+    GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, FRAGMENT_HEADER, fragmentSource, error);
+    if (!fragmentShader) {
+        glDeleteShader(vertexShader);
+        return false;
+    }
+    _program = glCreateProgram();
+    glAttachShader(_program, vertexShader);
+    glAttachShader(_program, fragmentShader);
+    glBindAttribLocation(_program, ATTRIB_POSITION, "a_position");
+    glBindAttribLocation(_program, ATTRIB_TEX_COORD, "a_texCoord");
+    glBindAttribLocation(_program, ATTRIB_TEX_COORD1, "a_texCoord1");
+    glLinkProgram(_program);
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+    GLint status = GL_FALSE;
+    glGetProgramiv(_program, GL_LINK_STATUS, &status);
+    if (status != GL_TRUE) {
+        char log[1024] = {};
+        glGetProgramInfoLog(_program, sizeof(log), nullptr, log);
+        setError(error, std::string("link: ") + log);
+        return false;
+    }
+
+    glGenTextures(1, &_texture);
+    glGenBuffers(2, _buffers);
+    return true;
+}
+
+std::string GlCardRenderer::getRenderer() const
+{
+    const GLubyte* renderer = glGetString(GL_RENDERER);
+    return renderer ? reinterpret_cast<const char*>(renderer) : "unknown";
+}
+
+void GlCardRenderer::setAtlas(const Canvas& atlas, const CardAtlasLayout& layout, float cardWidth, float cardHeight)
+{
+    // 非 2 次幂纹理在 GLES2 下只能用 CLAMP_TO_EDGE、不带 mipmap，与 CardAtlas 的 RenderTexture 相同
+    std::vector<unsigned char> pixels;
+    atlas.toRgba8888(pixels);
+    glBindTexture(GL_TEXTURE_2D, _texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, atlas.width, atlas.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    // 同 CardBatchNode::setupProgram
+    CardGlyphPlacement smallPlace = CardGlyphs::smallNumber(cardWidth, cardHeight);
+    CardGlyphPlacement suitPlace = CardGlyphs::suit(cardWidth, cardHeight);
+    CardGlyphPlacement bigPlace = CardGlyphs::bigNumber(cardWidth, cardHeight);
+    glUseProgram(_program);
+    glUniform2f(glGetUniformLocation(_program, "u_cardSize"), cardWidth, cardHeight);
+    glUniform2f(glGetUniformLocation(_program, "u_atlasSize"), static_cast<float>(atlas.width), static_cast<float>(atlas.height));
+    glUniform4f(glGetUniformLocation(_program, "u_back"), layout.back.x, layout.back.y, layout.back.cellWidth, layout.back.cellHeight);
+    glUniform4f(glGetUniformLocation(_program, "u_smallNumber"), layout.smallNumber.x, layout.smallNumber.y, layout.smallNumber.cellWidth, layout.smallNumber.cellHeight);
+    glUniform4f(glGetUniformLocation(_program, "u_bigNumber"), layout.bigNumber.x, layout.bigNumber.y, layout.bigNumber.cellWidth, layout.bigNumber.cellHeight);
+    glUniform4f(glGetUniformLocation(_program, "u_suit"), layout.suit.x, layout.suit.y, layout.suit.cellWidth, layout.suit.cellHeight);
+    glUniform3f(glGetUniformLocation(_program, "u_columns"), static_cast<float>(layout.smallNumber.columns),
+        static_cast<float>(layout.bigNumber.columns), static_cast<float>(layout.suit.columns));
+    glUniform3f(glGetUniformLocation(_program, "u_smallPlace"), smallPlace.x, smallPlace.y, smallPlace.scale);
+    glUniform3f(glGetUniformLocation(_program, "u_suitPlace"), suitPlace.x, suitPlace.y, suitPlace.scale);
+    glUniform3f(glGetUniformLocation(_program, "u_bigPlace"), bigPlace.x, bigPlace.y, bigPlace.scale);
+    glUniform1i(glGetUniformLocation(_program, "CC_Texture0"), 0);
+}
+
+bool GlCardRenderer::render(int width, int height, const std::vector<CardVertex>& vertices, const std::vector<uint16_t>& indices,
+                            Canvas& out, std::string* error)
+{
+    GLuint target = 0;
+    GLuint framebuffer = 0;
+    glGenTextures(1, &target);
+    glBindTexture(GL_TEXTURE_2D, target);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, target, 0);
+    bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+
+    if (complete) {
+        glViewport(0, 0, width, height);
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        // 正交投影：(0, 0)~(width, height) 映射到整个视口（列主序）
+        const GLfloat mvp[16] = {
+            2.0f / width, 0.0f, 0.0f, 0.0f,
+            0.0f, 2.0f / height, 0.0f, 0.0f,
+            0.0f, 0.0f, -1.0f, 0.0f,
+            -1.0f, -1.0f, 0.0f, 1.0f,
+        };
+        glUseProgram(_program);
+        glUniformMatrix4fv(glGetUniformLocation(_program, "CC_MVPMatrix"), 1, GL_FALSE, mvp);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, _texture);
+
+        // 与 CardBatchNode::draw 相同：预乘 alpha 混合，顶点和索引放在缓冲区里
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+        glBindBuffer(GL_ARRAY_BUFFER, _buffers[0]);
+        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(CardVertex), vertices.data(), GL_STREAM_DRAW);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffers[1]);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint16_t), indices.data(), GL_STREAM_DRAW);
+        glEnableVertexAttribArray(ATTRIB_POSITION);
+        glEnableVertexAttribArray(ATTRIB_TEX_COORD);
+        glEnableVertexAttribArray(ATTRIB_TEX_COORD1);
+        glVertexAttribPointer(ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(CardVertex), reinterpret_cast<GLvoid*>(offsetof(CardVertex, x)));
+        glVertexAttribPointer(ATTRIB_TEX_COORD, 2, GL_FLOAT, GL_FALSE, sizeof(CardVertex), reinterpret_cast<GLvoid*>(offsetof(CardVertex, u)));
+        glVertexAttribPointer(ATTRIB_TEX_COORD1, 2, GL_FLOAT, GL_FALSE, sizeof(CardVertex), reinterpret_cast<GLvoid*>(offsetof(CardVertex, face)));
+        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_SHORT, nullptr);
+
+        std::vector<unsigned char> pixels(static_cast<size_t>(width) * height * 4);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+        out.fromRgba8888(width, height, pixels.data());
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &framebuffer);
+    glDeleteTextures(1, &target);
+    GLenum glError = glGetError();
+    if (!complete || glError != GL_NO_ERROR) {
+        setError(error, complete ? "GL error " + std::to_string(glError) : "framebuffer incomplete");
+        return false;
+    }
+    return true;
+}
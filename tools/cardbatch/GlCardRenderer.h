@@ -0,0 +1,44 @@
+#ifndef __GL_CARD_RENDERER_H__
+#define __GL_CARD_RENDERER_H__
+
+#include "CardRaster.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * 无窗口的 GLES2 卡牌渲染（EGL，不需要 X / GPU）
+ *
+ * 用游戏中的 card_batch.vsh/.fsh，按 CardBatchNode::setupProgram 设置 uniform，
+ * 画进离屏帧缓冲后读回。设置 LIBGL_ALWAYS_SOFTWARE=1 时 Mesa 使用 llvmpipe。
+ */
+class GlCardRenderer {
+public:
+    GlCardRenderer();
+    ~GlCardRenderer();
+
+    // 创建上下文并编译着色器（源码为 Resources/shaders 下的文件内容）
+    bool init(const std::string& vertexSource, const std::string& fragmentSource, std::string* error = nullptr);
+
+    // GL_RENDERER，如 "llvmpipe (LLVM 15.0.6, 256 bits)"
+    std::string getRenderer() const;
+
+    // 上传图集（尺寸与布局一致）并设置 uniform
+    void setAtlas(const Canvas& atlas, const CardAtlasLayout& layout, float cardWidth, float cardHeight);
+
+    // 以 1 点 = 1 像素绘制顶点流，读回到 out
+    bool render(int width, int height, const std::vector<CardVertex>& vertices, const std::vector<uint16_t>& indices,
+                Canvas& out, std::string* error = nullptr);
+
+private:
+    GlCardRenderer(const GlCardRenderer&) = delete;
+    GlCardRenderer& operator=(const GlCardRenderer&) = delete;
+
+    void* _display;
+    void* _context;
+    unsigned int _program;
+    unsigned int _texture;
+    unsigned int _buffers[2];
+};
+
+#endif // __GL_CARD_RENDERER_H__
@@ -0,0 +1,384 @@
+#include "../common/FileSystemUtils.h"
+#include "CardRaster.h"
+#include "GlCardRenderer.h"
+#include "configs/LevelConfigLoader.h"
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * 批量卡牌绘制自检
+ * 不依赖 cocos2d，在没有 GPU 的机器（CI）上检查 CardBatchBuilder 和 card_batch 着色器与逐张精灵的 CardView 一致：
+ *
+ *   cardbatch [options] <level>
+ *
+ * 1. 图集布局：格子都在图集内、互不重叠，每张图片四周留出 PADDING；
+ * 2. 顶点流：关卡开局的每张牌（及倒序添加、层级相同时）四边形与 CardView 的位置、尺寸一致，按层级稳定排序；
+ * 3. 像素：CPU 版着色器画出的 52 张牌和关卡开局画面与逐张精灵（牌背 + CardView 的三个子精灵）比较；
+ * 4. --gl：用 EGL 创建无窗口的 GLES2 上下文，编译游戏中的着色器，按 CardBatchNode 设置 uniform 画同样的画面，
+ *    与 CPU 版着色器逐像素比较。LIBGL_ALWAYS_SOFTWARE=1 时使用 Mesa llvmpipe。
+ *
+ * 全部一致时输出 "verify: ok"，否则输出 MISMATCH 并返回 1。
+ */
+namespace {
+
+// CPU 着色器与逐张精灵比较：图片在格子里居中时可能落在半个像素上，两条路径各自做一次线性采样，图片边缘略有不同。
+// 实测约 0.03% 的卡牌像素超过 0.25；元素错位 1 点或缩放差 5% 时超过 0.2%
+const float SPRITE_ERROR = 0.25f;
+const float SPRITE_OVER_RATIO = 0.001f;
+
+// GL 与 CPU 着色器比较：算法相同，只差 8 位量化和光栅器的插值精度
+const float GL_ERROR = 3.0f / 255.0f;
+const float GL_OVER_RATIO = 0.0005f;
+
+// 层级同 ViewReconciler 的分区：主牌区、备用牌堆、底牌堆
+const float PLAYFIELD_Z = 1000.0f;
+const float TRAY_Z = 3000.0f;
+const float STACK_Z = 5000.0f;
+
+struct Options {
+    std::string resources;
+    bool gl;
+
+    Options() : resources("Resources"), gl(false) {}
+};
+
+struct SceneCard {
+    float x;
+    float y;
+    float z;
+    int face;
+    int suit;
+};
+
+void printUsage()
+{
+    std::printf(
+        "usage: cardbatch [options] <level>\n"
+        "  -r, --resources <dir>  Resources directory (default Resources)\n"
+        "  --gl                   also render with the GLES2 shaders through EGL and compare\n"
+        "                         (set LIBGL_ALWAYS_SOFTWARE=1 to force Mesa llvmpipe)\n");
+}
+
+// 关卡开局画面：主牌区坐标加堆牌区高度，备用牌叠放在 TRAY_POS（只检查层级），底牌堆顶牌在 STACK_POS
+void collectLevelCards(const LevelConfig& level, std::vector<SceneCard>& outCards)
+{
+    outCards.clear();
+    for (size_t i = 0; i < level.playfield.size(); i++) {
+        const LevelCardConfig& card = level.playfield[i];
+        outCards.push_back({ card.x, card.y + LevelLayout::STACK_AREA_HEIGHT, PLAYFIELD_Z + i, card.face, card.suit });
+    }
+    for (size_t i = 0; i + 1 < level.stack.size(); i++) {
+        const LevelCardConfig& card = level.stack[i];
+        outCards.push_back({ LevelLayout::TRAY_POS_X, LevelLayout::TRAY_POS_Y, TRAY_Z + i, card.face, card.suit });
+    }
+    if (!level.stack.empty()) {
+        const LevelCardConfig& card = level.stack.back();
+        outCards.push_back({ LevelLayout::STACK_POS_X, LevelLayout::STACK_POS_Y, STACK_Z, card.face, card.suit });
+    }
+}
+
+// 52 张牌排成 13 列 x 4 行，互不重叠
+void collectAllCards(float cardWidth, float cardHeight, std::vector<SceneCard>& outCards)
+{
+    outCards.clear();
+    for (int suit = 0; suit < LevelLayout::SUIT_COUNT; suit++) {
+        for (int face = 0; face < LevelLayout::FACE_COUNT; face++) {
+            outCards.push_back({ (face + 0.5f) * cardWidth, (suit + 0.5f) * cardHeight, 0.0f, face, suit });
+        }
+    }
+}
+
+struct CellRect {
+    const char* section;
+    int index;
+    float left;
+    float bottom;
+    float right;
+    float top;
+};
+
+void collectCells(const CardAtlasSection& section, const char* name, std::vector<CellRect>& outCells)
+{
+    for (int i = 0; i < section.count; i++) {
+        float x = 0.0f;
+        float y = 0.0f;
+        section.cellOrigin(i, x, y);
+        outCells.push_back({ name, i, x, y, x + section.cellWidth, y + section.cellHeight });
+    }
+}
+
+bool fitsCell(const std::vector<Canvas>& images, const CardAtlasSection& section, const char* name)
+{
+    for (size_t i = 0; i < images.size(); i++) {
+        if (images[i].width + CardAtlasLayout::PADDING * 2 > section.cellWidth
+            || images[i].height + CardAtlasLayout::PADDING * 2 > section.cellHeight) {
+            std::printf("atlas: %s %zu (%dx%d) does not fit its cell (%.0fx%.0f) with padding\n",
+                name, i, images[i].width, images[i].height, section.cellWidth, section.cellHeight);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool checkLayout(const CardImages& images, const CardAtlasLayout& layout)
+{
+    bool ok = layout.width <= CardAtlasLayout::MAX_WIDTH
+        && layout.back.count == 1
+        && layout.smallNumber.count == CardAtlasLayout::NUMBER_COUNT
+        && layout.bigNumber.count == CardAtlasLayout::NUMBER_COUNT
+        && layout.suit.count == CardAtlasLayout::SUIT_COUNT;
+
+    std::vector<CellRect> cells;
+    collectCells(layout.back, "back", cells);
+    collectCells(layout.smallNumber, "small", cells);
+    collectCells(layout.bigNumber, "big", cells);
+    collectCells(layout.suit, "suit", cells);
+    for (size_t i = 0; i < cells.size() && ok; i++) {
+        const CellRect& a = cells[i];
+        if (a.left < 0.0f || a.bottom < 0.0f || a.right > layout.width || a.top > layout.height) {
+            std::printf("atlas: %s %d lies outside the atlas\n", a.section, a.index);
+            ok = false;
+        }
+        for (size_t j = i + 1; j < cells.size() && ok; j++) {
+            const CellRect& b = cells[j];
+            if (a.left < b.right && b.left < a.right && a.bottom < b.top && b.bottom < a.top) {
+                std::printf("atlas: %s %d overlaps %s %d\n", a.section, a.index, b.section, b.index);
+                ok = false;
+            }
+        }
+    }
+    ok = ok && fitsCell(std::vector<Canvas>(1, images.back), layout.back, "back")
+        && fitsCell(images.smallNumbers, layout.smallNumber, "small")
+        && fitsCell(images.bigNumbers, layout.bigNumber, "big")
+        && fitsCell(images.suits, layout.suit, "suit");
+
+    std::printf("atlas %.0fx%.0f, %zu cells (small %d, big %d, suit %d columns): %s\n",
+        layout.width, layout.height, cells.size(),
+        layout.smallNumber.columns, layout.bigNumber.columns, layout.suit.columns, ok ? "ok" : "MISMATCH");
+    return ok;
+}
+
+void buildVertices(const std::vector<SceneCard>& cards, float cardWidth, float cardHeight, CardBatchBuilder& builder)
+{
+    builder.clear();
+    for (const auto& card : cards) {
+        builder.addCard(card.x, card.y, card.z, card.face, card.suit);
+    }
+    builder.build(cardWidth, cardHeight);
+}
+
+// 顶点流与逐张 CardView 比较：绘制顺序为按层级稳定排序，四边形为 CardView 的包围盒（锚点在中心）
+bool checkVertices(const char* name, const std::vector<SceneCard>& cards, float cardWidth, float cardHeight)
+{
+    CardBatchBuilder builder;
+    buildVertices(cards, cardWidth, cardHeight, builder);
+
+    std::vector<SceneCard> expected = cards;
+    std::stable_sort(expected.begin(), expected.end(), [](const SceneCard& a, const SceneCard& b) {
+        return a.z < b.z;
+    });
+
+    const auto& vertices = builder.getVertices();
+    const auto& indices = builder.getIndices();
+    bool ok = builder.getCardCount() == cards.size() && vertices.size() == cards.size() * 4 && indices.size() == cards.size() * 6;
+    static const float CORNERS[4][2] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 0.0f, 1.0f }, { 1.0f, 1.0f } };
+    static const uint16_t PATTERN[6] = { 0, 1, 2, 2, 1, 3 };
+    for (size_t i = 0; i < expected.size() && ok; i++) {
+        const SceneCard& card = expected[i];
+        float left = card.x - cardWidth / 2;
+        float bottom = card.y - cardHeight / 2;
+        for (int corner = 0; corner < 4 && ok; corner++) {
+            const CardVertex& vertex = vertices[i * 4 + corner];
+            ok = vertex.x == left + CORNERS[corner][0] * cardWidth
+                && vertex.y == bottom + CORNERS[corner][1] * cardHeight
+                && vertex.z == 0.0f
+                && vertex.u == CORNERS[corner][0] && vertex.v == CORNERS[corner][1]
+                && vertex.face == static_cast<float>(card.face) && vertex.suit == static_cast<float>(card.suit);
+        }
+        for (int k = 0; k < 6 && ok; k++) {
+            ok = indices[i * 6 + k] == i * 4 + PATTERN[k];
+        }
+        if (!ok) {
+            std::printf("vertices (%s): card %zu (face %d suit %d at %.1f,%.1f z %.0f) differs\n",
+                name, i, card.face, card.suit, card.x, card.y, card.z);
+        }
+    }
+    std::printf("vertices (%s): %zu cards: %s\n", name, cards.size(), ok ? "ok" : "MISMATCH");
+    return ok;
+}
+
+bool reportDiff(const char* name, const CanvasDiff& diff, float maxOverRatio)
+{
+    bool ok = diff.pixels > 0 && diff.overThreshold <= static_cast<size_t>(diff.pixels * maxOverRatio);
+    std::printf("%s: max error %.3f, mean %.5f, %zu of %zu pixels over tolerance: %s\n",
+        name, diff.maxError, diff.meanError, diff.overThreshold, diff.pixels, ok ? "ok" : "MISMATCH");
+    return ok;
+}
+
+// 同一画面分别用逐张精灵、CPU 着色器（和 GL）绘制并比较
+bool checkPixels(const char* name, const std::vector<SceneCard>& cards, int width, int height,
+                 const CardImages& images, const Canvas& atlas, const CardAtlasLayout& layout, GlCardRenderer* gl)
+{
+    float cardWidth = static_cast<float>(images.back.width);
+    float cardHeight = static_cast<float>(images.back.height);
+    CardBatchBuilder builder;
+    buildVertices(cards, cardWidth, cardHeight, builder);
+
+    // 逐张精灵按层级顺序绘制（层级相同保持添加顺序）
+    std::vector<SceneCard> ordered = cards;
+    std::stable_sort(ordered.begin(), ordered.end(), [](const SceneCard& a, const SceneCard& b) {
+        return a.z < b.z;
+    });
+    Canvas sprites;
+    sprites.reset(width, height);
+    for (const auto& card : ordered) {
+        CardRaster::drawCardView(sprites, images, card.x, card.y, card.face, card.suit);
+    }
+
+    Canvas batch;
+    batch.reset(width, height);
+    CardRaster::drawBatch(batch, atlas, layout, cardWidth, cardHeight, builder.getVertices());
+
+    std::string label = std::string(name) + " sprites/shader";
+    bool ok = reportDiff(label.c_str(), CardRaster::compare(sprites, batch, SPRITE_ERROR), SPRITE_OVER_RATIO);
+
+    if (gl) {
+        Canvas rendered;
+        std::string error;
+        if (!gl->render(width, height, builder.getVertices(), builder.getIndices(), rendered, &error)) {
+            std::printf("%s gl: %s\n", name, error.c_str());
+            return false;
+        }
+        batch.quantize();
+        label = std::string(name) + " gl/shader";
+        ok = reportDiff(label.c_str(), CardRaster::compare(rendered, batch, GL_ERROR), GL_OVER_RATIO) && ok;
+    }
+    return ok;
+}
+
+bool loadLevel(const std::string& path, LevelConfig& outLevel)
+{
+    std::string data;
+    if (!FileSystemUtils::readFile(path, data)) {
+        std::fprintf(stderr, "%s: cannot read file\n", path.c_str());
+        return false;
+    }
+    std::string error;
+    if (!LevelConfigLoader::loadFromBuffer(data.data(), data.size(), outLevel, &error)) {
+        std::fprintf(stderr, "%s: %s\n", path.c_str(), error.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    std::string input;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (arg == "--help" || arg == "-h") {
+            printUsage();
+            return 0;
+        }
+        else if (arg == "--gl") {
+            options.gl = true;
+        }
+        else if (arg[0] == '-') {
+            if (!value) {
+                printUsage();
+                return 1;
+            }
+            if (arg == "-r" || arg == "--resources") options.resources = value;
+            else {
+                printUsage();
+                return 1;
+            }
+            i++;
+        }
+        else if (input.empty()) {
+            input = arg;
+        }
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+    if (input.empty()) {
+        printUsage();
+        return 1;
+    }
+
+    LevelConfig level;
+    if (!loadLevel(input, level)) {
+        return 1;
+    }
+    CardImages images;
+    CardAtlasLayout layout;
+    std::string error;
+    if (!images.load(options.resources, &error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+    if (!images.computeLayout(layout)) {
+        std::fprintf(stderr, "atlas layout does not fit in %.0f points\n", CardAtlasLayout::MAX_WIDTH);
+        return 1;
+    }
+    float cardWidth = static_cast<float>(images.back.width);
+    float cardHeight = static_cast<float>(images.back.height);
+
+    std::unique_ptr<GlCardRenderer> gl;
+    if (options.gl) {
+        std::string vertexSource;
+        std::string fragmentSource;
+        std::string shaderDir = FileSystemUtils::joinPath(options.resources, "shaders");
+        if (!FileSystemUtils::readFile(FileSystemUtils::joinPath(shaderDir, "card_batch.vsh"), vertexSource)
+            || !FileSystemUtils::readFile(FileSystemUtils::joinPath(shaderDir, "card_batch.fsh"), fragmentSource)) {
+            std::fprintf(stderr, "%s: cannot read card_batch.vsh/.fsh\n", shaderDir.c_str());
+            return 1;
+        }
+        gl.reset(new GlCardRenderer());
+        if (!gl->init(vertexSource, fragmentSource, &error)) {
+            std::fprintf(stderr, "gl: %s\n", error.c_str());
+            return 1;
+        }
+        std::printf("gl: %s\n", gl->getRenderer().c_str());
+    }
+
+    bool ok = checkLayout(images, layout);
+    Canvas atlas;
+    CardRaster::composeAtlas(images, layout, atlas);
+    if (gl) {
+        gl->setAtlas(atlas, layout, cardWidth, cardHeight);
+    }
+
+    std::vector<SceneCard> levelCards;
+    collectLevelCards(level, levelCards);
+    std::vector<SceneCard> reversed(levelCards.rbegin(), levelCards.rend());
+    std::vector<SceneCard> flat = levelCards;
+    for (auto& card : flat) {
+        card.z = 0.0f;
+    }
+    ok = checkVertices("level", levelCards, cardWidth, cardHeight) && ok;
+    ok = checkVertices("reversed", reversed, cardWidth, cardHeight) && ok;
+    ok = checkVertices("same z", flat, cardWidth, cardHeight) && ok;
+
+    std::vector<SceneCard> allCards;
+    collectAllCards(cardWidth, cardHeight, allCards);
+    int gridWidth = static_cast<int>(cardWidth * LevelLayout::FACE_COUNT);
+    int gridHeight = static_cast<int>(cardHeight * LevelLayout::SUIT_COUNT);
+    int sceneWidth = static_cast<int>(LevelLayout::PLAYFIELD_WIDTH);
+    int sceneHeight = static_cast<int>(LevelLayout::STACK_AREA_HEIGHT + LevelLayout::PLAYFIELD_HEIGHT);
+    ok = checkPixels("52 cards", allCards, gridWidth, gridHeight, images, atlas, layout, gl.get()) && ok;
+    ok = checkPixels("level", levelCards, sceneWidth, sceneHeight, images, atlas, layout, gl.get()) && ok;
+
+    std::printf("verify: %s\n", ok ? "ok" : "MISMATCH");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,227 @@
+#include "FileSystemUtils.h"
+#include <algorithm>
+#include <cstdio>
+
+#ifdef _WIN32
+#include <direct.h>
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#endif
+
+namespace FileSystemUtils {
+
+namespace {
+
+bool isSeparator(char c)
+{
+    return c == '/' || c == '\\';
+}
+
+size_t lastSeparator(const std::string& path)
+{
+    return path.find_last_of("/\\");
+}
+
+bool makeDirectory(const std::string& path)
+{
+#ifdef _WIN32
+    return _mkdir(path.c_str()) == 0 || isDirectory(path);
+#else
+    return mkdir(path.c_str(), 0755) == 0 || isDirectory(path);
+#endif
+}
+
+bool listRecursive(const std::string& root, const std::string& relative, std::vector<std::string>& out)
+{
+    std::string directory = relative.empty() ? root : joinPath(root, relative);
+
+#ifdef _WIN32
+    WIN32_FIND_DATAA data;
+    HANDLE find = FindFirstFileA(joinPath(directory, "*").c_str(), &data);
+    if (find == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    do {
+        std::string name = data.cFileName;
+        if (name == "." || name == "..") {
+            continue;
+        }
+        std::string child = relative.empty() ? name : relative + "/" + name;
+        if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+            listRecursive(root, child, out);
+        }
+        else {
+            out.push_back(child);
+        }
+    } while (FindNextFileA(find, &data));
+    FindClose(find);
+#else
+    DIR* dir = opendir(directory.c_str());
+    if (!dir) {
+        return false;
+    }
+    while (dirent* entry = readdir(dir)) {
+        std::string name = entry->d_name;
+        if (name == "." || name == "..") {
+            continue;
+        }
+        std::string child = relative.empty() ? name : relative + "/" + name;
+        if (isDirectory(joinPath(root, child))) {
+            listRecursive(root, child, out);
+        }
+        else {
+            out.push_back(child);
+        }
+    }
+    closedir(dir);
+#endif
+    return true;
+}
+
+} // namespace
+
+bool readFile(const std::string& path, std::string& outData)
+{
+    outData.clear();
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+
+    char buffer[64 * 1024];
+    size_t n;
+    while ((n = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        outData.append(buffer, n);
+    }
+    bool ok = !std::ferror(file);
+    std::fclose(file);
+    return ok;
+}
+
+bool writeFile(const std::string& path, const void* data, size_t size)
+{
+    std::string tempPath = path + ".tmp";
+    FILE* file = std::fopen(tempPath.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    bool ok = size == 0 || std::fwrite(data, 1, size, file) == size;
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok) {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+
+#ifdef _WIN32
+    // Windows 下 rename 不会覆盖已存在的文件
+    std::remove(path.c_str());
+#endif
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool isDirectory(const std::string& path)
+{
+#ifdef _WIN32
+    DWORD attributes = GetFileAttributesA(path.c_str());
+    return attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_DIRECTORY);
+#else
+    struct stat info;
+    return stat(path.c_str(), &info) == 0 && S_ISDIR(info.st_mode);
+#endif
+}
+
+bool fileExists(const std::string& path)
+{
+#ifdef _WIN32
+    DWORD attributes = GetFileAttributesA(path.c_str());
+    return attributes != INVALID_FILE_ATTRIBUTES && !(attributes & FILE_ATTRIBUTE_DIRECTORY);
+#else
+    struct stat info;
+    return stat(path.c_str(), &info) == 0 && S_ISREG(info.st_mode);
+#endif
+}
+
+bool createDirectories(const std::string& path)
+{
+    if (path.empty() || isDirectory(path)) {
+        return true;
+    }
+    std::string parent = parentPath(path);
+    if (!parent.empty() && parent != path && !createDirectories(parent)) {
+        return false;
+    }
+    return makeDirectory(path);
+}
+
+bool listFiles(const std::string& directory, std::vector<std::string>& outRelativePaths)
+{
+    outRelativePaths.clear();
+    if (!listRecursive(directory, "", outRelativePaths)) {
+        return false;
+    }
+    std::sort(outRelativePaths.begin(), outRelativePaths.end());
+    return true;
+}
+
+std::string joinPath(const std::string& base, const std::string& relative)
+{
+    if (base.empty()) {
+        return relative;
+    }
+    if (isSeparator(base.back())) {
+        return base + relative;
+    }
+    return base + "/" + relative;
+}
+
+std::string parentPath(const std::string& path)
+{
+    std::string trimmed = path;
+    while (trimmed.size() > 1 && isSeparator(trimmed.back())) {
+        trimmed.pop_back();
+    }
+    size_t pos = lastSeparator(trimmed);
+    if (pos == std::string::npos) {
+        return "";
+    }
+    return pos == 0 ? trimmed.substr(0, 1) : trimmed.substr(0, pos);
+}
+
+std::string fileName(const std::string& path)
+{
+    size_t pos = lastSeparator(path);
+    return pos == std::string::npos ? path : path.substr(pos + 1);
+}
+
+std::string replaceExtension(const std::string& path, const std::string& extension)
+{
+    size_t dot = path.find_last_of('.');
+    size_t slash = lastSeparator(path);
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        return path + extension;
+    }
+    return path.substr(0, dot) + extension;
+}
+
+std::string extension(const std::string& path)
+{
+    size_t dot = path.find_last_of('.');
+    size_t slash = lastSeparator(path);
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        return "";
+    }
+    std::string ext = path.substr(dot);
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](char c) {
+        return static_cast<char>(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c);
+    });
+    return ext;
+}
+
+} // namespace FileSystemUtils
@@ -0,0 +1,37 @@
+#ifndef __FILE_SYSTEM_UTILS_H__
+#define __FILE_SYSTEM_UTILS_H__
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * 跨平台文件操作封装（Win32 / POSIX）
+ * 仅供命令行工具使用，游戏内请使用 cocos2d::FileUtils
+ */
+namespace FileSystemUtils {
+
+bool readFile(const std::string& path, std::string& outData);
+
+// 先写临时文件再改名，中途失败不会留下半个文件
+bool writeFile(const std::string& path, const void* data, size_t size);
+
+bool isDirectory(const std::string& path);
+bool fileExists(const std::string& path);
+
+// 逐级创建目录，已存在时返回 true
+bool createDirectories(const std::string& path);
+
+// 递归列出目录下所有文件，输出相对 directory 的路径（分隔符统一为 '/'），按路径排序
+bool listFiles(const std::string& directory, std::vector<std::string>& outRelativePaths);
+
+// 路径辅助
+std::string joinPath(const std::string& base, const std::string& relative);
+std::string parentPath(const std::string& path);
+std::string fileName(const std::string& path);
+std::string replaceExtension(const std::string& path, const std::string& extension);
+std::string extension(const std::string& path);   // 含 '.'，转为小写；无扩展名时为空
+
+} // namespace FileSystemUtils
+
+#endif // __FILE_SYSTEM_UTILS_H__
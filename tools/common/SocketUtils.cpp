@@ -0,0 +1,281 @@
+#include "SocketUtils.h"
+#include <cstring>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "ws2_32.lib")
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace SocketUtils {
+
+namespace {
+
+#ifdef _WIN32
+typedef SOCKET NativeSocket;
+#else
+typedef int NativeSocket;
+#endif
+
+NativeSocket toNative(SocketHandle handle)
+{
+    return static_cast<NativeSocket>(handle);
+}
+
+void setError(std::string* error, const std::string& msg)
+{
+    if (error) {
+        *error = msg;
+    }
+}
+
+bool fillTcpAddress(const std::string& host, int port, sockaddr_in& addr)
+{
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<unsigned short>(port));
+    return inet_pton(AF_INET, host.c_str(), &addr.sin_addr) == 1;
+}
+
+void setNoDelay(SocketHandle socket)
+{
+    int flag = 1;
+    setsockopt(toNative(socket), IPPROTO_TCP, TCP_NODELAY,
+        reinterpret_cast<const char*>(&flag), sizeof(flag));
+}
+
+} // namespace
+
+bool initialize()
+{
+#ifdef _WIN32
+    WSADATA data;
+    return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+#else
+    return true;
+#endif
+}
+
+SocketHandle listenTcp(const std::string& host, int port, std::string* error)
+{
+    sockaddr_in addr;
+    if (!fillTcpAddress(host, port, addr)) {
+        setError(error, "invalid host " + host);
+        return INVALID_HANDLE;
+    }
+
+    NativeSocket fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    SocketHandle handle = static_cast<SocketHandle>(fd);
+    if (handle == INVALID_HANDLE) {
+        setError(error, "socket() failed");
+        return INVALID_HANDLE;
+    }
+
+    int reuse = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || ::listen(fd, 64) != 0) {
+        setError(error, "cannot listen on " + host + ":" + std::to_string(port));
+        closeSocket(handle);
+        return INVALID_HANDLE;
+    }
+    return handle;
+}
+
+SocketHandle listenUnix(const std::string& path, std::string* error)
+{
+#ifdef _WIN32
+    setError(error, "unix domain sockets are not supported on this platform");
+    return INVALID_HANDLE;
+#else
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) {
+        setError(error, "socket path too long");
+        return INVALID_HANDLE;
+    }
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    ::unlink(path.c_str());
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        setError(error, "socket() failed");
+        return INVALID_HANDLE;
+    }
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || ::listen(fd, 64) != 0) {
+        setError(error, "cannot listen on " + path);
+        ::close(fd);
+        return INVALID_HANDLE;
+    }
+    return fd;
+#endif
+}
+
+SocketHandle connectTcp(const std::string& host, int port, std::string* error)
+{
+    sockaddr_in addr;
+    if (!fillTcpAddress(host, port, addr)) {
+        setError(error, "invalid host " + host);
+        return INVALID_HANDLE;
+    }
+
+    NativeSocket fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    SocketHandle handle = static_cast<SocketHandle>(fd);
+    if (handle == INVALID_HANDLE) {
+        setError(error, "socket() failed");
+        return INVALID_HANDLE;
+    }
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        setError(error, "cannot connect to " + host + ":" + std::to_string(port));
+        closeSocket(handle);
+        return INVALID_HANDLE;
+    }
+    setNoDelay(handle);
+    return handle;
+}
+
+SocketHandle connectUnix(const std::string& path, std::string* error)
+{
+#ifdef _WIN32
+    setError(error, "unix domain sockets are not supported on this platform");
+    return INVALID_HANDLE;
+#else
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        setError(error, "socket() failed");
+        return INVALID_HANDLE;
+    }
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        setError(error, "cannot connect to " + path);
+        ::close(fd);
+        return INVALID_HANDLE;
+    }
+    return fd;
+#endif
+}
+
+SocketHandle acceptClient(SocketHandle listener)
+{
+    NativeSocket fd = ::accept(toNative(listener), nullptr, nullptr);
+    SocketHandle handle = static_cast<SocketHandle>(fd);
+    if (handle != INVALID_HANDLE) {
+        setNoDelay(handle);
+    }
+    return handle;
+}
+
+bool sendAll(SocketHandle socket, const char* data, size_t size)
+{
+    NativeSocket fd = toNative(socket);
+    while (size > 0) {
+#ifdef _WIN32
+        int sent = ::send(fd, data, static_cast<int>(size), 0);
+#else
+        ssize_t sent = ::send(fd, data, size, MSG_NOSIGNAL);
+#endif
+        if (sent <= 0) {
+            return false;
+        }
+        data += sent;
+        size -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+long receiveSome(SocketHandle socket, char* buffer, size_t size)
+{
+    NativeSocket fd = toNative(socket);
+#ifdef _WIN32
+    return ::recv(fd, buffer, static_cast<int>(size), 0);
+#else
+    return static_cast<long>(::recv(fd, buffer, size, 0));
+#endif
+}
+
+void shutdownSocket(SocketHandle socket)
+{
+    NativeSocket fd = toNative(socket);
+#ifdef _WIN32
+    ::shutdown(fd, SD_BOTH);
+#else
+    ::shutdown(fd, SHUT_RDWR);
+#endif
+}
+
+void closeSocket(SocketHandle socket)
+{
+    NativeSocket fd = toNative(socket);
+#ifdef _WIN32
+    ::closesocket(fd);
+#else
+    ::close(fd);
+#endif
+}
+
+} // namespace SocketUtils
+
+SocketReader::SocketReader(SocketUtils::SocketHandle socket)
+    : _socket(socket)
+    , _offset(0)
+{
+}
+
+bool SocketReader::readLine(std::string& outLine, size_t maxLength)
+{
+    for (;;) {
+        size_t newline = _buffer.find('\n', _offset);
+        if (newline != std::string::npos) {
+            outLine.assign(_buffer, _offset, newline - _offset);
+            if (!outLine.empty() && outLine.back() == '\r') {
+                outLine.pop_back();
+            }
+            _offset = newline + 1;
+            return true;
+        }
+        if (_buffer.size() - _offset > maxLength || !fill()) {
+            return false;
+        }
+    }
+}
+
+bool SocketReader::readExact(std::string& outData, size_t size)
+{
+    while (_buffer.size() - _offset < size) {
+        if (!fill()) {
+            return false;
+        }
+    }
+    outData.assign(_buffer, _offset, size);
+    _offset += size;
+    return true;
+}
+
+bool SocketReader::fill()
+{
+    // 丢弃已消费的数据，避免缓冲区无限增长
+    if (_offset > 0) {
+        _buffer.erase(0, _offset);
+        _offset = 0;
+    }
+
+    char chunk[16 * 1024];
+    long received = SocketUtils::receiveSome(_socket, chunk, sizeof(chunk));
+    if (received <= 0) {
+        return false;
+    }
+    _buffer.append(chunk, static_cast<size_t>(received));
+    return true;
+}
@@ -0,0 +1,60 @@
+#ifndef __SOCKET_UTILS_H__
+#define __SOCKET_UTILS_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * 跨平台套接字封装（Winsock / POSIX）
+ * 仅供本地工具使用：本机 TCP 端口，以及非 Windows 平台的 Unix 域套接字
+ */
+namespace SocketUtils {
+
+typedef intptr_t SocketHandle;
+const SocketHandle INVALID_HANDLE = -1;
+
+// 进程内调用一次（Windows 下初始化 Winsock）
+bool initialize();
+
+SocketHandle listenTcp(const std::string& host, int port, std::string* error = nullptr);
+SocketHandle listenUnix(const std::string& path, std::string* error = nullptr);
+SocketHandle connectTcp(const std::string& host, int port, std::string* error = nullptr);
+SocketHandle connectUnix(const std::string& path, std::string* error = nullptr);
+
+SocketHandle acceptClient(SocketHandle listener);
+
+// 发送全部数据，失败返回 false
+bool sendAll(SocketHandle socket, const char* data, size_t size);
+
+// 接收数据，返回读到的字节数；连接关闭或出错时返回 0 或负数
+long receiveSome(SocketHandle socket, char* buffer, size_t size);
+
+// 关闭读写方向，唤醒阻塞在该套接字上的线程
+void shutdownSocket(SocketHandle socket);
+void closeSocket(SocketHandle socket);
+
+} // namespace SocketUtils
+
+/**
+ * 带缓冲的套接字读取器，支持按行读取和按长度读取
+ */
+class SocketReader {
+public:
+    explicit SocketReader(SocketUtils::SocketHandle socket);
+
+    // 读取一行（不含换行符），连接关闭时返回 false
+    bool readLine(std::string& outLine, size_t maxLength = 4096);
+
+    // 读取恰好 size 字节
+    bool readExact(std::string& outData, size_t size);
+
+private:
+    bool fill();
+
+    SocketUtils::SocketHandle _socket;
+    std::string _buffer;
+    size_t _offset;
+};
+
+#endif // __SOCKET_UTILS_H__
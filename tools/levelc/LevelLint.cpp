@@ -0,0 +1,189 @@
+#include "LevelLint.h"
+#include "models/BoardState.h"
+#include "services/LevelSolver.h"
+#include <cstdio>
+#include <map>
+#include <utility>
+
+namespace {
+
+std::string cardName(const char* area, size_t index)
+{
+    return std::string(area) + " card #" + std::to_string(index);
+}
+
+std::string formatPosition(float x, float y)
+{
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "(%g, %g)", x, y);
+    return buffer;
+}
+
+bool checkFaceSuit(const LevelConfig& level, std::vector<LintIssue>& outIssues)
+{
+    bool ok = true;
+    for (size_t i = 0; i < level.playfield.size(); i++) {
+        const LevelCardConfig& card = level.playfield[i];
+        if (card.face < 0 || card.face >= LevelLayout::FACE_COUNT || card.suit < 0 || card.suit >= LevelLayout::SUIT_COUNT) {
+            outIssues.push_back(LintIssue(LintIssue::ERROR, cardName("Playfield", i) + " face/suit out of range ("
+                + std::to_string(card.face) + ", " + std::to_string(card.suit) + ")"));
+            ok = false;
+        }
+    }
+    for (size_t i = 0; i < level.stack.size(); i++) {
+        const LevelCardConfig& card = level.stack[i];
+        if (card.face < 0 || card.face >= LevelLayout::FACE_COUNT || card.suit < 0 || card.suit >= LevelLayout::SUIT_COUNT) {
+            outIssues.push_back(LintIssue(LintIssue::ERROR, cardName("Stack", i) + " face/suit out of range ("
+                + std::to_string(card.face) + ", " + std::to_string(card.suit) + ")"));
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+void checkPositions(const LevelConfig& level, std::vector<LintIssue>& outIssues)
+{
+    const float halfWidth = LevelLayout::CARD_WIDTH * 0.5f;
+    const float halfHeight = LevelLayout::CARD_HEIGHT * 0.5f;
+    std::map<std::pair<float, float>, size_t> seen;
+
+    for (size_t i = 0; i < level.playfield.size(); i++) {
+        const LevelCardConfig& card = level.playfield[i];
+        if (card.x < 0.0f || card.x > LevelLayout::PLAYFIELD_WIDTH || card.y < 0.0f || card.y > LevelLayout::PLAYFIELD_HEIGHT) {
+            outIssues.push_back(LintIssue(LintIssue::ERROR, cardName("Playfield", i) + " at "
+                + formatPosition(card.x, card.y) + " is off the playfield"));
+        }
+        else if (card.x < halfWidth || card.x > LevelLayout::PLAYFIELD_WIDTH - halfWidth
+            || card.y < halfHeight || card.y > LevelLayout::PLAYFIELD_HEIGHT - halfHeight) {
+            outIssues.push_back(LintIssue(LintIssue::WARNING, cardName("Playfield", i) + " at "
+                + formatPosition(card.x, card.y) + " crosses the playfield edge"));
+        }
+
+        auto result = seen.insert(std::make_pair(std::make_pair(card.x, card.y), i));
+        if (!result.second) {
+            outIssues.push_back(LintIssue(LintIssue::ERROR, cardName("Playfield", i) + " has the same position as #"
+                + std::to_string(result.first->second) + " " + formatPosition(card.x, card.y)));
+        }
+    }
+}
+
+// 放宽规则的消除不动点：只要露出且牌组中存在可配的牌就认为能被消除
+void checkReachability(const BoardLayout& layout, std::vector<LintIssue>& outIssues)
+{
+    const int playfieldCount = layout.playfieldCount;
+    const uint64_t* rows = MatchRules::rowsFor(layout.matchRule);
+
+    int codeCounts[LevelLayout::CARD_CODE_COUNT] = { 0 };
+    uint64_t present = 0;
+    for (uint8_t code : layout.codes) {
+        codeCounts[code]++;
+        present |= 1ULL << code;
+    }
+
+    std::vector<uint8_t> hasPartner(playfieldCount, 0);
+    for (int i = 0; i < playfieldCount; i++) {
+        int code = layout.codes[i];
+        uint64_t others = codeCounts[code] > 1 ? present : present & ~(1ULL << code);
+        hasPartner[i] = (rows[code] & others) != 0;
+    }
+
+    std::vector<uint8_t> removed(playfieldCount, 0);
+    std::vector<float> upperX;
+    std::vector<float> upperY;
+    auto isExposed = [&](int i) {
+        upperX.clear();
+        upperY.clear();
+        for (int upper : layout.coveredBy[i]) {
+            if (!removed[upper]) {
+                upperX.push_back(layout.posX[upper]);
+                upperY.push_back(layout.posY[upper]);
+            }
+        }
+        return BoardLayout::isUncovered(layout.posX[i], layout.posY[i], upperX.data(), upperY.data(), static_cast<int>(upperX.size()));
+    };
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int i = playfieldCount - 1; i >= 0; i--) {
+            if (!removed[i] && hasPartner[i] && isExposed(i)) {
+                removed[i] = 1;
+                changed = true;
+            }
+        }
+    }
+
+    for (int i = 0; i < playfieldCount; i++) {
+        if (removed[i]) {
+            continue;
+        }
+        if (!hasPartner[i]) {
+            outIssues.push_back(LintIssue(LintIssue::ERROR, cardName("Playfield", i) + " can never be matched under rule "
+                + MatchRules::ruleName(layout.matchRule)));
+        }
+        else if (!isExposed(i)) {
+            std::string blockers;
+            for (int upper : layout.coveredBy[i]) {
+                if (!removed[upper]) {
+                    blockers += " #" + std::to_string(upper);
+                }
+            }
+            outIssues.push_back(LintIssue(LintIssue::ERROR, cardName("Playfield", i) + " can never become exposed (stuck under"
+                + blockers + ")"));
+        }
+    }
+}
+
+void checkSolvable(const std::shared_ptr<const BoardLayout>& layout, const LintOptions& options, std::vector<LintIssue>& outIssues)
+{
+    BoardState state;
+    if (!state.init(layout)) {
+        return;
+    }
+
+    LevelSolver solver;
+    solver.setNodeBudget(options.solveNodes);
+    solver.setTimeBudget(options.solveTimeMs);
+    SolveResult result = solver.solve(state);
+
+    if (result.status == SolveResult::UNWINNABLE) {
+        outIssues.push_back(LintIssue(LintIssue::ERROR, "level is unwinnable (at most " + std::to_string(result.maxDepth) + " moves)"));
+    }
+    else if (result.status == SolveResult::UNKNOWN) {
+        outIssues.push_back(LintIssue(LintIssue::WARNING, "solver gave up after " + std::to_string(result.nodes) + " nodes"));
+    }
+}
+
+} // namespace
+
+void LevelLint::lint(const LevelConfig& level, const LintOptions& options, std::vector<LintIssue>& outIssues)
+{
+    bool codesValid = checkFaceSuit(level, outIssues);
+    checkPositions(level, outIssues);
+
+    if (level.stack.empty()) {
+        outIssues.push_back(LintIssue(LintIssue::ERROR, "Stack is empty"));
+    }
+
+    // 牌码越界时无法构建布局，后续检查依赖合法牌码
+    if (!codesValid) {
+        return;
+    }
+
+    std::shared_ptr<const BoardLayout> layout = BoardLayout::build(level);
+    checkReachability(*layout, outIssues);
+
+    if (options.solveNodes > 0 && !level.stack.empty() && !hasErrors(outIssues)) {
+        checkSolvable(layout, options, outIssues);
+    }
+}
+
+bool LevelLint::hasErrors(const std::vector<LintIssue>& issues)
+{
+    for (const auto& issue : issues) {
+        if (issue.severity == LintIssue::ERROR) {
+            return true;
+        }
+    }
+    return false;
+}
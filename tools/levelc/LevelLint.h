@@ -0,0 +1,51 @@
+#ifndef __LEVEL_LINT_H__
+#define __LEVEL_LINT_H__
+
+#include "configs/LevelConfig.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * 单条检查结果
+ */
+struct LintIssue {
+    enum Severity {
+        WARNING = 0,
+        ERROR
+    };
+
+    Severity severity;
+    std::string message;
+
+    LintIssue(Severity s, const std::string& msg) : severity(s), message(msg) {}
+};
+
+/**
+ * 检查选项
+ */
+struct LintOptions {
+    uint64_t solveNodes;     // 大于 0 时用求解器确认能否通关（每关最多展开的状态数）
+    int solveTimeMs;         // 求解时间上限，0 表示不限制
+
+    LintOptions() : solveNodes(0), solveTimeMs(0) {}
+};
+
+/**
+ * 关卡静态检查
+ *
+ * 错误：牌面/花色越界、卡牌中心超出主牌区、两张牌位置完全相同、
+ *       永远不会露出的牌、永远无牌可配的牌、底牌堆为空、（开启求解时）无法通关
+ * 警告：卡牌部分超出主牌区边缘、（开启求解时）超出预算未能确定
+ *
+ * 露出分析是放宽规则后的必要条件：假设每张露出且有可配对象的牌终将被消除，
+ * 反复消除直到不动点，此时仍未消除的牌即使在最理想的出牌顺序下也无法消除。
+ */
+class LevelLint {
+public:
+    static void lint(const LevelConfig& level, const LintOptions& options, std::vector<LintIssue>& outIssues);
+
+    static bool hasErrors(const std::vector<LintIssue>& issues);
+};
+
+#endif // __LEVEL_LINT_H__
@@ -0,0 +1,335 @@
+#include "LevelLint.h"
+#include "../common/FileSystemUtils.h"
+#include "configs/LevelConfigLoader.h"
+#include "utils/ThreadPool.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * 关卡检查与编译工具
+ * 用与游戏相同的 LevelConfigLoader 解析关卡（JSON、种子关卡、二进制），做静态检查，
+ * 通过检查的关卡编译为运行时二进制格式（.cglv）。
+ *
+ *   levelc [options] <file|dir>...
+ *
+ * 目录会递归处理其中的 .json / .cgdl / .cglv 文件，输出保持相对目录结构。
+ * 输出目录下的 .levelc_cache 记录每个关卡的内容哈希，内容和选项未变且输出存在时跳过。
+ */
+namespace {
+
+const char* CACHE_FILE_NAME = ".levelc_cache";
+const int LEVELC_VERSION = 1;
+
+struct Options {
+    std::string outDir;          // 为空时只检查不输出
+    size_t jobs;
+    bool force;
+    bool warningsAsErrors;
+    bool quiet;
+    LintOptions lint;
+
+    Options() : jobs(0), force(false), warningsAsErrors(false), quiet(false) {}
+};
+
+struct Job {
+    std::string source;          // 源文件路径
+    std::string relative;        // 输出相对路径（.cglv）
+};
+
+struct JobResult {
+    enum Status {
+        BUILT = 0,
+        UP_TO_DATE,
+        CHECKED,                 // 只检查模式下通过
+        FAILED
+    };
+
+    Status status;
+    uint64_t hash;
+    std::vector<LintIssue> issues;
+
+    JobResult() : status(FAILED), hash(0) {}
+};
+
+void printUsage()
+{
+    std::printf(
+        "usage: levelc [options] <file|dir>...\n"
+        "  -o, --out <dir>      write compiled .cglv levels to dir (default: lint only)\n"
+        "  -j, --jobs <n>       worker threads (default: hardware threads)\n"
+        "  --solve-nodes <n>    also prove each level winnable with the solver (default 0 = off)\n"
+        "  --solve-ms <n>       solver time budget per level (default 0 = unlimited)\n"
+        "  --werror             treat warnings as errors\n"
+        "  --force              ignore the incremental cache and rebuild everything\n"
+        "  -q, --quiet          only print problems and the summary\n");
+}
+
+bool isLevelFile(const std::string& path)
+{
+    std::string ext = FileSystemUtils::extension(path);
+    return ext == ".json" || ext == ".cgdl" || ext == ".cglv";
+}
+
+// FNV-1a 64
+uint64_t hashBytes(uint64_t hash, const void* data, size_t size)
+{
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= p[i];
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+// 影响输出的选项一并计入哈希，改了选项或工具版本后自动全部重建
+uint64_t optionsHash(const Options& options)
+{
+    char text[128];
+    std::snprintf(text, sizeof(text), "levelc%d|cglv%d|nodes%llu|ms%d|werror%d",
+        LEVELC_VERSION,
+        LevelConfigLoader::BINARY_VERSION,
+        static_cast<unsigned long long>(options.lint.solveNodes),
+        options.lint.solveTimeMs,
+        options.warningsAsErrors ? 1 : 0);
+    return hashBytes(0xCBF29CE484222325ULL, text, std::strlen(text));
+}
+
+void loadCache(const std::string& path, std::map<std::string, uint64_t>& outCache)
+{
+    std::string data;
+    if (!FileSystemUtils::readFile(path, data)) {
+        return;
+    }
+    size_t start = 0;
+    while (start < data.size()) {
+        size_t end = data.find('\n', start);
+        if (end == std::string::npos) {
+            end = data.size();
+        }
+        std::string line = data.substr(start, end - start);
+        start = end + 1;
+
+        // "<16 位十六进制哈希> <相对路径>"
+        if (line.size() > 17 && line[16] == ' ') {
+            outCache[line.substr(17)] = std::strtoull(line.substr(0, 16).c_str(), nullptr, 16);
+        }
+    }
+}
+
+bool saveCache(const std::string& path, const std::map<std::string, uint64_t>& cache)
+{
+    std::string data;
+    char hash[20];
+    for (const auto& entry : cache) {
+        std::snprintf(hash, sizeof(hash), "%016llx ", static_cast<unsigned long long>(entry.second));
+        data += hash;
+        data += entry.first;
+        data += '\n';
+    }
+    return FileSystemUtils::writeFile(path, data.data(), data.size());
+}
+
+void runJob(const Job& job, const Options& options, uint64_t baseHash, const std::map<std::string, uint64_t>& cache, JobResult& result)
+{
+    std::string data;
+    if (!FileSystemUtils::readFile(job.source, data)) {
+        result.issues.push_back(LintIssue(LintIssue::ERROR, "cannot read file"));
+        return;
+    }
+
+    result.hash = hashBytes(baseHash, data.data(), data.size());
+    std::string outPath;
+    if (!options.outDir.empty()) {
+        outPath = FileSystemUtils::joinPath(options.outDir, job.relative);
+        auto cached = cache.find(job.relative);
+        if (!options.force && cached != cache.end() && cached->second == result.hash && FileSystemUtils::fileExists(outPath)) {
+            result.status = JobResult::UP_TO_DATE;
+            return;
+        }
+    }
+
+    LevelConfig level;
+    std::string error;
+    if (!LevelConfigLoader::loadFromBuffer(data.data(), data.size(), level, &error)) {
+        result.issues.push_back(LintIssue(LintIssue::ERROR, error));
+        return;
+    }
+
+    LevelLint::lint(level, options.lint, result.issues);
+    if (LevelLint::hasErrors(result.issues) || (options.warningsAsErrors && !result.issues.empty())) {
+        return;
+    }
+
+    if (outPath.empty()) {
+        result.status = JobResult::CHECKED;
+        return;
+    }
+
+    std::vector<unsigned char> binary;
+    if (!LevelConfigLoader::saveToBinary(level, binary, &error)) {
+        result.issues.push_back(LintIssue(LintIssue::ERROR, error));
+        return;
+    }
+    if (!FileSystemUtils::createDirectories(FileSystemUtils::parentPath(outPath))
+        || !FileSystemUtils::writeFile(outPath, binary.data(), binary.size())) {
+        result.issues.push_back(LintIssue(LintIssue::ERROR, "cannot write " + outPath));
+        return;
+    }
+    result.status = JobResult::BUILT;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    std::vector<std::string> inputs;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (arg == "--help" || arg == "-h") {
+            printUsage();
+            return 0;
+        }
+        else if (arg == "--werror")              options.warningsAsErrors = true;
+        else if (arg == "--force")               options.force = true;
+        else if (arg == "-q" || arg == "--quiet") options.quiet = true;
+        else if (arg[0] == '-') {
+            if (!value) {
+                printUsage();
+                return 1;
+            }
+            if (arg == "-o" || arg == "--out")       options.outDir = value;
+            else if (arg == "-j" || arg == "--jobs") options.jobs = static_cast<size_t>(std::atoi(value));
+            else if (arg == "--solve-nodes")         options.lint.solveNodes = std::strtoull(value, nullptr, 10);
+            else if (arg == "--solve-ms")            options.lint.solveTimeMs = std::atoi(value);
+            else {
+                printUsage();
+                return 1;
+            }
+            i++;
+        }
+        else {
+            inputs.push_back(arg);
+        }
+    }
+    if (inputs.empty()) {
+        printUsage();
+        return 1;
+    }
+
+    // 展开目录
+    std::vector<Job> jobs;
+    std::map<std::string, std::string> outputs;   // 输出相对路径 -> 源文件，检查重名
+    int failed = 0;
+    for (const auto& input : inputs) {
+        std::vector<std::string> files;
+        if (FileSystemUtils::isDirectory(input)) {
+            if (!FileSystemUtils::listFiles(input, files)) {
+                std::fprintf(stderr, "%s: cannot list directory\n", input.c_str());
+                failed++;
+                continue;
+            }
+            for (const auto& file : files) {
+                if (isLevelFile(file)) {
+                    Job job;
+                    job.source = FileSystemUtils::joinPath(input, file);
+                    job.relative = FileSystemUtils::replaceExtension(file, ".cglv");
+                    jobs.push_back(job);
+                }
+            }
+        }
+        else {
+            Job job;
+            job.source = input;
+            job.relative = FileSystemUtils::replaceExtension(FileSystemUtils::fileName(input), ".cglv");
+            jobs.push_back(job);
+        }
+    }
+    for (size_t i = 0; i < jobs.size(); ) {
+        auto result = outputs.insert(std::make_pair(jobs[i].relative, jobs[i].source));
+        if (!result.second) {
+            std::fprintf(stderr, "%s: error: output %s already produced by %s\n",
+                jobs[i].source.c_str(), jobs[i].relative.c_str(), result.first->second.c_str());
+            failed++;
+            jobs.erase(jobs.begin() + i);
+            continue;
+        }
+        i++;
+    }
+
+    std::map<std::string, uint64_t> cache;
+    std::string cachePath;
+    if (!options.outDir.empty()) {
+        if (!FileSystemUtils::createDirectories(options.outDir)) {
+            std::fprintf(stderr, "levelc: cannot create %s\n", options.outDir.c_str());
+            return 1;
+        }
+        cachePath = FileSystemUtils::joinPath(options.outDir, CACHE_FILE_NAME);
+        loadCache(cachePath, cache);
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+    uint64_t baseHash = optionsHash(options);
+    std::vector<JobResult> results(jobs.size());
+    {
+        ThreadPool pool(options.jobs, 0);
+        for (size_t i = 0; i < jobs.size(); i++) {
+            pool.submit([&, i]() {
+                runJob(jobs[i], options, baseHash, cache, results[i]);
+            });
+        }
+        pool.waitIdle();
+    }
+
+    // 按输入顺序输出，结果与线程数无关
+    int built = 0;
+    int upToDate = 0;
+    int checked = 0;
+    int warnings = 0;
+    for (size_t i = 0; i < jobs.size(); i++) {
+        const JobResult& result = results[i];
+        for (const auto& issue : result.issues) {
+            std::fprintf(stderr, "%s: %s: %s\n", jobs[i].source.c_str(),
+                issue.severity == LintIssue::ERROR ? "error" : "warning", issue.message.c_str());
+            if (issue.severity == LintIssue::WARNING) {
+                warnings++;
+            }
+        }
+
+        switch (result.status) {
+        case JobResult::BUILT:
+            built++;
+            cache[jobs[i].relative] = result.hash;
+            if (!options.quiet) {
+                std::printf("built %s\n", jobs[i].relative.c_str());
+            }
+            break;
+        case JobResult::UP_TO_DATE:
+            upToDate++;
+            break;
+        case JobResult::CHECKED:
+            checked++;
+            break;
+        case JobResult::FAILED:
+            failed++;
+            cache.erase(jobs[i].relative);
+            break;
+        }
+    }
+
+    if (!cachePath.empty() && !saveCache(cachePath, cache)) {
+        std::fprintf(stderr, "levelc: cannot write %s\n", cachePath.c_str());
+    }
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    std::printf("%d level(s): %d built, %d up to date, %d checked, %d failed, %d warning(s) in %.0f ms\n",
+        static_cast<int>(jobs.size()), built, upToDate, checked, failed, warnings, ms);
+    return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,286 @@
+#include "../common/FileSystemUtils.h"
+#include "configs/LevelCanonicalizer.h"
+#include "configs/LevelConfigLoader.h"
+#include "utils/ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * 关卡库查重工具
+ * 并行规范化整个关卡库（LevelCanonicalizer），按 128 位规范哈希聚出等价关卡，
+ * 再用近似签名的 LSH 分桶找出近似关卡（只差少量卡牌），输出聚类。
+ *
+ *   levelindex [options] <file|dir>...
+ *
+ * 输出：
+ *   = <规范哈希> <文件>...        等价关卡（只差花色置换、镜像、平移或无关叠放顺序）
+ *   ~ <相似度> <文件>...          近似关卡，每个等价类列出第一个文件，相似度为类间最低的估计值
+ */
+namespace {
+
+// LSH 分桶：签名分成 BANDS 段，每段 ROWS 个值，任意一段完全相同即为候选
+// 相似度 s 的两关成为候选的概率为 1 - (1 - s^ROWS)^BANDS，阈值约 0.77
+const int LSH_BANDS = 8;
+const int LSH_ROWS = NearSignature::SIZE / LSH_BANDS;
+
+struct Options {
+    int jobs;
+    double nearThreshold;
+    bool list;
+
+    Options() : jobs(0), nearThreshold(0.8), list(false) {}
+};
+
+struct Entry {
+    std::string path;
+    bool ok;
+    std::string error;
+    LevelHash128 hash;
+    NearSignature signature;
+
+    Entry() : ok(false), signature() {}
+};
+
+void printUsage()
+{
+    std::printf(
+        "usage: levelindex [options] <file|dir>...\n"
+        "  -j, --jobs <n>       worker threads (default: hardware threads)\n"
+        "  --near <s>           estimated similarity for near clusters, 0 = off (default 0.8)\n"
+        "  --list               also print the canonical hash of every level\n");
+}
+
+bool isLevelFile(const std::string& path)
+{
+    std::string ext = FileSystemUtils::extension(path);
+    return ext == ".json" || ext == ".cgdl" || ext == ".cglv";
+}
+
+void indexLevel(Entry& entry)
+{
+    std::string data;
+    if (!FileSystemUtils::readFile(entry.path, data)) {
+        entry.error = "cannot read file";
+        return;
+    }
+    LevelConfig level;
+    CanonicalLevel canonical;
+    if (!LevelConfigLoader::loadFromBuffer(data.data(), data.size(), level, &entry.error)
+        || !LevelCanonicalizer::canonicalize(level, canonical, &entry.error)) {
+        return;
+    }
+    entry.hash = canonical.hash;
+    LevelCanonicalizer::nearSignature(canonical.level, entry.signature);
+    entry.ok = true;
+}
+
+/**
+ * 并查集
+ */
+class DisjointSet {
+public:
+    explicit DisjointSet(size_t count) : _parent(count)
+    {
+        for (size_t i = 0; i < count; i++) {
+            _parent[i] = i;
+        }
+    }
+
+    size_t find(size_t i)
+    {
+        while (_parent[i] != i) {
+            _parent[i] = _parent[_parent[i]];
+            i = _parent[i];
+        }
+        return i;
+    }
+
+    // 以较小的序号为根，聚类结果与合并顺序无关
+    void unite(size_t a, size_t b)
+    {
+        a = find(a);
+        b = find(b);
+        if (a < b) _parent[b] = a;
+        else if (b < a) _parent[a] = b;
+    }
+
+private:
+    std::vector<size_t> _parent;
+};
+
+uint64_t bandKey(const NearSignature& signature, int band)
+{
+    uint64_t key = 0xCBF29CE484222325ULL ^ static_cast<uint64_t>(band);
+    for (int k = band * LSH_ROWS; k < (band + 1) * LSH_ROWS; k++) {
+        key = (key ^ signature.values[k]) * 0x100000001B3ULL;
+    }
+    return key;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    std::vector<std::string> inputs;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (arg == "--help" || arg == "-h") {
+            printUsage();
+            return 0;
+        }
+        else if (arg == "--list") {
+            options.list = true;
+        }
+        else if (arg[0] == '-') {
+            if (!value) {
+                printUsage();
+                return 1;
+            }
+            if (arg == "-j" || arg == "--jobs") options.jobs = std::atoi(value);
+            else if (arg == "--near")           options.nearThreshold = std::atof(value);
+            else {
+                printUsage();
+                return 1;
+            }
+            i++;
+        }
+        else {
+            inputs.push_back(arg);
+        }
+    }
+    if (inputs.empty()) {
+        printUsage();
+        return 1;
+    }
+
+    // 展开目录
+    std::vector<Entry> entries;
+    int failed = 0;
+    for (const auto& input : inputs) {
+        if (!FileSystemUtils::isDirectory(input)) {
+            Entry entry;
+            entry.path = input;
+            entries.push_back(entry);
+            continue;
+        }
+        std::vector<std::string> files;
+        if (!FileSystemUtils::listFiles(input, files)) {
+            std::fprintf(stderr, "%s: cannot list directory\n", input.c_str());
+            failed++;
+            continue;
+        }
+        for (const auto& file : files) {
+            if (isLevelFile(file)) {
+                Entry entry;
+                entry.path = FileSystemUtils::joinPath(input, file);
+                entries.push_back(entry);
+            }
+        }
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+    {
+        ThreadPool pool(options.jobs, 0);
+        for (size_t i = 0; i < entries.size(); i++) {
+            pool.submit([&entries, i]() {
+                indexLevel(entries[i]);
+            });
+        }
+        pool.waitIdle();
+    }
+    double indexSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    // 等价类：按规范哈希分组，std::map 使输出顺序与线程数无关
+    std::map<LevelHash128, std::vector<size_t>> exact;
+    for (size_t i = 0; i < entries.size(); i++) {
+        const Entry& entry = entries[i];
+        if (!entry.ok) {
+            std::fprintf(stderr, "%s: %s\n", entry.path.c_str(), entry.error.c_str());
+            failed++;
+            continue;
+        }
+        if (options.list) {
+            std::printf("%s %s\n", entry.hash.toString().c_str(), entry.path.c_str());
+        }
+        exact[entry.hash].push_back(i);
+    }
+
+    std::vector<const std::vector<size_t>*> classes;
+    size_t duplicateFiles = 0;
+    int exactClusters = 0;
+    for (const auto& group : exact) {
+        classes.push_back(&group.second);
+        if (group.second.size() > 1) {
+            exactClusters++;
+            duplicateFiles += group.second.size() - 1;
+            std::printf("= %s", group.first.toString().c_str());
+            for (size_t index : group.second) {
+                std::printf(" %s", entries[index].path.c_str());
+            }
+            std::printf("\n");
+        }
+    }
+
+    // 近似类：每个等价类取第一个文件的签名，同一 LSH 桶中估计相似度达到阈值的两类合并
+    int nearClusters = 0;
+    if (options.nearThreshold > 0 && classes.size() > 1) {
+        DisjointSet sets(classes.size());
+        std::vector<double> lowest(classes.size(), 1.0);
+        for (int band = 0; band < LSH_BANDS; band++) {
+            std::unordered_map<uint64_t, std::vector<size_t>> buckets;
+            for (size_t c = 0; c < classes.size(); c++) {
+                buckets[bandKey(entries[classes[c]->front()].signature, band)].push_back(c);
+            }
+            for (const auto& bucket : buckets) {
+                const std::vector<size_t>& members = bucket.second;
+                for (size_t a = 0; a < members.size(); a++) {
+                    for (size_t b = a + 1; b < members.size(); b++) {
+                        double similarity = LevelCanonicalizer::similarity(
+                            entries[classes[members[a]]->front()].signature,
+                            entries[classes[members[b]]->front()].signature);
+                        if (similarity >= options.nearThreshold && sets.find(members[a]) != sets.find(members[b])) {
+                            size_t rootA = sets.find(members[a]);
+                            size_t rootB = sets.find(members[b]);
+                            double merged = std::min(similarity, std::min(lowest[rootA], lowest[rootB]));
+                            sets.unite(rootA, rootB);
+                            lowest[sets.find(rootA)] = merged;
+                        }
+                    }
+                }
+            }
+        }
+
+        std::map<size_t, std::vector<size_t>> clusters;
+        for (size_t c = 0; c < classes.size(); c++) {
+            clusters[sets.find(c)].push_back(c);
+        }
+        for (const auto& cluster : clusters) {
+            if (cluster.second.size() < 2) {
+                continue;
+            }
+            nearClusters++;
+            std::printf("~ %.2f", lowest[cluster.first]);
+            for (size_t c : cluster.second) {
+                std::printf(" %s", entries[classes[c]->front()].path.c_str());
+            }
+            std::printf("\n");
+        }
+    }
+
+    double totalSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    std::printf("%zu levels, %zu unique, %d exact clusters (%zu duplicates), %d near clusters, %d failed "
+        "(indexed in %.3fs, %.3fs total)\n",
+        entries.size(),
+        classes.size(), exactClusters, duplicateFiles, nearClusters, failed,
+        indexSeconds, totalSeconds);
+    return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,243 @@
+#include "../common/FileSystemUtils.h"
+#include "configs/LevelConfigLoader.h"
+#include "services/MatchBot.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+/**
+ * 对战回滚测试工具
+ * 两个 MatchBot 经 LoopbackLink 对战同一关卡，链路按帧加延迟和抖动（抖动会让消息乱序），
+ * 检查两端的结果、对方棋盘是否与对方自己的棋盘一致、有没有不同步，并统计回滚次数和单帧耗时。
+ *
+ *   racesim [options] <level>
+ *
+ * 机器人只在自己的帧上出牌，没有暂停推进时，结果与零延迟对战完全相同，也一并核对。
+ */
+namespace {
+
+struct Options {
+    int matches;
+    int latency;
+    int jitter;
+    int thinkFrames;
+    int undoPercent;
+    int maxFrames;
+    uint64_t seed;
+
+    Options() : matches(200), latency(6), jitter(6), thinkFrames(20), undoPercent(10), maxFrames(20000), seed(1) {}
+};
+
+struct MatchOutcome {
+    RaceResult results[LockstepMatch::PLAYER_COUNT];
+    uint32_t frames;
+    bool consistent;           // 两端结果相同、对方棋盘与对方自己的棋盘一致、没有不同步
+    RollbackStats stats[LockstepMatch::PLAYER_COUNT];
+    double totalFrameUs;       // 推进（含回滚）的总耗时
+    double maxFrameUs;         // 单次推进的最长耗时（含系统调度的抖动）
+
+    MatchOutcome() : frames(0), consistent(false), totalFrameUs(0), maxFrameUs(0) {}
+};
+
+void printUsage()
+{
+    std::printf(
+        "usage: racesim [options] <level>\n"
+        "  -n, --matches <n>    matches to play (default 200)\n"
+        "  --latency <f>        link latency in frames (default 6)\n"
+        "  --jitter <f>         extra random delay in frames, reorders messages (default 6)\n"
+        "  --think <f>          frames between bot moves (default 20)\n"
+        "  --undo <pct>         bot undo percentage (default 10)\n"
+        "  --seed <n>           random seed (default 1)\n");
+}
+
+bool sameResult(const RaceResult& a, const RaceResult& b)
+{
+    return a.winner == b.winner && a.draw == b.draw && a.frame == b.frame && a.confirmed == b.confirmed;
+}
+
+MatchOutcome playMatch(const std::shared_ptr<const BoardLayout>& layout, const Options& options, int latency, int jitter, uint64_t seed)
+{
+    LoopbackLink link(latency, jitter, seed);
+    MatchBot bots[LockstepMatch::PLAYER_COUNT];
+    for (int p = 0; p < LockstepMatch::PLAYER_COUNT; p++) {
+        bots[p].start(layout, p, &link.getEndpoint(p), options.thinkFrames, seed * 2 + p + 1);
+        bots[p].setUndoPercent(options.undoPercent);
+    }
+
+    MatchOutcome outcome;
+    uint32_t frame = 0;
+    for (; frame < static_cast<uint32_t>(options.maxFrames); frame++) {
+        for (auto& bot : bots) {
+            auto start = std::chrono::steady_clock::now();
+            bot.update();
+            double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+            outcome.totalFrameUs += us;
+            outcome.maxFrameUs = std::max(outcome.maxFrameUs, us);
+        }
+        link.tick();
+        if (bots[0].getMatch().getResult().confirmed && bots[1].getMatch().getResult().confirmed) {
+            break;
+        }
+    }
+    outcome.frames = frame;
+
+    // 再推进到链路排空，两端看到对方的全部输入
+    for (int drain = 0; drain < latency + jitter + 2; drain++) {
+        for (auto& bot : bots) {
+            bot.getMatch().advanceFrame();
+        }
+        link.tick();
+    }
+
+    outcome.consistent = true;
+    for (int p = 0; p < LockstepMatch::PLAYER_COUNT; p++) {
+        const LockstepMatch& match = bots[p].getMatch();
+        const LockstepMatch& other = bots[1 - p].getMatch();
+        outcome.results[p] = match.getResult();
+        outcome.stats[p] = match.getStats();
+        uint32_t seen = match.getHost().getStateChecksum(match.getSession(1 - p));
+        uint32_t actual = other.getHost().getStateChecksum(other.getSession(1 - p));
+        if (match.isDesynced() || seen != actual || match.getMoveCount(1 - p) != other.getMoveCount(1 - p)) {
+            outcome.consistent = false;
+        }
+    }
+    if (!sameResult(outcome.results[0], outcome.results[1])) {
+        outcome.consistent = false;
+    }
+    return outcome;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    std::string input;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (arg == "--help" || arg == "-h") {
+            printUsage();
+            return 0;
+        }
+        else if (arg[0] == '-') {
+            if (!value) {
+                printUsage();
+                return 1;
+            }
+            if (arg == "-n" || arg == "--matches") options.matches = std::atoi(value);
+            else if (arg == "--latency")           options.latency = std::atoi(value);
+            else if (arg == "--jitter")            options.jitter = std::atoi(value);
+            else if (arg == "--think")             options.thinkFrames = std::atoi(value);
+            else if (arg == "--undo")              options.undoPercent = std::atoi(value);
+            else if (arg == "--seed")              options.seed = std::strtoull(value, nullptr, 10);
+            else {
+                printUsage();
+                return 1;
+            }
+            i++;
+        }
+        else if (input.empty()) {
+            input = arg;
+        }
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+    if (input.empty()) {
+        printUsage();
+        return 1;
+    }
+
+    std::string data;
+    if (!FileSystemUtils::readFile(input, data)) {
+        std::fprintf(stderr, "%s: cannot read file\n", input.c_str());
+        return 1;
+    }
+    LevelConfig level;
+    std::string error;
+    if (!LevelConfigLoader::loadFromBuffer(data.data(), data.size(), level, &error)) {
+        std::fprintf(stderr, "%s: %s\n", input.c_str(), error.c_str());
+        return 1;
+    }
+    if (level.stack.empty()) {
+        std::fprintf(stderr, "%s: level has no stack cards\n", input.c_str());
+        return 1;
+    }
+    auto layout = BoardLayout::build(level);
+
+    int decided = 0;
+    int draws = 0;
+    int wins[LockstepMatch::PLAYER_COUNT] = { 0, 0 };
+    int inconsistent = 0;
+    int compared = 0;
+    int differsFromReference = 0;
+    uint64_t rollbacks = 0;
+    uint64_t resimulated = 0;
+    uint64_t lateInputs = 0;
+    uint64_t stalls = 0;
+    uint32_t maxRollback = 0;
+    double totalFrameUs = 0;
+    double maxFrameUs = 0;
+    uint64_t totalFrames = 0;
+    for (int m = 0; m < options.matches; m++) {
+        uint64_t seed = options.seed + static_cast<uint64_t>(m);
+        MatchOutcome outcome = playMatch(layout, options, options.latency, options.jitter, seed);
+        if (!outcome.consistent) {
+            inconsistent++;
+            std::printf("match %d: MISMATCH\n", m);
+        }
+        const RaceResult& result = outcome.results[0];
+        if (result.draw) {
+            draws++;
+        }
+        else if (result.winner >= 0) {
+            wins[result.winner]++;
+        }
+        if (result.confirmed) {
+            decided++;
+        }
+
+        uint64_t matchStalls = 0;
+        for (const auto& stats : outcome.stats) {
+            rollbacks += stats.rollbacks;
+            resimulated += stats.resimulatedFrames;
+            lateInputs += stats.lateInputs;
+            matchStalls += stats.stalledFrames;
+            maxRollback = std::max(maxRollback, stats.maxRollbackFrames);
+        }
+        stalls += matchStalls;
+        totalFrameUs += outcome.totalFrameUs;
+        totalFrames += static_cast<uint64_t>(outcome.frames) * LockstepMatch::PLAYER_COUNT;
+        maxFrameUs = std::max(maxFrameUs, outcome.maxFrameUs);
+
+        // 没有暂停推进时，延迟不影响结果
+        if (matchStalls == 0) {
+            MatchOutcome reference = playMatch(layout, options, 0, 0, seed);
+            compared++;
+            if (!sameResult(reference.results[0], result)) {
+                differsFromReference++;
+                std::printf("match %d: result differs from zero-latency reference\n", m);
+            }
+        }
+    }
+
+    std::printf("%s: %d matches, latency %d+%d frames: player 0 won %d, player 1 won %d, %d draws, %d undecided\n",
+        input.c_str(), options.matches, options.latency, options.jitter, wins[0], wins[1], draws, options.matches - decided);
+    std::printf("rollbacks %llu (late inputs %llu), %.1f frames resimulated on average, max %u; stalled frames %llu\n",
+        static_cast<unsigned long long>(rollbacks),
+        static_cast<unsigned long long>(lateInputs),
+        rollbacks > 0 ? static_cast<double>(resimulated) / rollbacks : 0.0,
+        maxRollback,
+        static_cast<unsigned long long>(stalls));
+    std::printf("advance frame (including rollback): %.2f us average, %.1f us slowest\n",
+        totalFrames > 0 ? totalFrameUs / totalFrames : 0.0, maxFrameUs);
+    std::printf("verify: %s (%d inconsistent, %d of %d differ from zero-latency reference)\n",
+        inconsistent == 0 && differsFromReference == 0 ? "ok" : "MISMATCH", inconsistent, differsFromReference, compared);
+    return inconsistent == 0 && differsFromReference == 0 ? 0 : 1;
+}
@@ -0,0 +1,223 @@
+#include "../common/FileSystemUtils.h"
+#include "configs/LevelConfigLoader.h"
+#include "services/SessionHost.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+/**
+ * 多会话宿主压测工具
+ * 在一个 SessionHost 中创建大量同一关卡的会话，轮流为每个会话随机走若干步（匹配、翻牌、偶尔回退，
+ * 通关或无路可走时重开），输出每会话内存占用、共享数据大小和每秒操作数。
+ *
+ *   sessionhost [options] <level>
+ *
+ * --verify 为前 n 个会话各维护一个 BoardState 并逐步比对，确认紧凑状态与规则实现一致。
+ */
+namespace {
+
+struct Options {
+    uint64_t sessions;
+    uint64_t rounds;
+    uint64_t seed;
+    uint64_t verify;
+
+    Options() : sessions(10000), rounds(50), seed(1), verify(0) {}
+};
+
+void printUsage()
+{
+    std::printf(
+        "usage: sessionhost [options] <level>\n"
+        "  -n, --sessions <n>   sessions to host (default 10000)\n"
+        "  -r, --rounds <n>     moves per session (default 50)\n"
+        "  --seed <n>           random seed (default 1)\n"
+        "  --verify <n>         mirror the first n sessions with BoardState and compare\n");
+}
+
+uint64_t nextRandom(uint64_t& state)
+{
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1DULL;
+}
+
+bool sameState(const SessionHost& host, SessionHandle handle, const BoardState& state)
+{
+    if (host.getLiveCount(handle) != state.getLiveCount() || host.getTrayRemaining(handle) != state.getTrayRemaining()
+        || host.getStackSize(handle) != state.getStackSize() || host.getTopCardId(handle) != state.getTopCardId()) {
+        return false;
+    }
+    for (int i = 0; i < state.getPlayfieldCount(); i++) {
+        if (host.isLive(handle, i) != state.isLive(i) || host.isExposed(handle, i) != state.isExposed(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    std::string input;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (arg == "--help" || arg == "-h") {
+            printUsage();
+            return 0;
+        }
+        else if (arg[0] == '-') {
+            if (!value) {
+                printUsage();
+                return 1;
+            }
+            if (arg == "-n" || arg == "--sessions")     options.sessions = std::strtoull(value, nullptr, 10);
+            else if (arg == "-r" || arg == "--rounds")  options.rounds = std::strtoull(value, nullptr, 10);
+            else if (arg == "--seed")                   options.seed = std::strtoull(value, nullptr, 10);
+            else if (arg == "--verify")                 options.verify = std::strtoull(value, nullptr, 10);
+            else {
+                printUsage();
+                return 1;
+            }
+            i++;
+        }
+        else if (input.empty()) {
+            input = arg;
+        }
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+    if (input.empty()) {
+        printUsage();
+        return 1;
+    }
+
+    std::string data;
+    if (!FileSystemUtils::readFile(input, data)) {
+        std::fprintf(stderr, "%s: cannot read file\n", input.c_str());
+        return 1;
+    }
+    LevelConfig level;
+    std::string error;
+    if (!LevelConfigLoader::loadFromBuffer(data.data(), data.size(), level, &error)) {
+        std::fprintf(stderr, "%s: %s\n", input.c_str(), error.c_str());
+        return 1;
+    }
+    if (level.stack.empty()) {
+        std::fprintf(stderr, "%s: level has no stack cards\n", input.c_str());
+        return 1;
+    }
+
+    auto layout = BoardLayout::build(level);
+    SessionHost host;
+    int levelIndex = host.addLevel(layout);
+    if (levelIndex < 0) {
+        std::fprintf(stderr, "%s: level too large for the session host\n", input.c_str());
+        return 1;
+    }
+
+    std::vector<SessionHandle> sessions;
+    sessions.reserve(options.sessions);
+    for (uint64_t i = 0; i < options.sessions; i++) {
+        sessions.push_back(host.createSession(levelIndex));
+    }
+    SessionMemoryReport created = host.getMemoryReport();
+
+    uint64_t verifyCount = options.verify < options.sessions ? options.verify : options.sessions;
+    std::vector<BoardState> mirrors(verifyCount);
+    for (auto& mirror : mirrors) {
+        mirror.init(layout);
+    }
+
+    // 轮流推进：每一轮每个会话走一步
+    uint64_t rng = options.seed * 0x9E3779B97F4A7C15ULL + 1;
+    uint64_t moves = 0;
+    uint64_t wins = 0;
+    uint64_t restarts = 0;
+    uint64_t mismatches = 0;
+    std::vector<int> playable;
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t round = 0; round < options.rounds; round++) {
+        for (uint64_t s = 0; s < sessions.size(); s++) {
+            SessionHandle handle = sessions[s];
+            host.collectPlayable(handle, playable);
+            uint64_t roll = nextRandom(rng);
+            GameMove move;
+            if (host.getStackSize(handle) > 1 && roll % 10 == 0) {
+                move = GameMove::undo();
+            }
+            else if (!playable.empty()) {
+                move = GameMove::match(playable[(roll >> 8) % playable.size()]);
+            }
+            else if (host.getTrayRemaining(handle) > 0) {
+                move = GameMove::flip();
+            }
+            else {
+                // 无路可走：重开
+                host.resetSession(handle);
+                if (s < verifyCount) {
+                    mirrors[s].init(layout);
+                }
+                restarts++;
+                continue;
+            }
+
+            host.applyMove(handle, move);
+            moves++;
+            if (s < verifyCount) {
+                mirrors[s].applyMove(move);
+                if (!sameState(host, handle, mirrors[s])) {
+                    mismatches++;
+                }
+            }
+            if (host.isWon(handle)) {
+                host.resetSession(handle);
+                if (s < verifyCount) {
+                    mirrors[s].init(layout);
+                }
+                wins++;
+            }
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // 重放出的 BoardState 与镜像一致
+    for (uint64_t s = 0; s < verifyCount; s++) {
+        BoardState replayed;
+        if (!host.toBoardState(sessions[s], replayed) || !sameState(host, sessions[s], replayed)) {
+            mismatches++;
+        }
+    }
+
+    SessionMemoryReport report = host.getMemoryReport();
+    size_t boardStateBytes = sizeof(BoardState) + level.playfield.size() * 2
+        + layout->getCardCount() * sizeof(int);
+    std::printf("%s: %llu sessions, %llu moves in %.3fs (%.0f moves/s), %llu wins, %llu restarts\n",
+        input.c_str(),
+        static_cast<unsigned long long>(report.sessions),
+        static_cast<unsigned long long>(moves),
+        seconds,
+        seconds > 0 ? moves / seconds : 0.0,
+        static_cast<unsigned long long>(wins),
+        static_cast<unsigned long long>(restarts));
+    std::printf("after create: %.1f bytes/session (%zu slot bytes, %zu page bytes)\n",
+        created.getBytesPerSession(), created.slotBytes, created.pageBytes);
+    std::printf("after play:   %.1f bytes/session, %zu of %zu sessions own a %zu-byte state block\n",
+        report.getBytesPerSession(), report.ownedSessions, report.sessions, host.getBlockBytes(levelIndex));
+    std::printf("shared level data %zu bytes, total %zu bytes (BoardState per session would be >= %zu bytes)\n",
+        report.levelBytes, report.totalBytes, boardStateBytes);
+    if (verifyCount > 0) {
+        std::printf("verify %llu sessions: %s (%llu mismatches)\n",
+            static_cast<unsigned long long>(verifyCount), mismatches == 0 ? "ok" : "MISMATCH",
+            static_cast<unsigned long long>(mismatches));
+    }
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,138 @@
+#include "services/TelemetryRecorder.h"
+#include "models/MatchRules.h"
+#include "zlib.h"
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/**
+ * 遥测文件转换工具
+ * 读取 TelemetryRecorder 写出的 .cgt.gz 文件，按记录输出 CSV
+ *
+ *   telemetry_reader [-o out.csv] telemetry_20240101_120000_000.cgt.gz ...
+ */
+namespace {
+
+void printUsage()
+{
+    std::fprintf(stderr, "usage: telemetry_reader [-o out.csv] <file.cgt.gz>...\n");
+}
+
+// 转换单个文件，返回记录数，文件格式错误返回 -1
+long convertFile(const std::string& path, FILE* out)
+{
+    gzFile file = gzopen(path.c_str(), "rb");
+    if (!file) {
+        std::fprintf(stderr, "%s: cannot open\n", path.c_str());
+        return -1;
+    }
+
+    unsigned char header[TelemetryRecorder::FILE_HEADER_SIZE];
+    if (gzread(file, header, sizeof(header)) != static_cast<int>(sizeof(header))
+        || std::memcmp(header, TelemetryRecorder::FILE_MAGIC, sizeof(TelemetryRecorder::FILE_MAGIC)) != 0) {
+        std::fprintf(stderr, "%s: not a telemetry file\n", path.c_str());
+        gzclose(file);
+        return -1;
+    }
+    if (header[4] != TelemetryRecorder::FILE_VERSION || header[5] < 29) {
+        std::fprintf(stderr, "%s: unsupported version %d (record size %d)\n", path.c_str(), header[4], header[5]);
+        gzclose(file);
+        return -1;
+    }
+
+    // 按文件头中的记录大小读取，兼容以后在记录末尾追加字段
+    size_t recordSize = header[5];
+    std::vector<unsigned char> buffer(recordSize * 1024);
+    long count = 0;
+    size_t pending = 0;
+    while (true) {
+        int n = gzread(file, buffer.data() + pending, static_cast<unsigned int>(buffer.size() - pending));
+        if (n <= 0) {
+            break;
+        }
+        size_t total = pending + static_cast<size_t>(n);
+        size_t records = total / recordSize;
+        for (size_t i = 0; i < records; i++) {
+            TelemetryRecord rec = TelemetryRecord::decode(&buffer[i * recordSize]);
+            const char* rule = rec.matchRule < static_cast<uint8_t>(MatchRuleType::COUNT)
+                ? MatchRules::ruleName(static_cast<MatchRuleType>(rec.matchRule)) : "unknown";
+            std::fprintf(out, "%s,%llu,%u,%u,%s,%d,%u,%u,%u,%u,%s,%u\n",
+                path.c_str(),
+                static_cast<unsigned long long>(rec.timeUs),
+                rec.levelSeq,
+                rec.moveIndex,
+                TelemetryRecord::typeName(rec.type),
+                rec.cardId,
+                rec.decideUs,
+                rec.liveCount,
+                rec.trayRemaining,
+                rec.undoDepth,
+                rule,
+                rec.playableCount);
+        }
+        count += static_cast<long>(records);
+        pending = total - records * recordSize;
+        std::memmove(buffer.data(), buffer.data() + records * recordSize, pending);
+    }
+
+    // 写入中途被杀时文件末尾可能不完整，只丢弃最后半条
+    if (pending > 0) {
+        std::fprintf(stderr, "%s: ignored %zu trailing bytes\n", path.c_str(), pending);
+    }
+    gzclose(file);
+    return count;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::string outPath;
+    std::vector<std::string> inputs;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-o" && i + 1 < argc) {
+            outPath = argv[++i];
+        }
+        else if (arg == "-h" || arg == "--help") {
+            printUsage();
+            return 0;
+        }
+        else {
+            inputs.push_back(arg);
+        }
+    }
+    if (inputs.empty()) {
+        printUsage();
+        return 1;
+    }
+
+    FILE* out = stdout;
+    if (!outPath.empty()) {
+        out = std::fopen(outPath.c_str(), "w");
+        if (!out) {
+            std::fprintf(stderr, "cannot write %s\n", outPath.c_str());
+            return 1;
+        }
+    }
+
+    std::fprintf(out, "file,time_us,level,move,type,card,decide_us,live,tray,undo_depth,rule,playable\n");
+    int failed = 0;
+    long total = 0;
+    for (const auto& path : inputs) {
+        long count = convertFile(path, out);
+        if (count < 0) {
+            failed++;
+        }
+        else {
+            total += count;
+        }
+    }
+
+    if (out != stdout) {
+        std::fclose(out);
+    }
+    std::fprintf(stderr, "%ld records from %d file(s), %d failed\n", total, static_cast<int>(inputs.size()) - failed, failed);
+    return failed > 0 ? 1 : 0;
+}
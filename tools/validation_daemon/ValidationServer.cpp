@@ -0,0 +1,407 @@
+#include "ValidationServer.h"
+#include "configs/LevelConfigLoader.h"
+#include "models/BoardState.h"
+#include "services/LevelSolver.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
+namespace {
+
+const size_t MAX_PAYLOAD_BYTES = 4 * 1024 * 1024;
+const size_t MAX_BATCH_SIZE = 4096;
+
+uint64_t elapsedUs(std::chrono::steady_clock::time_point since)
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - since).count());
+}
+
+void updateMax(std::atomic<uint64_t>& target, uint64_t value)
+{
+    uint64_t current = target.load(std::memory_order_relaxed);
+    while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+} // namespace
+
+struct ValidationServer::Connection {
+    SocketUtils::SocketHandle socket;
+    std::mutex writeMutex;
+    bool alive;
+
+    explicit Connection(SocketUtils::SocketHandle s) : socket(s), alive(true) {}
+
+    // 连接线程和队列中的请求都不再引用时才关闭，避免回写到已被复用的句柄
+    ~Connection() { SocketUtils::closeSocket(socket); }
+
+    void send(const std::string& line)
+    {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        if (alive && !SocketUtils::sendAll(socket, line.data(), line.size())) {
+            alive = false;
+        }
+    }
+};
+
+struct ValidationServer::Request {
+    std::string id;
+    std::string level;
+    std::string moveLog;
+    std::chrono::steady_clock::time_point receivedAt;
+};
+
+// ---------------------------------------------------------------------------
+
+ValidationStats::ValidationStats()
+    : _startTime(std::chrono::steady_clock::now())
+    , _received(0)
+    , _completed(0)
+    , _rejected(0)
+    , _totalLatencyUs(0)
+    , _maxLatencyUs(0)
+{
+    for (auto& bucket : _buckets) {
+        bucket.store(0);
+    }
+}
+
+void ValidationStats::onCompleted(uint64_t latencyUs)
+{
+    _completed.fetch_add(1, std::memory_order_relaxed);
+    _totalLatencyUs.fetch_add(latencyUs, std::memory_order_relaxed);
+    updateMax(_maxLatencyUs, latencyUs);
+
+    int bucket = 0;
+    while (bucket + 1 < LATENCY_BUCKETS && (1ULL << (bucket + 1)) <= latencyUs) {
+        bucket++;
+    }
+    _buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t ValidationStats::percentileUs(double ratio) const
+{
+    uint64_t total = _completed.load(std::memory_order_relaxed);
+    if (total == 0) {
+        return 0;
+    }
+    uint64_t target = static_cast<uint64_t>(total * ratio);
+    uint64_t seen = 0;
+    for (int i = 0; i < LATENCY_BUCKETS; i++) {
+        seen += _buckets[i].load(std::memory_order_relaxed);
+        if (seen > target) {
+            return 1ULL << (i + 1);   // 桶上界
+        }
+    }
+    return _maxLatencyUs.load(std::memory_order_relaxed);
+}
+
+std::string ValidationStats::format(size_t queueSize) const
+{
+    uint64_t received = _received.load();
+    uint64_t completed = _completed.load();
+    uint64_t rejected = _rejected.load();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - _startTime).count();
+
+    std::ostringstream out;
+    out << "received=" << received
+        << " completed=" << completed
+        << " rejected=" << rejected
+        << " inflight=" << (received - completed - rejected)
+        << " queue=" << queueSize
+        << " uptime_s=" << static_cast<uint64_t>(seconds)
+        << " throughput=" << (seconds > 0.0 ? static_cast<uint64_t>(completed / seconds) : 0)
+        << " avg_us=" << (completed > 0 ? _totalLatencyUs.load() / completed : 0)
+        << " p50_us<=" << percentileUs(0.50)
+        << " p99_us<=" << percentileUs(0.99)
+        << " max_us=" << _maxLatencyUs.load();
+    return out.str();
+}
+
+// ---------------------------------------------------------------------------
+
+ValidationServer::ValidationServer()
+    : _listener(SocketUtils::INVALID_HANDLE)
+    , _running(false)
+{
+}
+
+ValidationServer::~ValidationServer()
+{
+    stop();
+}
+
+bool ValidationServer::start(const ValidationServerConfig& config, std::string* error)
+{
+    _config = config;
+
+    if (!SocketUtils::initialize()) {
+        if (error) *error = "socket initialization failed";
+        return false;
+    }
+
+    _listener = config.unixPath.empty()
+        ? SocketUtils::listenTcp(config.host, config.port, error)
+        : SocketUtils::listenUnix(config.unixPath, error);
+    if (_listener == SocketUtils::INVALID_HANDLE) {
+        return false;
+    }
+
+    _pool.reset(new ThreadPool(config.threadCount, config.queueCapacity));
+    _running = true;
+    return true;
+}
+
+void ValidationServer::run()
+{
+    while (_running) {
+        SocketUtils::SocketHandle client = SocketUtils::acceptClient(_listener);
+        if (client == SocketUtils::INVALID_HANDLE) {
+            if (!_running) {
+                break;
+            }
+            continue;
+        }
+        if (!_running) {
+            SocketUtils::closeSocket(client);
+            break;
+        }
+
+        reapFinishedConnections();
+
+        auto connection = std::make_shared<Connection>(client);
+        std::lock_guard<std::mutex> lock(_connectionsMutex);
+        _connections.push_back(connection);
+        _connectionThreads.emplace_back(&ValidationServer::handleConnection, this, connection);
+    }
+}
+
+void ValidationServer::reapFinishedConnections()
+{
+    std::vector<std::thread> finished;
+    {
+        std::lock_guard<std::mutex> lock(_connectionsMutex);
+        for (auto id : _finishedThreads) {
+            auto it = std::find_if(_connectionThreads.begin(), _connectionThreads.end(),
+                [id](const std::thread& thread) { return thread.get_id() == id; });
+            if (it != _connectionThreads.end()) {
+                finished.push_back(std::move(*it));
+                *it = std::move(_connectionThreads.back());
+                _connectionThreads.pop_back();
+            }
+        }
+        _finishedThreads.clear();
+    }
+    // 这些线程已退出或即将退出，join 不会阻塞接收
+    for (auto& thread : finished) {
+        thread.join();
+    }
+}
+
+void ValidationServer::interrupt()
+{
+    // 只做原子写和 shutdown，可在信号处理函数中调用
+    _running = false;
+    if (_listener != SocketUtils::INVALID_HANDLE) {
+        SocketUtils::shutdownSocket(_listener);
+    }
+}
+
+void ValidationServer::stop()
+{
+    if (_listener == SocketUtils::INVALID_HANDLE) {
+        return;
+    }
+    _running = false;
+
+    SocketUtils::shutdownSocket(_listener);
+    SocketUtils::closeSocket(_listener);
+    _listener = SocketUtils::INVALID_HANDLE;
+
+    // 先让已入队的请求处理完并回写结果，再断开连接
+    _pool->waitIdle();
+    {
+        std::lock_guard<std::mutex> lock(_connectionsMutex);
+        for (auto& connection : _connections) {
+            SocketUtils::shutdownSocket(connection->socket);
+        }
+    }
+    std::vector<std::thread> threads;
+    {
+        std::lock_guard<std::mutex> lock(_connectionsMutex);
+        threads.swap(_connectionThreads);
+    }
+    for (auto& thread : threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    _pool->shutdown();
+
+    // 套接字随最后一个引用关闭
+    std::lock_guard<std::mutex> lock(_connectionsMutex);
+    _connections.clear();
+    _finishedThreads.clear();
+}
+
+std::string ValidationServer::formatStats() const
+{
+    return _stats.format(_pool ? _pool->getQueueSize() : 0);
+}
+
+void ValidationServer::handleConnection(std::shared_ptr<Connection> connection)
+{
+    SocketReader reader(connection->socket);
+    std::string line;
+
+    while (_running && reader.readLine(line)) {
+        if (line.empty()) {
+            continue;
+        }
+
+        std::istringstream header(line);
+        std::string command;
+        header >> command;
+
+        if (command == "REQ" || command == "BATCH") {
+            size_t count = 1;
+            if (command == "BATCH") {
+                header >> count;
+                if (count == 0 || count > MAX_BATCH_SIZE) {
+                    connection->send("ERROR bad batch size\n");
+                    break;
+                }
+            }
+
+            bool ok = true;
+            for (size_t i = 0; i < count && ok; i++) {
+                std::string reqLine = line;
+                if (command == "BATCH" && !reader.readLine(reqLine)) {
+                    ok = false;
+                    break;
+                }
+                std::shared_ptr<Request> request;
+                if (!readRequest(reader, reqLine, request)) {
+                    connection->send("ERROR malformed request\n");
+                    ok = false;
+                    break;
+                }
+                _stats.onReceived();
+
+                // 有界队列满时阻塞，从而停止读取该连接，向客户端施加背压
+                if (!_pool->submit([this, connection, request]() { processRequest(connection, request); })) {
+                    _stats.onRejected();
+                    connection->send("VERDICT " + request->id + " error=shutting_down\n");
+                }
+            }
+            if (!ok) {
+                break;
+            }
+            if (command == "BATCH") {
+                connection->send("ACK " + std::to_string(count) + "\n");
+            }
+        }
+        else if (command == "STATS") {
+            connection->send("STATS " + formatStats() + "\n");
+        }
+        else if (command == "QUIT") {
+            break;
+        }
+        else {
+            connection->send("ERROR unknown command\n");
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(connection->writeMutex);
+        connection->alive = false;
+        SocketUtils::shutdownSocket(connection->socket);
+    }
+
+    // 从连接表移除，线程交给接收循环 join；套接字在队列中的请求处理完后随连接对象关闭
+    std::lock_guard<std::mutex> lock(_connectionsMutex);
+    _connections.erase(std::remove(_connections.begin(), _connections.end(), connection), _connections.end());
+    _finishedThreads.push_back(std::this_thread::get_id());
+}
+
+bool ValidationServer::readRequest(SocketReader& reader, const std::string& header, std::shared_ptr<Request>& outRequest)
+{
+    std::istringstream in(header);
+    std::string command;
+    size_t levelBytes = 0;
+    size_t logBytes = 0;
+
+    auto request = std::make_shared<Request>();
+    if (!(in >> command >> request->id >> levelBytes >> logBytes) || command != "REQ") {
+        return false;
+    }
+    if (levelBytes > MAX_PAYLOAD_BYTES || logBytes > MAX_PAYLOAD_BYTES) {
+        return false;
+    }
+    if (!reader.readExact(request->level, levelBytes) || !reader.readExact(request->moveLog, logBytes)) {
+        return false;
+    }
+
+    request->receivedAt = std::chrono::steady_clock::now();
+    outRequest = request;
+    return true;
+}
+
+void ValidationServer::processRequest(const std::shared_ptr<Connection>& connection, const std::shared_ptr<Request>& request)
+{
+    std::ostringstream verdict;
+    verdict << "VERDICT " << request->id;
+
+    LevelConfig level;
+    std::string error;
+    BoardState state;
+    if (!LevelConfigLoader::loadFromBuffer(request->level.data(), request->level.size(), level, &error)
+        || !LevelConfigLoader::validate(level, &error)
+        || !state.init(level)) {
+        // 协议以空格分隔字段，错误信息中的空格替换为下划线
+        std::replace(error.begin(), error.end(), ' ', '_');
+        verdict << " level=invalid error=" << (error.empty() ? "bad_level" : error) << "\n";
+        _stats.onCompleted(elapsedUs(request->receivedAt));
+        connection->send(verdict.str());
+        return;
+    }
+    verdict << " level=ok";
+
+    // 回放操作记录，遇到非法操作时停止，并从停止处继续求解
+    int applied = 0;
+    if (request->moveLog.empty()) {
+        verdict << " replay=none";
+    }
+    else {
+        std::vector<GameMove> moves;
+        if (!GameMove::parseLog(request->moveLog, moves, &error)) {
+            verdict << " replay=illegal@0";
+        }
+        else {
+            applied = state.replay(moves);
+            if (applied == static_cast<int>(moves.size())) {
+                verdict << " replay=ok";
+            }
+            else {
+                verdict << " replay=illegal@" << applied;
+            }
+        }
+    }
+    verdict << " won=" << (state.isWon() ? 1 : 0);
+
+    LevelSolver solver;
+    solver.setNodeBudget(_config.nodeBudget);
+    solver.setTimeBudget(_config.timeBudgetMs);
+    SolveResult result = solver.solve(state);
+
+    verdict << " solve=" << SolveResult::statusName(result.status)
+            << " moves=" << applied
+            << " nodes=" << result.nodes;
+
+    uint64_t latency = elapsedUs(request->receivedAt);
+    verdict << " latency_us=" << latency << "\n";
+    _stats.onCompleted(latency);
+    connection->send(verdict.str());
+}
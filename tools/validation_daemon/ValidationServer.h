@@ -0,0 +1,119 @@
+#ifndef __VALIDATION_SERVER_H__
+#define __VALIDATION_SERVER_H__
+
+#include "../common/SocketUtils.h"
+#include "utils/ThreadPool.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * 校验服务配置
+ */
+struct ValidationServerConfig {
+    std::string host;           // TCP 监听地址
+    int port;                   // TCP 端口
+    std::string unixPath;       // 非空时改为监听 Unix 域套接字
+    size_t threadCount;         // 工作线程数，0 表示硬件线程数
+    size_t queueCapacity;       // 有界队列长度
+    uint64_t nodeBudget;        // 每个请求的求解状态数上限
+    int timeBudgetMs;           // 每个请求的求解时间上限
+
+    ValidationServerConfig()
+        : host("127.0.0.1")
+        , port(7878)
+        , threadCount(0)
+        , queueCapacity(1024)
+        , nodeBudget(2000000)
+        , timeBudgetMs(200)
+    {
+    }
+};
+
+/**
+ * 吞吐与延迟计数器（延迟按 2 的幂分桶统计）
+ */
+class ValidationStats {
+public:
+    static const int LATENCY_BUCKETS = 40;
+
+    ValidationStats();
+
+    void onReceived() { _received++; }
+    void onRejected() { _rejected++; }
+    void onCompleted(uint64_t latencyUs);
+
+    // 格式化为 "key=value" 列表
+    std::string format(size_t queueSize) const;
+
+private:
+    uint64_t percentileUs(double ratio) const;
+
+    std::chrono::steady_clock::time_point _startTime;
+    std::atomic<uint64_t> _received;
+    std::atomic<uint64_t> _completed;
+    std::atomic<uint64_t> _rejected;
+    std::atomic<uint64_t> _totalLatencyUs;
+    std::atomic<uint64_t> _maxLatencyUs;
+    std::atomic<uint64_t> _buckets[LATENCY_BUCKETS];
+};
+
+/**
+ * 本地关卡/回放校验服务
+ *
+ * 协议为文本行加定长负载，每行以 '\n' 结束：
+ *   BATCH <n>                          后跟 n 个 REQ，全部入队后回复 ACK <n>
+ *   REQ <id> <levelBytes> <logBytes>   后紧跟关卡数据（JSON 或二进制）和操作记录（如 "M3 F U"）
+ *   STATS                              回复 STATS 计数器
+ *   QUIT                               关闭连接
+ * 结果按完成顺序流式返回：
+ *   VERDICT <id> level=ok|invalid replay=none|ok|illegal@<k> won=0|1 solve=winnable|unwinnable|unknown
+ *           moves=<k> nodes=<n> latency_us=<us> [error=<msg>]
+ */
+class ValidationServer {
+public:
+    ValidationServer();
+    ~ValidationServer();
+
+    bool start(const ValidationServerConfig& config, std::string* error = nullptr);
+
+    // 阻塞运行接收循环，直到 interrupt() 或 stop() 被调用
+    void run();
+
+    // 让 run() 尽快返回（可在信号处理函数中调用）
+    void interrupt();
+
+    // 关闭监听和所有连接，等待队列中的请求处理完毕
+    void stop();
+
+    std::string formatStats() const;
+
+private:
+    struct Connection;
+    struct Request;
+
+    void handleConnection(std::shared_ptr<Connection> connection);
+
+    // join 已结束的连接线程
+    void reapFinishedConnections();
+    bool readRequest(SocketReader& reader, const std::string& header, std::shared_ptr<Request>& outRequest);
+    void processRequest(const std::shared_ptr<Connection>& connection, const std::shared_ptr<Request>& request);
+
+    ValidationServerConfig _config;
+    SocketUtils::SocketHandle _listener;
+    std::unique_ptr<ThreadPool> _pool;
+    ValidationStats _stats;
+    std::atomic<bool> _running;
+
+    std::mutex _connectionsMutex;
+    std::vector<std::shared_ptr<Connection>> _connections;
+    std::vector<std::thread> _connectionThreads;
+    std::vector<std::thread::id> _finishedThreads;     // 已结束、等待 join 的连接线程
+};
+
+#endif // __VALIDATION_SERVER_H__
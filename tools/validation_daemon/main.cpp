@@ -0,0 +1,114 @@
+#include "ValidationServer.h"
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+namespace {
+
+ValidationServer* g_server = nullptr;
+
+void onSignal(int)
+{
+    if (g_server) {
+        g_server->interrupt();
+    }
+}
+
+void printUsage()
+{
+    std::printf(
+        "usage: validation_daemon [options]\n"
+        "  --host <addr>        TCP listen address (default 127.0.0.1)\n"
+        "  --port <n>           TCP port (default 7878)\n"
+        "  --unix <path>        listen on a unix domain socket instead of TCP\n"
+        "  --threads <n>        worker threads (default: hardware threads)\n"
+        "  --queue <n>          bounded queue capacity (default 1024)\n"
+        "  --nodes <n>          solver node budget per request (default 2000000)\n"
+        "  --time-ms <n>        solver time budget per request (default 200)\n"
+        "  --stats-every <s>    print counters to stdout every s seconds (default 0 = off)\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    ValidationServerConfig config;
+    int statsEvery = 0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (arg == "--help" || arg == "-h") {
+            printUsage();
+            return 0;
+        }
+        if (!value) {
+            printUsage();
+            return 1;
+        }
+        if (arg == "--host")             config.host = value;
+        else if (arg == "--port")        config.port = std::atoi(value);
+        else if (arg == "--unix")        config.unixPath = value;
+        else if (arg == "--threads")     config.threadCount = static_cast<size_t>(std::atoi(value));
+        else if (arg == "--queue")       config.queueCapacity = static_cast<size_t>(std::atoi(value));
+        else if (arg == "--nodes")       config.nodeBudget = std::strtoull(value, nullptr, 10);
+        else if (arg == "--time-ms")     config.timeBudgetMs = std::atoi(value);
+        else if (arg == "--stats-every") statsEvery = std::atoi(value);
+        else {
+            printUsage();
+            return 1;
+        }
+        i++;
+    }
+
+    ValidationServer server;
+    std::string error;
+    if (!server.start(config, &error)) {
+        std::fprintf(stderr, "validation_daemon: %s\n", error.c_str());
+        return 1;
+    }
+
+    g_server = &server;
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    if (config.unixPath.empty()) {
+        std::printf("validation_daemon listening on %s:%d\n", config.host.c_str(), config.port);
+    }
+    else {
+        std::printf("validation_daemon listening on %s\n", config.unixPath.c_str());
+    }
+    std::fflush(stdout);
+
+    std::atomic<bool> statsRunning(statsEvery > 0);
+    std::thread statsThread;
+    if (statsEvery > 0) {
+        statsThread = std::thread([&server, &statsRunning, statsEvery]() {
+            int ticks = 0;
+            while (statsRunning) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                if (++ticks >= statsEvery * 10) {
+                    ticks = 0;
+                    std::printf("STATS %s\n", server.formatStats().c_str());
+                    std::fflush(stdout);
+                }
+            }
+        });
+    }
+
+    server.run();
+    g_server = nullptr;
+    server.stop();
+
+    statsRunning = false;
+    if (statsThread.joinable()) {
+        statsThread.join();
+    }
+    std::printf("STATS %s\n", server.formatStats().c_str());
+    return 0;
+}
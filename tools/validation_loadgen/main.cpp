@@ -0,0 +1,247 @@
+#include "../common/SocketUtils.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * validation_daemon 的本地压测客户端
+ * 多个连接并发发送批量请求，统计吞吐和端到端延迟
+ */
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+struct LoadOptions {
+    std::string host = "127.0.0.1";
+    int port = 7878;
+    std::string unixPath;
+    std::string levelFile;
+    std::string moveLog;
+    int connections = 4;
+    int batches = 100;
+    int batchSize = 32;
+};
+
+struct ConnectionResult {
+    std::vector<double> latenciesUs;
+    uint64_t winnable = 0;
+    uint64_t unwinnable = 0;
+    uint64_t unknown = 0;
+    uint64_t invalid = 0;
+    bool failed = false;
+};
+
+bool readFile(const std::string& path, std::string& out)
+{
+    std::ifstream in(path.c_str(), std::ios::binary);
+    if (!in) {
+        return false;
+    }
+    std::ostringstream buffer;
+    buffer << in.rdbuf();
+    out = buffer.str();
+    return true;
+}
+
+SocketUtils::SocketHandle connectTo(const LoadOptions& options)
+{
+    std::string error;
+    SocketUtils::SocketHandle socket = options.unixPath.empty()
+        ? SocketUtils::connectTcp(options.host, options.port, &error)
+        : SocketUtils::connectUnix(options.unixPath, &error);
+    if (socket == SocketUtils::INVALID_HANDLE) {
+        std::fprintf(stderr, "validation_loadgen: %s\n", error.c_str());
+    }
+    return socket;
+}
+
+void runConnection(int index, const LoadOptions& options, const std::string& level, ConnectionResult& result)
+{
+    SocketUtils::SocketHandle socket = connectTo(options);
+    if (socket == SocketUtils::INVALID_HANDLE) {
+        result.failed = true;
+        return;
+    }
+
+    const int total = options.batches * options.batchSize;
+    std::mutex sentMutex;
+    std::unordered_map<std::string, Clock::time_point> sentAt;
+    sentAt.reserve(total);
+
+    // 读线程：按完成顺序接收 VERDICT
+    std::thread reader([&]() {
+        SocketReader in(socket);
+        std::string line;
+        int received = 0;
+        while (received < total && in.readLine(line)) {
+            if (line.compare(0, 8, "VERDICT ") != 0) {
+                continue;
+            }
+            Clock::time_point now = Clock::now();
+            std::istringstream fields(line.substr(8));
+            std::string id;
+            fields >> id;
+
+            Clock::time_point start;
+            {
+                std::lock_guard<std::mutex> lock(sentMutex);
+                auto it = sentAt.find(id);
+                if (it == sentAt.end()) {
+                    continue;
+                }
+                start = it->second;
+                sentAt.erase(it);
+            }
+            result.latenciesUs.push_back(std::chrono::duration<double, std::micro>(now - start).count());
+
+            if (line.find("level=invalid") != std::string::npos) result.invalid++;
+            else if (line.find("solve=winnable") != std::string::npos) result.winnable++;
+            else if (line.find("solve=unwinnable") != std::string::npos) result.unwinnable++;
+            else result.unknown++;
+            received++;
+        }
+        if (received < total) {
+            result.failed = true;
+        }
+    });
+
+    // 写线程（当前线程）：流水线发送所有批次
+    for (int b = 0; b < options.batches && !result.failed; b++) {
+        std::string payload = "BATCH " + std::to_string(options.batchSize) + "\n";
+        std::vector<std::string> ids;
+        for (int r = 0; r < options.batchSize; r++) {
+            std::string id = std::to_string(index) + "-" + std::to_string(b) + "-" + std::to_string(r);
+            payload += "REQ " + id + " " + std::to_string(level.size()) + " " + std::to_string(options.moveLog.size()) + "\n";
+            payload += level;
+            payload += options.moveLog;
+            ids.push_back(id);
+        }
+        {
+            Clock::time_point now = Clock::now();
+            std::lock_guard<std::mutex> lock(sentMutex);
+            for (const auto& id : ids) {
+                sentAt[id] = now;
+            }
+        }
+        if (!SocketUtils::sendAll(socket, payload.data(), payload.size())) {
+            result.failed = true;
+        }
+    }
+
+    if (result.failed) {
+        SocketUtils::shutdownSocket(socket);
+    }
+    reader.join();
+
+    const char quit[] = "QUIT\n";
+    SocketUtils::sendAll(socket, quit, sizeof(quit) - 1);
+    SocketUtils::closeSocket(socket);
+}
+
+double percentile(const std::vector<double>& sorted, double ratio)
+{
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t index = static_cast<size_t>(ratio * (sorted.size() - 1));
+    return sorted[index];
+}
+
+void printUsage()
+{
+    std::printf(
+        "usage: validation_loadgen --level <file> [options]\n"
+        "  --host <addr> / --port <n> / --unix <path>   daemon address\n"
+        "  --moves <text>        move log sent with every request, e.g. \"M3 F U\"\n"
+        "  --connections <n>     concurrent connections (default 4)\n"
+        "  --batches <n>         batches per connection (default 100)\n"
+        "  --batch-size <n>      requests per batch (default 32)\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    LoadOptions options;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        const char* value = argv[i + 1];
+        if (arg == "--host")              options.host = value;
+        else if (arg == "--port")         options.port = std::atoi(value);
+        else if (arg == "--unix")         options.unixPath = value;
+        else if (arg == "--level")        options.levelFile = value;
+        else if (arg == "--moves")        options.moveLog = value;
+        else if (arg == "--connections")  options.connections = std::max(1, std::atoi(value));
+        else if (arg == "--batches")      options.batches = std::max(1, std::atoi(value));
+        else if (arg == "--batch-size")   options.batchSize = std::max(1, std::atoi(value));
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    std::string level;
+    if (options.levelFile.empty() || !readFile(options.levelFile, level)) {
+        printUsage();
+        return 1;
+    }
+    if (!SocketUtils::initialize()) {
+        return 1;
+    }
+
+    std::vector<ConnectionResult> results(options.connections);
+    std::vector<std::thread> threads;
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < options.connections; i++) {
+        threads.emplace_back(runConnection, i, std::cref(options), std::cref(level), std::ref(results[i]));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::vector<double> latencies;
+    ConnectionResult total;
+    for (const auto& result : results) {
+        latencies.insert(latencies.end(), result.latenciesUs.begin(), result.latenciesUs.end());
+        total.winnable += result.winnable;
+        total.unwinnable += result.unwinnable;
+        total.unknown += result.unknown;
+        total.invalid += result.invalid;
+        total.failed = total.failed || result.failed;
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    std::printf("requests=%zu seconds=%.3f throughput=%.0f/s\n",
+        latencies.size(), seconds, seconds > 0.0 ? latencies.size() / seconds : 0.0);
+    std::printf("latency_us p50=%.0f p90=%.0f p99=%.0f max=%.0f\n",
+        percentile(latencies, 0.50), percentile(latencies, 0.90),
+        percentile(latencies, 0.99), latencies.empty() ? 0.0 : latencies.back());
+    std::printf("verdicts winnable=%llu unwinnable=%llu unknown=%llu invalid=%llu\n",
+        static_cast<unsigned long long>(total.winnable), static_cast<unsigned long long>(total.unwinnable),
+        static_cast<unsigned long long>(total.unknown), static_cast<unsigned long long>(total.invalid));
+
+    // 打印服务端计数器
+    SocketUtils::SocketHandle socket = connectTo(options);
+    if (socket != SocketUtils::INVALID_HANDLE) {
+        const char stats[] = "STATS\n";
+        SocketUtils::sendAll(socket, stats, sizeof(stats) - 1);
+        SocketReader in(socket);
+        std::string line;
+        if (in.readLine(line)) {
+            std::printf("server %s\n", line.c_str());
+        }
+        SocketUtils::closeSocket(socket);
+    }
+
+    return total.failed ? 2 : 0;
+}